@@ -0,0 +1,61 @@
+#
+# Adds the desktop app sources, except its main.cpp, to a test or benchmark target, with the
+# include directories, compile definitions, libraries and ui files of the MEGAsync target.
+#
+function(desktopapp_add_app_sources TARGET_NAME)
+    # Reuse the app sources with their paths resolved against the app folder
+    get_target_property(MEGA_DESKTOP_APP_DIR MEGAsync SOURCE_DIR)
+    get_target_property(MEGA_DESKTOP_APP_TARGET_SOURCES MEGAsync SOURCES)
+    get_target_property(MEGA_DESKTOP_APP_UIC_SEARCH_PATHS MEGAsync AUTOUIC_SEARCH_PATHS)
+    get_target_property(MEGA_DESKTOP_APP_INCLUDE_DIRECTORIES MEGAsync INCLUDE_DIRECTORIES)
+    get_target_property(MEGA_DESKTOP_APP_COMPILE_DEFINITIONS MEGAsync COMPILE_DEFINITIONS)
+    get_target_property(MEGA_DESKTOP_APP_LINK_LIBRARIES MEGAsync LINK_LIBRARIES)
+
+    set(MEGA_DESKTOP_APP_SOURCES)
+    foreach(APP_SOURCE IN LISTS MEGA_DESKTOP_APP_TARGET_SOURCES)
+        if (APP_SOURCE STREQUAL "main.cpp")
+            continue()
+        endif()
+
+        if (NOT IS_ABSOLUTE "${APP_SOURCE}" AND NOT APP_SOURCE MATCHES "^\\$<")
+            set(APP_SOURCE "${MEGA_DESKTOP_APP_DIR}/${APP_SOURCE}")
+        endif()
+        list(APPEND MEGA_DESKTOP_APP_SOURCES "${APP_SOURCE}")
+    endforeach()
+
+    set(MEGA_DESKTOP_APP_TARGET_UIC_SEARCH_PATHS)
+    foreach(UIC_SEARCH_PATH IN LISTS MEGA_DESKTOP_APP_UIC_SEARCH_PATHS)
+        list(APPEND MEGA_DESKTOP_APP_TARGET_UIC_SEARCH_PATHS "${MEGA_DESKTOP_APP_DIR}/${UIC_SEARCH_PATH}")
+    endforeach()
+
+    target_sources(${TARGET_NAME}
+        PRIVATE
+        ${MEGA_DESKTOP_APP_SOURCES}
+    )
+
+    # Activate properties for Qt code
+    set_target_properties(${TARGET_NAME}
+        PROPERTIES
+        AUTOUIC ON
+        AUTOMOC ON
+        AUTORCC ON
+        AUTOUIC_SEARCH_PATHS "${MEGA_DESKTOP_APP_TARGET_UIC_SEARCH_PATHS}"
+    )
+
+    target_include_directories(${TARGET_NAME}
+        PRIVATE
+        ${MEGA_DESKTOP_APP_INCLUDE_DIRECTORIES}
+    )
+
+    target_compile_definitions(${TARGET_NAME}
+        PRIVATE
+        ${MEGA_DESKTOP_APP_COMPILE_DEFINITIONS}
+    )
+
+    target_link_libraries(${TARGET_NAME}
+        PRIVATE
+        ${MEGA_DESKTOP_APP_LINK_LIBRARIES}
+    )
+
+    add_dependencies(${TARGET_NAME} generate_ts)
+endfunction()
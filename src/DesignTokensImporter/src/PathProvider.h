@@ -13,6 +13,11 @@ namespace DTI
         const QString RELATIVE_DESIGN_TOKENS_FILE_PATH = QString::fromLatin1("../DesignTokensImporter/megadesignassets/tokens.json");
         const QString JSON_NAME_FILTER = QString::fromLatin1("*.json");
         const QString COLOR_THEMED_TOKENS_FILE_NAME = QString::fromLatin1("ColorThemedTokens.json");
+        const QString RELATIVE_UI_FILES_PATH = RELATIVE_UI_PATH + QString::fromLatin1("/ui");
+        const QString UI_NAME_FILTER = QString::fromLatin1("*.ui");
+        const QString RELATIVE_STYLE_DIR_PATH = RELATIVE_UI_PATH + QString::fromLatin1("/style");
+        const QString RELATIVE_STANDARD_COMPONENTS_STYLE_SHEET_PATH = RELATIVE_STYLE_DIR_PATH + QString::fromLatin1("/WidgetsComponentsStyleSheets.css");
+        const QString THEMED_STYLE_SHEETS_FILE_NAME = QString::fromLatin1("ThemedStyleSheets.json");
     }
 }
 
@@ -64,7 +64,7 @@ QJsonObject WidgetsColorDesignTarget::createColorJson(const ColorData& themeData
     return jsonTheme;
 }
 
-QString WidgetsColorDesignTarget::adjustColorValue(const QString& colorValue) const
+QString WidgetsColorDesignTarget::adjustColorValue(const QString& colorValue)
 {
     if (colorValue.size() == NO_ALPHA_COLOR_SIZE) // Solid alpha channel is missing
     {
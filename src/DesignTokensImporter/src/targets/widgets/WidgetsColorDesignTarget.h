@@ -13,12 +13,13 @@ class WidgetsColorDesignTarget: public IDesignTarget
 public:
     void deploy(const DesignAssets& designAssets) const override;
 
+    static QString adjustColorValue(const QString& colorValue);
+
 private:
     static bool registered;
 
     QJsonObject createThemeJson(const DesignAssets& designAssets) const;
     QJsonObject createColorJson(const ColorData& themeData) const;
-    QString adjustColorValue(const QString& colorValue) const;
     void writeThemesToFile(const QJsonObject& jsonThemes) const;
 };
 }
@@ -0,0 +1,294 @@
+#include "WidgetsStyleSheetsDesignTarget.h"
+
+#include "DesignTargetFactory.h"
+#include "PathProvider.h"
+#include "Utilities.h"
+#include "WidgetsColorDesignTarget.h"
+
+#include <QCryptographicHash>
+#include <QDir>
+#include <QFile>
+#include <QJsonDocument>
+#include <QRegularExpression>
+#include <QStringBuilder>
+#include <QXmlStreamReader>
+
+using namespace DTI;
+
+// Same expressions used by the TokenParserWidgetManager of the desktop app
+static const QRegularExpression COLOR_TOKEN_REGULAR_EXPRESSION(
+    "(#.*) *; *\\/\\* *colorToken\\.(.*)\\*\\/");
+static const QRegularExpression ICON_COLOR_TOKEN_REGULAR_EXPRESSION(
+    " *\\/\\* *ColorTokenIcon;(.*);(.*);(.*);(.*);colorToken\\.(.*) *\\*\\/");
+static const QRegularExpression REPLACE_THEME_TOKEN_REGULAR_EXPRESSION(
+    ".*\\/(light|dark)\\/.*; *\\/\\* *replaceThemeToken *\\*\\/");
+
+static const QString COLOR_TOKEN_MARKER("colorToken.");
+static const QString REPLACE_THEME_TOKEN_MARKER("replaceThemeToken");
+
+enum COLOR_TOKEN_CAPTURE_INDEX
+{
+    COLOR_WHOLE_MATCH,
+    COLOR_HEX_COLOR_VALUE,
+    COLOR_DESIGN_TOKEN_NAME
+};
+
+enum ICON_TOKEN_CAPTURE_INDEX
+{
+    ICON_TOKEN_WHOLE_MATCH,
+    ICON_TOKEN_TARGET_PROPERTY,
+    ICON_TOKEN_TARGET_ELEMENT_ID,
+    ICON_TOKEN_TARGET_MODE,
+    ICON_TOKEN_TARGET_STATE,
+    ICON_TOKEN_DESIGN_TOKEN_NAME
+};
+
+enum REPLACE_THEME_TOKEN_CAPTURE_INDEX
+{
+    REPLACE_THEME_TOKEN_WHOLE_MATCH,
+    REPLACE_THEME_TOKEN_THEME
+};
+
+bool WidgetsStyleSheetsDesignTarget::registered =
+    ConcreteDesignTargetFactory<WidgetsStyleSheetsDesignTarget>::Register("widgetsStyleSheets");
+
+void WidgetsStyleSheetsDesignTarget::deploy(const DesignAssets& designAssets) const
+{
+    const auto uiStyleSheets = readUiStyleSheets();
+    const auto standardComponentsStyleSheet = readStandardComponentsStyleSheet();
+
+    QJsonObject jsonThemes;
+
+    for (auto themeColorDataIt = designAssets.colorTokens.constKeyValueBegin();
+         themeColorDataIt != designAssets.colorTokens.constKeyValueEnd();
+         ++themeColorDataIt)
+    {
+        auto themeColorData = *themeColorDataIt;
+        const auto& themeName = themeColorData.first;
+        const auto& themeData = themeColorData.second;
+
+        jsonThemes[themeName] =
+            createThemeJson(themeName, themeData, uiStyleSheets, standardComponentsStyleSheet);
+    }
+
+    if (!jsonThemes.isEmpty())
+    {
+        writeStyleSheetsToFile(jsonThemes);
+    }
+}
+
+//!
+//! \brief WidgetsStyleSheetsDesignTarget::readUiStyleSheets
+//! \returns the name and the stylesheet of the top level widget of every tokenized .ui file
+//!
+QList<WidgetsStyleSheetsDesignTarget::UiStyleSheet>
+    WidgetsStyleSheetsDesignTarget::readUiStyleSheets() const
+{
+    QList<UiStyleSheet> uiStyleSheets;
+
+    const auto uiFiles = Utilities::findFilesInDir(QDir::currentPath() % PathProvider::RELATIVE_UI_FILES_PATH,
+                                                   PathProvider::UI_NAME_FILTER);
+    for (const auto& uiFilePath : uiFiles)
+    {
+        QFile uiFile(uiFilePath);
+        if (!uiFile.open(QIODevice::ReadOnly | QIODevice::Text))
+        {
+            qWarning() << __func__ << " Error opening file : " << uiFilePath;
+            continue;
+        }
+
+        QXmlStreamReader xml(&uiFile);
+        if (!xml.readNextStartElement() || xml.name() != QLatin1String("ui"))
+        {
+            continue;
+        }
+
+        while (xml.readNextStartElement())
+        {
+            if (xml.name() != QLatin1String("widget"))
+            {
+                xml.skipCurrentElement();
+                continue;
+            }
+
+            UiStyleSheet uiStyleSheet;
+            uiStyleSheet.widgetName = xml.attributes().value("name").toString();
+
+            while (xml.readNextStartElement())
+            {
+                if (xml.name() == QLatin1String("property")
+                    && xml.attributes().value("name") == QLatin1String("styleSheet")
+                    && xml.readNextStartElement() && xml.name() == QLatin1String("string"))
+                {
+                    uiStyleSheet.styleSheet = xml.readElementText();
+                }
+                xml.skipCurrentElement();
+            }
+
+            if (!uiStyleSheet.widgetName.isEmpty() && isTokenized(uiStyleSheet.styleSheet))
+            {
+                uiStyleSheets.append(uiStyleSheet);
+            }
+            break;
+        }
+
+        if (xml.hasError())
+        {
+            qWarning() << __func__ << " Error parsing file : " << uiFilePath << xml.errorString();
+        }
+    }
+
+    return uiStyleSheets;
+}
+
+QString WidgetsStyleSheetsDesignTarget::readStandardComponentsStyleSheet() const
+{
+    QFile file(QDir::currentPath() % PathProvider::RELATIVE_STANDARD_COMPONENTS_STYLE_SHEET_PATH);
+    if (!file.open(QIODevice::ReadOnly | QIODevice::Text))
+    {
+        qWarning() << __func__ << " Error opening file : " << file.fileName();
+        return QString();
+    }
+
+    return QString::fromLatin1(file.readAll());
+}
+
+QJsonObject WidgetsStyleSheetsDesignTarget::createThemeJson(const QString& theme,
+                                                            const ColorData& themeData,
+                                                            const QList<UiStyleSheet>& uiStyleSheets,
+                                                            const QString& standardComponentsStyleSheet) const
+{
+    QJsonObject jsonWidgets;
+
+    for (const auto& uiStyleSheet : uiStyleSheets)
+    {
+        QJsonObject jsonWidget;
+        jsonWidget["sourceHash"] = getSourceHash(uiStyleSheet.styleSheet);
+        jsonWidget["styleSheet"] = resolveStyleSheet(uiStyleSheet.styleSheet, theme, themeData);
+        jsonWidget["iconTokens"] = getIconTokens(uiStyleSheet.styleSheet, themeData);
+        jsonWidgets[uiStyleSheet.widgetName] = jsonWidget;
+    }
+
+    QJsonObject jsonComponents;
+    jsonComponents["sourceHash"] = getSourceHash(standardComponentsStyleSheet);
+    jsonComponents["styleSheet"] = resolveStyleSheet(standardComponentsStyleSheet, theme, themeData);
+
+    QJsonObject jsonTheme;
+    jsonTheme["components"] = jsonComponents;
+    jsonTheme["widgets"] = jsonWidgets;
+
+    return jsonTheme;
+}
+
+//!
+//! \brief WidgetsStyleSheetsDesignTarget::resolveStyleSheet
+//! \returns @styleSheet with the color values replaced by the ones of its color tokens and the
+//! themed resource paths pointing to @theme. The token comments are kept.
+//!
+QString WidgetsStyleSheetsDesignTarget::resolveStyleSheet(const QString& styleSheet,
+                                                          const QString& theme,
+                                                          const ColorData& themeData) const
+{
+    QString colorsResolved;
+    int lastIndex = 0;
+
+    auto colorMatchIterator = COLOR_TOKEN_REGULAR_EXPRESSION.globalMatch(styleSheet);
+    while (colorMatchIterator.hasNext())
+    {
+        auto match = colorMatchIterator.next();
+        auto tokenId = match.captured(COLOR_DESIGN_TOKEN_NAME).trimmed();
+
+        if (!themeData.contains(tokenId))
+        {
+            qWarning() << __func__ << " Error color token not found : " << tokenId;
+            continue;
+        }
+
+        auto startIndex = match.capturedStart(COLOR_HEX_COLOR_VALUE);
+        colorsResolved += styleSheet.midRef(lastIndex, startIndex - lastIndex)
+                          % WidgetsColorDesignTarget::adjustColorValue(themeData.value(tokenId));
+        lastIndex = match.capturedEnd(COLOR_HEX_COLOR_VALUE);
+    }
+    colorsResolved += styleSheet.midRef(lastIndex);
+
+    QString themeResolved;
+    lastIndex = 0;
+
+    auto themeMatchIterator = REPLACE_THEME_TOKEN_REGULAR_EXPRESSION.globalMatch(colorsResolved);
+    while (themeMatchIterator.hasNext())
+    {
+        auto match = themeMatchIterator.next();
+        auto startIndex = match.capturedStart(REPLACE_THEME_TOKEN_THEME);
+
+        themeResolved += colorsResolved.midRef(lastIndex, startIndex - lastIndex) % theme.toLower();
+        lastIndex = match.capturedEnd(REPLACE_THEME_TOKEN_THEME);
+    }
+    themeResolved += colorsResolved.midRef(lastIndex);
+
+    return themeResolved;
+}
+
+QJsonArray WidgetsStyleSheetsDesignTarget::getIconTokens(const QString& styleSheet,
+                                                         const ColorData& themeData) const
+{
+    QJsonArray jsonIconTokens;
+
+    auto matchIterator = ICON_COLOR_TOKEN_REGULAR_EXPRESSION.globalMatch(styleSheet);
+    while (matchIterator.hasNext())
+    {
+        auto match = matchIterator.next();
+        auto tokenId = match.captured(ICON_TOKEN_DESIGN_TOKEN_NAME).trimmed();
+
+        if (!themeData.contains(tokenId))
+        {
+            qWarning() << __func__ << " Error color token not found : " << tokenId;
+            continue;
+        }
+
+        QJsonObject jsonIconToken;
+        jsonIconToken["property"] = match.captured(ICON_TOKEN_TARGET_PROPERTY);
+        jsonIconToken["elementId"] = match.captured(ICON_TOKEN_TARGET_ELEMENT_ID);
+        jsonIconToken["mode"] = match.captured(ICON_TOKEN_TARGET_MODE);
+        jsonIconToken["state"] = match.captured(ICON_TOKEN_TARGET_STATE);
+        jsonIconToken["token"] = tokenId;
+        jsonIconToken["color"] = WidgetsColorDesignTarget::adjustColorValue(themeData.value(tokenId));
+        jsonIconTokens.append(jsonIconToken);
+    }
+
+    return jsonIconTokens;
+}
+
+//!
+//! \brief WidgetsStyleSheetsDesignTarget::getSourceHash
+//! \returns the hash the desktop app uses to check that a resolved stylesheet was generated from
+//! the stylesheet it has, as the .ui files can be modified after this target is deployed.
+//!
+QString WidgetsStyleSheetsDesignTarget::getSourceHash(const QString& styleSheet) const
+{
+    return QString::fromLatin1(
+        QCryptographicHash::hash(styleSheet.toUtf8(), QCryptographicHash::Md5).toHex());
+}
+
+bool WidgetsStyleSheetsDesignTarget::isTokenized(const QString& styleSheet) const
+{
+    return styleSheet.contains(COLOR_TOKEN_MARKER) || styleSheet.contains(REPLACE_THEME_TOKEN_MARKER);
+}
+
+void WidgetsStyleSheetsDesignTarget::writeStyleSheetsToFile(const QJsonObject& jsonThemes) const
+{
+    const QString directoryStylePath = QDir::currentPath() % PathProvider::RELATIVE_STYLE_DIR_PATH;
+
+    if (Utilities::createDirectory(directoryStylePath))
+    {
+        const QString styleSheetsFilePath =
+            directoryStylePath % "/" % PathProvider::THEMED_STYLE_SHEETS_FILE_NAME;
+
+        if (Utilities::writeJSONToFile(QJsonDocument(jsonThemes), styleSheetsFilePath))
+        {
+            Utilities::logInfoMessage(
+                QString::fromUtf8(
+                    "The target widgetsStyleSheets has successfully generated the file : %0")
+                    .arg(styleSheetsFilePath));
+        }
+    }
+}
@@ -0,0 +1,49 @@
+#ifndef WIDGETS_STYLE_SHEETS_DESIGN_TARGET_H
+#define WIDGETS_STYLE_SHEETS_DESIGN_TARGET_H
+
+#include "DesignTarget.h"
+#include "Types.h"
+
+#include <QJsonArray>
+#include <QJsonObject>
+
+namespace DTI
+{
+//!
+//! \brief Resolves the color and theme tokens of the widgets stylesheets for every theme.
+//!
+//! The stylesheet of the top level widget of every .ui file and the standard components stylesheet
+//! are resolved at import time, so the desktop app only has to look them up when a dialog is
+//! opened or the theme changes.
+//!
+class WidgetsStyleSheetsDesignTarget: public IDesignTarget
+{
+public:
+    void deploy(const DesignAssets& designAssets) const override;
+
+private:
+    static bool registered;
+
+    struct UiStyleSheet
+    {
+        QString widgetName;
+        QString styleSheet;
+    };
+
+    QList<UiStyleSheet> readUiStyleSheets() const;
+    QString readStandardComponentsStyleSheet() const;
+    QJsonObject createThemeJson(const QString& theme,
+                                const ColorData& themeData,
+                                const QList<UiStyleSheet>& uiStyleSheets,
+                                const QString& standardComponentsStyleSheet) const;
+    QString resolveStyleSheet(const QString& styleSheet,
+                              const QString& theme,
+                              const ColorData& themeData) const;
+    QJsonArray getIconTokens(const QString& styleSheet, const ColorData& themeData) const;
+    QString getSourceHash(const QString& styleSheet) const;
+    bool isTokenized(const QString& styleSheet) const;
+    void writeStyleSheetsToFile(const QJsonObject& jsonThemes) const;
+};
+}
+
+#endif
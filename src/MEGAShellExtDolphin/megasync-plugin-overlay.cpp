@@ -13,7 +13,11 @@
 
 #include <QtNetwork/QLocalSocket>
 #include <QDir>
+#include <QHash>
 #include <QMetaEnum>
+#include <QQueue>
+#include <QSet>
+#include <QTimer>
 #include <QtNetwork/QAbstractSocket>
 #if QT_VERSION >= 0x050000
 #include <QStandardPaths>
@@ -40,13 +44,23 @@ const char OP_STRING      = 'T'; //Get Translated String
 const char OP_VIEW        = 'V'; //View on MEGA
 const char OP_PREVIOUS    = 'R'; //View previous versions
 
+// Paths whose state is kept, the oldest ones are forgotten first
+const int MAX_CACHED_STATES = 10000;
+
 class MegasyncDolphinOverlayPlugin : public KOverlayIconPlugin
 {
     Q_PLUGIN_METADATA(IID "com.megasync.ovarlayiconplugin" FILE "megasync-plugin-overlay.json")
     Q_OBJECT
 
-    typedef QHash<QByteArray, QByteArray> StatusMap;
-    StatusMap m_status;
+    // States received from the Ext Server, kept up to date with the Notify Server messages.
+    // getOverlays only reads this cache: the missing states are requested in one batch once the
+    // control is back in the event loop, and overlaysChanged is emitted when they arrive.
+    QHash<QString, int> m_states;
+    QQueue<QString> m_statesOrder;
+    QSet<QString> m_pendingPaths;
+    QStringList m_pendingRequests;
+    QQueue<QString> m_inFlightRequests;
+    QTimer m_requestTimer;
     QLocalSocket sockNotifyServer;
     QString sockPathNofityServer;
 
@@ -63,6 +77,9 @@ private slots:
     void sockNotifyServer_disconnected()
     {
         qDebug("MEGASYNCOVERLAYPLUGIN: disconnected from Notify Server");
+
+        // Without notifications the cached states can not be trusted
+        clearStates();
     }
 
     void sockNotifyServer_error(QLocalSocket::LocalSocketError err)
@@ -74,17 +91,98 @@ private slots:
     void sockExtServer_connected()
     {
         qDebug("MEGASYNCOVERLAYPLUGIN: connected to Ext Server");
+
+        sendPendingRequests();
     }
 
     void sockExtServer_disconnected()
     {
         qDebug("MEGASYNCOVERLAYPLUGIN: disconnected from Ext Server");
+
+        // The requests without answer are sent again the next time their overlays are needed
+        while (!m_inFlightRequests.isEmpty())
+        {
+            m_pendingPaths.remove(m_inFlightRequests.dequeue());
+        }
+    }
+
+    void sockExtServer_readyRead()
+    {
+        while (sockExtServer.canReadLine())
+        {
+            QByteArray reply = sockExtServer.readLine().trimmed();
+            if (m_inFlightRequests.isEmpty())
+            {
+                qCritical("MEGASYNCOVERLAYPLUGIN: unexpected read from extServer: %s", reply.constData());
+                continue;
+            }
+
+            QString path = m_inFlightRequests.dequeue();
+            m_pendingPaths.remove(path);
+
+            bool ok = false;
+            int state = reply.toInt(&ok);
+            setState(path, ok ? state : RESPONSE_ERROR);
+
+            QUrl url = QUrl::fromLocalFile(path);
+            emit overlaysChanged(url, getOverlays(url));
+        }
+    }
+
+    void sendPendingRequests()
+    {
+        if (m_pendingRequests.isEmpty())
+        {
+            return;
+        }
+
+        if (sockExtServer.state() == QLocalSocket::UnconnectedState)
+        {
+            sockExtServer.connectToServer(sockPathExtServer);
+        }
+
+        if (sockExtServer.state() == QLocalSocket::UnconnectedState)
+        {
+            // MEGAsync is not running: the requests are dropped instead of piling up, their
+            // paths are requested again the next time their overlays are needed
+            qDebug("MEGASYNCOVERLAYPLUGIN: failed to connect, %d states not requested",
+                   m_pendingRequests.size());
+            dropPendingRequests();
+            return;
+        }
+
+        if (sockExtServer.state() != QLocalSocket::ConnectedState)
+        {
+            return;
+        }
+
+        QByteArray requests;
+        for (const QString& path : m_pendingRequests)
+        {
+            requests.append(OP_PATH_STATE);
+            requests.append(':');
+            requests.append(path.toUtf8());
+            // The separator ends the path, so the server does not take the line feed as part of it
+            requests.append((char)0x1C);
+            requests.append('0');
+            requests.append('\n');
+            m_inFlightRequests.enqueue(path);
+        }
+        m_pendingRequests.clear();
+
+        sockExtServer.write(requests);
+        sockExtServer.flush();
     }
 
     void sockExtServer_error(QLocalSocket::LocalSocketError err)
     {
         QMetaEnum metaEnum = QMetaEnum::fromType<QAbstractSocket::SocketError>();
         qCritical("MEGASYNCOVERLAYPLUGIN: error in connection to ext server: %s", metaEnum.valueToKey(err));
+
+        if (sockExtServer.state() != QLocalSocket::ConnectedState)
+        {
+            dropPendingRequests();
+        }
     }
 
     void notifiedfromServer()
@@ -119,7 +217,17 @@ private slots:
 
             qDebug("MEGASYNCOVERLAYPLUGIN: Server notified <%s>: %s",action.toUtf8().constData(), url.toUtf8().constData());
 
-            emit overlaysChanged(QUrl::fromLocalFile(url), getOverlays(QUrl::fromLocalFile(url)));
+            if (*type == 'P')
+            {
+                // The new state is requested and notified when it arrives
+                invalidateState(url);
+                requestState(url);
+            }
+            else if (*type == 'A' || *type == 'D')
+            {
+                invalidateStates(url);
+                emit overlaysChanged(QUrl::fromLocalFile(url), getOverlays(QUrl::fromLocalFile(url)));
+            }
         }
     }
 
@@ -138,6 +246,7 @@ public:
 
         connect(&sockExtServer, SIGNAL(connected()), this, SLOT(sockExtServer_connected()));
         connect(&sockExtServer, SIGNAL(disconnected()), this, SLOT(sockExtServer_disconnected()));
+        connect(&sockExtServer, SIGNAL(readyRead()), this, SLOT(sockExtServer_readyRead()));
         connect(&sockExtServer, SIGNAL(error(QLocalSocket::LocalSocketError)),
                 this, SLOT(sockExtServer_error(QLocalSocket::LocalSocketError)));
 
@@ -158,6 +267,11 @@ public:
         sockPathExtServer.append(QDir::separator()).append("data/Mega Limited/MEGAsync/mega.socket");
 #endif
         sockExtServer.connectToServer(sockPathExtServer);
+
+        // The states missed while a folder is listed are requested together
+        m_requestTimer.setSingleShot(true);
+        m_requestTimer.setInterval(0);
+        connect(&m_requestTimer, SIGNAL(timeout()), this, SLOT(sendPendingRequests()));
     }
 
     ~MegasyncDolphinOverlayPlugin()
@@ -174,7 +288,7 @@ public:
 
         QStringList r;
 
-        int state = getState(url.toLocalFile());
+        int state = getCachedState(url.toLocalFile());
 
         switch (state)
         {
@@ -202,42 +316,113 @@ public:
 
 private:
 
-    int getState(QString path)
+    // Returns the cached state of the path. If it is not cached yet, it is requested and
+    // RESPONSE_DEFAULT is returned until it arrives
+    int getCachedState(const QString& localPath)
     {
-        QString res;
-        res = sendRequest(OP_PATH_STATE, QFileInfo(path).canonicalFilePath());
+        QString path = QFileInfo(localPath).canonicalFilePath();
+        if (path.isEmpty())
+        {
+            return RESPONSE_ERROR;
+        }
+
+        QHash<QString, int>::const_iterator it = m_states.constFind(path);
+        if (it != m_states.constEnd())
+        {
+            return it.value();
+        }
 
-        return res.isEmpty() ? RESPONSE_ERROR : res.toInt();
+        requestState(path);
+        return RESPONSE_DEFAULT;
     }
 
-    // send request and receive response from Extension server
-    // Return newly-allocated response string
-    QString sendRequest(char type, QString command)
+    void requestState(const QString& path)
     {
-        int waitTime = -1; // This (instead of a timeout) makes dolphin hang until the location for an upload is selected (will be corrected in megasync>3.0.1).
-                           // Otherwise megaync segafaults accesing client socket
-        QString req;
+        if (path.isEmpty() || m_pendingPaths.contains(path))
+        {
+            return;
+        }
 
-        if(!sockExtServer.isOpen()) {
-            sockExtServer.connectToServer(sockPathExtServer);
-            if(!sockExtServer.waitForConnected(waitTime))
-                return QString();
+        m_pendingPaths.insert(path);
+        m_pendingRequests.append(path);
+
+        if (!m_requestTimer.isActive())
+        {
+            m_requestTimer.start();
+        }
+    }
+
+    void setState(const QString& path, int state)
+    {
+        if (!m_states.contains(path))
+        {
+            m_statesOrder.enqueue(path);
+            while (m_statesOrder.size() > MAX_CACHED_STATES)
+            {
+                m_states.remove(m_statesOrder.dequeue());
+            }
         }
 
-        req.sprintf("%c:%s", type, command.toUtf8().constData());
+        m_states.insert(path, state);
+    }
 
-        sockExtServer.write(req.toUtf8());
-        sockExtServer.flush();
+    void invalidateState(const QString& path)
+    {
+        if (m_states.remove(path))
+        {
+            m_statesOrder.removeOne(path);
+        }
+    }
+
+    // Invalidates the path and everything below it, when a sync is added or removed
+    void invalidateStates(const QString& path)
+    {
+        QString childrenPrefix = path;
+        if (!childrenPrefix.endsWith(QDir::separator()))
+        {
+            childrenPrefix.append(QDir::separator());
+        }
+
+        QHash<QString, int>::iterator it = m_states.begin();
+        while (it != m_states.end())
+        {
+            if (it.key() == path || it.key().startsWith(childrenPrefix))
+            {
+                it = m_states.erase(it);
+            }
+            else
+            {
+                ++it;
+            }
+        }
 
-        if(!sockExtServer.waitForReadyRead(waitTime)) {
-            sockExtServer.close();
-            return QString();
+        QQueue<QString>::iterator orderIt = m_statesOrder.begin();
+        while (orderIt != m_statesOrder.end())
+        {
+            if (*orderIt == path || orderIt->startsWith(childrenPrefix))
+            {
+                orderIt = m_statesOrder.erase(orderIt);
+            }
+            else
+            {
+                ++orderIt;
+            }
         }
+    }
 
-        QString reply;
-        reply.append(sockExtServer.readAll());
+    void dropPendingRequests()
+    {
+        for (const QString& path : m_pendingRequests)
+        {
+            m_pendingPaths.remove(path);
+        }
+        m_pendingRequests.clear();
+    }
 
-        return reply;
+    void clearStates()
+    {
+        m_states.clear();
+        m_statesOrder.clear();
     }
 };
 
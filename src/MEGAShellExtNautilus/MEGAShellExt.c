@@ -15,6 +15,7 @@
 #include "MEGAShellExt.h"
 #include "mega_ext_client.h"
 #include "mega_notify_client.h"
+#include "mega_state_client.h"
 #include <string.h>
 
 static GObjectClass *parent_class;
@@ -36,6 +37,7 @@ static void mega_ext_instance_init(MEGAExt *mega_ext, G_GNUC_UNUSED gpointer g_c
     mega_ext->string_viewprevious = NULL;
     mega_ext->string_upload = NULL;
     mega_ext->syncs_received = FALSE;
+    mega_state_client_init(mega_ext);
 
     // ignore SIGPIPE as we most likely will write to a closed socket in mega_notify_client_read()
     signal(SIGPIPE, SIG_IGN);
@@ -67,6 +69,14 @@ static const gchar *file_state_to_str(FileState state)
 
 // received path from notify server with the path to item which state was changed
 void mega_ext_on_item_changed(MEGAExt *mega_ext, const gchar *path)
+{
+    g_debug("Item changed: %s", path);
+    // the cached state is used until the new one arrives
+    mega_state_client_request(mega_ext, path);
+}
+
+// received a state different from the cached one, update the emblems of the item
+void mega_ext_on_state_changed(MEGAExt *mega_ext, const gchar *path)
 {
     GFile *f;
     f = g_file_new_for_path(path);
@@ -76,12 +86,14 @@ void mega_ext_on_item_changed(MEGAExt *mega_ext, const gchar *path)
     }
 
     NautilusFileInfo *file = nautilus_file_info_lookup(f);
+    g_object_unref(f);
     if (!file) {
         g_debug("No NautilusFileInfo found for %s!", path);
         return;
     }
-    g_debug("Item changed: %s", path);
+    g_debug("State changed: %s", path);
     nautilus_info_provider_update_file_info((NautilusInfoProvider*)mega_ext, file, (void*)1, (void*)1);
+    g_object_unref(file);
 }
 
 // user clicked on "Upload to MEGA" menu item
@@ -128,12 +140,14 @@ void mega_ext_on_sync_add(MEGAExt *mega_ext, const gchar *path)
         return;
     g_debug("New sync path: %s", path);
     g_hash_table_insert(mega_ext->h_syncs, g_strdup(path), GINT_TO_POINTER(1));
+    mega_state_client_refresh(mega_ext, path);
 }
 
 void mega_ext_on_sync_del(MEGAExt *mega_ext, const gchar *path)
 {
     g_debug("Deleted sync path: %s", path);
     g_hash_table_remove(mega_ext->h_syncs, path);
+    mega_state_client_refresh(mega_ext, path);
 }
 
 void expanselocalpath(const char *path, char *absolutepath)
@@ -510,30 +524,19 @@ static NautilusOperationResult mega_ext_update_file_info(NautilusInfoProvider *p
         return NAUTILUS_OPERATION_COMPLETE;
     }
 
-    gboolean has_mega_icon = FALSE;
-    GFileInfo* file_info = g_file_query_info(fp, "metadata::custom-icon", G_FILE_QUERY_INFO_NONE, NULL, NULL);
-    if (file_info != NULL)
+    // avoid requesting states of files which are not in synced folders
+    // but make sure we received the list of synced folders first
+    if (mega_ext->syncs_received && !mega_ext_path_in_sync(mega_ext, path))
     {
-        char* icon_path = g_file_info_get_attribute_as_string (file_info, "metadata::custom-icon");
-        if (icon_path != NULL)
-        {
-            if (strstr(icon_path, "/usr/share/icons") && strstr(icon_path, "apps/mega.png"))
-            {
-                has_mega_icon = TRUE;
-            }
-
-            g_free(icon_path);
-        }
-
-        g_object_unref(file_info);
+        state = RESPONSE_DEFAULT;
     }
-
-    state = mega_ext_client_get_path_state(mega_ext, path, 0);
-    if (state == RESPONSE_DEFAULT)
+    else if (!mega_state_client_get_cached(mega_ext, path, &state))
     {
-        char canonical[PATH_MAX];
-        expanselocalpath(path,canonical);
-        state = mega_ext_client_get_path_state(mega_ext, canonical, 0);
+        // don't wait for MEGAsync, the emblems are updated when the state arrives
+        g_debug("mega_ext_update_file_info. File: %s  State: requested", path);
+        mega_state_client_request(mega_ext, path);
+        g_free(path);
+        return NAUTILUS_OPERATION_COMPLETE;
     }
 
     g_debug("mega_ext_update_file_info. File: %s  State: %s", path, file_state_to_str(state));
@@ -541,6 +544,24 @@ static NautilusOperationResult mega_ext_update_file_info(NautilusInfoProvider *p
     // process items located in sync folders
     if (state == RESPONSE_DEFAULT || state == RESPONSE_IGNORED)
     {
+        gboolean has_mega_icon = FALSE;
+        GFileInfo* file_info = g_file_query_info(fp, "metadata::custom-icon", G_FILE_QUERY_INFO_NONE, NULL, NULL);
+        if (file_info != NULL)
+        {
+            char* icon_path = g_file_info_get_attribute_as_string (file_info, "metadata::custom-icon");
+            if (icon_path != NULL)
+            {
+                if (strstr(icon_path, "/usr/share/icons") && strstr(icon_path, "apps/mega.png"))
+                {
+                    has_mega_icon = TRUE;
+                }
+
+                g_free(icon_path);
+            }
+
+            g_object_unref(file_info);
+        }
+
         if (has_mega_icon)
         {
             g_file_set_attribute(fp, "metadata::custom-icon", G_FILE_ATTRIBUTE_TYPE_INVALID, NULL, G_FILE_QUERY_INFO_NONE, NULL, NULL);
@@ -27,6 +27,16 @@ struct _MEGAExt {
     gchar *string_viewonmega; // cached string
     gchar *string_viewprevious; // cached string
 
+    // overlay states, requested asynchronously through their own connection to the Ext Server
+    GIOChannel *state_chan;
+    int state_sock;
+    guint state_watch_id; // source that reads the responses
+    guint state_send_id; // idle source that sends the pending requests
+    GHashTable *h_states; // path -> FileState + 1 of the cached states
+    GQueue *q_states; // paths in h_states, oldest first
+    GHashTable *h_pending; // paths requested and not answered yet
+    GQueue *q_pending; // paths waiting to be sent
+    GQueue *q_in_flight; // paths sent, in the order of their responses
 };
 
 struct _MEGAExtClass {
@@ -59,6 +69,7 @@ void  mega_ext_register_type(GTypeModule *module);
 G_END_DECLS
 
 void mega_ext_on_item_changed(MEGAExt *mega_ext, const gchar *path);
+void mega_ext_on_state_changed(MEGAExt *mega_ext, const gchar *path);
 void mega_ext_on_sync_add(MEGAExt *mega_ext, const gchar *path);
 void mega_ext_on_sync_del(MEGAExt *mega_ext, const gchar *path);
 void expanselocalpath(const char *path, char *absolutepath);
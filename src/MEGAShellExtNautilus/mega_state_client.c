@@ -0,0 +1,295 @@
+#include "mega_state_client.h"
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+
+// The overlay states are requested through their own connection to the Ext Server, so
+// update_file_info never waits for MEGAsync: the states missing from the cache are sent in
+// one batch from an idle source, and the server answers them in the same order.
+
+static const gchar OP_PATH_STATE = 'P'; //Path state
+static const gchar FILE_SEP = 0x1C;
+
+// paths whose state is kept, the oldest ones are forgotten first
+static const guint MAX_CACHED_STATES = 10000;
+
+static gboolean mega_state_client_read(GIOChannel *state_chan, GIOCondition condition, gpointer data);
+
+void mega_state_client_init(MEGAExt *mega_ext)
+{
+    mega_ext->state_chan = NULL;
+    mega_ext->state_sock = -1;
+    mega_ext->state_watch_id = 0;
+    mega_ext->state_send_id = 0;
+    mega_ext->h_states = g_hash_table_new_full(g_str_hash, g_str_equal, g_free, NULL);
+    mega_ext->q_states = g_queue_new();
+    mega_ext->h_pending = g_hash_table_new_full(g_str_hash, g_str_equal, g_free, NULL);
+    mega_ext->q_pending = g_queue_new();
+    mega_ext->q_in_flight = g_queue_new();
+}
+
+// forget the given requests, they are sent again the next time their states are needed
+static void mega_state_client_drop_requests(MEGAExt *mega_ext, GQueue *requests)
+{
+    gchar *path;
+
+    while ((path = g_queue_pop_head(requests))) {
+        g_hash_table_remove(mega_ext->h_pending, path);
+        g_free(path);
+    }
+}
+
+static void mega_state_client_disconnect(MEGAExt *mega_ext)
+{
+    g_debug("State client disconnected");
+
+    if (mega_ext->state_watch_id) {
+        g_source_remove(mega_ext->state_watch_id);
+        mega_ext->state_watch_id = 0;
+    }
+
+    if (mega_ext->state_chan) {
+        g_io_channel_shutdown(mega_ext->state_chan, FALSE, NULL);
+        g_io_channel_unref(mega_ext->state_chan);
+        mega_ext->state_chan = NULL;
+    }
+
+    if (mega_ext->state_sock > 0)
+        close(mega_ext->state_sock);
+    mega_ext->state_sock = -1;
+
+    mega_state_client_drop_requests(mega_ext, mega_ext->q_in_flight);
+}
+
+// try to connect to the Ext Server
+// return TRUE if connection established
+static gboolean mega_state_client_connect(MEGAExt *mega_ext)
+{
+    int len;
+    struct sockaddr_un remote;
+    gchar *sock_path;
+    const gchar sock_file[] = "mega.socket";
+    // XXX: current path MEGASync uses to store private data
+    const gchar sock_path_hardcode[] = "data/Mega Limited/MEGAsync";
+
+    if ((mega_ext->state_sock = socket(AF_UNIX, SOCK_STREAM, 0)) == -1) {
+        g_warning("socket() failed: %s", strerror(errno));
+        goto failed;
+    }
+
+    sock_path = g_build_filename(g_get_user_data_dir(), sock_path_hardcode, sock_file, NULL);
+
+    remote.sun_family = AF_UNIX;
+    strncpy(remote.sun_path, sock_path, sizeof(remote.sun_path));
+    g_free(sock_path);
+
+    len = strlen(remote.sun_path) + sizeof(remote.sun_family);
+    if (connect(mega_ext->state_sock, (struct sockaddr *)&remote, len) == -1) {
+        g_warning("connect() failed");
+        goto failed;
+    }
+    g_debug("State client connected to the server!");
+
+    mega_ext->state_chan = g_io_channel_unix_new(mega_ext->state_sock);
+    if (!mega_ext->state_chan) {
+        g_warning("g_io_channel_unix_new() failed");
+        goto failed;
+    }
+    g_io_channel_set_close_on_unref(mega_ext->state_chan, TRUE);
+    g_io_channel_set_line_term(mega_ext->state_chan, "\n", -1);
+
+    mega_ext->state_watch_id = g_io_add_watch(mega_ext->state_chan, G_IO_IN | G_IO_HUP | G_IO_ERR,
+                                              mega_state_client_read, mega_ext);
+    if (!mega_ext->state_watch_id) {
+        g_warning("g_io_add_watch() failed!");
+        goto failed;
+    }
+
+    return TRUE;
+
+failed:
+    mega_state_client_disconnect(mega_ext);
+    return FALSE;
+}
+
+// store the state of path
+// return TRUE if it was not cached or it was cached with a different value
+static gboolean mega_state_client_set_state(MEGAExt *mega_ext, const gchar *path, FileState state)
+{
+    gpointer value;
+    gpointer new_value = GINT_TO_POINTER(state + 1);
+
+    if (g_hash_table_lookup_extended(mega_ext->h_states, path, NULL, &value)) {
+        g_hash_table_replace(mega_ext->h_states, g_strdup(path), new_value);
+        return value != new_value;
+    }
+
+    g_hash_table_insert(mega_ext->h_states, g_strdup(path), new_value);
+    g_queue_push_tail(mega_ext->q_states, g_strdup(path));
+
+    while (g_queue_get_length(mega_ext->q_states) > MAX_CACHED_STATES) {
+        gchar *oldest = g_queue_pop_head(mega_ext->q_states);
+        g_hash_table_remove(mega_ext->h_states, oldest);
+        g_free(oldest);
+    }
+
+    return TRUE;
+}
+
+static gboolean mega_state_client_read(GIOChannel *state_chan, GIOCondition condition, gpointer data)
+{
+    gchar *in_line;
+    gchar *path;
+    gsize term_pos;
+    GError *error = NULL;
+    GIOStatus status;
+    MEGAExt *mega_ext = (MEGAExt *)data;
+
+    if (condition & (G_IO_HUP | G_IO_ERR)) {
+        g_warning("Failed to read data!");
+        mega_state_client_disconnect(mega_ext);
+        return FALSE;
+    }
+
+    // the watch is not triggered again for the responses already buffered by the channel
+    do {
+        in_line = NULL;
+        status = g_io_channel_read_line(state_chan, &in_line, NULL, &term_pos, &error);
+        if (status != G_IO_STATUS_NORMAL || error) {
+            g_warning("Failed to read data!");
+            if (error)
+                g_error_free(error);
+            g_free(in_line);
+            mega_state_client_disconnect(mega_ext);
+            return FALSE;
+        }
+        in_line[term_pos] = '\0';
+
+        path = g_queue_pop_head(mega_ext->q_in_flight);
+        if (!path) {
+            g_warning("Unexpected response: %s", in_line);
+            g_free(in_line);
+            continue;
+        }
+        g_hash_table_remove(mega_ext->h_pending, path);
+
+        if (mega_state_client_set_state(mega_ext, path, atoi(in_line)))
+            mega_ext_on_state_changed(mega_ext, path);
+
+        g_free(path);
+        g_free(in_line);
+    } while (g_io_channel_get_buffer_condition(state_chan) & G_IO_IN);
+
+    return TRUE;
+}
+
+// return FALSE to remove the idle source
+static gboolean mega_state_client_send_pending(gpointer user_data)
+{
+    MEGAExt *mega_ext = (MEGAExt *)user_data;
+    GString *requests;
+    gchar *path;
+    GError *error = NULL;
+    GIOStatus status;
+
+    mega_ext->state_send_id = 0;
+
+    if (g_queue_is_empty(mega_ext->q_pending))
+        return FALSE;
+
+    if (mega_ext->state_sock < 0 && !mega_state_client_connect(mega_ext)) {
+        g_debug("Failed to connect, %u states not requested", g_queue_get_length(mega_ext->q_pending));
+        mega_state_client_drop_requests(mega_ext, mega_ext->q_pending);
+        return FALSE;
+    }
+
+    requests = g_string_new(NULL);
+    while ((path = g_queue_pop_head(mega_ext->q_pending))) {
+        char canonical[PATH_MAX];
+        g_strlcpy(canonical, path, sizeof(canonical));
+        expanselocalpath(path, canonical);
+
+        // the separator ends the path, so the server does not take the line feed as part of it
+        g_string_append_printf(requests, "%c:%s%c0\n", OP_PATH_STATE, canonical, FILE_SEP);
+        g_queue_push_tail(mega_ext->q_in_flight, path);
+    }
+
+    g_debug("Requesting %u states", g_queue_get_length(mega_ext->q_in_flight));
+
+    status = g_io_channel_write_chars(mega_ext->state_chan, requests->str, requests->len, NULL, &error);
+    if (status == G_IO_STATUS_NORMAL && !error)
+        status = g_io_channel_flush(mega_ext->state_chan, &error);
+    g_string_free(requests, TRUE);
+
+    if (status != G_IO_STATUS_NORMAL || error) {
+        g_warning("Failed to write data!");
+        if (error)
+            g_error_free(error);
+        mega_state_client_disconnect(mega_ext);
+    }
+
+    return FALSE;
+}
+
+// return TRUE and set state if the state of path is cached
+gboolean mega_state_client_get_cached(MEGAExt *mega_ext, const gchar *path, FileState *state)
+{
+    gpointer value = g_hash_table_lookup(mega_ext->h_states, path);
+
+    if (!value)
+        return FALSE;
+
+    *state = GPOINTER_TO_INT(value) - 1;
+    return TRUE;
+}
+
+// request the state of path, mega_ext_on_state_changed() is called if it is not the cached one
+void mega_state_client_request(MEGAExt *mega_ext, const gchar *path)
+{
+    if (g_hash_table_contains(mega_ext->h_pending, path))
+        return;
+
+    g_hash_table_add(mega_ext->h_pending, g_strdup(path));
+    g_queue_push_tail(mega_ext->q_pending, g_strdup(path));
+
+    if (!mega_ext->state_send_id)
+        mega_ext->state_send_id = g_idle_add(mega_state_client_send_pending, mega_ext);
+}
+
+// request again the cached states of path and the items below it
+void mega_state_client_refresh(MEGAExt *mega_ext, const gchar *path)
+{
+    GHashTableIter iter;
+    gpointer key;
+    GList *l = NULL, *p;
+    gchar *children_prefix;
+
+    if (g_str_has_suffix(path, "/"))
+        children_prefix = g_strdup(path);
+    else
+        children_prefix = g_strconcat(path, "/", NULL);
+
+    g_hash_table_iter_init(&iter, mega_ext->h_states);
+    while (g_hash_table_iter_next(&iter, &key, NULL)) {
+        if (g_str_equal(key, path) || g_str_has_prefix(key, children_prefix))
+            l = g_list_prepend(l, key);
+    }
+
+    for (p = l; p; p = g_list_next(p))
+        mega_state_client_request(mega_ext, p->data);
+
+    g_list_free(l);
+    g_free(children_prefix);
+}
+
+// forget the cached states, used when MEGAsync can not notify their changes
+void mega_state_client_clear(MEGAExt *mega_ext)
+{
+    g_hash_table_remove_all(mega_ext->h_states);
+    g_queue_foreach(mega_ext->q_states, (GFunc)g_free, NULL);
+    g_queue_clear(mega_ext->q_states);
+}
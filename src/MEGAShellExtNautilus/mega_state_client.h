@@ -0,0 +1,12 @@
+#ifndef MEGA_STATE_CLIENT_H
+#define MEGA_STATE_CLIENT_H
+
+#include "MEGAShellExt.h"
+
+void mega_state_client_init(MEGAExt *mega_ext);
+gboolean mega_state_client_get_cached(MEGAExt *mega_ext, const gchar *path, FileState *state);
+void mega_state_client_request(MEGAExt *mega_ext, const gchar *path);
+void mega_state_client_refresh(MEGAExt *mega_ext, const gchar *path);
+void mega_state_client_clear(MEGAExt *mega_ext);
+
+#endif
@@ -18,6 +18,7 @@
 #include "EventUpdater.h"
 #include "ExportProcessor.h"
 #include "FatalEventHandler.h"
+#include "FolderNameIndex.h"
 #include "FullName.h"
 #include "GuiUtilities.h"
 #include "ImportMegaLinksDialog.h"
@@ -37,12 +38,14 @@
 #include "QmlDialogWrapper.h"
 #include "QTMegaApiManager.h"
 #include "ReloadingEventHandler.h"
+#include "RemoteFolderStatsIndex.h"
 #include "RequestListenerManager.h"
 #include "StalledIssuesDialog.h"
 #include "StalledIssuesModel.h"
 #include "StatsEventHandler.h"
 #include "StreamingFromMegaDialog.h"
 #include "SyncsMenu.h"
+#include "SyncStatsRecorder.h"
 #include "TransferMetaData.h"
 #include "UploadToMegaDialog.h"
 #include "UserAttributesManager.h"
@@ -57,7 +60,6 @@
 #include <QNetworkProxy>
 #include <QScreen>
 #include <QSettings>
-#include <QtConcurrent/QtConcurrent>
 #include <QToolTip>
 #include <QTranslator>
 
@@ -73,6 +75,10 @@
 #include "platform/macx/PlatformImplementation.h"
 #endif
 
+#ifdef Q_OS_LINUX
+#include "platform/linux/HeadlessControlServer.h"
+#endif
+
 #ifndef WIN32
 //sleep
 #include <unistd.h>
@@ -92,6 +98,8 @@ QString MegaApplication::dataPath = QString();
 QString MegaApplication::lastNotificationError = QString();
 
 constexpr auto openUrlClusterMaxElapsedTime = std::chrono::seconds(5);
+// Same as SDK default
+constexpr long long maxPayloadLogSize = 10240;
 
 static const QString SCHEME_MEGA_URL = QString::fromUtf8("mega");
 static const QString SCHEME_LOCAL_URL = QString::fromUtf8("local");
@@ -134,7 +142,9 @@ MegaApplication::MegaApplication(int& argc, char** argv):
     scanStageController(this),
     mDisableGfx(false),
     mUserMessageController(nullptr),
-    mGfxProvider(nullptr)
+    mGfxProvider(nullptr),
+    mHeadless(false),
+    mHeadlessControlServer(nullptr)
 {
 #if defined Q_OS_MACX && !defined QT_DEBUG
     if (!qEnvironmentVariableIsSet("MEGA_DISABLE_RUN_MAC_RESTRICTION"))
@@ -181,6 +191,10 @@ MegaApplication::MegaApplication(int& argc, char** argv):
 
     logToStdout |= args.contains(QLatin1String("--debug"));
 
+    // Only the syncs, the transfers and the file manager extensions, for machines without a
+    // desktop session. The status can be queried through the HeadlessControlServer socket
+    mHeadless = args.contains(QLatin1String("--headless"));
+
 #endif
 
     connect(this, SIGNAL(blocked()), this, SLOT(onBlocked()));
@@ -251,6 +265,12 @@ MegaApplication::MegaApplication(int& argc, char** argv):
     mStalledIssuesModel = nullptr;
     mStatusController = nullptr;
     mStatsEventHandler = nullptr;
+    mTaskScheduler = nullptr;
+    mGlobalStateTask = TaskScheduler::INVALID_TASK;
+    mMaintenanceTask = TaskScheduler::INVALID_TASK;
+    mLocalCachesTask = TaskScheduler::INVALID_TASK;
+    mPeriodicStatsTask = TaskScheduler::INVALID_TASK;
+    mSyncStatsTask = TaskScheduler::INVALID_TASK;
 
     context = new QObject(this);
 
@@ -315,7 +335,6 @@ MegaApplication::MegaApplication(int& argc, char** argv):
     mCurrency.reset();
     mStorageOverquotaDialog = nullptr;
     mTransferManager = nullptr;
-    cleaningSchedulerExecution = 0;
     lastUserActivityExecution = 0;
     lastTsBusinessWarning = 0;
     lastTsErrorMessageShown = 0;
@@ -503,6 +522,7 @@ void MegaApplication::initialize()
     connect(model, &SyncInfo::syncStateChanged, this, &MegaApplication::onSyncModelUpdated);
     connect(model, &SyncInfo::syncRemoved, this, &MegaApplication::onSyncModelUpdated);
     connect(model, &SyncInfo::syncDisabledListUpdated, this, &MegaApplication::updateTrayIcon);
+    SyncStatsRecorder::instance().start();
 
     MegaApi::log(MegaApi::LOG_LEVEL_INFO, QString::fromLatin1("Graphics processing %1")
                  .arg(mDisableGfx ? QLatin1String("disabled")
@@ -512,13 +532,16 @@ void MegaApplication::initialize()
     // Set maximum log line size to 10k (same as SDK default)
     // Otherwise network logging can cause large glitches when logging hundreds of MB
     // On Mac it is particularly apparent, causing the beachball to appear often
-    long long newPayLoadLogSize = 10240;
+    long long newPayLoadLogSize = maxPayloadLogSize;
     megaApi->log(MegaApi::LOG_LEVEL_INFO, QString::fromUtf8("Establishing max payload log size: %1").arg(newPayLoadLogSize).toUtf8().constData());
     megaApi->setMaxPayloadLogSize(newPayLoadLogSize);
     megaApiFolders->setMaxPayloadLogSize(newPayLoadLogSize);
 
     mStatsEventHandler = std::make_unique<ProxyStatsEventHandler>(megaApi);
-    QmlManager::instance()->setRootContextProperty(mStatsEventHandler.get());
+    if (!mHeadless)
+    {
+        QmlManager::instance()->setRootContextProperty(mStatsEventHandler.get());
+    }
 
     QString stagingPath = QDir(dataPath).filePath(QString::fromUtf8("megasync.staging"));
     QFile fstagingPath(stagingPath);
@@ -529,6 +552,7 @@ void MegaApplication::initialize()
         QString disablepkp = settings.value(QString::fromUtf8("disablepkp"), QString::fromUtf8("0")).toString();
         megaApi->changeApiUrl(apiURL.toUtf8(), disablepkp == QString::fromUtf8("1"));
         megaApiFolders->changeApiUrl(apiURL.toUtf8());
+        mStagingApiUrl = apiURL;
 
         QMegaMessageBox::MessageBoxInfo msgInfo;
         msgInfo.title = MegaSyncApp->getMEGAString();
@@ -549,7 +573,11 @@ void MegaApplication::initialize()
         Preferences::overridePreferences(settings);
         Preferences::SDK_ID.append(QString::fromUtf8(" - STAGING"));
     }
-    trayIcon->show();
+
+    if (trayIcon)
+    {
+        trayIcon->show();
+    }
 
     megaApi->log(MegaApi::LOG_LEVEL_INFO, QString::fromUtf8("MEGA Desktop App is starting. Version string: %1   Version code: %2.%3   User-Agent: %4").arg(Preferences::VERSION_STRING)
              .arg(Preferences::VERSION_CODE).arg(Preferences::BUILD_ID).arg(QString::fromUtf8(megaApi->getUserAgent())).toUtf8().constData());
@@ -566,7 +594,10 @@ void MegaApplication::initialize()
     megaApi->setPublicKeyPinning(!preferences->SSLcertificateException());
 
     mStatusController = new AccountStatusController(this);
-    QmlManager::instance()->setRootContextProperty(mStatusController);
+    if (!mHeadless)
+    {
+        QmlManager::instance()->setRootContextProperty(mStatusController);
+    }
     AccountDetailsManager::instance()->init(megaApi);
 
     delegateListener = new QTMegaListener(megaApi, this);
@@ -606,7 +637,8 @@ void MegaApplication::initialize()
     {
         preferences->setCrashed(false);
         QStringList reports = CrashHandler::instance()->getPendingCrashReports();
-        if (reports.size())
+        // Nobody can review the report without a display, keep it for the next GUI session
+        if (reports.size() && !mHeadless)
         {
             QPointer<CrashReportDialog> crashDialog = new CrashReportDialog(reports.join(QString::fromUtf8("------------------------------\n")));
             if (crashDialog->exec() == QDialog::Accepted)
@@ -653,13 +685,7 @@ void MegaApplication::initialize()
     mTransferQuota = std::make_shared<TransferQuota>(mOsNotifications);
     connect(mTransferQuota.get(), &TransferQuota::waitTimeIsOver, this, &MegaApplication::updateStatesAfterTransferOverQuotaTimeHasExpired);
 
-    periodicTasksTimer = new QTimer(this);
-    connect(periodicTasksTimer, SIGNAL(timeout()), this, SLOT(periodicTasks()));
-    periodicTasksTimer->start(Preferences::STATE_REFRESH_INTERVAL_MS);
-
-    networkCheckTimer = new QTimer(this);
-    networkCheckTimer->start(Preferences::NETWORK_REFRESH_INTERVAL_MS);
-    connect(networkCheckTimer, SIGNAL(timeout()), this, SLOT(checkNetworkInterfaces()));
+    registerScheduledTasks();
 
     // SDK locker code for testing purposes
     if (Preferences::MUTEX_STEALER_MS && Preferences::MUTEX_STEALER_PERIOD_MS)
@@ -692,7 +718,7 @@ void MegaApplication::initialize()
     }
 
     QDir dataDir(dataPath);
-    if (dataDir.exists())
+    if (dataDir.exists() && !mHeadless)
     {
         QString appShowInterfacePath = dataDir.filePath(QString::fromUtf8("megasync.show"));
         QFileSystemWatcher *watcher = new QFileSystemWatcher(this);
@@ -713,9 +739,12 @@ void MegaApplication::initialize()
     connect(Platform::getInstance()->getShellNotifier().get(), &AbstractShellNotifier::shellNotificationProcessed,
             this, &MegaApplication::onNotificationProcessed);
 
-    mLogoutController = new LogoutController(QmlManager::instance()->getEngine());
+    mLogoutController = new LogoutController(getControllersParent());
     connect(mLogoutController, &LogoutController::logout, this, &MegaApplication::onLogout);
-    QmlManager::instance()->setRootContextProperty(mLogoutController);
+    if (!mHeadless)
+    {
+        QmlManager::instance()->setRootContextProperty(mLogoutController);
+    }
 
     //! NOTE! Create a raw pointer, as the lifetime of this object needs to be carefully managed:
     //! mSetManager needs to be manually deleted, as the SDK needs to be destroyed first
@@ -723,6 +752,11 @@ void MegaApplication::initialize()
     connect(mSetManager, &SetManager::onSetDownloadFinished, this, &MegaApplication::setDownloadFinished);
 
     mLinkProcessor = new LinkProcessor(megaApi, megaApiFolders);
+    mLinkProcessor->setFolderSessionFactory(
+        [this]()
+        {
+            return createFolderLinkSession();
+        });
 
     connect(mLinkProcessor,
             &LinkProcessor::linkDownloadErrorDetected,
@@ -738,7 +772,10 @@ void MegaApplication::initialize()
 
     createUserMessageController();
 
-    TokenParserWidgetManager::instance();
+    if (!mHeadless)
+    {
+        TokenParserWidgetManager::instance();
+    }
 }
 
 QString MegaApplication::applicationFilePath()
@@ -786,6 +823,11 @@ void MegaApplication::changeLanguage(QString languageCode)
         currentLanguageCode = languageCode;
     }
 
+    if (mHeadless)
+    {
+        return;
+    }
+
     QmlManager::instance()->retranslate();
 
     createTrayIcon();
@@ -810,6 +852,15 @@ void MegaApplication::updateTrayIcon()
         return;
     }
 
+    const AppStatusSnapshot status = getAppStatusSnapshot();
+    if (mLastTrayIconStatus && status.sameTrayIconInputs(*mLastTrayIconStatus))
+    {
+        ++mAppStatusCounters.trayIconSkipped;
+        return;
+    }
+    mLastTrayIconStatus = status;
+    ++mAppStatusCounters.trayIconUpdates;
+
     QString tooltipState;
     QString icon;
 
@@ -1112,6 +1163,8 @@ void MegaApplication::start()
     transferOverQuotaWaitTimeExpiredReceived = false;
     updateTrayIconMenu();
 
+    if (trayIcon)
+    {
 #ifndef __APPLE__
     #ifdef _WIN32
         trayIcon->setIcon(QIcon(QString::fromUtf8("://images/tray_sync.ico")));
@@ -1119,18 +1172,20 @@ void MegaApplication::start()
         setTrayIconFromTheme(QString::fromUtf8("://images/synching.svg"));
     #endif
 #else
-    QIcon ic = QIcon(QString::fromUtf8("://images/icon_syncing_mac.png"));
-    ic.setIsMask(true);
-    trayIcon->setIcon(ic);
+        QIcon ic = QIcon(QString::fromUtf8("://images/icon_syncing_mac.png"));
+        ic.setIsMask(true);
+        trayIcon->setIcon(ic);
 
-    if (!scanningTimer->isActive())
-    {
-        scanningAnimationIndex = 1;
-        scanningTimer->start();
-    }
+        if (!scanningTimer->isActive())
+        {
+            scanningAnimationIndex = 1;
+            scanningTimer->start();
+        }
 #endif
-    trayIcon->setToolTip(QCoreApplication::applicationName() + QString::fromUtf8(" ") + Preferences::VERSION_STRING + QString::fromUtf8("\n") + tr("Logging in"));
-    trayIcon->show();
+        trayIcon->setToolTip(QCoreApplication::applicationName() + QString::fromUtf8(" ") + Preferences::VERSION_STRING + QString::fromUtf8("\n") + tr("Logging in"));
+        trayIcon->show();
+    }
+    invalidateAppStatus();
 
     //In case the previous session did not remove all of them
     Preferences::instance()->clearTempTransfersPath();
@@ -1158,6 +1213,27 @@ void MegaApplication::start()
 
     applyProxySettings();
     Platform::getInstance()->startShellDispatcher(this);
+
+#ifdef Q_OS_LINUX
+    if (mHeadless)
+    {
+        if (!mHeadlessControlServer)
+        {
+            mHeadlessControlServer = new HeadlessControlServer(this);
+            connect(mHeadlessControlServer, &HeadlessControlServer::exitRequested,
+                    this, &MegaApplication::exitApplication);
+        }
+
+        // The onboarding can only be done from the GUI
+        if (preferences->getSession().isEmpty())
+        {
+            MegaApi::log(MegaApi::LOG_LEVEL_ERROR,
+                         "No session to run in headless mode, log in without --headless first");
+            QTimer::singleShot(0, this, &MegaApplication::exitApplication);
+            return;
+        }
+    }
+#endif
 #ifdef Q_OS_MACX
     if (!preferences->isOneTimeActionDone(Preferences::ONE_TIME_ACTION_ACTIVE_FINDER_EXT))
     {
@@ -1197,7 +1273,7 @@ void MegaApplication::start()
             createTrayIcon();
         }
 
-        mLoginController = new LoginController(QmlManager::instance()->getEngine());
+        mLoginController = new LoginController(getControllersParent());
         if (!preferences->isFirstStartDone())
         {
             mStatsEventHandler->sendEvent(AppStatsEvents::EventType::FIRST_START);
@@ -1212,7 +1288,7 @@ void MegaApplication::start()
     }
     else //Otherwise, login in the account
     {
-        mLoginController = new FastLoginController(QmlManager::instance()->getEngine());
+        mLoginController = new FastLoginController(getControllersParent());
         if (mLoginController == nullptr || !static_cast<FastLoginController*>(mLoginController)->fastLogin()) //In case preferences are corrupt with empty session, just unlink and remove associated data.
         {
             MegaApi::log(MegaApi::LOG_LEVEL_ERROR, "MEGAsync preferences logged but empty session. Unlink account and fresh start.");
@@ -1225,19 +1301,22 @@ void MegaApplication::start()
         }
     }
 
-    // The same name is used for fast login
-    QmlManager::instance()->setRootContextProperty(QString::fromUtf8("loginControllerAccess"),
-                                                   mLoginController);
-    if (preferences->getSession().isEmpty())
+    if (!mHeadless)
     {
-        QmlDialogManager::instance()->openOnboardingDialog();
-    }
+        // The same name is used for fast login
+        QmlManager::instance()->setRootContextProperty(QString::fromUtf8("loginControllerAccess"),
+                                                       mLoginController);
+        if (preferences->getSession().isEmpty())
+        {
+            QmlDialogManager::instance()->openOnboardingDialog();
+        }
 
-    static constexpr int FIRST_5_X_VERSION = 50000;
-    if (updated && !(preferences->getSession().isEmpty()) &&
-        (Preferences::lastVersionUponStartup < FIRST_5_X_VERSION))
-    {
-        QmlDialogManager::instance()->openWhatsNewDialog();
+        static constexpr int FIRST_5_X_VERSION = 50000;
+        if (updated && !(preferences->getSession().isEmpty()) &&
+            (Preferences::lastVersionUponStartup < FIRST_5_X_VERSION))
+        {
+            QmlDialogManager::instance()->openWhatsNewDialog();
+        }
     }
     updateTrayIcon();
 }
@@ -1325,15 +1404,18 @@ if (!preferences->lastExecutionTime())
 
     checkOperatingSystem();
 
-    if (!infoDialog)
+    if (!mHeadless)
     {
-        createInfoDialog();
+        if (!infoDialog)
+        {
+            createInfoDialog();
+        }
+        infoDialog->setUsage();
+        infoDialog->setAvatar();
+        infoDialog->setAccountType(preferences->accountType());
     }
-    infoDialog->setUsage();
-    infoDialog->setAvatar();
-    infoDialog->setAccountType(preferences->accountType());
 
-    if (!QSystemTrayIcon::isSystemTrayAvailable())
+    if (!QSystemTrayIcon::isSystemTrayAvailable() && !mHeadless)
     {
         checkSystemTray();
         if (!qEnvironmentVariableIsSet("START_MEGASYNC_IN_BACKGROUND"))
@@ -1416,6 +1498,10 @@ if (!preferences->lastExecutionTime())
     mIsFirstFileTwoWaySynced = preferences->isFirstFileSynced();
     mIsFirstFileBackedUp = preferences->isFirstFileBackedUp();
 
+    // Both need a logged in account
+    mTaskScheduler->runNow(mLocalCachesTask);
+    mTaskScheduler->runNow(mPeriodicStatsTask);
+
     createAppMenus();
 
     mThreadPool->push([=](){
@@ -1492,6 +1578,8 @@ void MegaApplication::onLogout()
     mStalledIssuesModel->fullReset();
     mStatusController->reset();
     EmailRequester::instance()->reset();
+    SyncStatsRecorder::instance().clear();
+    RemoteFolderStatsIndex::instance().clear();
 
     // Queue processing of logout cleanup to avoid race conditions
     // due to threadifing processing.
@@ -1518,10 +1606,13 @@ void MegaApplication::onLogout()
                 mGfxProvider.reset();
                 mUserMessageController.reset();
                 createUserMessageController();
-                infoDialog->deleteLater();
-                infoDialog = nullptr;
+                if (infoDialog)
+                {
+                    infoDialog->deleteLater();
+                    infoDialog = nullptr;
+                }
                 start();
-                periodicTasks();
+                mTaskScheduler->runNow(mGlobalStateTask);
             }
         });
     });
@@ -1686,7 +1777,13 @@ void MegaApplication::onUploadsCheckedAndReady(QPointer<DuplicatedNodeDialog> ch
         foreach(auto uploadInfo, uploads)
         {
             QString filePath = uploadInfo->getLocalPath();
-            uploader->upload(filePath, uploadInfo->getNewName(), checkDialog->getNode(), data->getAppId(), batch);
+            const QString newName(uploadInfo->getNewName());
+            if(!newName.isEmpty())
+            {
+                // The node is created when the upload finishes, the next conflicts must skip its name
+                FolderNameIndex::instance().reserveName(checkDialog->getNode().get(), newName);
+            }
+            uploader->upload(filePath, newName, checkDialog->getNode(), data->getAppId(), batch);
 
             //Do not update the last items, leave Qt to do it in its natural way
             //If you update them, the flag mProcessingUploadQueue will be false and the scanning widget
@@ -1726,7 +1823,7 @@ void MegaApplication::processDownloadQueue(QString path)
         {
             HTTPServer::onTransferDataUpdate((*it)->getMegaNode()->getHandle(),
                                              MegaTransfer::STATE_CANCELLED,
-                                             0, 0, 0, QString());
+                                             0, 0, 0);
         }
 
         qDeleteAll(downloadQueue);
@@ -1773,7 +1870,10 @@ void MegaApplication::rebootApplication(bool update)
         return;
     }
 
-    trayIcon->hide();
+    if (trayIcon)
+    {
+        trayIcon->hide();
+    }
     QApplication::exit();
 }
 
@@ -1851,11 +1951,11 @@ void MegaApplication::pauseTransfers(bool pause)
     }
 }
 
-void MegaApplication::checkNetworkInterfaces()
+bool MegaApplication::checkNetworkInterfaces()
 {
     if (appfinished)
     {
-        return;
+        return false;
     }
 
     bool disconnect = false;
@@ -1886,6 +1986,7 @@ void MegaApplication::checkNetworkInterfaces()
     }
 
     reconnectIfNecessary(disconnect, newNetworkInterfaces);
+    return disconnect || !networkConnectivity;
 }
 
 void MegaApplication::checkMemoryUsage()
@@ -1959,7 +2060,7 @@ void MegaApplication::checkMemoryUsage()
 
 void MegaApplication::checkOverStorageStates()
 {
-    if (!preferences->logged() || ((!infoDialog || !infoDialog->isVisible()) && !mStorageOverquotaDialog && !Platform::getInstance()->isUserActive()))
+    if (mHeadless || !preferences->logged() || ((!infoDialog || !infoDialog->isVisible()) && !mStorageOverquotaDialog && !Platform::getInstance()->isUserActive()))
     {
         return;
     }
@@ -2087,68 +2188,258 @@ void MegaApplication::checkOverQuotaStates()
     mTransferQuota->checkQuotaAndAlerts();
 }
 
-void MegaApplication::periodicTasks()
+void MegaApplication::registerScheduledTasks()
+{
+    mTaskScheduler = new TaskScheduler(this);
+
+    // The SDK notifies the state changes, this is only to catch up with the ones that were
+    // coalesced while a refresh was in progress
+    mGlobalStateTask = mTaskScheduler->addTask(
+        QLatin1String("globalState"),
+        [this]()
+        {
+            return refreshGlobalState();
+        },
+        Preferences::STATE_REFRESH_INTERVAL_MS,
+        Preferences::STATE_REFRESH_MAX_INTERVAL_MS,
+        true);
+
+    mMaintenanceTask = mTaskScheduler->addTask(
+        QLatin1String("maintenance"),
+        [this]()
+        {
+            return runMaintenanceTasks();
+        },
+        Preferences::MAINTENANCE_INTERVAL_MS,
+        Preferences::MAINTENANCE_MAX_INTERVAL_MS,
+        true);
+
+    mLocalCachesTask = mTaskScheduler->addTask(
+        QLatin1String("localCachesCleaning"),
+        [this]()
+        {
+            MegaApi::log(MegaApi::LOG_LEVEL_INFO, "Cleaning local cache folders");
+            cleanLocalCaches();
+            return TaskScheduler::Result::IDLE;
+        },
+        static_cast<int>(Preferences::MIN_UPDATE_CLEANING_INTERVAL_MS),
+        static_cast<int>(Preferences::MIN_UPDATE_CLEANING_INTERVAL_MS));
+
+    // Only the day change matters, there is no need to check it more often
+    mPeriodicStatsTask = mTaskScheduler->addTask(
+        QLatin1String("periodicStats"),
+        [this]()
+        {
+            sendPeriodicStats();
+            return TaskScheduler::Result::IDLE;
+        },
+        Preferences::PERIODIC_STATS_INTERVAL_MS,
+        Preferences::PERIODIC_STATS_INTERVAL_MS);
+
+    // Idle syncs record no samples, the stats updates of the syncs wake the task up again
+    mSyncStatsTask = mTaskScheduler->addTask(
+        QLatin1String("syncStats"),
+        []()
+        {
+            return SyncStatsRecorder::instance().takeSamples() > 0 ? TaskScheduler::Result::BUSY :
+                                                                     TaskScheduler::Result::IDLE;
+        },
+        Preferences::SYNC_STATS_SAMPLE_INTERVAL_MS,
+        Preferences::SYNC_STATS_SAMPLE_MAX_INTERVAL_MS);
+    connect(&SyncStatsRecorder::instance(),
+            &SyncStatsRecorder::syncActivity,
+            this,
+            [this]()
+            {
+                mTaskScheduler->wakeUp(mSyncStatsTask);
+            });
+
+    // Checked often while the network changes or is down, less often while it is stable. The
+    // user coming back (e.g. after a resume or a Wi-Fi switch) brings the interval back down.
+    mTaskScheduler->addTask(
+        QLatin1String("networkCheck"),
+        [this]()
+        {
+            return checkNetworkInterfaces() ? TaskScheduler::Result::BUSY :
+                                              TaskScheduler::Result::IDLE;
+        },
+        Preferences::NETWORK_REFRESH_INTERVAL_MS,
+        Preferences::NETWORK_REFRESH_MAX_INTERVAL_MS,
+        true);
+
+    mTaskScheduler->start();
+
+#ifdef Q_OS_LINUX
+    // XFCE needs the tray icon to be added again once its panel is ready
+    const QString xdgEnvVar = qEnvironmentVariable("XDG_CURRENT_DESKTOP");
+    if (xdgEnvVar == QLatin1String("XFCE"))
+    {
+        QTimer::singleShot(4 * Preferences::STATE_REFRESH_INTERVAL_MS,
+                           this,
+                           [this]()
+                           {
+                               if (trayIcon)
+                               {
+                                   trayIcon->hide();
+                                   trayIcon->show();
+                               }
+                           });
+    }
+#endif
+}
+
+TaskScheduler::Result MegaApplication::refreshGlobalState()
 {
     if (appfinished)
     {
-        return;
+        return TaskScheduler::Result::IDLE;
+    }
+
+    if (megaApi && mIntervalExecutioner)
+    {
+        mIntervalExecutioner->scheduleExecution();
     }
 
-    if (!cleaningSchedulerExecution || ((QDateTime::currentMSecsSinceEpoch() - cleaningSchedulerExecution) > Preferences::MIN_UPDATE_CLEANING_INTERVAL_MS))
+    if (trayIcon)
     {
-        cleaningSchedulerExecution = QDateTime::currentMSecsSinceEpoch();
-        MegaApi::log(MegaApi::LOG_LEVEL_INFO, "Cleaning local cache folders");
-        cleanLocalCaches();
+        trayIcon->show();
     }
 
-    AccountDetailsManager::instance()->periodicUpdate();
+    return (mIndexing || mWaiting || mSyncing || mTransferring) ? TaskScheduler::Result::BUSY
+                                                                : TaskScheduler::Result::IDLE;
+}
+
+TaskScheduler::Result MegaApplication::runMaintenanceTasks()
+{
+    if (appfinished || !megaApi)
+    {
+        return TaskScheduler::Result::IDLE;
+    }
 
-    initLocalServer();
+    HTTPServer::checkAndPurgeRequests();
 
-    static int counter = 0;
-    counter++;
-    if (megaApi)
+    if (checkupdate)
     {
-        if (!(counter % 6))
-        {
-            HTTPServer::checkAndPurgeRequests();
+        checkupdate = false;
+        mStatsEventHandler->sendEvent(AppStatsEvents::EventType::UPDATE_OK);
+    }
 
-            if (checkupdate)
-            {
-                checkupdate = false;
-                mStatsEventHandler->sendEvent(AppStatsEvents::EventType::UPDATE_OK);
-            }
+    checkMemoryUsage();
+    mThreadPool->push([=]()
+    {//thread pool function
+        megaApi->update();
 
-            checkMemoryUsage();
-            mThreadPool->push([=]()
-            {//thread pool function
-                megaApi->update();
+        Utilities::queueFunctionInAppThread([=]()
+        {//queued function
+            checkOverStorageStates();
+            checkOverQuotaStates();
+        });//end of queued function
 
-                Utilities::queueFunctionInAppThread([=]()
-                {//queued function
-                    checkOverStorageStates();
-                    checkOverQuotaStates();
-                });//end of queued function
+    });// end of thread pool function
 
-            });// end of thread pool function
-        }
+    // The over quota alerts are only shown to active users
+    const bool busy = mSyncing || mTransferring || Platform::getInstance()->isUserActive();
+    return busy ? TaskScheduler::Result::BUSY : TaskScheduler::Result::IDLE;
+}
 
-        onGlobalSyncStateChanged(megaApi);
+AppStatusSnapshot MegaApplication::getAppStatusSnapshot()
+{
+    AppStatusSnapshot status;
+
+    status.paused = paused;
+    status.indexing = mIndexing;
+    status.waiting = mWaiting;
+    status.syncing = mSyncing;
+    status.syncStalled = mSyncStalled;
+    status.transferring = mTransferring;
+
+    if (mTransfersModel)
+    {
+        auto transferCount = mTransfersModel->getTransfersCount();
+        status.totalTransfers = transferCount.totalUploads + transferCount.totalDownloads;
+        status.pendingUploads = transferCount.pendingUploads;
+        status.pendingDownloads = transferCount.pendingDownloads;
+        status.failedTransfers = mTransfersModel->failedTransfers();
     }
+    status.hasStalledIssues = mStalledIssuesModel && !mStalledIssuesModel->isEmpty();
 
-    sendPeriodicStats();
+    status.appState = AppState::instance()->getAppState();
+    status.storageState = appliedStorageState;
+    status.transferOverQuota = mTransferQuota && mTransferQuota->isOverQuota();
+    status.accountBlocked = mStatusController && mStatusController->isAccountBlocked();
+    status.loggedIn = megaApi && megaApi->isLoggedIn();
+    status.nodesCurrent = nodescurrent && getRootNode();
+    if (model)
+    {
+        status.disabledSyncs = model->hasUnattendedDisabledSyncs(MegaSync::TYPE_TWOWAY);
+        status.disabledBackups = model->hasUnattendedDisabledSyncs(MegaSync::TYPE_BACKUP);
+    }
+    if (appliedStorageState == MegaApi::STORAGE_STATE_PAYWALL && megaApi)
+    {
+        // The info dialog shows the days or hours left
+        int64_t remainingDays(0);
+        int64_t remainingHours(0);
+        Utilities::getDaysAndHoursToTimestamp(megaApi->getOverquotaDeadlineTs() * 1000,
+                                              remainingDays,
+                                              remainingHours);
+        status.paywallHoursLeft = remainingDays * 24 + remainingHours;
+    }
 
-    if (trayIcon)
+    status.hasInfoDialog = !infoDialog.isNull();
+    if (infoDialog)
     {
-#ifdef Q_OS_LINUX
-        const QString xdgEnvVar = qEnvironmentVariable("XDG_CURRENT_DESKTOP");
-        if (counter == 4 && !xdgEnvVar.isEmpty() && xdgEnvVar == QString::fromUtf8("XFCE"))
-        {
-            trayIcon->hide();
-        }
-#endif
-        trayIcon->show();
+        infoDialog->fillStatusSnapshot(status);
     }
+    status.networkConnectivity = networkConnectivity;
+    status.updateAvailable = updateAvailable;
+    status.reboot = reboot;
+    status.languageCode = currentLanguageCode;
+
+    return status;
+}
+
+void MegaApplication::updateInfoDialogState()
+{
+    if (!infoDialog)
+    {
+        return;
+    }
+
+    const AppStatusSnapshot status = getAppStatusSnapshot();
+    if (mLastInfoDialogStatus && status.sameInfoDialogInputs(*mLastInfoDialogStatus))
+    {
+        ++mAppStatusCounters.infoDialogSkipped;
+        return;
+    }
+    mLastInfoDialogStatus = status;
+    ++mAppStatusCounters.infoDialogUpdates;
+
+    infoDialog->setIndexing(mIndexing);
+    infoDialog->setWaiting(mWaiting);
+    infoDialog->setSyncing(mSyncing);
+    infoDialog->setTransferring(mTransferring);
+    infoDialog->updateDialogState();
+}
+
+void MegaApplication::invalidateAppStatus()
+{
+    // The tray icon or the info dialog have been (re)set outside of their updates
+    mLastTrayIconStatus.reset();
+    mLastInfoDialogStatus.reset();
+}
+
+void MegaApplication::logAppStatusCounters() const
+{
+    MegaApi::log(MegaApi::LOG_LEVEL_DEBUG,
+                 QString::fromUtf8("Tray icon: %1 updates, %2 skipped. Info dialog: %3 updates, "
+                                   "%4 skipped. State logs skipped: %5")
+                     .arg(mAppStatusCounters.trayIconUpdates)
+                     .arg(mAppStatusCounters.trayIconSkipped)
+                     .arg(mAppStatusCounters.infoDialogUpdates)
+                     .arg(mAppStatusCounters.infoDialogSkipped)
+                     .arg(mAppStatusCounters.stateLogsSkipped)
+                     .toUtf8()
+                     .constData());
 }
 
 void MegaApplication::cleanAll()
@@ -2167,8 +2458,11 @@ void MegaApplication::cleanAll()
 
     qInstallMessageHandler(0);
 
-    periodicTasksTimer->stop();
-    networkCheckTimer->stop();
+    mTaskScheduler->logStats();
+    mTaskScheduler->stop();
+    SyncStatsRecorder::instance().finish();
+    logAppStatusCounters();
+    mThreadPool->logStats();
     stopUpdateTask();
     Platform::getInstance()->stopShellDispatcher();
 
@@ -2181,8 +2475,11 @@ void MegaApplication::cleanAll()
     PowerOptions::appShutdown();
 
     DialogOpener::closeAllDialogs();
-    QmlDialogManager::instance()->forceCloseOnboardingDialog();
-    QmlManager::instance()->finish();
+    if (!mHeadless)
+    {
+        QmlDialogManager::instance()->forceCloseOnboardingDialog();
+        QmlManager::instance()->finish();
+    }
 
     if(mBlockingBatch.isValid())
     {
@@ -2195,6 +2492,10 @@ void MegaApplication::cleanAll()
     mSetManager = nullptr;
     delete httpServer;
     httpServer = nullptr;
+#ifdef Q_OS_LINUX
+    delete mHeadlessControlServer;
+    mHeadlessControlServer = nullptr;
+#endif
     delete uploader;
     uploader = nullptr;
     delete downloader;
@@ -2206,7 +2507,10 @@ void MegaApplication::cleanAll()
 
     mGfxProvider.reset();
     mUserMessageController.reset();
-    infoDialog->deleteLater();
+    if (infoDialog)
+    {
+        infoDialog->deleteLater();
+    }
 
     // Delete menus and menu items
     deleteMenu(initialTrayMenu);
@@ -2215,8 +2519,14 @@ void MegaApplication::cleanAll()
 #ifdef _WIN32
     deleteMenu(windowsMenu);
 #endif
-    mSyncs2waysMenu->deleteLater();
-    mBackupsMenu->deleteLater();
+    if (mSyncs2waysMenu)
+    {
+        mSyncs2waysMenu->deleteLater();
+    }
+    if (mBackupsMenu)
+    {
+        mBackupsMenu->deleteLater();
+    }
 
     preferences->setLastExit(QDateTime::currentMSecsSinceEpoch());
 
@@ -2236,8 +2546,11 @@ void MegaApplication::cleanAll()
 
     QTMegaApiManager::removeMegaApis();
 
-    trayIcon->deleteLater();
-    trayIcon = nullptr;
+    if (trayIcon)
+    {
+        trayIcon->deleteLater();
+        trayIcon = nullptr;
+    }
 
     logger.reset();
 
@@ -2452,7 +2765,8 @@ void MegaApplication::startHttpServer()
 
 void MegaApplication::initLocalServer()
 {
-    if (!httpServer)
+    // The webclient can not be used from a headless machine
+    if (!httpServer && !mHeadless)
     {
         startHttpServer();
     }
@@ -2478,6 +2792,7 @@ bool MegaApplication::eventFilter(QObject *obj, QEvent *e)
 void MegaApplication::createInfoDialog()
 {
     infoDialog = new InfoDialog(this);
+    invalidateAppStatus();
     connect(infoDialog.data(), &InfoDialog::dismissStorageOverquota,
             this, &MegaApplication::onDismissStorageOverquota);
     connect(infoDialog.data(), &InfoDialog::transferOverquotaMsgVisibilityChange,
@@ -2955,7 +3270,10 @@ bool MegaApplication::dontAskForExitConfirmation(bool force)
 void MegaApplication::exitApplication()
 {
     reboot = false;
-    trayIcon->hide();
+    if (trayIcon)
+    {
+        trayIcon->hide();
+    }
     QApplication::exit();
 }
 
@@ -3106,7 +3424,7 @@ void MegaApplication::clearDownloadAndPendingLinks()
     {
         for (QQueue<WrappedNode *>::iterator it = downloadQueue.begin(); it != downloadQueue.end(); ++it)
         {
-            HTTPServer::onTransferDataUpdate((*it)->getMegaNode()->getHandle(), MegaTransfer::STATE_CANCELLED, 0, 0, 0, QString());
+            HTTPServer::onTransferDataUpdate((*it)->getMegaNode()->getHandle(), MegaTransfer::STATE_CANCELLED, 0, 0, 0);
         }
 
         for (QMap<QString, QString>::iterator it = pendingLinks.begin(); it != pendingLinks.end(); it++)
@@ -3114,7 +3432,7 @@ void MegaApplication::clearDownloadAndPendingLinks()
             QString link = it.key();
             QString handle = link.mid(18, 8);
             HTTPServer::onTransferDataUpdate(megaApi->base64ToHandle(handle.toUtf8().constData()),
-                                             MegaTransfer::STATE_CANCELLED, 0, 0, 0, QString());
+                                             MegaTransfer::STATE_CANCELLED, 0, 0, 0);
         }
 
         qDeleteAll(downloadQueue);
@@ -3142,6 +3460,10 @@ void MegaApplication::unlink(bool keepLogs)
         megaApi->logout(true, nullptr);
     }
     megaApiFolders->setAccountAuth(nullptr);
+    for (auto folderLinkSession : qAsConst(mFolderLinkSessions))
+    {
+        folderLinkSession->setAccountAuth(nullptr);
+    }
     DialogOpener::closeAllDialogs();
     Platform::getInstance()->notifyAllSyncFoldersRemoved();
 
@@ -3423,6 +3745,31 @@ void MegaApplication::applyProxySettings()
     }
 
     QNetworkProxy proxy(QNetworkProxy::NoProxy);
+    MegaProxy* proxySettings = createProxySettings(proxy);
+
+    megaApi->setProxySettings(proxySettings);
+    megaApiFolders->setProxySettings(proxySettings);
+    for (auto folderLinkSession : qAsConst(mFolderLinkSessions))
+    {
+        folderLinkSession->setProxySettings(proxySettings);
+    }
+    delete proxySettings;
+    QNetworkProxy::setApplicationProxy(proxy);
+    megaApi->retryPendingConnections(true, true);
+    megaApiFolders->retryPendingConnections(true, true);
+    for (auto folderLinkSession : qAsConst(mFolderLinkSessions))
+    {
+        folderLinkSession->retryPendingConnections(true, true);
+    }
+}
+
+//!
+//! \brief MegaApplication::createProxySettings
+//! \param proxy: filled with the Qt proxy matching the returned SDK settings
+//! \Returns the SDK proxy settings from the preferences. The caller owns them.
+//!
+MegaProxy* MegaApplication::createProxySettings(QNetworkProxy& proxy) const
+{
     MegaProxy *proxySettings = new MegaProxy();
     proxySettings->setProxyType(preferences->proxyType());
 
@@ -3476,12 +3823,7 @@ void MegaApplication::applyProxySettings()
         }
     }
 
-    megaApi->setProxySettings(proxySettings);
-    megaApiFolders->setProxySettings(proxySettings);
-    delete proxySettings;
-    QNetworkProxy::setApplicationProxy(proxy);
-    megaApi->retryPendingConnections(true, true);
-    megaApiFolders->retryPendingConnections(true, true);
+    return proxySettings;
 }
 
 void MegaApplication::showUpdatedMessage(int lastVersion)
@@ -3691,6 +4033,10 @@ void MegaApplication::updateStatesAfterTransferOverQuotaTimeHasExpired()
 void MegaApplication::registerUserActivity()
 {
     lastUserActivityExecution = QDateTime::currentMSecsSinceEpoch();
+    if (mTaskScheduler)
+    {
+        mTaskScheduler->registerUserActivity();
+    }
 }
 
 void MegaApplication::PSAseen(int id)
@@ -3726,10 +4072,7 @@ void MegaApplication::onTransfersModelUpdate()
         return;
     }
     //Send updated statics to the information dialog
-    if (infoDialog)
-    {
-        infoDialog->updateDialogState();
-    }
+    updateInfoDialogState();
 
     auto TransfersStats = mTransfersModel->getTransfersCount();
     //If there are no pending transfers or we have the first ones, reset the statics and update the state of the tray icon
@@ -4131,6 +4474,26 @@ bool MegaApplication::isInfoDialogVisible() const
     return infoDialog && infoDialog->isVisible();
 }
 
+bool MegaApplication::isHeadless() const
+{
+    return mHeadless;
+}
+
+TaskScheduler* MegaApplication::getTaskScheduler() const
+{
+    return mTaskScheduler;
+}
+
+QObject* MegaApplication::getControllersParent()
+{
+    // Nothing is exposed to QML in headless mode, so the QML engine is never created
+    if (mHeadless)
+    {
+        return this;
+    }
+    return QmlManager::instance()->getEngine();
+}
+
 void MegaApplication::downloadActionClicked()
 {
     if (appfinished)
@@ -4274,7 +4637,7 @@ void MegaApplication::updateTrayIconMenu()
 
 void MegaApplication::createTrayIcon()
 {
-    if (appfinished)
+    if (appfinished || mHeadless)
     {
         return;
     }
@@ -4306,6 +4669,7 @@ void MegaApplication::createTrayIcon()
                      + Preferences::VERSION_STRING
                      + QString::fromUtf8("\n")
                      + tr("Starting"));
+    invalidateAppStatus();
 
 #ifndef __APPLE__
     #ifdef _WIN32
@@ -4521,6 +4885,42 @@ void MegaApplication::createGfxProvider(const QString& basePath)
     mGfxProvider.reset(provider ? provider : MegaGfxProvider::createInternalInstance());
 }
 
+//!
+//! \brief MegaApplication::createFolderLinkSession
+//! \Creates an extra folder link session, configured like megaApiFolders, so the link processor
+//! \can resolve several folder links at the same time. It is destroyed with the other MegaApis.
+//!
+MegaApi* MegaApplication::createFolderLinkSession()
+{
+    if (appfinished)
+    {
+        return nullptr;
+    }
+
+    const QString basePath = QDir::toNativeSeparators(dataPath + QString::fromUtf8("/"));
+
+    MegaApi* folderLinkSession(nullptr);
+    QTMegaApiManager::createMegaApi(folderLinkSession,
+                                    Preferences::CLIENT_KEY,
+                                    nullptr,
+                                    basePath.toUtf8().constData(),
+                                    Preferences::USER_AGENT.toUtf8().constData());
+    folderLinkSession->disableGfxFeatures(true);
+    folderLinkSession->setMaxPayloadLogSize(maxPayloadLogSize);
+    if (!mStagingApiUrl.isEmpty())
+    {
+        folderLinkSession->changeApiUrl(mStagingApiUrl.toUtf8());
+    }
+    folderLinkSession->setLanguage(currentLanguageCode.toUtf8().constData());
+
+    QNetworkProxy proxy(QNetworkProxy::NoProxy);
+    std::unique_ptr<MegaProxy> proxySettings(createProxySettings(proxy));
+    folderLinkSession->setProxySettings(proxySettings.get());
+
+    mFolderLinkSessions.append(folderLinkSession);
+    return folderLinkSession;
+}
+
 void MegaApplication::processSetDownload(const QString& publicLink,
                                          const QList<MegaHandle>& elementHandleList)
 {
@@ -4595,7 +4995,7 @@ void MegaApplication::onDownloadFromMegaFinished(QPointer<DownloadFromMegaDialog
             QQueue<WrappedNode *>::iterator it;
             for (it = downloadQueue.begin(); it != downloadQueue.end(); ++it)
             {
-                HTTPServer::onTransferDataUpdate((*it)->getMegaNode()->getHandle(), MegaTransfer::STATE_CANCELLED, 0, 0, 0, QString());
+                HTTPServer::onTransferDataUpdate((*it)->getMegaNode()->getHandle(), MegaTransfer::STATE_CANCELLED, 0, 0, 0);
             }
 
             //If the dialog is rejected, cancel uploads
@@ -4816,7 +5216,11 @@ void MegaApplication::externalFolderUpload(MegaHandle targetFolder)
                         watcher->deleteLater();
                     });
 
-            future = QtConcurrent::run(countFilesAndFolders, foldersSelected);
+            future = mThreadPool->run(ThreadPool::Priority::NORMAL,
+                                      [foldersSelected]()
+                                      {
+                                          return countFilesAndFolders(foldersSelected);
+                                      });
             watcher->setFuture(future);
         }
         else
@@ -5275,7 +5679,7 @@ void MegaApplication::openSettingsAddSync(MegaHandle megaFolderHandle)
 
 void MegaApplication::createAppMenus()
 {
-    if (appfinished)
+    if (appfinished || mHeadless)
     {
         return;
     }
@@ -6040,7 +6444,7 @@ void MegaApplication::onTransferStart(MegaApi *api, MegaTransfer *transfer)
                                              transfer->getTransferredBytes(),
                                              transfer->getTotalBytes(),
                                              transfer->getSpeed(),
-                                             QString::fromUtf8(transfer->getPath()));
+                                             transfer->getPath());
     }
 
 
@@ -6055,6 +6459,8 @@ void MegaApplication::onTransferFinish(MegaApi* , MegaTransfer *transfer, MegaEr
         return;
     }
 
+    SyncStatsRecorder::instance().onTransferFinish(transfer);
+
     if (transfer->getType() == MegaTransfer::TYPE_DOWNLOAD)
     {
         HTTPServer::onTransferDataUpdate(transfer->getNodeHandle(),
@@ -6062,7 +6468,7 @@ void MegaApplication::onTransferFinish(MegaApi* , MegaTransfer *transfer, MegaEr
                                              transfer->getTransferredBytes(),
                                              transfer->getTotalBytes(),
                                              transfer->getSpeed(),
-                                             QString::fromUtf8(transfer->getPath()));
+                                             transfer->getPath());
     }
 
     if (e->getErrorCode() == MegaError::API_EBUSINESSPASTDUE
@@ -6150,6 +6556,8 @@ void MegaApplication::onTransferUpdate(MegaApi*, MegaTransfer* transfer)
         return;
     }
 
+    SyncStatsRecorder::instance().onTransferUpdate(transfer);
+
     int type = transfer->getType();
     if (type == MegaTransfer::TYPE_DOWNLOAD)
     {
@@ -6158,7 +6566,7 @@ void MegaApplication::onTransferUpdate(MegaApi*, MegaTransfer* transfer)
                                              transfer->getTransferredBytes(),
                                              transfer->getTotalBytes(),
                                              transfer->getSpeed(),
-                                             QString::fromUtf8(transfer->getPath()));
+                                             transfer->getPath());
     }
 }
 
@@ -6312,6 +6720,13 @@ void MegaApplication::onGlobalSyncStateChanged(MegaApi* api)
     {
         mIntervalExecutioner->scheduleExecution();
     }
+
+    // Something changed, keep refreshing the state often until it settles again
+    if (mTaskScheduler)
+    {
+        mTaskScheduler->wakeUp(mGlobalStateTask);
+        mTaskScheduler->wakeUp(mMaintenanceTask);
+    }
 }
 
 void MegaApplication::onGlobalSyncStateChangedImpl()
@@ -6321,7 +6736,7 @@ void MegaApplication::onGlobalSyncStateChangedImpl()
         return;
     }
 
-    if (megaApi && infoDialog && mTransfersModel)
+    if (megaApi && (infoDialog || mHeadless) && mTransfersModel)
     {
         mIndexing = megaApi->isScanning();
         mSyncStalled = megaApi->isSyncStalled();
@@ -6331,28 +6746,31 @@ void MegaApplication::onGlobalSyncStateChangedImpl()
         auto transferCount = mTransfersModel->getTransfersCount();
         mTransferring = transferCount.pendingUploads || transferCount.pendingDownloads;
 
-        auto pendingUploads = transferCount.pendingUploads;
-        auto pendingDownloads = transferCount.pendingDownloads;
-
-        if (pendingUploads)
+        // The same state is notified many times in a row while syncing, log only the changes
+        const AppStatusSnapshot status = getAppStatusSnapshot();
+        if (!mLastLoggedStatus || !status.sameSyncState(*mLastLoggedStatus))
         {
-            MegaApi::log(MegaApi::LOG_LEVEL_INFO, QString::fromUtf8("Pending uploads: %1").arg(pendingUploads).toUtf8().constData());
-        }
+            mLastLoggedStatus = status;
 
-        if (pendingDownloads)
-        {
-            MegaApi::log(MegaApi::LOG_LEVEL_INFO, QString::fromUtf8("Pending downloads: %1").arg(pendingDownloads).toUtf8().constData());
-        }
+            if (status.pendingUploads)
+            {
+                MegaApi::log(MegaApi::LOG_LEVEL_INFO, QString::fromUtf8("Pending uploads: %1").arg(status.pendingUploads).toUtf8().constData());
+            }
 
-        infoDialog->setIndexing(mIndexing);
-        infoDialog->setWaiting(mWaiting);
-        infoDialog->setSyncing(mSyncing);
-        infoDialog->setTransferring(mTransferring);
-        infoDialog->updateDialogState();
+            if (status.pendingDownloads)
+            {
+                MegaApi::log(MegaApi::LOG_LEVEL_INFO, QString::fromUtf8("Pending downloads: %1").arg(status.pendingDownloads).toUtf8().constData());
+            }
 
-        MegaApi::log(MegaApi::LOG_LEVEL_INFO, QString::fromUtf8("Current state. Paused = %1 Indexing = %2 Waiting = %3 Syncing = %4 Stalled = %5")
-                                                  .arg(paused).arg(mIndexing).arg(mWaiting).arg(mSyncing).arg(mSyncStalled).toUtf8().constData());
+            MegaApi::log(MegaApi::LOG_LEVEL_INFO, QString::fromUtf8("Current state. Paused = %1 Indexing = %2 Waiting = %3 Syncing = %4 Stalled = %5")
+                                                      .arg(paused).arg(mIndexing).arg(mWaiting).arg(mSyncing).arg(mSyncStalled).toUtf8().constData());
+        }
+        else
+        {
+            ++mAppStatusCounters.stateLogsSkipped;
+        }
 
+        updateInfoDialogState();
         updateTrayIcon();
     }
 }
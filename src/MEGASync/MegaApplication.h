@@ -2,6 +2,7 @@
 #define MEGAAPPLICATION_H
 
 #include "AppState.h"
+#include "AppStatusSnapshot.h"
 #include "BlockingStageProgressController.h"
 #include "DesktopNotifications.h"
 #include "DownloadFromMegaDialog.h"
@@ -19,6 +20,7 @@
 #include "SetManager.h"
 #include "SettingsDialog.h"
 #include "SyncInfo.h"
+#include "TaskScheduler.h"
 #include "ThreadPool.h"
 #include "TransferManager.h"
 #include "TransferQuota.h"
@@ -35,10 +37,12 @@
 #include <QLocalSocket>
 #include <QMenu>
 #include <QNetworkInterface>
+#include <QNetworkProxy>
 #include <QQueue>
 #include <QSystemTrayIcon>
 
 #include <memory>
+#include <optional>
 
 class IntervalExecutioner;
 class TransfersModel;
@@ -58,6 +62,7 @@ class LoginController;
 class AccountStatusController;
 class StatsEventHandler;
 class UserMessageController;
+class HeadlessControlServer;
 
 enum GetUserStatsReason {
     USERSTATS_LOGGEDIN,
@@ -180,6 +185,14 @@ public:
     bool finished() const;
     bool isInfoDialogVisible() const;
 
+    //!
+    //! \brief Whether the app was started with --headless (Linux only): no tray icon, dialogs or
+    //! QML, only the syncs, the transfers and the file manager extensions servers.
+    //!
+    bool isHeadless() const;
+
+    TaskScheduler* getTaskScheduler() const;
+
     void requestUserData(); //groups user attributes retrieving, getting PSA, ... to be retrieved after login in
 
     void updateTrayIconMenu();
@@ -265,11 +278,10 @@ public slots:
     void tryExitApplication(bool force = false);
     void highLightMenuEntry(QAction* action);
     void pauseTransfers(bool pause);
-    void checkNetworkInterfaces();
+    bool checkNetworkInterfaces();
     void checkMemoryUsage();
     void checkOverStorageStates();
     void checkOverQuotaStates();
-    void periodicTasks();
     void cleanAll();
     void onInstallUpdateClicked();
     void onAboutClicked();
@@ -395,6 +407,9 @@ protected:
     SyncInfo *model;
     mega::MegaApi *megaApi;
     mega::MegaApi *megaApiFolders;
+    // Extra sessions for folder links resolved at the same time as the one in megaApiFolders
+    QVector<mega::MegaApi*> mFolderLinkSessions;
+    QString mStagingApiUrl;
     QObject *context;
     QString crashReportFilePath;
 
@@ -410,7 +425,6 @@ protected:
     std::shared_ptr<mega::MegaNode> mRootNode;
     std::shared_ptr<mega::MegaNode> mVaultNode;
     std::shared_ptr<mega::MegaNode> mRubbishNode;
-    long long cleaningSchedulerExecution;
     long long lastUserActivityExecution;
     long long lastTsBusinessWarning;
     long long lastTsErrorMessageShown;
@@ -426,8 +440,12 @@ protected:
     mega::QTMegaListener *delegateListener;
     MegaUploader *uploader;
     MegaDownloader *downloader;
-    QTimer *periodicTasksTimer;
-    QTimer *networkCheckTimer;
+    TaskScheduler* mTaskScheduler;
+    TaskScheduler::TaskId mGlobalStateTask;
+    TaskScheduler::TaskId mMaintenanceTask;
+    TaskScheduler::TaskId mLocalCachesTask;
+    TaskScheduler::TaskId mPeriodicStatsTask;
+    TaskScheduler::TaskId mSyncStatsTask;
     QTimer *infoDialogTimer;
     std::unique_ptr<std::thread> mMutexStealerThread;
 
@@ -502,8 +520,27 @@ protected:
 
     std::unique_ptr<mega::MegaGfxProvider> mGfxProvider;
 
+    bool mHeadless;
+    HeadlessControlServer* mHeadlessControlServer;
+
+    // Inputs of the last tray icon, info dialog and state log refreshes
+    std::optional<AppStatusSnapshot> mLastTrayIconStatus;
+    std::optional<AppStatusSnapshot> mLastInfoDialogStatus;
+    std::optional<AppStatusSnapshot> mLastLoggedStatus;
+    AppStatusUpdateCounters mAppStatusCounters;
+
 private:
     void loadSyncExclusionRules(QString email = QString());
+    QObject* getControllersParent();
+
+    void registerScheduledTasks();
+    TaskScheduler::Result refreshGlobalState();
+    TaskScheduler::Result runMaintenanceTasks();
+
+    AppStatusSnapshot getAppStatusSnapshot();
+    void updateInfoDialogState();
+    void invalidateAppStatus();
+    void logAppStatusCounters() const;
 
     QList<QNetworkInterface> findNewNetworkInterfaces();
     bool checkNetworkInterfaces(const QList<QNetworkInterface>& newNetworkInterfaces) const;
@@ -608,6 +645,9 @@ private:
 
     void createGfxProvider(const QString& basePath);
 
+    mega::MegaApi* createFolderLinkSession();
+    mega::MegaProxy* createProxySettings(QNetworkProxy& proxy) const;
+
 private slots:
     void onFolderTransferUpdate(FolderTransferUpdateEvent event);
     void onNotificationProcessed();
@@ -2,6 +2,7 @@
 
 #include "AvatarWidget.h"
 #include "FullName.h"
+#include "ImageCache.h"
 #include "megaapi.h"
 #include "MegaApplication.h"
 #include "Preferences.h"
@@ -53,10 +54,18 @@ bool Avatar::isFileValid(const QString& filePath)
     QString stored_hash = Preferences::instance()->fileHash(filePath);
     if (stored_hash.isEmpty()) { return false; }
 
-    QString new_hash = Utilities::getFileHash(filePath);
+    // The hash is only recalculated when the file changes
+    QString new_hash = ImageCache::instance().contentHash(filePath);
     return (!new_hash.isEmpty() && new_hash == stored_hash);
 }
 
+void Avatar::setIconFile(const QString& filePath)
+{
+    mIconPath = filePath;
+    mIconHash = ImageCache::instance().contentHash(mIconPath);
+    mUseImgFile = true;
+}
+
 void Avatar::onRequestFinish(mega::MegaApi*, mega::MegaRequest* incoming_request, mega::MegaError* e)
 {
     if(incoming_request->getParamType() == mega::MegaApi::USER_ATTR_AVATAR)
@@ -75,15 +84,12 @@ void Avatar::onRequestFinish(mega::MegaApi*, mega::MegaRequest* incoming_request
             #endif
             if (QFile::exists(mIconPath))
             {
-                mUseImgFile = true;
-                mIcon.clear();
-
-                QString new_hash = Utilities::getFileHash(mIconPath);
+                setIconFile(mIconPath);
 
-                if (!new_hash.isEmpty())
+                if (!mIconHash.isEmpty())
                 {
                     // Store the hash, so next time we have a secure way of fetching the local avatar
-                    Preferences::instance()->setFileHash(mIconPath, new_hash);
+                    Preferences::instance()->setFileHash(mIconPath, mIconHash);
                 }
             }
             if (mFullName)
@@ -97,8 +103,8 @@ void Avatar::onRequestFinish(mega::MegaApi*, mega::MegaRequest* incoming_request
             {
                 QFile::remove(mIconPath);
                 mIconPath.clear();
+                mIconHash.clear();
             }
-            mIcon.clear();
             if (!mFullName)
             {
                 mFullName = FullName::requestFullName(getEmail().toUtf8().constData());
@@ -147,9 +153,7 @@ void Avatar::requestAttribute()
     if (isFileValid(avatarPath))
     {
         // Get local avatar
-        mIconPath = avatarPath;
-        mUseImgFile = true;
-        mIcon.clear();
+        setIconFile(avatarPath);
 
         if (mFullName)
         {
@@ -171,7 +175,6 @@ void Avatar::onFullNameAttributeReady()
     fillLetterInfo();
     if (!mUseImgFile && oldSymbol != mLetterAvatarInfo.symbol)
     {
-        mIcon.clear();
         emit attributeReady();
     }
 }
@@ -229,9 +232,31 @@ void Avatar::getLetterColor()
     }
 }
 
-const QPixmap& Avatar::getPixmap(const int& size) const
+QString Avatar::getPixmapSource() const
 {
-    auto& icon = mIcon[size];
+    if (mUseImgFile)
+    {
+        // The hash is empty if the file could not be read, the path still tells the users apart
+        return mIconHash.isEmpty() ? QString::fromLatin1("avatarfile:%1").arg(mIconPath)
+                                   : QString::fromLatin1("avatar:%1").arg(mIconHash);
+    }
+
+    // If the attribute is not ready, the first char of the email is used as a placeholder.
+    return QString::fromLatin1("letter:%1:%2:%3")
+        .arg(isAttributeReady() ? mLetterAvatarInfo.symbol : getEmail().at(0).toUpper(),
+             mLetterAvatarInfo.primaryColor.name(),
+             mLetterAvatarInfo.secondaryColor.name());
+}
+
+QPixmap Avatar::getPixmap(int size) const
+{
+    // Rendered avatars are shared by all the views through the image cache. Images from files
+    // are also persisted, keyed by their content hash
+    auto& cache(ImageCache::instance());
+    ImageCache::Key key(getPixmapSource(), size, Utilities::getDevicePixelRatio());
+    const QString persistentHash(mUseImgFile ? mIconHash : QString());
+
+    auto icon = cache.pixmap(key, persistentHash);
     if (icon.isNull())
     {
         if (!mUseImgFile)
@@ -242,6 +267,7 @@ const QPixmap& Avatar::getPixmap(const int& size) const
                                                   mLetterAvatarInfo.primaryColor,
                                                   mLetterAvatarInfo.secondaryColor,
                                                   size);
+            cache.insertPixmap(key, icon);
         }
         else
         {
@@ -253,6 +279,10 @@ const QPixmap& Avatar::getPixmap(const int& size) const
                 forceRequestAttribute();
                 icon = AvatarPixmap::maskFromImagePath(QString::fromUtf8(DEFAULT_AVATAR), size);
             }
+            else
+            {
+                cache.insertPixmap(key, icon, persistentHash);
+            }
         }
     }
     return icon;
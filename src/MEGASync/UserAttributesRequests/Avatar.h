@@ -25,7 +25,7 @@ public:
     void requestAttribute() override;
     RequestInfo fillRequestInfo() override;
 
-    const QPixmap& getPixmap(const int& size) const;
+    QPixmap getPixmap(int size) const;
 
     bool isAttributeReady() const override;
     static constexpr char DEFAULT_AVATAR[] = ":/images/default-avatar.jpg";
@@ -57,9 +57,12 @@ private:
     void getLetterColor();
 
     bool isFileValid(const QString& filePath);
+    void setIconFile(const QString& filePath);
+    QString getPixmapSource() const;
 
-    mutable QMap<int,QPixmap> mIcon;
     QString mIconPath;
+    // Content hash of mIconPath, used to share the rendered pixmaps through ImageCache
+    QString mIconHash;
     LetterInfo mLetterAvatarInfo;
     std::shared_ptr<const FullName> mFullName;
     bool mUseImgFile;
@@ -5,6 +5,8 @@
 #include "RequestListenerManager.h"
 #include "SettingsDialog.h"
 
+#include <algorithm>
+
 //
 // UserStats implementation (private).
 //
@@ -74,6 +76,7 @@ void AccountDetailsManager::reset()
     mLastRequestUserStats.updateWithValue(0);
     mQueuedUserStats.updateWithValue(false);
     mQueuedStorageUserStatsReason = 0;
+    mQueuedUserStatsTimer.stop();
 }
 
 void AccountDetailsManager::init(mega::MegaApi* megaApi)
@@ -88,6 +91,11 @@ void AccountDetailsManager::init(mega::MegaApi* megaApi)
         {
             updateUserStats(Flag::ALL, true, USERSTATS_PRO_EXPIRED);
         });
+        mQueuedUserStatsTimer.setSingleShot(true);
+        connect(&mQueuedUserStatsTimer,
+                &QTimer::timeout,
+                this,
+                &AccountDetailsManager::updateQueuedUserStats);
     }
 }
 
@@ -157,10 +165,17 @@ void AccountDetailsManager::updateUserStats(const Flags& flags, bool force, int
     else
     {
         mQueuedUserStats.updateWithValue(flagsToFetch, true);
+
+        // Request them as soon as the minimum interval is over
+        if (!mQueuedUserStatsTimer.isActive())
+        {
+            long long pendingInterval = Preferences::MIN_UPDATE_STATS_INTERVAL - lastRequestInterval;
+            mQueuedUserStatsTimer.start(static_cast<int>(std::max(0LL, pendingInterval)));
+        }
     }
 }
 
-void AccountDetailsManager::periodicUpdate()
+void AccountDetailsManager::updateQueuedUserStats()
 {
     if (mQueuedUserStats.storageValue() || mQueuedUserStats.transferValue() || mQueuedUserStats.proValue())
     {
@@ -50,7 +50,6 @@ public:
                          mega::MegaError* error);
 
     void updateUserStats(const Flags& flags, bool force, int source);
-    void periodicUpdate();
 
 signals:
     void accountDetailsUpdated();
@@ -87,6 +86,7 @@ private:
     UserStats<long long> mLastRequestUserStats;
     int mQueuedStorageUserStatsReason;
     QTimer mProExpirityTimer;
+    QTimer mQueuedUserStatsTimer;
 
     AccountDetailsManager(QObject* parent = nullptr);
 
@@ -106,6 +106,7 @@ private:
     void processInShares(const std::shared_ptr<mega::MegaAccountDetails>& details,
                          const std::shared_ptr<mega::MegaNodeList>& inShares);
     void checkInflightUserStats(Flags& flags);
+    void updateQueuedUserStats();
 
     static long long getLastRequest(const Flags& flags,
                                     const UserStats<long long>& lastRequestUserStats);
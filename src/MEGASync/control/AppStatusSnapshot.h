@@ -0,0 +1,137 @@
+#ifndef APPSTATUSSNAPSHOT_H
+#define APPSTATUSSNAPSHOT_H
+
+#include <QString>
+#include <QtGlobal>
+
+#include <tuple>
+
+//!
+//! \brief Everything the tray icon, its tooltip and the info dialog status are built from.
+//!
+//! It is taken every time the app state may have changed, and compared with the one used for the
+//! last update, so the UI is only touched when one of its inputs changes.
+//!
+struct AppStatusSnapshot
+{
+    // Sync engine
+    bool paused = false;
+    bool indexing = false;
+    bool waiting = false;
+    bool syncing = false;
+    bool syncStalled = false;
+    bool transferring = false;
+
+    // Transfers and stalled issues
+    uint totalTransfers = 0;
+    uint pendingUploads = 0;
+    uint pendingDownloads = 0;
+    uint failedTransfers = 0;
+    bool hasStalledIssues = false;
+
+    // Account
+    int appState = -1;
+    int storageState = -1;
+    bool transferOverQuota = false;
+    bool accountBlocked = false;
+    bool loggedIn = false;
+    bool nodesCurrent = false;
+    bool disabledSyncs = false;
+    bool disabledBackups = false;
+    // Hours left until the paywall deadline, -1 without paywall
+    qint64 paywallHoursLeft = -1;
+
+    // Kept by the info dialog
+    int infoDialogStorageState = -1; // With the warnings dismissed
+    int transferQuotaState = -1;
+    bool transferOverQuotaAlert = false;
+    bool transferAlmostOverQuotaAlert = false;
+    bool psaReady = false;
+    bool transferScanActive = false;
+
+    // Rest of the tray icon inputs
+    bool hasInfoDialog = false;
+    bool networkConnectivity = true;
+    bool updateAvailable = false;
+    bool reboot = false;
+    QString languageCode;
+
+private:
+    auto syncStateTie() const
+    {
+        return std::tie(paused, indexing, waiting, syncing, syncStalled, transferring);
+    }
+
+    auto transfersTie() const
+    {
+        return std::tie(totalTransfers,
+                        pendingUploads,
+                        pendingDownloads,
+                        failedTransfers,
+                        hasStalledIssues);
+    }
+
+    auto accountTie() const
+    {
+        return std::tie(appState,
+                        storageState,
+                        transferOverQuota,
+                        accountBlocked,
+                        loggedIn,
+                        nodesCurrent,
+                        disabledSyncs,
+                        disabledBackups,
+                        paywallHoursLeft);
+    }
+
+    auto infoDialogTie() const
+    {
+        return std::tie(infoDialogStorageState,
+                        transferQuotaState,
+                        transferOverQuotaAlert,
+                        transferAlmostOverQuotaAlert,
+                        psaReady,
+                        transferScanActive);
+    }
+
+public:
+    //! \brief Only the values logged with the current state.
+    bool sameSyncState(const AppStatusSnapshot& other) const
+    {
+        return syncStateTie() == other.syncStateTie()
+               && std::tie(pendingUploads, pendingDownloads)
+                      == std::tie(other.pendingUploads, other.pendingDownloads);
+    }
+
+    bool sameInfoDialogInputs(const AppStatusSnapshot& other) const
+    {
+        return syncStateTie() == other.syncStateTie() && transfersTie() == other.transfersTie()
+               && accountTie() == other.accountTie() && infoDialogTie() == other.infoDialogTie();
+    }
+
+    bool sameTrayIconInputs(const AppStatusSnapshot& other) const
+    {
+        return sameInfoDialogInputs(other)
+               && std::tie(hasInfoDialog, networkConnectivity, updateAvailable, reboot, languageCode)
+                      == std::tie(other.hasInfoDialog,
+                                  other.networkConnectivity,
+                                  other.updateAvailable,
+                                  other.reboot,
+                                  other.languageCode);
+    }
+};
+
+//!
+//! \brief How many times the tray icon and the info dialog have been refreshed, and how many
+//! refreshes have been skipped because their inputs had not changed.
+//!
+struct AppStatusUpdateCounters
+{
+    quint64 trayIconUpdates = 0;
+    quint64 trayIconSkipped = 0;
+    quint64 infoDialogUpdates = 0;
+    quint64 infoDialogSkipped = 0;
+    quint64 stateLogsSkipped = 0;
+};
+
+#endif // APPSTATUSSNAPSHOT_H
@@ -4,6 +4,7 @@
 #include "Preferences.h"
 #include "QTMegaApiManager.h"
 #include "RequestListenerManager.h"
+#include "SyncStatsRecorder.h"
 #include "Utilities.h"
 
 const int BugReportData::MAXIMUM_PERMIL_VALUE = 1010;
@@ -288,6 +289,12 @@ void BugReportController::createSupportTicket()
     report.append(QString::fromUtf8("Description: %1")
                       .arg(mData.mReportDescription.append(QString::fromUtf8("\n"))));
 
+    const QString syncStatsSummary(SyncStatsRecorder::instance().getSummary());
+    if (!syncStatsSummary.isEmpty())
+    {
+        report.append(QString::fromUtf8("Sync stats:\n%1").arg(syncStatsSummary));
+    }
+
     auto listener = RequestListenerManager::instance().registerAndGetFinishListener(this, true);
     mMegaApi->createSupportTicket(report.toUtf8().constData(), 6, listener.get());
 
@@ -1,7 +1,9 @@
 #include "FileFolderAttributes.h"
 
 #include "FullName.h"
+#include "LocalFolderStatsWalker.h"
 #include "MegaApplication.h"
+#include "RemoteFolderStatsIndex.h"
 #include "RequestListenerManager.h"
 
 #include <QEventLoop>
@@ -129,14 +131,11 @@ LocalFileFolderAttributes::LocalFileFolderAttributes(const QString &path, QObjec
     : FileFolderAttributes(parent),
       mPath(path)
 {
-    connect(&mModifiedTimeWatcher, &QFutureWatcher<QDateTime>::finished,
-            this, &LocalFileFolderAttributes::onModifiedTimeCalculated);
-
-    connect(&mFolderSizeFuture, &QFutureWatcher<qint64>::finished,
-            this, &LocalFileFolderAttributes::onSizeCalculated);
+}
 
-    QDirIterator filesIt(mPath, QDir::Files | QDir::NoDotAndDotDot | QDir::NoSymLinks, QDirIterator::Subdirectories);
-    mDirectoryIsEmpty = !filesIt.hasNext();
+LocalFileFolderAttributes::~LocalFileFolderAttributes()
+{
+    LocalFolderStatsWalker::instance().cancel(mPath, this);
 }
 
 void LocalFileFolderAttributes::requestSize(QObject* caller, std::function<void(qint64)> func)
@@ -154,14 +153,10 @@ void LocalFileFolderAttributes::requestSize(QObject* caller, std::function<void(
             }
             else
             {
-                auto future = QtConcurrent::run([this]() -> qint64 {
-                    return calculateSize();
-                });
-                mFolderSizeFuture.setFuture(future);
-
                 // We always send the size, even if the request is async...just to show on GUI a
                 // "loading size..." or the most recent size while the new is received
                 emit attributeReady(AttributeTypes::SIZE, true);
+                requestFolderStats();
                 return;
             }
         }
@@ -189,20 +184,10 @@ void LocalFileFolderAttributes::requestModifiedTime(QObject* caller,std::functio
             //Is local folder
             else
             {
-                if (mDirectoryIsEmpty)
-                {
-                    requestCreatedTime(caller, func);
-                }
-                else
-                {
-                    auto future = QtConcurrent::run([this]() -> QDateTime {
-                        return calculateModifiedTime();
-                    });
-                    mModifiedTimeWatcher.setFuture(future);
-                    //We always send the time, even if the request is async...just to show on GUI a "loading time..." or the most recent time while the new is received
-                    emit attributeReady(AttributeTypes::MODIFIED_TIME, true);
-                    return;
-                }
+                //We always send the time, even if the request is async...just to show on GUI a "loading time..." or the most recent time while the new is received
+                emit attributeReady(AttributeTypes::MODIFIED_TIME, true);
+                requestFolderStats();
+                return;
             }
         }
         else
@@ -213,17 +198,56 @@ void LocalFileFolderAttributes::requestModifiedTime(QObject* caller,std::functio
     }
 }
 
-void LocalFileFolderAttributes::onModifiedTimeCalculated()
+void LocalFileFolderAttributes::requestFileCount(QObject* caller, std::function<void(int)> func)
 {
-    auto newModifiedTime(mModifiedTimeWatcher.result());
-    mValues.insert(AttributeTypes::MODIFIED_TIME, newModifiedTime);
-    emit attributeReady(AttributeTypes::MODIFIED_TIME);
+    if (requestValue<int>(caller, LocalAttributeTypes::FILE_COUNT, func))
+    {
+        initValue<int>(LocalAttributeTypes::FILE_COUNT, Status::NOT_READY);
+
+        QFileInfo fileInfo(mPath);
+        if (fileInfo.exists() && !fileInfo.isFile())
+        {
+            emit attributeReady(LocalAttributeTypes::FILE_COUNT, true);
+            requestFolderStats();
+            return;
+        }
+
+        mValues.insert(LocalAttributeTypes::FILE_COUNT, fileInfo.exists() ? 1 : 0);
+        emit attributeReady(LocalAttributeTypes::FILE_COUNT);
+    }
 }
 
-void LocalFileFolderAttributes::onSizeCalculated()
+void LocalFileFolderAttributes::requestFolderStats()
 {
-    mValues.insert(AttributeTypes::SIZE, mFolderSizeFuture.result());
+    // Size, modified time and counts are all obtained from the same walk, which is shared with any
+    // other LocalFileFolderAttributes pointing to the same folder
+    LocalFolderStatsWalker::instance().request(mPath,
+                                               this,
+                                               [this](const LocalFolderStats& stats)
+                                               {
+                                                   onFolderStatsCalculated(stats);
+                                               });
+}
+
+void LocalFileFolderAttributes::onFolderStatsCalculated(const LocalFolderStats& stats)
+{
+    if (mCancelled)
+    {
+        return;
+    }
+
+    mValues.insert(AttributeTypes::SIZE,
+                   stats.readable ? stats.size : static_cast<qint64>(Status::NOT_READABLE));
+    mValues.insert(LocalAttributeTypes::FILE_COUNT, stats.fileCount);
+    mValues.insert(LocalAttributeTypes::FOLDER_COUNT, stats.folderCount);
+
+    // An empty folder is considered modified when it was created
+    mValues.insert(AttributeTypes::MODIFIED_TIME,
+                   stats.fileCount == 0 ? calculateCreatedTime() : stats.newestModifiedTime);
+
     emit attributeReady(AttributeTypes::SIZE);
+    emit attributeReady(AttributeTypes::MODIFIED_TIME);
+    emit attributeReady(LocalAttributeTypes::FILE_COUNT);
 }
 
 bool LocalFileFolderAttributes::attributeNeedsUpdate(QObject* caller, int type)
@@ -240,36 +264,9 @@ void LocalFileFolderAttributes::requestCreatedTime(QObject* caller,std::function
 {
     if (requestValue<QDateTime>(caller, AttributeTypes::CREATED_TIME, func))
     {
-        QFileInfo fileInfo(mPath);
-        if (fileInfo.exists())
+        if (QFileInfo::exists(mPath))
         {
-            QVariant& createdTime = mValues[AttributeTypes::CREATED_TIME];
-#ifdef Q_OS_WINDOWS
-            struct stat result;
-            const QString sourcePath = mPath;
-            QVarLengthArray<wchar_t, MAX_PATH + 1> file(sourcePath.length() + 2);
-            sourcePath.toWCharArray(file.data());
-            file[sourcePath.length()] = wchar_t{};
-            file[sourcePath.length() + 1] = wchar_t{};
-            if (_wstat(file.constData(), &result) == 0)
-            {
-                createdTime = QVariant::fromValue<QDateTime>(QDateTime::fromSecsSinceEpoch(result.st_ctime));
-            }
-#elif defined(Q_OS_MACOS)
-            struct stat the_time;
-            stat(mPath.toUtf8(), &the_time);
-            createdTime = QVariant::fromValue<QDateTime>(
-                QDateTime::fromSecsSinceEpoch(the_time.st_birthtimespec.tv_sec));
-#elif defined(Q_OS_LINUX)
-            createdTime = QVariant::fromValue<QDateTime>(QDateTime::fromSecsSinceEpoch(0));
-#endif
-            if (!fileInfo.isFile())
-            {
-                if (mDirectoryIsEmpty)
-                {
-                    mValues.insert(AttributeTypes::MODIFIED_TIME, mValues.value(AttributeTypes::CREATED_TIME));
-                }
-            }
+            mValues.insert(AttributeTypes::CREATED_TIME, calculateCreatedTime());
         }
 
         emit attributeReady(AttributeTypes::CREATED_TIME);
@@ -299,60 +296,56 @@ void LocalFileFolderAttributes::requestCRC(QObject *caller, std::function<void (
     }
 }
 
-QDateTime LocalFileFolderAttributes::calculateModifiedTime()
+int LocalFileFolderAttributes::fileCount() const
 {
-    QDateTime newDate;
-    QDirIterator filesIt(mPath, QDir::Files | QDir::NoDotAndDotDot | QDir::NoSymLinks, QDirIterator::Subdirectories);
-
-    while (filesIt.hasNext())
-    {
-        if(mCancelled)
-        {
-            break;
-        }
-
-        filesIt.next();
-        if(filesIt.fileInfo().lastModified() > newDate)
-        {
-            newDate = filesIt.fileInfo().lastModified();
-        }
-    }
-
-    return newDate;
+    return mValues.value(LocalAttributeTypes::FILE_COUNT, 0).toInt();
 }
 
-qint64 LocalFileFolderAttributes::calculateSize()
+int LocalFileFolderAttributes::folderCount() const
 {
-    qint64 newSize(0);
+    return mValues.value(LocalAttributeTypes::FOLDER_COUNT, 0).toInt();
+}
 
-    QFileInfo fileInfo(mPath);
-    if(!fileInfo.isReadable())
-    {
-        newSize = NOT_READABLE;
-    }
-    if(!mPath.isEmpty() && fileInfo.exists())
+QDateTime LocalFileFolderAttributes::calculateCreatedTime() const
+{
+    QDateTime createdTime;
+#ifdef Q_OS_WINDOWS
+    struct stat result;
+    const QString sourcePath = mPath;
+    QVarLengthArray<wchar_t, MAX_PATH + 1> file(sourcePath.length() + 2);
+    sourcePath.toWCharArray(file.data());
+    file[sourcePath.length()] = wchar_t{};
+    file[sourcePath.length() + 1] = wchar_t{};
+    if (_wstat(file.constData(), &result) == 0)
     {
-        QDirIterator filesIt(mPath, QDir::Files| QDir::NoDotAndDotDot | QDir::NoSymLinks | QDir::Hidden, QDirIterator::Subdirectories);
-
-        while (filesIt.hasNext())
-        {
-            filesIt.next();
-            newSize += filesIt.fileInfo().size();
-        }
+        createdTime = QDateTime::fromSecsSinceEpoch(result.st_ctime);
     }
-
-    return newSize;
+#elif defined(Q_OS_MACOS)
+    struct stat the_time;
+    stat(mPath.toUtf8(), &the_time);
+    createdTime = QDateTime::fromSecsSinceEpoch(the_time.st_birthtimespec.tv_sec);
+#elif defined(Q_OS_LINUX)
+    createdTime = QDateTime::fromSecsSinceEpoch(0);
+#endif
+    return createdTime;
 }
 
 void LocalFileFolderAttributes::setPath(const QString &newPath)
 {
     if(mPath != newPath)
     {
+        LocalFolderStatsWalker::instance().cancel(mPath, this);
         mPath = newPath;
         mValues.clear();
     }
 }
 
+void LocalFileFolderAttributes::cancel()
+{
+    FileFolderAttributes::cancel();
+    LocalFolderStatsWalker::instance().cancel(mPath, this);
+}
+
 //REMOTE
 RemoteFileFolderAttributes::RemoteFileFolderAttributes(const QString &filePath, QObject *parent, bool waitForAttributes)
     : FileFolderAttributes(parent),
@@ -388,12 +381,18 @@ void RemoteFileFolderAttributes::requestSize(QObject* caller,std::function<void(
     if (requestValue<qint64>(caller, AttributeTypes::SIZE, func))
     {
         std::unique_ptr<mega::MegaNode> node = getNode();
+        RemoteFolderStatsIndex::Stats folderStats;
         if(node)
         {
             if(node->isFile())
             {
                 mValues.insert(AttributeTypes::SIZE, std::max(static_cast<long long>(node->getSize()), static_cast<long long>(0)));
             }
+            else if(RemoteFolderStatsIndex::instance().getStats(node->getHandle(), folderStats))
+            {
+                // Inside a tracked folder, already up to date
+                mValues.insert(AttributeTypes::SIZE, folderStats.size);
+            }
             else
             {
                 auto listener = RequestListenerManager::instance().registerAndGetCustomFinishListener(
@@ -446,6 +445,14 @@ void RemoteFileFolderAttributes::requestFileCount(QObject *caller, std::function
     {
         if (requestValue<int>(caller, RemoteAttributeTypes::FILE_COUNT, func))
         {
+            RemoteFolderStatsIndex::Stats folderStats;
+            if(RemoteFolderStatsIndex::instance().getStats(node->getHandle(), folderStats))
+            {
+                mValues.insert(RemoteAttributeTypes::FILE_COUNT, static_cast<int>(folderStats.files));
+                emit attributeReady(RemoteAttributeTypes::FILE_COUNT);
+                return;
+            }
+
             initValue<int>(RemoteAttributeTypes::FILE_COUNT, Status::NOT_READY);
 
             auto listener = RequestListenerManager::instance().registerAndGetCustomFinishListener(
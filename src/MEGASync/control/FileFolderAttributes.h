@@ -14,6 +14,8 @@ namespace UserAttributes{
 class FullName;
 }
 
+struct LocalFolderStats;
+
 class FileFolderAttributes : public QObject
 {
     Q_OBJECT
@@ -49,7 +51,7 @@ public:
     virtual void requestCreatedTime(QObject*, std::function<void(const QDateTime&)>) = 0;
     virtual void requestCRC(QObject*, std::function<void(const QString&)>) = 0;
 
-    void cancel();
+    virtual void cancel();
 
     template <class Type>
     static std::shared_ptr<Type> convert(std::shared_ptr<FileFolderAttributes> attributes)
@@ -130,28 +132,34 @@ class LocalFileFolderAttributes : public FileFolderAttributes
 
 public:
     LocalFileFolderAttributes(const QString& path, QObject* parent);
-    ~LocalFileFolderAttributes() override = default;
+    ~LocalFileFolderAttributes() override;
 
     void requestSize(QObject* caller, std::function<void(qint64)> func) override;
     void requestModifiedTime(QObject* caller, std::function<void(const QDateTime&)> func) override;
     void requestCreatedTime(QObject* caller, std::function<void(const QDateTime&)> func) override;
     void requestCRC(QObject* caller, std::function<void(const QString&)> func) override;
+    void requestFileCount(QObject* caller, std::function<void(int)> func);
+
+    void cancel() override;
+
+    int fileCount() const;
+    int folderCount() const;
 
     void setPath(const QString &newPath);
 
-private slots:
-    void onModifiedTimeCalculated();
-    void onSizeCalculated();
-    
 private:
+    enum LocalAttributeTypes
+    {
+        FILE_COUNT = AttributeTypes::LOCAL_ATTRIBUTES,
+        FOLDER_COUNT
+    };
+
     bool attributeNeedsUpdate(QObject* caller, int type) override;
-    QDateTime calculateModifiedTime();
-    qint64 calculateSize();
+    void requestFolderStats();
+    void onFolderStatsCalculated(const LocalFolderStats& stats);
+    QDateTime calculateCreatedTime() const;
 
-    QFutureWatcher<qint64> mFolderSizeFuture;
-    QFutureWatcher<QDateTime> mModifiedTimeWatcher;
     QString mPath;
-    bool mDirectoryIsEmpty;
 };
 
 class RemoteFileFolderAttributes : public FileFolderAttributes
@@ -0,0 +1,310 @@
+#include "FolderNameIndex.h"
+
+#include "MegaApplication.h"
+
+#include <QDir>
+#include <QDirIterator>
+#include <QFileInfo>
+#include <QMutexLocker>
+
+namespace
+{
+// Indexed folders kept before starting again, the index is rebuilt on demand
+constexpr int MAX_INDEXED_FOLDERS = 256;
+}
+
+FolderNameIndex::FolderNameIndex():
+    mGlobalListener(std::make_unique<mega::QTMegaGlobalListener>(MegaSyncApp->getMegaApi(), this))
+{
+    // The index may be created from a worker thread, node updates are received in the GUI one
+    moveToThread(qApp->thread());
+    mGlobalListener->moveToThread(qApp->thread());
+    MegaSyncApp->getMegaApi()->addGlobalListener(mGlobalListener.get());
+}
+
+QString FolderNameIndex::foldName(const QString& name)
+{
+    return name.normalized(QString::NormalizationForm_C).toCaseFolded();
+}
+
+// ----------------------------------------------------------------------------
+//
+// REMOTE FOLDERS
+//
+// ----------------------------------------------------------------------------
+bool FolderNameIndex::findName(mega::MegaNode* parentNode, const QString& name, Entry* entry)
+{
+    if (!parentNode)
+    {
+        return false;
+    }
+
+    QMutexLocker locker(&mMutex);
+
+    auto folder(getRemoteFolder(parentNode));
+    auto entryIt(folder->entries.constFind(foldName(name)));
+    // The reserved names are not nodes yet
+    if (entryIt == folder->entries.constEnd() || entryIt->handle == mega::INVALID_HANDLE)
+    {
+        return false;
+    }
+
+    if (entry)
+    {
+        *entry = entryIt.value();
+    }
+    return true;
+}
+
+std::shared_ptr<mega::MegaNode> FolderNameIndex::getNodeByName(mega::MegaNode* parentNode,
+                                                               const QString& name)
+{
+    Entry entry;
+    if (!findName(parentNode, name, &entry))
+    {
+        return nullptr;
+    }
+
+    return std::shared_ptr<mega::MegaNode>(
+        MegaSyncApp->getMegaApi()->getNodeByHandle(entry.handle));
+}
+
+QString FolderNameIndex::suggestNonDuplicatedName(mega::MegaNode* parentNode,
+                                                  const QString& baseName,
+                                                  const QString& suffix,
+                                                  const QStringList& reservedNames)
+{
+    Folder emptyFolder;
+
+    QMutexLocker locker(&mMutex);
+
+    auto folder(parentNode ? getRemoteFolder(parentNode) : nullptr);
+    return findNonDuplicatedName(folder ? *folder : emptyFolder, baseName, suffix, reservedNames);
+}
+
+void FolderNameIndex::reserveName(mega::MegaNode* parentNode, const QString& name)
+{
+    if (!parentNode)
+    {
+        return;
+    }
+
+    QMutexLocker locker(&mMutex);
+    addReservedName(*getRemoteFolder(parentNode), name);
+}
+
+void FolderNameIndex::invalidate(mega::MegaHandle folderHandle)
+{
+    QMutexLocker locker(&mMutex);
+    removeRemoteFolder(folderHandle);
+}
+
+std::shared_ptr<FolderNameIndex::Folder>
+    FolderNameIndex::getRemoteFolder(mega::MegaNode* parentNode)
+{
+    auto folderIt(mRemoteFolders.constFind(parentNode->getHandle()));
+    if (folderIt != mRemoteFolders.constEnd())
+    {
+        return folderIt.value();
+    }
+
+    if (mRemoteFolders.size() >= MAX_INDEXED_FOLDERS)
+    {
+        mRemoteFolders.clear();
+        mParentByChild.clear();
+    }
+
+    auto folder(std::make_shared<Folder>());
+
+    std::unique_ptr<mega::MegaNodeList> children(
+        MegaSyncApp->getMegaApi()->getChildren(parentNode));
+    for (int index = 0; index < children->size(); ++index)
+    {
+        auto child(children->get(index));
+
+        Entry entry;
+        entry.name = QString::fromUtf8(child->getName());
+        entry.handle = child->getHandle();
+        entry.isFile = child->isFile();
+
+        // With name conflicts, the first node is the one found
+        auto foldedName(foldName(entry.name));
+        if (!folder->entries.contains(foldedName))
+        {
+            folder->entries.insert(foldedName, entry);
+        }
+        mParentByChild.insert(entry.handle, parentNode->getHandle());
+    }
+
+    mRemoteFolders.insert(parentNode->getHandle(), folder);
+    return folder;
+}
+
+void FolderNameIndex::removeRemoteFolder(mega::MegaHandle folderHandle)
+{
+    auto folder(mRemoteFolders.take(folderHandle));
+    if (folder)
+    {
+        for (const auto& entry : qAsConst(folder->entries))
+        {
+            mParentByChild.remove(entry.handle);
+        }
+    }
+}
+
+void FolderNameIndex::onNodesUpdate(mega::MegaApi*, mega::MegaNodeList* nodes)
+{
+    QMutexLocker locker(&mMutex);
+
+    // Full reload of the nodes
+    if (!nodes)
+    {
+        mRemoteFolders.clear();
+        mParentByChild.clear();
+        return;
+    }
+
+    for (int index = 0; index < nodes->size(); ++index)
+    {
+        auto node(nodes->get(index));
+
+        // New, renamed or moved in: the current parent
+        removeRemoteFolder(node->getParentHandle());
+
+        // Moved out or removed: the parent it was indexed in
+        auto previousParent(mParentByChild.value(node->getHandle(), mega::INVALID_HANDLE));
+        if (previousParent != mega::INVALID_HANDLE)
+        {
+            removeRemoteFolder(previousParent);
+        }
+
+        if (node->getChanges() & mega::MegaNode::CHANGE_TYPE_REMOVED)
+        {
+            removeRemoteFolder(node->getHandle());
+        }
+    }
+}
+
+// ----------------------------------------------------------------------------
+//
+// LOCAL FOLDERS
+//
+// ----------------------------------------------------------------------------
+bool FolderNameIndex::containsLocalName(const QString& folderPath, const QString& name)
+{
+    QMutexLocker locker(&mMutex);
+    return getLocalFolder(folderPath)->entries.contains(foldName(name));
+}
+
+QString FolderNameIndex::suggestNonDuplicatedLocalName(const QString& folderPath,
+                                                       const QString& baseName,
+                                                       const QString& suffix,
+                                                       const QStringList& reservedNames)
+{
+    QMutexLocker locker(&mMutex);
+    return findNonDuplicatedName(*getLocalFolder(folderPath), baseName, suffix, reservedNames);
+}
+
+void FolderNameIndex::reserveLocalName(const QString& folderPath, const QString& name)
+{
+    QMutexLocker locker(&mMutex);
+    addReservedName(*getLocalFolder(folderPath), name);
+}
+
+void FolderNameIndex::invalidateLocal(const QString& folderPath)
+{
+    QMutexLocker locker(&mMutex);
+    mLocalFolders.remove(QDir::cleanPath(folderPath));
+}
+
+std::shared_ptr<FolderNameIndex::Folder>
+    FolderNameIndex::getLocalFolder(const QString& folderPath)
+{
+    const QString cleanPath(QDir::cleanPath(folderPath));
+    const QDateTime lastModified(QFileInfo(cleanPath).lastModified());
+
+    auto folder(mLocalFolders.value(cleanPath));
+    if (folder && folder->lastModified == lastModified)
+    {
+        return folder;
+    }
+
+    if (mLocalFolders.size() >= MAX_INDEXED_FOLDERS)
+    {
+        mLocalFolders.clear();
+    }
+
+    folder = std::make_shared<Folder>();
+    folder->lastModified = lastModified;
+
+    QDirIterator filesIt(cleanPath,
+                         QDir::AllEntries | QDir::System | QDir::Hidden | QDir::NoDotAndDotDot);
+    while (filesIt.hasNext())
+    {
+        filesIt.next();
+
+        Entry entry;
+        entry.name = filesIt.fileName();
+        entry.isFile = filesIt.fileInfo().isFile();
+        folder->entries.insert(foldName(entry.name), entry);
+    }
+
+    mLocalFolders.insert(cleanPath, folder);
+    return folder;
+}
+
+// ----------------------------------------------------------------------------
+
+void FolderNameIndex::clear()
+{
+    QMutexLocker locker(&mMutex);
+    mRemoteFolders.clear();
+    mParentByChild.clear();
+    mLocalFolders.clear();
+}
+
+QString FolderNameIndex::findNonDuplicatedName(Folder& folder,
+                                               const QString& baseName,
+                                               const QString& suffix,
+                                               const QStringList& reservedNames)
+{
+    // '/' can't be part of a name, so the key is unique for each base name and suffix
+    const QString suffixKey(foldName(baseName) + QLatin1Char('/') + foldName(suffix));
+
+    int counter(folder.nextFreeSuffix.value(suffixKey, 1));
+    bool firstFreeInFolder(true);
+
+    while (true)
+    {
+        QString suggestedName =
+            baseName + QString(QLatin1String("(%1)")).arg(QString::number(counter)) + suffix;
+
+        if (!folder.entries.contains(foldName(suggestedName)))
+        {
+            // The reserved names are not part of the folder yet, they may never be
+            if (firstFreeInFolder)
+            {
+                folder.nextFreeSuffix.insert(suffixKey, counter);
+                firstFreeInFolder = false;
+            }
+
+            if (!reservedNames.contains(suggestedName, Qt::CaseInsensitive))
+            {
+                return suggestedName;
+            }
+        }
+
+        counter++;
+    }
+}
+
+void FolderNameIndex::addReservedName(Folder& folder, const QString& name)
+{
+    const QString foldedName(foldName(name));
+    if (!folder.entries.contains(foldedName))
+    {
+        Entry entry;
+        entry.name = name;
+        folder.entries.insert(foldedName, entry);
+    }
+}
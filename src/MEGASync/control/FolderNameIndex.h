@@ -0,0 +1,106 @@
+#ifndef FOLDER_NAME_INDEX_H
+#define FOLDER_NAME_INDEX_H
+
+#include "megaapi.h"
+#include "QTMegaGlobalListener.h"
+
+#include <QDateTime>
+#include <QHash>
+#include <QMutex>
+#include <QObject>
+#include <QStringList>
+
+#include <memory>
+
+/*
+ * Process-wide index of the child names of remote and local folders.
+ *
+ * Names are compared in NFC and case folded, so the same name written with a different case or
+ * with decomposed characters is found. Each folder also remembers the first free "(n)" suffix of
+ * every base name already looked up, so suggesting many non duplicated names in the same folder
+ * does not scan it again for each candidate. Suggesting a name does not take it: the code that
+ * creates, moves or renames a node to it reserves it, so the next suggestion skips it even if
+ * the node update did not arrive yet.
+ *
+ * Remote folders are invalidated on node updates and local folders when their modification time
+ * changes. It can be used from any thread.
+ */
+class FolderNameIndex : public QObject, public mega::MegaGlobalListener
+{
+    Q_OBJECT
+
+public:
+    struct Entry
+    {
+        QString name;
+        mega::MegaHandle handle = mega::INVALID_HANDLE;
+        bool isFile = false;
+    };
+
+    static FolderNameIndex& instance()
+    {
+        static FolderNameIndex instance;
+        return instance;
+    }
+
+    FolderNameIndex(const FolderNameIndex&) = delete;
+    FolderNameIndex& operator=(const FolderNameIndex&) = delete;
+
+    // Remote folders. Invalidate the folder after every rename, move or copy done synchronously.
+    bool findName(mega::MegaNode* parentNode, const QString& name, Entry* entry = nullptr);
+    std::shared_ptr<mega::MegaNode> getNodeByName(mega::MegaNode* parentNode, const QString& name);
+    QString suggestNonDuplicatedName(mega::MegaNode* parentNode,
+                                     const QString& baseName,
+                                     const QString& suffix,
+                                     const QStringList& reservedNames);
+    // Until the folder is invalidated
+    void reserveName(mega::MegaNode* parentNode, const QString& name);
+    void invalidate(mega::MegaHandle folderHandle);
+
+    // Local folders
+    bool containsLocalName(const QString& folderPath, const QString& name);
+    QString suggestNonDuplicatedLocalName(const QString& folderPath,
+                                          const QString& baseName,
+                                          const QString& suffix,
+                                          const QStringList& reservedNames);
+    // Until the folder is invalidated or changes on disk
+    void reserveLocalName(const QString& folderPath, const QString& name);
+    void invalidateLocal(const QString& folderPath);
+
+    void clear();
+
+    static QString foldName(const QString& name);
+
+    void onNodesUpdate(mega::MegaApi* api, mega::MegaNodeList* nodes) override;
+
+private:
+    struct Folder
+    {
+        QHash<QString, Entry> entries;
+        QHash<QString, int> nextFreeSuffix;
+        // Local folders only
+        QDateTime lastModified;
+    };
+
+    FolderNameIndex();
+
+    // Must be called with mMutex locked
+    std::shared_ptr<Folder> getRemoteFolder(mega::MegaNode* parentNode);
+    std::shared_ptr<Folder> getLocalFolder(const QString& folderPath);
+    void removeRemoteFolder(mega::MegaHandle folderHandle);
+
+    // Only the suffix cache of the folder is updated
+    static QString findNonDuplicatedName(Folder& folder,
+                                         const QString& baseName,
+                                         const QString& suffix,
+                                         const QStringList& reservedNames);
+    static void addReservedName(Folder& folder, const QString& name);
+
+    QMutex mMutex;
+    QHash<mega::MegaHandle, std::shared_ptr<Folder>> mRemoteFolders;
+    QHash<mega::MegaHandle, mega::MegaHandle> mParentByChild;
+    QHash<QString, std::shared_ptr<Folder>> mLocalFolders;
+    std::unique_ptr<mega::QTMegaGlobalListener> mGlobalListener;
+};
+
+#endif // FOLDER_NAME_INDEX_H
@@ -4,8 +4,7 @@
 #include "Preferences.h"
 #include "StatsEventHandler.h"
 #include "Utilities.h"
-
-#include <QtConcurrent/QtConcurrent>
+#include "WebTransferProgressTracker.h"
 
 #include <algorithm>
 
@@ -28,20 +27,8 @@ RequestData::RequestData()
     status = STATE_OPEN;
 }
 
-RequestTransferData::RequestTransferData()
-{
-    state = MegaTransfer::STATE_NONE;
-    progress = 0;
-    size = 0;
-    speed = 0;
-    tsStart = QDateTime::currentMSecsSinceEpoch() / 1000;
-    tsEnd = -1;
-    tPath = QString();
-}
-
 bool HTTPServer::isFirstWebDownloadDone = false;
 QMultiMap<QString, RequestData*> HTTPServer::webDataRequests;
-QMap<mega::MegaHandle, RequestTransferData*> HTTPServer::webTransferStateRequests;
 
 HTTPServer::HTTPServer(MegaApi *megaApi, quint16 port)
     : QTcpServer(), disabled(false)
@@ -103,22 +90,7 @@ void HTTPServer::checkAndPurgeRequests()
         }
     }
 
-    for (QMap<MegaHandle, RequestTransferData*>::iterator it = webTransferStateRequests.begin() ; it != webTransferStateRequests.end();)
-    {
-        RequestTransferData *transferData = it.value();
-        if ((transferData->state == MegaTransfer::STATE_CANCELLED
-             || transferData->state == MegaTransfer::STATE_COMPLETED
-             || transferData->state == MegaTransfer::STATE_FAILED)
-                && (((QDateTime::currentMSecsSinceEpoch() / 1000) - transferData->tsEnd) > MAX_REQUEST_TIME_SECS))
-        {
-            webTransferStateRequests.erase(it++);
-            delete transferData;
-        }
-        else
-        {
-            it++;
-        }
-    }
+    WebTransferProgressTracker::instance().purgeFinished(MAX_REQUEST_TIME_SECS);
 }
 
 void HTTPServer::onUploadSelectionAccepted(int files, int folders)
@@ -147,38 +119,9 @@ void HTTPServer::onUploadSelectionDiscarded()
     }
 }
 
-void HTTPServer::onTransferDataUpdate(MegaHandle handle, int state, long long progress, long long size, long long speed, QString localPath)
+void HTTPServer::onTransferDataUpdate(MegaHandle handle, int state, long long progress, long long size, long long speed, const char* localPath)
 {
-    QMap<MegaHandle, RequestTransferData*>::iterator it = webTransferStateRequests.find(handle);
-    if (it == webTransferStateRequests.end())
-    {
-        return;
-    }
-
-    #ifdef WIN32
-    if (localPath.startsWith(QString::fromLatin1("\\\\?\\")))
-    {
-        localPath = localPath.mid(4);
-    }
-    #endif
-
-    RequestTransferData* tData = it.value();
-    tData->state = state;
-    tData->progress = progress;
-    tData->size = size;
-    tData->speed = speed;
-
-    if (!localPath.isEmpty() && tData->tPath != localPath)
-    {
-        tData->tPath = localPath;
-    }
-
-    if (state == MegaTransfer::STATE_CANCELLED
-            || state == MegaTransfer::STATE_COMPLETED
-            || state == MegaTransfer::STATE_FAILED)
-    {
-        tData->tsEnd = QDateTime::currentMSecsSinceEpoch() / 1000;
-    }
+    WebTransferProgressTracker::instance().onTransferData(handle, state, progress, size, speed, localPath);
 }
 
 void HTTPServer::readClient()
@@ -271,7 +214,7 @@ void HTTPServer::processRequest(QPointer<QAbstractSocket> socket, HTTPRequest re
     switch(GetRequestType(request))
     {
     case VERSION_COMMAND:
-        //Version command is taken using QtConcurrent, this is why the case is broken, as the response is received later
+        //Version command is taken using the thread pool, this is why the case is broken, as the response is received later
         versionCommand(request, socket);
         return;
     case OPEN_LINK_REQUEST_START:
@@ -357,7 +300,7 @@ void HTTPServer::endProcessRequest(QPointer<QAbstractSocket> socket,const HTTPRe
 
 void HTTPServer::versionCommand(const HTTPRequest& request, QPointer<QAbstractSocket> socket)
 {
-    auto future = QtConcurrent::run([this, socket, request]() -> VersionCommandAnswer
+    auto getVersion = [this, socket, request]() -> VersionCommandAnswer
     {
         VersionCommandAnswer answer;
 
@@ -379,8 +322,11 @@ void HTTPServer::versionCommand(const HTTPRequest& request, QPointer<QAbstractSo
         answer.socket = socket;
 
         return answer;
-    });
+    };
 
+    // The webclient is waiting for the answer
+    auto future =
+        ThreadPoolSingleton::getInstance()->run(ThreadPool::Priority::INTERACTIVE, getVersion);
     mVersionCommandWatcher.setFuture(future);
 }
 
@@ -412,12 +358,7 @@ void HTTPServer::openLinkRequest(QString &response, const HTTPRequest& request)
         auto preferences = Preferences::instance();
         QString defaultPath = preferences->downloadFolder();
         MegaHandle megaHandle = megaApi->base64ToHandle(handle.toUtf8().constData());
-        QMap<MegaHandle, RequestTransferData*>::iterator it = webTransferStateRequests.find(megaHandle);
-        if (it != webTransferStateRequests.end())
-        {
-            delete it.value();
-        }
-        webTransferStateRequests.insert(megaHandle, new RequestTransferData());
+        WebTransferProgressTracker::instance().registerHandle(megaHandle);
 
         if (preferences->hasDefaultDownloadFolder() && QFile(defaultPath).exists())
         {
@@ -563,12 +504,7 @@ void HTTPServer::externalDownloadRequest(QString &response, const HTTPRequest& r
                                                          publicAuthArray.constData(),
                                                          chatAuth.isEmpty() ? nullptr :  chatAuthArray.constData());
                         downloadQueue.append(new WrappedNode(WrappedNode::TransferOrigin::FROM_WEBSERVER, node, undelete));
-                        QMap<MegaHandle, RequestTransferData*>::iterator it = webTransferStateRequests.find(h);
-                        if (it != webTransferStateRequests.end())
-                        {
-                            delete it.value();
-                        }
-                        webTransferStateRequests.insert(h, new RequestTransferData());
+                        WebTransferProgressTracker::instance().registerHandle(h);
                     }
                     else
                     {
@@ -822,24 +758,24 @@ void HTTPServer::externalTransferQueryProgress(QString &response, const HTTPRequ
     }
     else
     {
-        if (!webTransferStateRequests.contains(handle))
+        WebTransferProgress tData;
+        if (!WebTransferProgressTracker::instance().getProgress(handle, tData))
         {
             response = QString::number(MegaError::API_ENOENT);
         }
         else
         {
-            RequestTransferData* tData = webTransferStateRequests.value(handle);
-            if (tData->state == MegaTransfer::STATE_NONE)
+            if (tData.state == MegaTransfer::STATE_NONE)
             {
-                response = QString::fromUtf8("{\"s\":%1}").arg(tData->state);
+                response = QString::fromUtf8("{\"s\":%1}").arg(tData.state);
             }
             else
             {
                 response = QString::fromUtf8("{\"s\":%1,\"p\":%2,\"t\":%3,\"v\":%4}")
-                        .arg(tData->state)
-                        .arg(tData->progress)
-                        .arg(tData->size)
-                        .arg(tData->speed);
+                        .arg(tData.state)
+                        .arg(tData.progress)
+                        .arg(tData.size)
+                        .arg(tData.speed);
             }
         }
     }
@@ -861,22 +797,22 @@ void HTTPServer::externalShowInFolder(QString &response, const HTTPRequest& requ
     }
     else
     {
-        if (!webTransferStateRequests.contains(handle))
+        if (!WebTransferProgressTracker::instance().isTracked(handle))
         {
             response = QString::number(MegaError::API_ENOENT);
         }
         else
         {
-            RequestTransferData* tData = webTransferStateRequests.value(handle);
-            if (!tData->tPath.isNull())
+            QString tPath(WebTransferProgressTracker::instance().getLocalPath(handle));
+            if (!tPath.isEmpty())
             {
-                if (QFile(tData->tPath).exists())
+                if (QFile(tPath).exists())
                 {
-                    emit onExternalShowInFolderRequested(tData->tPath);
+                    emit onExternalShowInFolderRequested(tPath);
                 }
                 else
                 {
-                    emit onExternalShowInFolderRequested(QFileInfo(tData->tPath).dir().absolutePath());
+                    emit onExternalShowInFolderRequested(QFileInfo(tPath).dir().absolutePath());
                 }
 
                 response = QString::number(MegaError::API_OK);
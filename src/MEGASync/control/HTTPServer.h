@@ -32,19 +32,6 @@ public:
     int status;
 };
 
-class RequestTransferData
-{
-public:
-    RequestTransferData();
-    int state;
-    long long progress;
-    long long size;
-    long long speed;
-    long long tsStart;
-    long long tsEnd;
-    QString tPath;
-};
-
 class HTTPRequest
 {
 public:
@@ -90,8 +77,10 @@ class HTTPServer: public QTcpServer
         static void checkAndPurgeRequests();
         static void onUploadSelectionAccepted(int files, int folders);
         static void onUploadSelectionDiscarded();
+        // Raw data from the transfer callbacks; ignored unless the webclient asked for the handle
         static void onTransferDataUpdate(mega::MegaHandle handle, int state, long long progress,
-                                         long long size, long long speed, QString localPath);
+                                         long long size, long long speed,
+                                         const char* localPath = nullptr);
 
     signals:
         void onLinkReceived(QString link, QString auth);
@@ -155,7 +144,6 @@ class HTTPServer: public QTcpServer
         QMap<QAbstractSocket*, HTTPRequest*> requests;
         static bool isFirstWebDownloadDone;
         static QMultiMap<QString, RequestData*> webDataRequests;
-        static QMap<mega::MegaHandle, RequestTransferData*> webTransferStateRequests;
         QFutureWatcher<VersionCommandAnswer> mVersionCommandWatcher;
 };
 
@@ -0,0 +1,222 @@
+#include "ImageCache.h"
+
+#include "Preferences.h"
+#include "Utilities.h"
+
+#include <QDir>
+#include <QFileInfo>
+#include <QFutureWatcher>
+
+#include <algorithm>
+
+namespace
+{
+constexpr int DEFAULT_MEMORY_BUDGET_KB = 32 * 1024;
+const QLatin1String THUMBNAILS_FOLDER("thumbnails");
+const QLatin1String THUMBNAIL_FORMAT("PNG");
+
+int costInKB(const QImage& image)
+{
+    return std::max(1, static_cast<int>(image.sizeInBytes() / 1024));
+}
+
+int costInKB(const QPixmap& pixmap)
+{
+    return std::max(1, pixmap.width() * pixmap.height() * pixmap.depth() / 8 / 1024);
+}
+}
+
+QString ImageCache::Key::toString() const
+{
+    return QString::fromLatin1("%1|%2|%3").arg(source).arg(size).arg(devicePixelRatio);
+}
+
+double ImageCache::Stats::hitRate() const
+{
+    auto lookups(hits + diskHits + misses);
+    return lookups > 0 ? static_cast<double>(hits + diskHits) / static_cast<double>(lookups) : 0.0;
+}
+
+ImageCache::ImageCache():
+    QObject(nullptr),
+    mEntries(DEFAULT_MEMORY_BUDGET_KB)
+{
+}
+
+QPixmap ImageCache::pixmap(const Key& key, const QString& contentHash)
+{
+    auto keyString(key.toString());
+    if (auto entry = mEntries.object(keyString))
+    {
+        if (!entry->pixmap.isNull())
+        {
+            ++mStats.hits;
+            return entry->pixmap;
+        }
+    }
+
+    if (!contentHash.isEmpty())
+    {
+        QPixmap storedPixmap;
+        if (storedPixmap.load(thumbnailPath(key, contentHash), THUMBNAIL_FORMAT.data()))
+        {
+            ++mStats.diskHits;
+            storedPixmap.setDevicePixelRatio(key.devicePixelRatio);
+            insertPixmap(key, storedPixmap);
+            return storedPixmap;
+        }
+    }
+
+    ++mStats.misses;
+    return QPixmap();
+}
+
+void ImageCache::insertPixmap(const Key& key, const QPixmap& pixmap, const QString& contentHash)
+{
+    if (pixmap.isNull())
+    {
+        return;
+    }
+
+    auto entry = new Entry();
+    entry->pixmap = pixmap;
+    mEntries.insert(key.toString(), entry, costInKB(pixmap));
+
+    if (!contentHash.isEmpty())
+    {
+        persist(key, pixmap, contentHash);
+    }
+}
+
+QImage ImageCache::image(const Key& key)
+{
+    if (auto entry = mEntries.object(key.toString()))
+    {
+        if (!entry->image.isNull())
+        {
+            ++mStats.hits;
+            return entry->image;
+        }
+    }
+
+    ++mStats.misses;
+    return QImage();
+}
+
+void ImageCache::insertImage(const Key& key, const QImage& image)
+{
+    if (image.isNull())
+    {
+        return;
+    }
+
+    auto entry = new Entry();
+    entry->image = image;
+    mEntries.insert(key.toString(), entry, costInKB(image));
+}
+
+void ImageCache::decodeAsync(const QByteArray& data,
+                             QImage::Format format,
+                             QObject* context,
+                             std::function<void(const QImage&)> callback)
+{
+    ++mStats.decodes;
+
+    auto watcher = new QFutureWatcher<QImage>(context);
+    connect(watcher,
+            &QFutureWatcher<QImage>::finished,
+            context,
+            [watcher, callback]()
+            {
+                if (callback)
+                {
+                    callback(watcher->result());
+                }
+                watcher->deleteLater();
+            });
+
+    watcher->setFuture(ThreadPoolSingleton::getInstance()->run(
+        ThreadPool::Priority::NORMAL,
+        [data, format]() -> QImage
+        {
+            QImage image(QSize(), format);
+            if (!image.loadFromData(data))
+            {
+                return QImage();
+            }
+            return image.format() == format ? image : image.convertToFormat(format);
+        }));
+}
+
+QString ImageCache::contentHash(const QString& filePath)
+{
+    QFileInfo fileInfo(filePath);
+    if (!fileInfo.exists())
+    {
+        mFileHashes.remove(filePath);
+        return QString();
+    }
+
+    auto& fileHash(mFileHashes[filePath]);
+    if (fileHash.hash.isEmpty() || fileHash.size != fileInfo.size() ||
+        fileHash.modifiedTime != fileInfo.lastModified())
+    {
+        fileHash.size = fileInfo.size();
+        fileHash.modifiedTime = fileInfo.lastModified();
+        fileHash.hash = Utilities::getFileHash(filePath);
+    }
+
+    return fileHash.hash;
+}
+
+void ImageCache::setMemoryBudgetKB(int budget)
+{
+    mEntries.setMaxCost(budget);
+}
+
+void ImageCache::clear()
+{
+    mEntries.clear();
+    mFileHashes.clear();
+
+    QDir thumbnailsDir(Preferences::instance()->getDataPath() + QDir::separator() +
+                       THUMBNAILS_FOLDER);
+    if (thumbnailsDir.exists())
+    {
+        thumbnailsDir.removeRecursively();
+    }
+}
+
+ImageCache::Stats ImageCache::stats() const
+{
+    auto stats(mStats);
+    stats.memoryUsageKB = mEntries.totalCost();
+    return stats;
+}
+
+QString ImageCache::thumbnailPath(const Key& key, const QString& contentHash) const
+{
+    return QString::fromLatin1("%1/%2/%3_%4@%5.png")
+        .arg(Preferences::instance()->getDataPath(), QString(THUMBNAILS_FOLDER), contentHash)
+        .arg(key.size)
+        .arg(qRound(key.devicePixelRatio * 100));
+}
+
+void ImageCache::persist(const Key& key, const QPixmap& pixmap, const QString& contentHash)
+{
+    auto path(thumbnailPath(key, contentHash));
+    if (QFile::exists(path))
+    {
+        return;
+    }
+
+    // QPixmap cannot leave the GUI thread, so the encoding is done on a QImage copy
+    auto image(pixmap.toImage());
+    ThreadPoolSingleton::getInstance()->push(
+        [path, image]()
+        {
+            QDir().mkpath(QFileInfo(path).absolutePath());
+            image.save(path, THUMBNAIL_FORMAT.data());
+        },
+        ThreadPool::Priority::BACKGROUND);
+}
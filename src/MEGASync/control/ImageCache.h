@@ -0,0 +1,108 @@
+#ifndef IMAGE_CACHE_H
+#define IMAGE_CACHE_H
+
+#include <QCache>
+#include <QDateTime>
+#include <QHash>
+#include <QImage>
+#include <QObject>
+#include <QPixmap>
+
+#include <functional>
+
+/*
+ * Process-wide LRU cache for decoded images and rendered pixmaps.
+ *
+ * Entries are keyed by (source, size, device pixel ratio) and evicted when the memory budget is
+ * exceeded. Pixmaps inserted with a content hash are also persisted in a thumbnail store, so they
+ * can be reloaded in following sessions without decoding the original image again.
+ *
+ * Must be used from the GUI thread. Only decodeAsync works in a background thread.
+ */
+class ImageCache : public QObject
+{
+    Q_OBJECT
+
+public:
+    struct Key
+    {
+        Key(const QString& source, int size = 0, qreal devicePixelRatio = 1.0):
+            source(source),
+            size(size),
+            devicePixelRatio(devicePixelRatio)
+        {}
+
+        QString toString() const;
+
+        QString source;
+        int size;
+        qreal devicePixelRatio;
+    };
+
+    struct Stats
+    {
+        quint64 hits = 0;
+        quint64 diskHits = 0;
+        quint64 misses = 0;
+        quint64 decodes = 0;
+        int memoryUsageKB = 0;
+
+        double hitRate() const;
+    };
+
+    static ImageCache& instance()
+    {
+        static ImageCache instance;
+        return instance;
+    }
+
+    ImageCache(const ImageCache&) = delete;
+    ImageCache& operator=(const ImageCache&) = delete;
+
+    QPixmap pixmap(const Key& key, const QString& contentHash = QString());
+    void insertPixmap(const Key& key, const QPixmap& pixmap, const QString& contentHash = QString());
+
+    QImage image(const Key& key);
+    void insertImage(const Key& key, const QImage& image);
+
+    // Decodes the data in a worker thread. The callback is called in the GUI thread, only if
+    // context is still alive. The result is a null QImage if the data could not be decoded.
+    void decodeAsync(const QByteArray& data,
+                     QImage::Format format,
+                     QObject* context,
+                     std::function<void(const QImage&)> callback);
+
+    // SHA-256 of the file contents, recalculated only when the file size or mtime change
+    QString contentHash(const QString& filePath);
+
+    void setMemoryBudgetKB(int budget);
+    // Removes every cached entry, both in memory and in the thumbnail store
+    void clear();
+
+    Stats stats() const;
+
+private:
+    ImageCache();
+
+    struct Entry
+    {
+        QImage image;
+        QPixmap pixmap;
+    };
+
+    struct FileHash
+    {
+        qint64 size = -1;
+        QDateTime modifiedTime;
+        QString hash;
+    };
+
+    QString thumbnailPath(const Key& key, const QString& contentHash) const;
+    void persist(const Key& key, const QPixmap& pixmap, const QString& contentHash);
+
+    QCache<QString, Entry> mEntries;
+    QHash<QString, FileHash> mFileHashes;
+    Stats mStats;
+};
+
+#endif // IMAGE_CACHE_H
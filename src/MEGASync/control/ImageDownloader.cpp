@@ -1,5 +1,6 @@
 #include "ImageDownloader.h"
 
+#include "ImageCache.h"
 #include "megaapi.h"
 
 #include <QNetworkRequest>
@@ -8,6 +9,11 @@ namespace
 {
 constexpr int DefaultTimeout = 30000;
 constexpr int StatusCodeOK = 200;
+
+ImageCache::Key cacheKey(const QString& url, QImage::Format format)
+{
+    return ImageCache::Key(QString::fromLatin1("%1#%2").arg(url).arg(static_cast<int>(format)));
+}
 }
 
 ImageDownloader::ImageDownloader(QObject* parent)
@@ -32,6 +38,13 @@ void ImageDownloader::downloadImage(const QString& imageUrl, QImage::Format form
         return;
     }
 
+    auto cachedImage(ImageCache::instance().image(cacheKey(imageUrl, format)));
+    if (!cachedImage.isNull())
+    {
+        emit downloadFinished(cachedImage, imageUrl);
+        return;
+    }
+
     QNetworkRequest request(url);
     request.setTransferTimeout(static_cast<int>(mTimeout));
     request.setAttribute(QNetworkRequest::CacheLoadControlAttribute, QNetworkRequest::AlwaysNetwork);
@@ -104,15 +117,26 @@ bool ImageDownloader::validateReply(QNetworkReply* reply,
 void ImageDownloader::processImageData(const QByteArray& bytes,
                                        const std::shared_ptr<ImageData>& imageData)
 {
-    QImage image(QSize(), imageData->format);
-    if (image.loadFromData(bytes))
-    {
-        emit downloadFinished(image, imageData->url);
-    }
-    else
-    {
-        mega::MegaApi::log(mega::MegaApi::LOG_LEVEL_WARNING,
-                           "Failed to load image from downloaded data");
-        emit downloadFinishedWithError(imageData->url, Error::InvalidImage, QNetworkReply::UnknownContentError);
-    }
+    // Decoding is done out of the GUI thread
+    ImageCache::instance().decodeAsync(
+        bytes,
+        imageData->format,
+        this,
+        [this, imageData](const QImage& image)
+        {
+            if (!image.isNull())
+            {
+                ImageCache::instance().insertImage(cacheKey(imageData->url, imageData->format),
+                                                   image);
+                emit downloadFinished(image, imageData->url);
+            }
+            else
+            {
+                mega::MegaApi::log(mega::MegaApi::LOG_LEVEL_WARNING,
+                                   "Failed to load image from downloaded data");
+                emit downloadFinishedWithError(imageData->url,
+                                               Error::InvalidImage,
+                                               QNetworkReply::UnknownContentError);
+            }
+        });
 }
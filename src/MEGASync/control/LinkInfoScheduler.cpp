@@ -0,0 +1,230 @@
+#include "LinkInfoScheduler.h"
+
+#include <algorithm>
+
+LinkInfoScheduler::LinkInfoScheduler(int maxFileRequests,
+                                     int maxFolderSessions,
+                                     qint64 timeoutMs,
+                                     Handlers handlers):
+    mMaxFileRequests(std::max(maxFileRequests, 1)),
+    mMaxFolderSessions(std::max(maxFolderSessions, 1)),
+    mTimeoutMs(timeoutMs),
+    mHandlers(std::move(handlers)),
+    mLastRequestId(0),
+    mFileRequestsInFlight(0),
+    mSetRequestsInFlight(0)
+{}
+
+void LinkInfoScheduler::addLink(const QString& link, LinkType type, int index)
+{
+    const quint64 sharedRequestId(mRequestIdByLink.value(link, 0));
+    if (mRequests.contains(sharedRequestId))
+    {
+        mRequests[sharedRequestId].indexes.append(index);
+        return;
+    }
+
+    Request request;
+    request.link = link;
+    request.type = type;
+    request.indexes.append(index);
+
+    const quint64 requestId(++mLastRequestId);
+    mRequests.insert(requestId, request);
+    mRequestIdByLink.insert(link, requestId);
+
+    switch (type)
+    {
+        case LinkType::FOLDER:
+            mPendingFolderLinks.enqueue(requestId);
+            break;
+        case LinkType::SET:
+            mPendingSetLinks.enqueue(requestId);
+            break;
+        case LinkType::FILE:
+        default:
+            mPendingFileLinks.enqueue(requestId);
+            break;
+    }
+}
+
+void LinkInfoScheduler::dispatch(qint64 now)
+{
+    while (mFileRequestsInFlight < mMaxFileRequests && !mPendingFileLinks.isEmpty())
+    {
+        send(mPendingFileLinks.dequeue(), now);
+    }
+
+    while (!mPendingFolderLinks.isEmpty())
+    {
+        const int session(getFreeFolderSession());
+        if (session < 0)
+        {
+            break;
+        }
+
+        send(mPendingFolderLinks.dequeue(), now, session);
+    }
+
+    // SetManager fetches one set at a time, sending more would only make them time out
+    if (mSetRequestsInFlight == 0 && !mPendingSetLinks.isEmpty())
+    {
+        send(mPendingSetLinks.dequeue(), now);
+    }
+}
+
+void LinkInfoScheduler::clear()
+{
+    // The folder sessions keep their requests until the SDK answers them
+    mRequests.clear();
+    mRequestIdByLink.clear();
+    mPendingFileLinks.clear();
+    mPendingFolderLinks.clear();
+    mPendingSetLinks.clear();
+    mFileRequestsInFlight = 0;
+    mSetRequestsInFlight = 0;
+}
+
+bool LinkInfoScheduler::contains(quint64 requestId) const
+{
+    return mRequests.contains(requestId);
+}
+
+bool LinkInfoScheduler::isEmpty() const
+{
+    return mRequests.isEmpty();
+}
+
+QString LinkInfoScheduler::getLink(quint64 requestId) const
+{
+    return mRequests.value(requestId).link;
+}
+
+quint64 LinkInfoScheduler::findSentSetRequest(const QString& link) const
+{
+    for (auto it = mRequests.cbegin(); it != mRequests.cend(); ++it)
+    {
+        if (it->type == LinkType::SET && it->sent && it->link == link)
+        {
+            return it.key();
+        }
+    }
+
+    return 0;
+}
+
+void LinkInfoScheduler::onFolderLoggedIn(quint64 requestId)
+{
+    auto requestIt(mRequests.find(requestId));
+    if (requestIt != mRequests.end())
+    {
+        requestIt->deadline = 0;
+    }
+}
+
+void LinkInfoScheduler::releaseFolderSession(int session, quint64 requestId)
+{
+    if (session >= 0 && session < mFolderSessions.size() && mFolderSessions[session] == requestId)
+    {
+        mFolderSessions[session] = 0;
+    }
+}
+
+LinkInfoScheduler::Request LinkInfoScheduler::finish(quint64 requestId)
+{
+    const auto request(mRequests.take(requestId));
+    if (request.sent)
+    {
+        if (request.type == LinkType::FILE)
+        {
+            mFileRequestsInFlight--;
+        }
+        else if (request.type == LinkType::SET)
+        {
+            mSetRequestsInFlight--;
+        }
+    }
+
+    return request;
+}
+
+QList<LinkInfoScheduler::Request> LinkInfoScheduler::takeExpired(qint64 now)
+{
+    QList<quint64> expiredRequestIds;
+    for (auto it = mRequests.cbegin(); it != mRequests.cend(); ++it)
+    {
+        if (it->deadline > 0 && it->deadline <= now)
+        {
+            expiredRequestIds.append(it.key());
+        }
+    }
+
+    QList<Request> expiredRequests;
+    for (auto requestId : expiredRequestIds)
+    {
+        expiredRequests.append(finish(requestId));
+    }
+
+    return expiredRequests;
+}
+
+int LinkInfoScheduler::getFileRequestsInFlight() const
+{
+    return mFileRequestsInFlight;
+}
+
+int LinkInfoScheduler::getBusyFolderSessions() const
+{
+    return static_cast<int>(std::count_if(mFolderSessions.cbegin(),
+                                          mFolderSessions.cend(),
+                                          [](quint64 requestId)
+                                          {
+                                              return requestId != 0;
+                                          }));
+}
+
+void LinkInfoScheduler::send(quint64 requestId, qint64 now, int session)
+{
+    auto& request(mRequests[requestId]);
+    request.sent = true;
+    request.deadline = now + mTimeoutMs;
+
+    // The handlers may add or finish requests
+    const QString link(request.link);
+    switch (request.type)
+    {
+        case LinkType::FOLDER:
+            mFolderSessions[session] = requestId;
+            mHandlers.sendFolderRequest(requestId, link, session);
+            break;
+        case LinkType::SET:
+            mSetRequestsInFlight++;
+            mHandlers.sendSetRequest(requestId, link);
+            break;
+        case LinkType::FILE:
+        default:
+            mFileRequestsInFlight++;
+            mHandlers.sendFileRequest(requestId, link);
+            break;
+    }
+}
+
+int LinkInfoScheduler::getFreeFolderSession()
+{
+    for (int session = 0; session < mFolderSessions.size(); session++)
+    {
+        if (mFolderSessions[session] == 0)
+        {
+            return session;
+        }
+    }
+
+    if (mFolderSessions.size() < mMaxFolderSessions &&
+        mHandlers.openFolderSession(mFolderSessions.size()))
+    {
+        mFolderSessions.append(0);
+        return mFolderSessions.size() - 1;
+    }
+
+    return -1;
+}
@@ -0,0 +1,102 @@
+#ifndef LINK_INFO_SCHEDULER_H
+#define LINK_INFO_SCHEDULER_H
+
+#include <QHash>
+#include <QList>
+#include <QQueue>
+#include <QString>
+#include <QVector>
+
+#include <functional>
+
+//!
+//! \brief Decides which link info requests of LinkProcessor are in flight.
+//!
+//! Every distinct link gets one request, shared by its duplicates. File links are sent in a
+//! bounded window, folder links need a folder session each (login + fetch nodes) and set links
+//! are sent one at a time, as SetManager fetches them one by one.
+//!
+//! A request not answered before its deadline is given up. Its folder session, if any, stays busy
+//! until the SDK answers it: a session logs in to one folder at a time. Fetching the nodes of a
+//! folder has no deadline, a large folder takes as long as it takes once its link is valid.
+//!
+class LinkInfoScheduler
+{
+public:
+    enum class LinkType
+    {
+        FILE,
+        FOLDER,
+        SET
+    };
+
+    struct Request
+    {
+        QString link;
+        LinkType type = LinkType::FILE;
+        QList<int> indexes;
+        bool sent = false;
+        qint64 deadline = 0; // 0 while not waited for
+    };
+
+    struct Handlers
+    {
+        std::function<void(quint64 requestId, const QString& link)> sendFileRequest;
+        std::function<void(quint64 requestId, const QString& link, int session)> sendFolderRequest;
+        std::function<void(quint64 requestId, const QString& link)> sendSetRequest;
+        // Makes the folder session with that index available, returns false if it can't
+        std::function<bool(int session)> openFolderSession;
+    };
+
+    LinkInfoScheduler(int maxFileRequests,
+                      int maxFolderSessions,
+                      qint64 timeoutMs,
+                      Handlers handlers);
+
+    // Queues the link at index, duplicated links share the request of the first one
+    void addLink(const QString& link, LinkType type, int index);
+    // Sends the queued requests there is room for
+    void dispatch(qint64 now);
+    // Forgets every request, their answers are ignored when they arrive
+    void clear();
+
+    bool contains(quint64 requestId) const;
+    bool isEmpty() const;
+    QString getLink(quint64 requestId) const;
+    // The set request waiting for the answer of link, 0 if none
+    quint64 findSentSetRequest(const QString& link) const;
+
+    // The folder is logged in, fetching its nodes has no deadline
+    void onFolderLoggedIn(quint64 requestId);
+    // The SDK answered the last request of the session, which can take another link
+    void releaseFolderSession(int session, quint64 requestId);
+    // Removes the answered request
+    Request finish(quint64 requestId);
+    // Removes the requests not answered before their deadline
+    QList<Request> takeExpired(qint64 now);
+
+    int getFileRequestsInFlight() const;
+    int getBusyFolderSessions() const;
+
+private:
+    void send(quint64 requestId, qint64 now, int session = -1);
+    int getFreeFolderSession();
+
+    int mMaxFileRequests;
+    int mMaxFolderSessions;
+    qint64 mTimeoutMs;
+    Handlers mHandlers;
+
+    QHash<quint64, Request> mRequests;
+    QHash<QString, quint64> mRequestIdByLink;
+    QQueue<quint64> mPendingFileLinks;
+    QQueue<quint64> mPendingFolderLinks;
+    QQueue<quint64> mPendingSetLinks;
+    quint64 mLastRequestId;
+    int mFileRequestsInFlight;
+    int mSetRequestsInFlight;
+    // Request each folder session is busy with, 0 if it is free
+    QVector<quint64> mFolderSessions;
+};
+
+#endif // LINK_INFO_SCHEDULER_H
@@ -5,6 +5,7 @@
 #include "Preferences.h"
 #include "RequestListenerManager.h"
 
+#include <QDateTime>
 #include <QDir>
 
 using namespace mega;
@@ -20,10 +21,32 @@ LinkProcessor::LinkProcessor(const QStringList& linkList, MegaApi* megaApi, Mega
     , mLinkList(linkList)
     , mImportParentFolder(mega::INVALID_HANDLE)
     , mDelegateTransferListener(std::make_shared<QTMegaTransferListener>(megaApi, this))
-    , mCurrentIndex(0)
+    , mFolderApis({megaApiFolders}) // The rest of folder link sessions are created on demand
+    , mLinkInfoScheduler(MAX_FILE_LINK_REQUESTS,
+                         MAX_FOLDER_LINK_SESSIONS,
+                         LINK_INFO_TIMEOUT_MS,
+                         {[this](quint64 requestId, const QString& link)
+                          {
+                              sendFileLinkRequest(requestId, link);
+                          },
+                          [this](quint64 requestId, const QString& link, int session)
+                          {
+                              sendFolderLinkRequest(requestId, link, session);
+                          },
+                          [this](quint64 requestId, const QString& link)
+                          {
+                              sendSetLinkRequest(requestId, link);
+                          },
+                          [this](int session)
+                          {
+                              return openFolderSession(session);
+                          }})
 {
     resetAndSetLinkList(linkList);
 
+    mLinkInfoTimeoutTimer.setInterval(1000);
+    connect(&mLinkInfoTimeoutTimer, &QTimer::timeout, this, &LinkProcessor::onLinkInfoTimeout);
+
     // Register for SDK Request callbacks
     mDelegateListener = RequestListenerManager::instance().registerAndGetFinishListener(this);
 }
@@ -34,9 +57,11 @@ LinkProcessor::~LinkProcessor()
 
 void LinkProcessor::resetAndSetLinkList(const QStringList& linkList)
 {
+    cancelLinkInfoRequests();
+
     mLinkObjects.clear();
-    mCurrentIndex = 0;
     mLinkList = linkList;
+    mResolvedLinks.fill(false, linkList.size());
 
     for (int i = 0; i < linkList.size(); i++)
     {
@@ -83,18 +108,6 @@ void LinkProcessor::sendLinkInfoAvailableSignal(int index)
                              linkObject->showFolderIcon());
 }
 
-void LinkProcessor::continueOrFinishLinkInfoReq()
-{
-    if (mCurrentIndex == mLinkList.size())
-    {
-        emit onLinkInfoRequestFinish();
-    }
-    else
-    {
-        requestLinkInfo();
-    }
-}
-
 void LinkProcessor::createInvalidLinkObject(int index, int error, const QString& name)
 {
     if (!isValidIndex(mLinkObjects, index)) { return; }
@@ -173,42 +186,10 @@ QString LinkProcessor::getReasonForExpiredLink(MegaRequest* request, MegaError*
 
 void LinkProcessor::onRequestFinish(MegaRequest* request, MegaError* e)
 {
-    const int error = e->getErrorCode();
+    Q_UNUSED(e)
 
     switch (request->getType())
     {
-    case MegaRequest::TYPE_GET_PUBLIC_NODE:
-    {
-        if (!isValidIndex(mLinkObjects, mCurrentIndex)) { return; }
-
-        if (error != MegaError::API_OK)
-        {
-            // Invalid Link
-            createInvalidLinkObject(mCurrentIndex, error, getReasonForExpiredLink(request, e));
-        }
-        else    // API_OK
-        {
-            MegaNode* node = request->getPublicMegaNode();
-
-            if (!node)
-            {
-                // Invalid Link
-                createInvalidLinkObject(mCurrentIndex, error, getReasonForExpiredLink(request, e));
-            }
-            else    // Valid Link
-            {
-                mLinkObjects[mCurrentIndex] = std::make_shared<LinkNode>(mMegaApi,
-                                                                         MegaNodeSPtr(node),
-                                                                         mLinkList[mCurrentIndex]);
-            }
-        }
-
-        mCurrentIndex++;
-        sendLinkInfoAvailableSignal(mCurrentIndex - 1);
-        continueOrFinishLinkInfoReq();
-        break;
-    }
-
     // Response to MegaApi::createFolder() request
     case MegaRequest::TYPE_CREATE_FOLDER:
     {
@@ -228,83 +209,6 @@ void LinkProcessor::onRequestFinish(MegaRequest* request, MegaError* e)
         processNextTransfer();
         break;
 
-    case MegaRequest::TYPE_LOGIN:
-    {
-        if (!isValidIndex(mLinkObjects, mCurrentIndex)) { return; }
-
-        if (error == MegaError::API_OK)
-        {
-            mMegaApiFolders->fetchNodes(mDelegateListener.get());
-        }
-        else
-        {
-            createInvalidLinkObject(mCurrentIndex, error, getReasonForExpiredLink(request, e));
-            mCurrentIndex++;
-            sendLinkInfoAvailableSignal(mCurrentIndex - 1);
-            continueOrFinishLinkInfoReq();
-        }
-        break;
-    }
-
-    case MegaRequest::TYPE_FETCH_NODES:
-    {
-        if (!isValidIndex(mLinkObjects, mCurrentIndex)) { return; }
-
-        if (error == MegaError::API_OK)
-        {
-            std::unique_ptr<MegaNode> rootNode(nullptr);
-            QString currentStr = mLinkList[mCurrentIndex];
-            QString splitSeparator;
-
-            if (currentStr.count(QChar::fromLatin1('!')) == 3)
-            {
-                splitSeparator = QString::fromUtf8("!");
-            }
-            else if (currentStr.count(QChar::fromLatin1('!')) == 2
-                     && currentStr.count(QChar::fromLatin1('?')) == 1)
-            {
-                splitSeparator = QString::fromUtf8("?");
-            }
-            else if (currentStr.count(QString::fromUtf8("/folder/")) == 2)
-            {
-                splitSeparator = QString::fromUtf8("/folder/");
-            }
-            else if (currentStr.count(QString::fromUtf8("/folder/")) == 1
-                     && currentStr.count(QString::fromUtf8("/file/")) == 1)
-            {
-                splitSeparator = QString::fromUtf8("/file/");
-            }
-
-            if (splitSeparator.isEmpty())
-            {
-                rootNode.reset(mMegaApiFolders->getRootNode());
-            }
-            else
-            {
-                QStringList linkparts = currentStr.split(splitSeparator, Qt::KeepEmptyParts);
-                MegaHandle handle = MegaApi::base64ToHandle(linkparts.last().toUtf8().constData());
-                rootNode.reset(mMegaApiFolders->getNodeByHandle(handle));
-            }
-
-            Preferences::instance()->setLastPublicHandle(request->getNodeHandle(), MegaApi::AFFILIATE_TYPE_FILE_FOLDER);
-            mega::MegaNode* node = mMegaApiFolders->authorizeNode(rootNode.get());
-            mLinkObjects[mCurrentIndex] = std::make_shared<LinkNode>(mMegaApi,
-                                                                     MegaNodeSPtr(node),
-                                                                     mLinkList[mCurrentIndex]);
-        }
-        else
-        {
-            // Invalid Link
-            createInvalidLinkObject(mCurrentIndex, error, getReasonForExpiredLink(request, e));
-        }
-
-        mCurrentIndex++;
-        sendLinkInfoAvailableSignal(mCurrentIndex - 1);
-        continueOrFinishLinkInfoReq();
-
-        break;
-    }
-
     default:
         break;
     }
@@ -329,30 +233,322 @@ void LinkProcessor::addTransfersAndStartIfNotStartedYet(LinkTransferType transfe
     }
 }
 
+void LinkProcessor::setFolderSessionFactory(FolderSessionFactory factory)
+{
+    mFolderSessionFactory = factory;
+}
+
+//!
+//! \brief LinkProcessor::requestLinkInfo
+//! \Requests the info of every link at once: file links are resolved in a bounded window,
+//! \folder links in a small pool of folder sessions and set links one by one through
+//! \SetManager. Results arrive out of order, each one through onLinkInfoAvailable, and
+//! \onLinkInfoRequestFinish is emitted when there are no links left.
+//!
 void LinkProcessor::requestLinkInfo()
 {
-    if (!isValidIndex(mLinkList, mCurrentIndex)) { return; }
+    cancelLinkInfoRequests();
+    mResolvedLinks.fill(false, mLinkList.size());
+
+    for (int index = 0; index < mLinkList.size(); index++)
+    {
+        const QString& link(mLinkList.at(index));
+        mLinkInfoScheduler.addLink(link, getLinkInfoType(link), index);
+    }
+
+    if (mLinkInfoScheduler.isEmpty()) { return; }
+
+    mLinkInfoTimeoutTimer.start();
+    mLinkInfoScheduler.dispatch(QDateTime::currentMSecsSinceEpoch());
+}
 
-    const QString link = mLinkList[mCurrentIndex];
+LinkInfoScheduler::LinkType LinkProcessor::getLinkInfoType(const QString& link) const
+{
     if (link.startsWith(Preferences::BASE_URL + QString::fromUtf8("/#F!")) ||
         link.startsWith(Preferences::BASE_URL + QString::fromUtf8("/folder/")))
     {
-        std::unique_ptr<char []> authToken(mMegaApi->getAccountAuth());
-        if (authToken)
+        return LinkInfoScheduler::LinkType::FOLDER;
+    }
+    else if (link.startsWith(Preferences::BASE_URL + QString::fromUtf8("/collection/")))
+    {
+        return LinkInfoScheduler::LinkType::SET;
+    }
+
+    return LinkInfoScheduler::LinkType::FILE;
+}
+
+//!
+//! \brief LinkProcessor::cancelLinkInfoRequests
+//! \Forgets the requests in progress: their callbacks are ignored when they arrive
+//!
+void LinkProcessor::cancelLinkInfoRequests()
+{
+    mLinkInfoTimeoutTimer.stop();
+    mLinkInfoScheduler.clear();
+}
+
+void LinkProcessor::sendFileLinkRequest(quint64 requestId, const QString& link)
+{
+    auto listener = RequestListenerManager::instance().registerAndGetCustomFinishListener(
+        this,
+        [this, requestId](MegaRequest* request, MegaError* e)
         {
-            mMegaApiFolders->setAccountAuth(authToken.get());
-        }
+            onFileLinkRequestFinish(requestId, request, e);
+        });
+
+    mMegaApi->getPublicNode(link.toUtf8().constData(), listener.get());
+}
 
-        mMegaApiFolders->loginToFolder(link.toUtf8().constData(), mDelegateListener.get());
+void LinkProcessor::sendFolderLinkRequest(quint64 requestId, const QString& link, int session)
+{
+    MegaApi* folderApi(mFolderApis[session]);
+    std::unique_ptr<char []> authToken(mMegaApi->getAccountAuth());
+    if (authToken)
+    {
+        folderApi->setAccountAuth(authToken.get());
     }
-    else if (link.startsWith(Preferences::BASE_URL + QString::fromUtf8("/collection/")))
+
+    auto listener = RequestListenerManager::instance().registerAndGetCustomFinishListener(
+        this,
+        [this, requestId, session](MegaRequest* request, MegaError* e)
+        {
+            onFolderLinkLoginFinish(requestId, session, request, e);
+        });
+
+    folderApi->loginToFolder(link.toUtf8().constData(), listener.get());
+}
+
+void LinkProcessor::sendSetLinkRequest(quint64 requestId, const QString& link)
+{
+    Q_UNUSED(requestId)
+
+    emit requestFetchSetFromLink(link);
+}
+
+bool LinkProcessor::openFolderSession(int session)
+{
+    if (isValidIndex(mFolderApis, session))
+    {
+        return true;
+    }
+
+    MegaApi* folderApi(mFolderSessionFactory ? mFolderSessionFactory() : nullptr);
+    if (!folderApi)
+    {
+        return false;
+    }
+
+    mFolderApis.append(folderApi);
+    return true;
+}
+
+//!
+//! \brief LinkProcessor::onFolderSessionAnswered
+//! \The SDK answered the request of a folder session whose link is no longer waited for (it
+//! \timed out or the link list was reset): the session is free for the next folder link.
+//!
+void LinkProcessor::onFolderSessionAnswered(int session, quint64 requestId)
+{
+    mLinkInfoScheduler.releaseFolderSession(session, requestId);
+    mLinkInfoScheduler.dispatch(QDateTime::currentMSecsSinceEpoch());
+}
+
+void LinkProcessor::onFileLinkRequestFinish(quint64 requestId, MegaRequest* request, MegaError* e)
+{
+    // Timed out or the link list was reset meanwhile
+    if (!mLinkInfoScheduler.contains(requestId)) { return; }
+
+    const int error = e->getErrorCode();
+    MegaNodeSPtr node((error == MegaError::API_OK) ? request->getPublicMegaNode() : nullptr);
+    const QString reason(node ? QString() : getReasonForExpiredLink(request, e));
+
+    finishLinkInfoRequest(requestId,
+                          [this, &node, error, &reason](int index)
+                          {
+                              if (node)
+                              {
+                                  mLinkObjects[index] =
+                                      std::make_shared<LinkNode>(mMegaApi, node, mLinkList[index]);
+                              }
+                              else
+                              {
+                                  // Invalid Link
+                                  createInvalidLinkObject(index, error, reason);
+                              }
+                          });
+}
+
+void LinkProcessor::onFolderLinkLoginFinish(quint64 requestId,
+                                            int session,
+                                            MegaRequest* request,
+                                            MegaError* e)
+{
+    if (!mLinkInfoScheduler.contains(requestId))
+    {
+        onFolderSessionAnswered(session, requestId);
+        return;
+    }
+
+    const int error = e->getErrorCode();
+    if (error == MegaError::API_OK)
+    {
+        auto listener = RequestListenerManager::instance().registerAndGetCustomFinishListener(
+            this,
+            [this, requestId, session](MegaRequest* fetchRequest, MegaError* fetchError)
+            {
+                onFolderLinkFetchNodesFinish(requestId, session, fetchRequest, fetchError);
+            });
+
+        mLinkInfoScheduler.onFolderLoggedIn(requestId);
+        mFolderApis[session]->fetchNodes(listener.get());
+        return;
+    }
+
+    const QString reason(getReasonForExpiredLink(request, e));
+    mLinkInfoScheduler.releaseFolderSession(session, requestId);
+    finishLinkInfoRequest(requestId,
+                          [this, error, &reason](int index)
+                          {
+                              createInvalidLinkObject(index, error, reason);
+                          });
+}
+
+void LinkProcessor::onFolderLinkFetchNodesFinish(quint64 requestId,
+                                                 int session,
+                                                 MegaRequest* request,
+                                                 MegaError* e)
+{
+    if (!mLinkInfoScheduler.contains(requestId))
     {
-        emit requestFetchSetFromLink(link);
+        onFolderSessionAnswered(session, requestId);
+        return;
+    }
+
+    const int error = e->getErrorCode();
+    MegaNodeSPtr node;
+    QString reason;
+
+    if (error == MegaError::API_OK)
+    {
+        MegaApi* folderApi(mFolderApis[session]);
+        auto rootNode(getFolderLinkRootNode(folderApi, mLinkInfoScheduler.getLink(requestId)));
+
+        Preferences::instance()->setLastPublicHandle(request->getNodeHandle(), MegaApi::AFFILIATE_TYPE_FILE_FOLDER);
+        node.reset(folderApi->authorizeNode(rootNode.get()));
     }
     else
     {
-        mMegaApi->getPublicNode(link.toUtf8().constData(), mDelegateListener.get());
+        reason = getReasonForExpiredLink(request, e);
+    }
+
+    mLinkInfoScheduler.releaseFolderSession(session, requestId);
+    finishLinkInfoRequest(requestId,
+                          [this, &node, error, &reason](int index)
+                          {
+                              if (error == MegaError::API_OK)
+                              {
+                                  mLinkObjects[index] =
+                                      std::make_shared<LinkNode>(mMegaApi, node, mLinkList[index]);
+                              }
+                              else
+                              {
+                                  // Invalid Link
+                                  createInvalidLinkObject(index, error, reason);
+                              }
+                          });
+}
+
+MegaNodeSPtr LinkProcessor::getFolderLinkRootNode(MegaApi* folderApi, const QString& link) const
+{
+    QString splitSeparator;
+
+    if (link.count(QChar::fromLatin1('!')) == 3)
+    {
+        splitSeparator = QString::fromUtf8("!");
+    }
+    else if (link.count(QChar::fromLatin1('!')) == 2
+             && link.count(QChar::fromLatin1('?')) == 1)
+    {
+        splitSeparator = QString::fromUtf8("?");
+    }
+    else if (link.count(QString::fromUtf8("/folder/")) == 2)
+    {
+        splitSeparator = QString::fromUtf8("/folder/");
     }
+    else if (link.count(QString::fromUtf8("/folder/")) == 1
+             && link.count(QString::fromUtf8("/file/")) == 1)
+    {
+        splitSeparator = QString::fromUtf8("/file/");
+    }
+
+    if (splitSeparator.isEmpty())
+    {
+        return MegaNodeSPtr(folderApi->getRootNode());
+    }
+
+    QStringList linkparts = link.split(splitSeparator, Qt::KeepEmptyParts);
+    MegaHandle handle = MegaApi::base64ToHandle(linkparts.last().toUtf8().constData());
+    return MegaNodeSPtr(folderApi->getNodeByHandle(handle));
+}
+
+//!
+//! \brief LinkProcessor::finishLinkInfoRequest
+//! \param requestId: the finished request
+//! \param setLinkObject: creates the LinkObject of every link index sharing the request
+//! \Sends the info of the resolved links and dispatches the pending ones, or
+//! \notifies that there are no links left.
+//!
+void LinkProcessor::finishLinkInfoRequest(quint64 requestId,
+                                          const std::function<void(int)>& setLinkObject)
+{
+    setLinkInfo(mLinkInfoScheduler.finish(requestId), setLinkObject);
+    continueOrFinishLinkInfoRequests();
+}
+
+void LinkProcessor::setLinkInfo(const LinkInfoScheduler::Request& linkRequest,
+                                const std::function<void(int)>& setLinkObject)
+{
+    for (auto index : linkRequest.indexes)
+    {
+        if (!isValidIndex(mLinkObjects, index)) { continue; }
+
+        setLinkObject(index);
+        mResolvedLinks[index] = true;
+        sendLinkInfoAvailableSignal(index);
+    }
+}
+
+void LinkProcessor::continueOrFinishLinkInfoRequests()
+{
+    if (mLinkInfoScheduler.isEmpty())
+    {
+        mLinkInfoTimeoutTimer.stop();
+        emit onLinkInfoRequestFinish();
+    }
+    else
+    {
+        mLinkInfoScheduler.dispatch(QDateTime::currentMSecsSinceEpoch());
+    }
+}
+
+void LinkProcessor::onLinkInfoTimeout()
+{
+    // Folder sessions stay busy until the SDK answers the expired logins
+    const auto expiredRequests(
+        mLinkInfoScheduler.takeExpired(QDateTime::currentMSecsSinceEpoch()));
+    if (expiredRequests.isEmpty()) { return; }
+
+    for (const auto& linkRequest : expiredRequests)
+    {
+        MegaApi::log(MegaApi::LOG_LEVEL_WARNING, "Timeout requesting public link info");
+        setLinkInfo(linkRequest,
+                    [this](int index)
+                    {
+                        createInvalidLinkObject(index, MegaError::API_ETEMPUNAVAIL);
+                    });
+    }
+
+    continueOrFinishLinkInfoRequests();
 }
 
 // ----------------------------------------------------------------------------
@@ -362,13 +558,17 @@ void LinkProcessor::requestLinkInfo()
 // ----------------------------------------------------------------------------
 void LinkProcessor::onFetchSetFromLink(const AlbumCollection& collection)
 {
-    if (mCurrentIndex >= mLinkObjects.size()) { return; }
+    // SetManager answers in order, but the link tells which request this is
+    const quint64 requestId(mLinkInfoScheduler.findSentSetRequest(collection.link));
 
-    mLinkObjects[mCurrentIndex] = std::make_shared<LinkSet>(mMegaApi, collection);
-    mCurrentIndex++;
+    // The request timed out or the link list was reset meanwhile
+    if (!requestId) { return; }
 
-    sendLinkInfoAvailableSignal(mCurrentIndex - 1);
-    continueOrFinishLinkInfoReq();
+    finishLinkInfoRequest(requestId,
+                          [this, &collection](int index)
+                          {
+                              mLinkObjects[index] = std::make_shared<LinkSet>(mMegaApi, collection);
+                          });
 }
 
 void LinkProcessor::onSetDownloadFinished(const QString& setName,
@@ -686,13 +886,15 @@ void LinkProcessor::onLinkSelected(int index, bool selected)
 
 //!
 //! \brief LinkProcessor::refreshLinkInfo
-//! \I'm not sure why this is required, but copied this
-//! \mechanism from the previous developer...
+//! \Sends again the info of every link resolved so far
 //!
 void LinkProcessor::refreshLinkInfo()
 {
-    for (int i = 0; i < mCurrentIndex; i++)
+    for (int i = 0; i < mResolvedLinks.size(); i++)
     {
-        sendLinkInfoAvailableSignal(i);
+        if (mResolvedLinks[i])
+        {
+            sendLinkInfoAvailableSignal(i);
+        }
     }
 }
@@ -1,6 +1,7 @@
 #ifndef LINKPROCESSOR_H
 #define LINKPROCESSOR_H
 
+#include "LinkInfoScheduler.h"
 #include "LinkObject.h"
 #include "megaapi.h"
 #include "QTMegaTransferListener.h"
@@ -12,7 +13,10 @@
 #include <QQueue>
 #include <QSharedPointer>
 #include <QStringList>
+#include <QTimer>
+#include <QVector>
 
+#include <functional>
 #include <memory>
 
 namespace mega
@@ -38,6 +42,17 @@ class LinkProcessor: public QObject, public mega::MegaTransferListener
     Q_OBJECT
 
 public:
+    // Creates an extra session (configured like megaApiFolders) to resolve folder links
+    using FolderSessionFactory = std::function<mega::MegaApi*()>;
+
+    // Public node requests in flight at the same time
+    static constexpr int MAX_FILE_LINK_REQUESTS = 8;
+    // Folder links need a session each (login + fetch nodes), including megaApiFolders
+    static constexpr int MAX_FOLDER_LINK_SESSIONS = 3;
+    // Time a link is waited for once its request has been sent. It does not apply to fetching
+    // the nodes of a folder link, which is only done once the link is known to be valid.
+    static constexpr int LINK_INFO_TIMEOUT_MS = 30000;
+
     LinkProcessor(mega::MegaApi* megaApi, mega::MegaApi* megaApiFolders);
     LinkProcessor(const QStringList& linkList, mega::MegaApi* megaApi, mega::MegaApi* megaApiFolders);
     virtual ~LinkProcessor();
@@ -50,6 +65,7 @@ public:
     void importLinks(const QString& nodePath);
     mega::MegaHandle getImportParentFolder();
     void downloadLinks(const QString& localPath);
+    void setFolderSessionFactory(FolderSessionFactory factory);
 
     void onRequestFinish(mega::MegaRequest *request, mega::MegaError* e);
 
@@ -84,6 +100,9 @@ public slots:
     void onLinkSelected(int index, bool selected);
     void refreshLinkInfo();
 
+private slots:
+    void onLinkInfoTimeout();
+
 private:
     template <typename Container>
     inline bool isValidIndex(const Container& container, int index) const
@@ -103,7 +122,29 @@ private:
 
     inline bool isLinkObjectValid(int index) const;
     void sendLinkInfoAvailableSignal(int index);
-    void continueOrFinishLinkInfoReq();
+
+    // Link info
+    LinkInfoScheduler::LinkType getLinkInfoType(const QString& link) const;
+    void cancelLinkInfoRequests();
+    void sendFileLinkRequest(quint64 requestId, const QString& link);
+    void sendFolderLinkRequest(quint64 requestId, const QString& link, int session);
+    void sendSetLinkRequest(quint64 requestId, const QString& link);
+    bool openFolderSession(int session);
+    void onFolderSessionAnswered(int session, quint64 requestId);
+    void onFileLinkRequestFinish(quint64 requestId, mega::MegaRequest* request, mega::MegaError* e);
+    void onFolderLinkLoginFinish(quint64 requestId,
+                                 int session,
+                                 mega::MegaRequest* request,
+                                 mega::MegaError* e);
+    void onFolderLinkFetchNodesFinish(quint64 requestId,
+                                      int session,
+                                      mega::MegaRequest* request,
+                                      mega::MegaError* e);
+    MegaNodeSPtr getFolderLinkRootNode(mega::MegaApi* folderApi, const QString& link) const;
+    void finishLinkInfoRequest(quint64 requestId, const std::function<void(int)>& setLinkObject);
+    void setLinkInfo(const LinkInfoScheduler::Request& linkRequest,
+                     const std::function<void(int)>& setLinkObject);
+    void continueOrFinishLinkInfoRequests();
     void createInvalidLinkObject(int index, int error, const QString& name = QString::fromUtf8(""));
 
     void addTransfersAndStartIfNotStartedYet(LinkTransferType transferType);
@@ -119,8 +160,14 @@ private:
     std::shared_ptr<mega::QTMegaRequestListener> mDelegateListener;
     std::shared_ptr<mega::QTMegaTransferListener> mDelegateTransferListener;
     uint32_t mRequestCounter;
-    int mCurrentIndex;
     QQueue<LinkTransfer> mTransferQueue;
+
+    QVector<bool> mResolvedLinks;
+    // Indexed by folder session, megaApiFolders is the first one
+    QVector<mega::MegaApi*> mFolderApis;
+    FolderSessionFactory mFolderSessionFactory;
+    LinkInfoScheduler mLinkInfoScheduler;
+    QTimer mLinkInfoTimeoutTimer;
 };
 
 #endif // LINKPROCESSOR_H
@@ -0,0 +1,218 @@
+#include "LocalFolderStatsWalker.h"
+
+#include "Utilities.h"
+
+#include <QDir>
+#include <QDirIterator>
+#include <QFileInfo>
+
+namespace
+{
+constexpr int MAX_CACHED_FOLDERS = 1000;
+}
+
+LocalFolderStatsWalker::LocalFolderStatsWalker():
+    QObject(nullptr),
+    mCache(MAX_CACHED_FOLDERS)
+{
+    qRegisterMetaType<LocalFolderStats>("LocalFolderStats");
+}
+
+void LocalFolderStatsWalker::request(const QString& path, QObject* caller, Callback callback)
+{
+    auto folderKey(key(path));
+
+    if (auto cached = mCache.object(folderKey))
+    {
+        if (cached->folderModifiedTime == QFileInfo(folderKey).lastModified())
+        {
+            if (callback)
+            {
+                callback(cached->stats);
+            }
+            return;
+        }
+
+        mCache.remove(folderKey);
+    }
+
+    auto walkIt = mWalks.find(folderKey);
+    if (walkIt != mWalks.end() && walkIt->cancellation.isCancelled())
+    {
+        // Dropping the watcher discards the result of the cancelled walk
+        mWalks.erase(walkIt);
+        walkIt = mWalks.end();
+    }
+
+    if (walkIt == mWalks.end())
+    {
+        Walk newWalk;
+        newWalk.watcher = std::make_shared<QFutureWatcher<LocalFolderStats>>();
+        connect(newWalk.watcher.get(),
+                &QFutureWatcher<LocalFolderStats>::finished,
+                this,
+                [this, folderKey]()
+                {
+                    onWalkFinished(folderKey);
+                });
+
+        walkIt = mWalks.insert(folderKey, newWalk);
+
+        auto cancellation(newWalk.cancellation);
+        walkIt->watcher->setFuture(ThreadPoolSingleton::getInstance()->run(
+            ThreadPool::Priority::BACKGROUND,
+            [folderKey, cancellation]() -> LocalFolderStats
+            {
+                return walk(folderKey, cancellation);
+            }));
+    }
+
+    if (!caller)
+    {
+        walkIt->keepAlive = true;
+        return;
+    }
+
+    PendingCallback pending;
+    pending.caller = caller;
+    pending.callback = callback;
+    pending.destroyedConnection = connect(caller,
+                                          &QObject::destroyed,
+                                          this,
+                                          [this, folderKey, caller]()
+                                          {
+                                              removeCaller(folderKey, caller);
+                                          });
+    walkIt->callbacks.append(pending);
+}
+
+void LocalFolderStatsWalker::cancel(const QString& path, QObject* caller)
+{
+    removeCaller(key(path), caller);
+}
+
+void LocalFolderStatsWalker::invalidate(const QString& path)
+{
+    mCache.remove(key(path));
+}
+
+bool LocalFolderStatsWalker::isCached(const QString& path) const
+{
+    return mCache.contains(key(path));
+}
+
+QString LocalFolderStatsWalker::key(const QString& path)
+{
+    return QDir::cleanPath(QDir::fromNativeSeparators(path));
+}
+
+LocalFolderStats LocalFolderStatsWalker::walk(const QString& path,
+                                              const CancellationToken& cancellation)
+{
+    LocalFolderStats stats;
+
+    QFileInfo folderInfo(path);
+    if (path.isEmpty() || !folderInfo.exists())
+    {
+        return stats;
+    }
+
+    stats.readable = folderInfo.isReadable();
+    if (!stats.readable)
+    {
+        return stats;
+    }
+
+    QDirIterator it(path,
+                    QDir::Files | QDir::Dirs | QDir::NoDotAndDotDot | QDir::NoSymLinks |
+                        QDir::Hidden,
+                    QDirIterator::Subdirectories);
+
+    while (it.hasNext())
+    {
+        if (cancellation.isCancelled())
+        {
+            stats.cancelled = true;
+            break;
+        }
+
+        it.next();
+        const auto fileInfo(it.fileInfo());
+
+        if (fileInfo.isDir())
+        {
+            ++stats.folderCount;
+            continue;
+        }
+
+        ++stats.fileCount;
+        stats.size += fileInfo.size();
+
+        if (!fileInfo.isHidden())
+        {
+            auto modifiedTime(fileInfo.lastModified());
+            if (modifiedTime > stats.newestModifiedTime)
+            {
+                stats.newestModifiedTime = modifiedTime;
+            }
+        }
+    }
+
+    return stats;
+}
+
+void LocalFolderStatsWalker::onWalkFinished(const QString& key)
+{
+    auto walk = mWalks.take(key);
+    if (!walk.watcher)
+    {
+        return;
+    }
+
+    auto stats(walk.watcher->result());
+    if (!stats.cancelled)
+    {
+        auto cached = new CachedStats();
+        cached->stats = stats;
+        cached->folderModifiedTime = QFileInfo(key).lastModified();
+        mCache.insert(key, cached);
+    }
+
+    for (const auto& pending: qAsConst(walk.callbacks))
+    {
+        disconnect(pending.destroyedConnection);
+
+        if (pending.caller && pending.callback && !stats.cancelled)
+        {
+            pending.callback(stats);
+        }
+    }
+}
+
+void LocalFolderStatsWalker::removeCaller(const QString& key, QObject* caller)
+{
+    auto walkIt = mWalks.find(key);
+    if (walkIt == mWalks.end())
+    {
+        return;
+    }
+
+    auto& callbacks(walkIt->callbacks);
+    callbacks.erase(std::remove_if(callbacks.begin(),
+                                   callbacks.end(),
+                                   [this, caller](const PendingCallback& pending)
+                                   {
+                                       if (pending.caller.isNull() || pending.caller == caller)
+                                       {
+                                           disconnect(pending.destroyedConnection);
+                                           return true;
+                                       }
+                                       return false;
+                                   }),
+                    callbacks.end());
+
+    if (callbacks.isEmpty() && !walkIt->keepAlive)
+    {
+        walkIt->cancellation.cancel();
+    }
+}
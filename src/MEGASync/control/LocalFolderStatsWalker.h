@@ -0,0 +1,95 @@
+#ifndef LOCALFOLDERSTATSWALKER_H
+#define LOCALFOLDERSTATSWALKER_H
+
+#include "ThreadPool.h"
+
+#include <QCache>
+#include <QDateTime>
+#include <QFutureWatcher>
+#include <QHash>
+#include <QObject>
+#include <QPointer>
+
+#include <functional>
+#include <memory>
+
+struct LocalFolderStats
+{
+    bool readable = false;
+    bool cancelled = false;
+    qint64 size = 0;
+    // Newest modification time of the non-hidden files in the tree
+    QDateTime newestModifiedTime;
+    int fileCount = 0;
+    int folderCount = 0;
+};
+
+Q_DECLARE_METATYPE(LocalFolderStats)
+
+/*
+ * Computes size, newest modified time and file/folder counts of a local folder in a single
+ * recursive walk.
+ *
+ * Concurrent requests for the same path share the same walk. A walk is cancelled as soon as all
+ * its callers are gone (destroyed or cancelled). Results are kept until the folder modified time
+ * changes or the path is explicitly invalidated.
+ */
+class LocalFolderStatsWalker : public QObject
+{
+    Q_OBJECT
+
+public:
+    using Callback = std::function<void(const LocalFolderStats&)>;
+
+    static LocalFolderStatsWalker& instance()
+    {
+        static LocalFolderStatsWalker instance;
+        return instance;
+    }
+
+    LocalFolderStatsWalker(const LocalFolderStatsWalker&) = delete;
+    LocalFolderStatsWalker& operator=(const LocalFolderStatsWalker&) = delete;
+
+    // The callback is executed in the GUI thread, only if caller is still alive
+    void request(const QString& path, QObject* caller, Callback callback);
+    void cancel(const QString& path, QObject* caller);
+    void invalidate(const QString& path);
+
+    bool isCached(const QString& path) const;
+
+private:
+    LocalFolderStatsWalker();
+
+    struct PendingCallback
+    {
+        QPointer<QObject> caller;
+        Callback callback;
+        QMetaObject::Connection destroyedConnection;
+    };
+
+    struct Walk
+    {
+        CancellationToken cancellation;
+        std::shared_ptr<QFutureWatcher<LocalFolderStats>> watcher;
+        QList<PendingCallback> callbacks;
+        // Set when the walk was requested without caller (attributes initialization)
+        bool keepAlive = false;
+    };
+
+    struct CachedStats
+    {
+        LocalFolderStats stats;
+        QDateTime folderModifiedTime;
+    };
+
+    static QString key(const QString& path);
+    static LocalFolderStats walk(const QString& path, const CancellationToken& cancellation);
+
+    void onWalkFinished(const QString& key);
+    void removeCaller(const QString& key, QObject* caller);
+
+    QHash<QString, Walk> mWalks;
+    QCache<QString, CachedStats> mCache;
+};
+
+#endif // LOCALFOLDERSTATSWALKER_H
@@ -1,192 +1,196 @@
 #include "MergeMEGAFolders.h"
 
-#include "MegaApiSynchronizedRequest.h"
+#include "FolderNameIndex.h"
 #include "MegaApplication.h"
 #include "MoveToMEGABin.h"
+#include "RequestListenerManager.h"
 #include "Utilities.h"
 
+#include <QEventLoop>
+
+namespace
+{
+// The names of the next conflicts are looked up again with the node moved
+void invalidateFolderNames(const MergeMEGAFolders::Operation& operation)
+{
+    auto& folderNameIndex(FolderNameIndex::instance());
+    folderNameIndex.invalidate(operation.node->getParentHandle());
+    if (operation.targetFolder)
+    {
+        folderNameIndex.invalidate(operation.targetFolder->getHandle());
+    }
+}
+}
+
 std::shared_ptr<mega::MegaError> MergeMEGAFolders::merge(mega::MegaNode* folderTarget,
                                                          mega::MegaNode* folderToMerge,
                                                          ActionForDuplicates action)
 {
-    std::shared_ptr<mega::MegaError> error(nullptr);
+    auto mergePlan(plan(folderTarget, folderToMerge, action));
+    auto result(execute(mergePlan));
 
-    if (folderTarget && folderToMerge)
-    {
-        error = performMerge(folderTarget, folderToMerge, action);
-    }
-    else if (folderTarget)
-    {
-        std::unique_ptr<mega::MegaNode> parentNode(
-            MegaSyncApp->getMegaApi()->getNodeByHandle(folderTarget->getParentHandle()));
-        if (parentNode)
-        {
-            QString targetNodeName(getNodeName(folderTarget));
+    logError(result.error);
 
-            std::unique_ptr<mega::MegaNodeList> folderToMergeNodes(
-                MegaSyncApp->getMegaApi()->getChildren(parentNode.get()));
-            for (int index = 0; index < folderToMergeNodes->size(); ++index)
-            {
-                auto node(folderToMergeNodes->get(index));
-                QString checkNodeName(getNodeName(node));
-                if (targetNodeName.compare(checkNodeName) == 0 &&
-                    node->getHandle() != folderTarget->getHandle())
-                {
-                    error = performMerge(folderTarget, node, action);
-                    if (error)
-                    {
-                        break;
-                    }
-                }
-            }
-        }
-    }
+    return result.error;
+}
 
-    logError(error);
+MergeMEGAFolders::MergeMEGAFolders(ActionForDuplicates action, const NodeSource& nodeSource):
+    mAction(action),
+    mNodeSource(nodeSource)
+{}
+
+// ----------------------------------------------------------------------------
+//
+// PLAN
+//
+// ----------------------------------------------------------------------------
+MergeMEGAFolders::Plan MergeMEGAFolders::plan(mega::MegaNode* folderTarget,
+                                              mega::MegaNode* folderToMerge,
+                                              ActionForDuplicates action)
+{
+    return plan(folderTarget, folderToMerge, action, getAppNodeSource());
+}
 
-    return error;
+MergeMEGAFolders::Plan MergeMEGAFolders::plan(mega::MegaNode* folderTarget,
+                                              mega::MegaNode* folderToMerge,
+                                              ActionForDuplicates action,
+                                              const NodeSource& nodeSource)
+{
+    MergeMEGAFolders planner(action, nodeSource);
+    planner.planMerge(folderTarget, folderToMerge);
+    return planner.mPlan;
 }
 
-std::shared_ptr<mega::MegaError> MergeMEGAFolders::performMerge(mega::MegaNode* folderTarget,
-                                                                mega::MegaNode* folderToMerge,
-                                                                ActionForDuplicates action)
+MergeMEGAFolders::NodeSource MergeMEGAFolders::getAppNodeSource()
 {
-    // Fill the folderTarget child names container, used to know if the folderToMerge nested nodes
-    // will be moved, rename or removed
-    QMap<QString, std::shared_ptr<mega::MegaNode>> targetNodeWithNameConflict;
-    QMap<QString, std::shared_ptr<mega::MegaNode>> targetNodeWithoutNameConflict;
+    NodeSource nodeSource;
 
-    readTargetFolder(folderTarget, targetNodeWithoutNameConflict, targetNodeWithNameConflict);
+    nodeSource.getChildren = [](mega::MegaNode* folder)
+    {
+        QList<std::shared_ptr<mega::MegaNode>> children;
 
-    std::shared_ptr<mega::MegaError> error =
-        fixTargetFolderNameConflicts(targetNodeWithNameConflict, action);
+        std::unique_ptr<mega::MegaNodeList> nodes(
+            MegaSyncApp->getMegaApi()->getChildren(folder));
+        for (int index = 0; index < nodes->size(); ++index)
+        {
+            children.append(std::shared_ptr<mega::MegaNode>(nodes->get(index)->copy()));
+        }
 
-    if (error)
-    {
-        return error;
-    }
+        return children;
+    };
 
-    error = mergeNestedNodesIntoTargetFolder(folderTarget,
-                                             folderToMerge,
-                                             targetNodeWithoutNameConflict,
-                                             action);
+    nodeSource.getNodeByHandle = [](mega::MegaHandle handle)
+    {
+        return std::shared_ptr<mega::MegaNode>(MegaSyncApp->getMegaApi()->getNodeByHandle(handle));
+    };
 
-    if (error)
+    nodeSource.unescapeName = [](const char* name)
     {
-        return error;
-    }
+        std::unique_ptr<char[]> unescapedName(
+            MegaSyncApp->getMegaApi()->unescapeFsIncompatible(name));
+        return QString::fromUtf8(unescapedName.get());
+    };
 
-    return finishMerge(folderTarget, folderToMerge, action);
+    return nodeSource;
 }
 
-void MergeMEGAFolders::readTargetFolder(
-    mega::MegaNode* folderTarget,
-    QMap<QString, std::shared_ptr<mega::MegaNode>>& targetNodeWithoutNameConflict,
-    QMap<QString, std::shared_ptr<mega::MegaNode>>& targetNodeWithNameConflict)
+void MergeMEGAFolders::planMerge(mega::MegaNode* folderTarget, mega::MegaNode* folderToMerge)
 {
-    std::unique_ptr<mega::MegaNodeList> folderTargetNodes(
-        MegaSyncApp->getMegaApi()->getChildren(folderTarget));
+    if (!folderTarget)
+    {
+        return;
+    }
+
+    std::shared_ptr<mega::MegaNode> target(folderTarget->copy());
 
-    for (int index = folderTargetNodes->size() - 1; index >= 0; --index)
+    if (folderToMerge)
     {
-        auto node(folderTargetNodes->get(index));
-        QString nodeName(getNodeName(node));
+        planFolderMerge(target, std::shared_ptr<mega::MegaNode>(folderToMerge->copy()), false);
+        return;
+    }
 
-        // Name conflict detected
-        if (!targetNodeWithoutNameConflict.contains(nodeName))
-        {
-            targetNodeWithoutNameConflict.insert(nodeName,
-                                                 std::shared_ptr<mega::MegaNode>(node->copy()));
-        }
-        else if (!targetNodeWithNameConflict.contains(nodeName))
+    auto parentNode(mNodeSource.getNodeByHandle(folderTarget->getParentHandle()));
+    if (parentNode)
+    {
+        QString targetNodeName(getNodeName(folderTarget));
+
+        const auto siblings(snapshot(parentNode.get())->children);
+        for (const auto& node : siblings)
         {
-            targetNodeWithNameConflict.insert(nodeName,
-                                              std::shared_ptr<mega::MegaNode>(node->copy()));
+            if (targetNodeName.compare(getNodeName(node.get())) == 0 &&
+                node->getHandle() != folderTarget->getHandle())
+            {
+                planNodeIntoNode(target, node, parentNode.get());
+            }
         }
     }
 }
 
-std::shared_ptr<mega::MegaError> MergeMEGAFolders::fixTargetFolderNameConflicts(
-    const QMap<QString, std::shared_ptr<mega::MegaNode>>& targetNodeWithNameConflict,
-    ActionForDuplicates action)
+void MergeMEGAFolders::planFolderMerge(std::shared_ptr<mega::MegaNode> folderTarget,
+                                       std::shared_ptr<mega::MegaNode> folderToMerge,
+                                       bool removedWithParent)
 {
-    // Check if the target folder has name conflicts and solve them first
-    if (targetNodeWithNameConflict.size() > 0)
+    if (mMergedNodes.contains(folderToMerge->getHandle()))
     {
-        foreach(auto node, targetNodeWithNameConflict)
-        {
-            auto error = merge(node.get(), nullptr, action);
-            if (error)
-            {
-                return error;
-            }
-        }
+        return;
     }
+    mMergedNodes.insert(folderToMerge->getHandle());
+
+    fixTargetFolderNameConflicts(folderTarget);
+    mergeNestedNodesIntoTargetFolder(folderTarget, folderToMerge);
 
-    return nullptr;
+    // Every nested node is moved or removed by the planned operations
+    finishMerge(folderToMerge, folderTarget.get(), true, removedWithParent);
 }
 
-std::shared_ptr<mega::MegaError> MergeMEGAFolders::finishMerge(mega::MegaNode* folderTarget,
-                                                               mega::MegaNode* folderToMerge,
-                                                               ActionForDuplicates action)
+void MergeMEGAFolders::planNodeIntoNode(std::shared_ptr<mega::MegaNode> nodeTarget,
+                                        std::shared_ptr<mega::MegaNode> nodeToMerge,
+                                        mega::MegaNode* parentFolder)
 {
-    std::shared_ptr<mega::MegaError> error(nullptr);
-    bool remove(false);
-
-    if (folderToMerge->isFolder())
+    if (nodeTarget->isFolder() && nodeToMerge->isFolder())
     {
-        std::unique_ptr<mega::MegaNodeList> folderChild(
-            MegaSyncApp->getMegaApi()->getChildren(folderToMerge));
-
-        remove = folderChild->size() == 0;
+        planFolderMerge(nodeTarget, nodeToMerge, false);
+    }
+    else if (!mMergedNodes.contains(nodeToMerge->getHandle()))
+    {
+        mMergedNodes.insert(nodeToMerge->getHandle());
+        finishMerge(nodeToMerge, parentFolder, false, false);
     }
+}
 
-    if (action == ActionForDuplicates::IgnoreAndRemove || remove)
+void MergeMEGAFolders::fixTargetFolderNameConflicts(std::shared_ptr<mega::MegaNode> folderTarget)
+{
+    auto targetSnapshot(snapshot(folderTarget.get()));
+    if (targetSnapshot->nameConflictsFixed)
     {
-        error = MegaApiSynchronizedRequest::runRequest(&mega::MegaApi::remove,
-                                                       MegaSyncApp->getMegaApi(),
-                                                       folderToMerge);
+        return;
     }
-    else if (action == ActionForDuplicates::IgnoreAndMoveToBin)
+    targetSnapshot->nameConflictsFixed = true;
+
+    // Check if the target folder has name conflicts and solve them first, merging every node into
+    // the one kept by name
+    const auto children(targetSnapshot->children);
+    for (const auto& node : children)
     {
-        MoveToMEGABin toBin;
-        auto moveToBinError =
-            toBin.moveToBin(folderToMerge->getHandle(), QLatin1String("FoldersMerge"), true);
-        if (moveToBinError.binFolderCreationError)
-        {
-            error = moveToBinError.binFolderCreationError;
-        }
-        else if (!moveToBinError.moveError)
+        auto nodeKept(targetSnapshot->nodesByName.value(getNodeName(node.get())));
+        if (nodeKept && nodeKept->getHandle() != node->getHandle())
         {
-            error = moveToBinError.moveError;
+            planNodeIntoNode(nodeKept, node, folderTarget.get());
         }
     }
-    else if (action == ActionForDuplicates::Rename)
-    {
-        QStringList itemsBeingRenamed;
-        error = rename(folderToMerge, folderTarget, itemsBeingRenamed);
-    }
-
-    return error;
 }
 
-std::shared_ptr<mega::MegaError> MergeMEGAFolders::mergeNestedNodesIntoTargetFolder(
-    mega::MegaNode* folderTarget,
-    mega::MegaNode* folderToMerge,
-    QMap<QString, std::shared_ptr<mega::MegaNode>>& targetNodeWithoutNameConflict,
-    ActionForDuplicates action)
+void MergeMEGAFolders::mergeNestedNodesIntoTargetFolder(
+    std::shared_ptr<mega::MegaNode> folderTarget,
+    std::shared_ptr<mega::MegaNode> folderToMerge)
 {
-    QStringList itemsBeingRenamed;
+    const auto nestedNodesToMerge(snapshot(folderToMerge.get())->children);
 
-    std::shared_ptr<mega::MegaError> error(nullptr);
-    std::unique_ptr<mega::MegaNodeList> folderToMergeNodes(
-        MegaSyncApp->getMegaApi()->getChildren(folderToMerge));
-
-    for (int index = 0; index < folderToMergeNodes->size(); ++index)
+    for (const auto& nestedNodeToMerge : nestedNodesToMerge)
     {
-        auto nestedNodeToMerge(folderToMergeNodes->get(index));
-        QString nestedNodeName(getNodeName(nestedNodeToMerge));
-        auto targetNode(targetNodeWithoutNameConflict.value(nestedNodeName));
+        auto targetSnapshot(snapshot(folderTarget.get()));
+        QString nestedNodeName(getNodeName(nestedNodeToMerge.get()));
+        auto targetNode(targetSnapshot->nodesByName.value(nestedNodeName));
 
         // There are one item with the same name in folderTarget (if there were more, they were
         // merged in "fixTargetFolderNameConflicts" method)
@@ -198,57 +202,350 @@ std::shared_ptr<mega::MegaError> MergeMEGAFolders::mergeNestedNodesIntoTargetFol
                 auto targetNodeFp(QString::fromUtf8(targetNode->getFingerprint()));
                 if (nodeToMoveFp == targetNodeFp)
                 {
-                    error = MegaApiSynchronizedRequest::runRequest(&mega::MegaApi::remove,
-                                                                   MegaSyncApp->getMegaApi(),
-                                                                   nestedNodeToMerge);
+                    Operation operation;
+                    operation.type = Operation::Type::Remove;
+                    operation.node = nestedNodeToMerge;
+                    mPlan.contentOperations.append(operation);
                 }
                 else
                 {
-                    error = rename(nestedNodeToMerge, folderTarget, itemsBeingRenamed);
+                    mPlan.contentOperations.append(
+                        renameOperation(nestedNodeToMerge, folderTarget.get()));
                 }
             }
             else if (nestedNodeToMerge->isFolder() && targetNode->isFolder())
             {
-                error = merge(targetNode.get(), nestedNodeToMerge, action);
+                // The nested folder goes away when folderToMerge is removed
+                planFolderMerge(targetNode, nestedNodeToMerge, true);
             }
             else
             {
-                error = rename(nestedNodeToMerge, folderTarget, itemsBeingRenamed);
+                mPlan.contentOperations.append(
+                    renameOperation(nestedNodeToMerge, folderTarget.get()));
             }
         }
         // We can simply move the node, as there is no item with the same name in the target node
         else
         {
-            error = MegaApiSynchronizedRequest::runRequestLambda(
-                [](mega::MegaNode* node,
-                   mega::MegaNode* targetNode,
-                   mega::MegaRequestListener* listener)
-                {
-                    MegaSyncApp->getMegaApi()->moveNode(node, targetNode, listener);
-                },
-                MegaSyncApp->getMegaApi(),
-                nestedNodeToMerge,
-                folderTarget);
-
-            // If the node was correctly moved, now it is part of the targetNodeWithoutNameConflict
-            if (!error)
+            Operation operation;
+            operation.type = Operation::Type::Move;
+            operation.node = nestedNodeToMerge;
+            operation.targetFolder = folderTarget;
+            mPlan.contentOperations.append(operation);
+
+            // Once moved, the node is part of the target folder
+            targetSnapshot->nodesByName.insert(nestedNodeName, nestedNodeToMerge);
+        }
+    }
+}
+
+void MergeMEGAFolders::finishMerge(std::shared_ptr<mega::MegaNode> nodeToMerge,
+                                   mega::MegaNode* parentFolder,
+                                   bool isEmpty,
+                                   bool removedWithParent)
+{
+    // Removing the parent folder removes this one too
+    if (removedWithParent)
+    {
+        return;
+    }
+
+    Operation operation;
+    operation.node = nodeToMerge;
+
+    if (mAction == ActionForDuplicates::IgnoreAndRemove || isEmpty)
+    {
+        operation.type = Operation::Type::Remove;
+    }
+    else if (mAction == ActionForDuplicates::IgnoreAndMoveToBin)
+    {
+        operation.type = Operation::Type::MoveToBin;
+    }
+    else if (mAction == ActionForDuplicates::Rename)
+    {
+        operation = renameOperation(nodeToMerge, parentFolder);
+    }
+
+    mPlan.finishOperations.append(operation);
+}
+
+MergeMEGAFolders::Operation
+    MergeMEGAFolders::renameOperation(std::shared_ptr<mega::MegaNode> nodeToRename,
+                                      mega::MegaNode* parentNode)
+{
+    auto parentSnapshot(snapshot(parentNode));
+
+    QString newName(getNonDuplicatedName(nodeToRename.get(), *parentSnapshot));
+    parentSnapshot->nodesByName.insert(getComparableName(newName), nodeToRename);
+
+    Operation operation;
+    operation.type = Operation::Type::MoveAndRename;
+    operation.node = nodeToRename;
+    operation.targetFolder = std::shared_ptr<mega::MegaNode>(parentNode->copy());
+    operation.newName = newName;
+    return operation;
+}
+
+QString MergeMEGAFolders::getNonDuplicatedName(mega::MegaNode* node,
+                                               const FolderSnapshot& parentSnapshot) const
+{
+    QString baseName(mNodeSource.unescapeName(node->getName()));
+    QString suffix;
+
+    if (node->isFile())
+    {
+        auto nameSplitted(Utilities::getFilenameBasenameAndSuffix(baseName));
+        if (nameSplitted != QPair<QString, QString>())
+        {
+            baseName = nameSplitted.first;
+            suffix = nameSplitted.second;
+        }
+    }
+
+    // The same "name(n).suffix" pattern as Utilities::getNonDuplicatedNodeName
+    for (int counter = 1;; ++counter)
+    {
+        QString newName(baseName + QString::fromLatin1("(%1)").arg(counter) + suffix);
+        if (!parentSnapshot.nodesByName.contains(getComparableName(newName)))
+        {
+            return newName;
+        }
+    }
+}
+
+std::shared_ptr<MergeMEGAFolders::FolderSnapshot> MergeMEGAFolders::snapshot(mega::MegaNode* folder)
+{
+    auto& folderSnapshot(mSnapshots[folder->getHandle()]);
+    if (!folderSnapshot)
+    {
+        folderSnapshot = std::make_shared<FolderSnapshot>();
+        folderSnapshot->children = mNodeSource.getChildren(folder);
+
+        // When there is a name conflict, the last node with that name is the one kept
+        for (int index = folderSnapshot->children.size() - 1; index >= 0; --index)
+        {
+            auto node(folderSnapshot->children.at(index));
+            QString nodeName(getNodeName(node.get()));
+            if (!folderSnapshot->nodesByName.contains(nodeName))
+            {
+                folderSnapshot->nodesByName.insert(nodeName, node);
+            }
+        }
+    }
+
+    return folderSnapshot;
+}
+
+// ----------------------------------------------------------------------------
+//
+// EXECUTE
+//
+// ----------------------------------------------------------------------------
+MergeMEGAFolders::Result MergeMEGAFolders::execute(const Plan& plan,
+                                                   ProgressCallback progress,
+                                                   mega::MegaCancelToken* cancelToken)
+{
+    // The merged folders are removed once their content is out of them
+    auto result(executeOperations(plan.contentOperations, plan.size(), 0, progress, cancelToken));
+    if (result.error || result.cancelled)
+    {
+        return result;
+    }
+
+    return executeOperations(plan.finishOperations,
+                             plan.size(),
+                             result.finishedOperations,
+                             progress,
+                             cancelToken);
+}
+
+MergeMEGAFolders::Result
+    MergeMEGAFolders::executeOperations(const QList<Operation>& operations,
+                                        int totalOperations,
+                                        int finishedOperations,
+                                        const ProgressCallback& progress,
+                                        mega::MegaCancelToken* cancelToken)
+{
+    Result result;
+    result.finishedOperations = finishedOperations;
+
+    QEventLoop eventLoop;
+    int nextOperation(0);
+    int requestsInFlight(0);
+
+    auto onOperationFinished = [&result, &progress, totalOperations](
+                                   std::shared_ptr<mega::MegaError> error)
+    {
+        // Don´t start more operations if any of them failed
+        if (error && !result.error)
+        {
+            result.error = error;
+        }
+
+        result.finishedOperations++;
+        if (progress)
+        {
+            progress(result.finishedOperations, totalOperations);
+        }
+    };
+
+    std::function<void()> sendNextOperations;
+    sendNextOperations = [&]()
+    {
+        while (!result.error && !result.cancelled && requestsInFlight < MAX_REQUESTS_IN_FLIGHT &&
+               nextOperation < operations.size())
+        {
+            if (cancelToken && cancelToken->isCancelled())
+            {
+                result.cancelled = true;
+                break;
+            }
+
+            const auto& operation(operations.at(nextOperation++));
+
+            // MoveToMEGABin waits for its own requests
+            if (operation.type == Operation::Type::MoveToBin)
             {
-                targetNodeWithoutNameConflict.insert(
-                    nestedNodeName,
-                    std::shared_ptr<mega::MegaNode>(nestedNodeToMerge->copy()));
+                auto moveToBinError = MoveToMEGABin::moveToBin(operation.node->getHandle(),
+                                                               QLatin1String("FoldersMerge"),
+                                                               true);
+                invalidateFolderNames(operation);
+                onOperationFinished(moveToBinError.binFolderCreationError ?
+                                        moveToBinError.binFolderCreationError :
+                                        moveToBinError.moveError);
+                continue;
             }
+
+            requestsInFlight++;
+            auto& listenerManager(RequestListenerManager::instance());
+            auto listener = listenerManager.registerAndGetSynchronousFinishListener(
+                [&, operation](mega::MegaRequest*, mega::MegaError* e)
+                {
+                    requestsInFlight--;
+                    invalidateFolderNames(operation);
+
+                    std::shared_ptr<mega::MegaError> error(nullptr);
+                    if (e->getErrorCode() != mega::MegaError::API_OK)
+                    {
+                        error.reset(e->copy());
+                    }
+                    onOperationFinished(error);
+
+                    sendNextOperations();
+                });
+            startOperation(operation, listener.get());
         }
 
-        // Don´t continue if any step failed
-        if (error)
+        if (requestsInFlight == 0)
         {
+            eventLoop.quit();
+        }
+    };
+
+    sendNextOperations();
+    if (requestsInFlight > 0)
+    {
+        eventLoop.exec();
+    }
+
+    return result;
+}
+
+void MergeMEGAFolders::startOperation(const Operation& operation,
+                                      mega::MegaRequestListener* listener)
+{
+    auto megaApi(MegaSyncApp->getMegaApi());
+
+    switch (operation.type)
+    {
+        case Operation::Type::Move:
+        {
+            megaApi->moveNode(operation.node.get(), operation.targetFolder.get(), listener);
+            break;
+        }
+        case Operation::Type::MoveAndRename:
+        {
+            // Other conflicts may ask for a name before the node update of the move arrives
+            FolderNameIndex::instance().reserveName(operation.targetFolder.get(), operation.newName);
+            megaApi->moveNode(operation.node.get(),
+                              operation.targetFolder.get(),
+                              operation.newName.toUtf8().constData(),
+                              listener);
+            break;
+        }
+        case Operation::Type::Remove:
+        {
+            megaApi->remove(operation.node.get(), listener);
             break;
         }
+        default:
+            break;
     }
+}
 
-    return error;
+// ----------------------------------------------------------------------------
+//
+// DRY RUN
+//
+// ----------------------------------------------------------------------------
+QString MergeMEGAFolders::Operation::toString() const
+{
+    QString nodeName(node ? QString::fromUtf8(node->getName()) : QString());
+
+    switch (type)
+    {
+        case Type::Move:
+        {
+            return QString::fromLatin1("move \"%1\" to \"%2\"")
+                .arg(nodeName, QString::fromUtf8(targetFolder->getName()));
+        }
+        case Type::MoveAndRename:
+        {
+            return QString::fromLatin1("move \"%1\" to \"%2\" as \"%3\"")
+                .arg(nodeName, QString::fromUtf8(targetFolder->getName()), newName);
+        }
+        case Type::Remove:
+        {
+            return QString::fromLatin1("remove \"%1\"").arg(nodeName);
+        }
+        case Type::MoveToBin:
+        {
+            return QString::fromLatin1("move \"%1\" to bin").arg(nodeName);
+        }
+    }
+
+    return QString();
+}
+
+int MergeMEGAFolders::Plan::size() const
+{
+    return contentOperations.size() + finishOperations.size();
+}
+
+bool MergeMEGAFolders::Plan::isEmpty() const
+{
+    return size() == 0;
 }
 
+QStringList MergeMEGAFolders::Plan::dryRun() const
+{
+    QStringList operations;
+
+    for (const auto& operation : contentOperations)
+    {
+        operations.append(operation.toString());
+    }
+
+    for (const auto& operation : finishOperations)
+    {
+        operations.append(operation.toString());
+    }
+
+    return operations;
+}
+
+// ----------------------------------------------------------------------------
+
 void MergeMEGAFolders::logError(std::shared_ptr<mega::MegaError> error)
 {
     if (error)
@@ -261,46 +558,16 @@ void MergeMEGAFolders::logError(std::shared_ptr<mega::MegaError> error)
     }
 }
 
-std::shared_ptr<mega::MegaError> MergeMEGAFolders::rename(mega::MegaNode* nodeToRename,
-                                                          mega::MegaNode* parentNode,
-                                                          QStringList& itemsBeingRenamed)
+QString MergeMEGAFolders::getNodeName(mega::MegaNode* node) const
 {
-    QString currentName(getNodeName(nodeToRename));
-    QString newName = Utilities::getNonDuplicatedNodeName(nodeToRename,
-                                                          parentNode,
-                                                          currentName,
-                                                          true,
-                                                          itemsBeingRenamed);
-
-    auto error = MegaApiSynchronizedRequest::runRequestLambda(
-        [](mega::MegaNode* node,
-           mega::MegaNode* targetNode,
-           const char* newName,
-           mega::MegaRequestListener* listener)
-        {
-            MegaSyncApp->getMegaApi()->moveNode(node, targetNode, newName, listener);
-        },
-        MegaSyncApp->getMegaApi(),
-        nodeToRename,
-        parentNode,
-        newName.toUtf8().constData());
-
-    if (!error)
-    {
-        itemsBeingRenamed.append(newName);
-    }
-
-    return error;
+    return getComparableName(mNodeSource.unescapeName(node->getName()));
 }
 
-QString MergeMEGAFolders::getNodeName(mega::MegaNode* node)
+QString MergeMEGAFolders::getComparableName(const QString& name)
 {
-    QString nodeName =
-        QString::fromUtf8(MegaSyncApp->getMegaApi()->unescapeFsIncompatible(node->getName()));
-
 #ifndef Q_OS_LINUX
-    return nodeName.toLower();
+    return name.toLower();
 #else
-    return nodeName;
+    return name;
 #endif
 }
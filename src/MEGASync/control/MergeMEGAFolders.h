@@ -3,8 +3,14 @@
 
 #include "megaapi.h"
 
+#include <QHash>
+#include <QList>
+#include <QMap>
 #include <QObject>
+#include <QSet>
+#include <QStringList>
 
+#include <functional>
 #include <memory>
 
 //FOLDER MERGE LOGIC
@@ -19,6 +25,13 @@
         c. If the secondary and the main folder have a folder with the same name:
             i.  We run this algorithm recursively but updating the main and the secondary folders pointer.
         d. If the secondary folder has a folder which is not in the main folder, we move it directly
+
+   The merge runs in two phases:
+   - Plan: the steps above are run in memory, reading the children of every folder once, and give
+     the list of requests to send. It has no side effects: the new names are chosen from the
+     children read and the names given by the plan itself.
+   - Execute: the requests are sent with a bounded number of them in flight. The nested nodes are
+     moved or removed first and then the merged folders, which are empty by then.
 */
 class MergeMEGAFolders
 {
@@ -30,42 +43,125 @@ public:
         IgnoreAndMoveToBin,
     };
 
+    struct Operation
+    {
+        enum class Type
+        {
+            Move,
+            MoveAndRename,
+            Remove,
+            MoveToBin,
+        };
+
+        Type type = Type::Move;
+        std::shared_ptr<mega::MegaNode> node;
+        // Used by Move and MoveAndRename
+        std::shared_ptr<mega::MegaNode> targetFolder;
+        // Used by MoveAndRename
+        QString newName;
+
+        QString toString() const;
+    };
+
+    // The operations of the same list do not depend on each other
+    struct Plan
+    {
+        QList<Operation> contentOperations;
+        QList<Operation> finishOperations;
+
+        int size() const;
+        bool isEmpty() const;
+        // One line per operation, in execution order
+        QStringList dryRun() const;
+    };
+
+    struct Result
+    {
+        std::shared_ptr<mega::MegaError> error;
+        int finishedOperations = 0;
+        bool cancelled = false;
+    };
+
+    // Where the plan reads the cloud from
+    struct NodeSource
+    {
+        std::function<QList<std::shared_ptr<mega::MegaNode>>(mega::MegaNode* folder)> getChildren;
+        std::function<std::shared_ptr<mega::MegaNode>(mega::MegaHandle handle)> getNodeByHandle;
+        std::function<QString(const char* name)> unescapeName;
+    };
+
+    using ProgressCallback = std::function<void(int finishedOperations, int totalOperations)>;
+
+    static constexpr int MAX_REQUESTS_IN_FLIGHT = 16;
+
     static std::shared_ptr<mega::MegaError> merge(mega::MegaNode* folderTarget,
                                                   mega::MegaNode* folderToMerge,
                                                   ActionForDuplicates action);
 
+    // If folderToMerge is null, the folders with the same name as folderTarget are merged into it
+    static Plan plan(mega::MegaNode* folderTarget,
+                     mega::MegaNode* folderToMerge,
+                     ActionForDuplicates action);
+    static Plan plan(mega::MegaNode* folderTarget,
+                     mega::MegaNode* folderToMerge,
+                     ActionForDuplicates action,
+                     const NodeSource& nodeSource);
+    // Reads the cloud of the app
+    static NodeSource getAppNodeSource();
+    static Result execute(const Plan& plan,
+                          ProgressCallback progress = nullptr,
+                          mega::MegaCancelToken* cancelToken = nullptr);
+
 private:
-    MergeMEGAFolders() = default;
-
-    static std::shared_ptr<mega::MegaError> performMerge(mega::MegaNode* folderTarget,
-                                                         mega::MegaNode* folderToMerge,
-                                                         ActionForDuplicates action);
-    static std::shared_ptr<mega::MegaError> mergeTwoFolders(ActionForDuplicates action);
-    static std::shared_ptr<mega::MegaError> mergeByName(ActionForDuplicates action);
-
-    // Preparation methods
-    static void readTargetFolder(
-        mega::MegaNode* folderTarget,
-        QMap<QString, std::shared_ptr<mega::MegaNode>>& targetNodeWithoutNameConflict,
-        QMap<QString, std::shared_ptr<mega::MegaNode>>& targetNodeWithNameConflict);
-    static std::shared_ptr<mega::MegaError> fixTargetFolderNameConflicts(
-        const QMap<QString, std::shared_ptr<mega::MegaNode>>& targetNodeWithNameConflict,
-        ActionForDuplicates action);
-    static std::shared_ptr<mega::MegaError> mergeNestedNodesIntoTargetFolder(
-        mega::MegaNode* folderTarget,
-        mega::MegaNode* folderToMerge,
-        QMap<QString, std::shared_ptr<mega::MegaNode>>& targetNodeWithoutNameConflict,
-        ActionForDuplicates action);
-    static std::shared_ptr<mega::MegaError> finishMerge(mega::MegaNode* folderTarget,
-                                                        mega::MegaNode* folderToMerge,
-                                                        ActionForDuplicates action);
+    struct FolderSnapshot
+    {
+        QList<std::shared_ptr<mega::MegaNode>> children;
+        // Node each name resolves to once the planned operations are done, also the names given
+        // by the planned moves and renames
+        QMap<QString, std::shared_ptr<mega::MegaNode>> nodesByName;
+        bool nameConflictsFixed = false;
+    };
+
+    MergeMEGAFolders(ActionForDuplicates action, const NodeSource& nodeSource);
+
+    // Plan
+    void planMerge(mega::MegaNode* folderTarget, mega::MegaNode* folderToMerge);
+    void planFolderMerge(std::shared_ptr<mega::MegaNode> folderTarget,
+                         std::shared_ptr<mega::MegaNode> folderToMerge,
+                         bool removedWithParent);
+    void planNodeIntoNode(std::shared_ptr<mega::MegaNode> nodeTarget,
+                          std::shared_ptr<mega::MegaNode> nodeToMerge,
+                          mega::MegaNode* parentFolder);
+    void fixTargetFolderNameConflicts(std::shared_ptr<mega::MegaNode> folderTarget);
+    void mergeNestedNodesIntoTargetFolder(std::shared_ptr<mega::MegaNode> folderTarget,
+                                          std::shared_ptr<mega::MegaNode> folderToMerge);
+    void finishMerge(std::shared_ptr<mega::MegaNode> nodeToMerge,
+                     mega::MegaNode* parentFolder,
+                     bool isEmpty,
+                     bool removedWithParent);
+    Operation renameOperation(std::shared_ptr<mega::MegaNode> nodeToRename,
+                              mega::MegaNode* parentNode);
+    QString getNonDuplicatedName(mega::MegaNode* node, const FolderSnapshot& parentSnapshot) const;
+    std::shared_ptr<FolderSnapshot> snapshot(mega::MegaNode* folder);
+    QString getNodeName(mega::MegaNode* node) const;
+
+    // Execute
+    static Result executeOperations(const QList<Operation>& operations,
+                                    int totalOperations,
+                                    int finishedOperations,
+                                    const ProgressCallback& progress,
+                                    mega::MegaCancelToken* cancelToken);
+    static void startOperation(const Operation& operation, mega::MegaRequestListener* listener);
 
     // Utilities
     static void logError(std::shared_ptr<mega::MegaError> error);
-    static std::shared_ptr<mega::MegaError> rename(mega::MegaNode* nodeToRename,
-                                                   mega::MegaNode* parentNode,
-                                                   QStringList& itemsBeingRenamed);
-    static QString getNodeName(mega::MegaNode* node);
+    static QString getComparableName(const QString& name);
+
+    ActionForDuplicates mAction;
+    NodeSource mNodeSource;
+    Plan mPlan;
+    QHash<mega::MegaHandle, std::shared_ptr<FolderSnapshot>> mSnapshots;
+    QSet<mega::MegaHandle> mMergedNodes;
 };
 
 #endif // MERGEMEGAFOLDERS_H
@@ -28,7 +28,15 @@ const QString Preferences::TRANSLATION_FOLDER = QString::fromLatin1("://translat
 const QString Preferences::TRANSLATION_PREFIX = QString::fromLatin1("MEGASyncStrings_");
 
 int Preferences::STATE_REFRESH_INTERVAL_MS        = 10000;
+int Preferences::STATE_REFRESH_MAX_INTERVAL_MS    = 300000;
+int Preferences::MAINTENANCE_INTERVAL_MS          = 60000;
+int Preferences::MAINTENANCE_MAX_INTERVAL_MS      = 600000;
+int Preferences::PERIODIC_STATS_INTERVAL_MS       = 3600000;
 int Preferences::NETWORK_REFRESH_INTERVAL_MS      = 30000;
+// Below MAX_IDLE_TIME_MS, so a longer gap between checks still means the computer was asleep
+int Preferences::NETWORK_REFRESH_MAX_INTERVAL_MS  = 300000;
+int Preferences::SYNC_STATS_SAMPLE_INTERVAL_MS    = 30000;
+int Preferences::SYNC_STATS_SAMPLE_MAX_INTERVAL_MS = 600000;
 int Preferences::FINISHED_TRANSFER_REFRESH_INTERVAL_MS        = 10000;
 
 long long Preferences::OQ_DIALOG_INTERVAL_MS = 604800000; // 7 daysm
@@ -3012,7 +3020,14 @@ void Preferences::overridePreferences(const QSettings &settings)
     overridePreference(settings, QString::fromUtf8("PAYWALL_NOTIFICATION_INTERVAL_MS"), Preferences::PAYWALL_NOTIFICATION_INTERVAL_MS);
     overridePreference(settings, QString::fromUtf8("USER_INACTIVITY_MS"), Preferences::USER_INACTIVITY_MS);
     overridePreference(settings, QString::fromUtf8("STATE_REFRESH_INTERVAL_MS"), Preferences::STATE_REFRESH_INTERVAL_MS);
+    overridePreference(settings, QString::fromUtf8("STATE_REFRESH_MAX_INTERVAL_MS"), Preferences::STATE_REFRESH_MAX_INTERVAL_MS);
+    overridePreference(settings, QString::fromUtf8("MAINTENANCE_INTERVAL_MS"), Preferences::MAINTENANCE_INTERVAL_MS);
+    overridePreference(settings, QString::fromUtf8("MAINTENANCE_MAX_INTERVAL_MS"), Preferences::MAINTENANCE_MAX_INTERVAL_MS);
+    overridePreference(settings, QString::fromUtf8("PERIODIC_STATS_INTERVAL_MS"), Preferences::PERIODIC_STATS_INTERVAL_MS);
     overridePreference(settings, QString::fromUtf8("NETWORK_REFRESH_INTERVAL_MS"), Preferences::NETWORK_REFRESH_INTERVAL_MS);
+    overridePreference(settings, QString::fromUtf8("NETWORK_REFRESH_MAX_INTERVAL_MS"), Preferences::NETWORK_REFRESH_MAX_INTERVAL_MS);
+    overridePreference(settings, QString::fromUtf8("SYNC_STATS_SAMPLE_INTERVAL_MS"), Preferences::SYNC_STATS_SAMPLE_INTERVAL_MS);
+    overridePreference(settings, QString::fromUtf8("SYNC_STATS_SAMPLE_MAX_INTERVAL_MS"), Preferences::SYNC_STATS_SAMPLE_MAX_INTERVAL_MS);
 
     overridePreference(settings, QString::fromUtf8("TRANSFER_OVER_QUOTA_DIALOG_DISABLE_DURATION_MS"), Preferences::OVER_QUOTA_DIALOG_DISABLE_DURATION);
     overridePreference(settings, QString::fromUtf8("TRANSFER_OVER_QUOTA_OS_NOTIFICATION_DISABLE_DURATION_MS"), Preferences::OVER_QUOTA_OS_NOTIFICATION_DISABLE_DURATION);
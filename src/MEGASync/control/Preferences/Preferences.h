@@ -504,7 +504,14 @@ public:
     static std::chrono::milliseconds OVER_QUOTA_ACTION_DIALOGS_DISABLE_TIME;
 
     static int STATE_REFRESH_INTERVAL_MS;
+    static int STATE_REFRESH_MAX_INTERVAL_MS;
+    static int MAINTENANCE_INTERVAL_MS;
+    static int MAINTENANCE_MAX_INTERVAL_MS;
+    static int PERIODIC_STATS_INTERVAL_MS;
     static int NETWORK_REFRESH_INTERVAL_MS;
+    static int NETWORK_REFRESH_MAX_INTERVAL_MS;
+    static int SYNC_STATS_SAMPLE_INTERVAL_MS;
+    static int SYNC_STATS_SAMPLE_MAX_INTERVAL_MS;
     static int FINISHED_TRANSFER_REFRESH_INTERVAL_MS;
 
     static long long MIN_UPDATE_NOTIFICATION_INTERVAL_MS;
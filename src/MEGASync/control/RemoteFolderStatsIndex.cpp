@@ -0,0 +1,468 @@
+#include "RemoteFolderStatsIndex.h"
+
+#include "MegaApplication.h"
+#include "SyncInfo.h"
+#include "ThreadPool.h"
+#include "Utilities.h"
+
+#include <algorithm>
+
+RemoteFolderStatsIndex::RemoteFolderStatsIndex():
+    mGlobalListener(std::make_unique<mega::QTMegaGlobalListener>(MegaSyncApp->getMegaApi(), this)),
+    mHasDetachedItems(false)
+{
+    moveToThread(qApp->thread());
+    mGlobalListener->moveToThread(qApp->thread());
+    MegaSyncApp->getMegaApi()->addGlobalListener(mGlobalListener.get());
+
+    connect(SyncInfo::instance(),
+            &SyncInfo::syncRemoved,
+            this,
+            &RemoteFolderStatsIndex::onSyncRemoved);
+}
+
+void RemoteFolderStatsIndex::track(mega::MegaHandle folderHandle)
+{
+    if (folderHandle == mega::INVALID_HANDLE || mTrackedFolders.contains(folderHandle))
+    {
+        return;
+    }
+
+    mTrackedFolders.insert(folderHandle);
+
+    // Already known if it is inside another tracked folder
+    if (!mItems.contains(folderHandle) && !mWalkingFolders.contains(folderHandle))
+    {
+        startWalk(folderHandle);
+    }
+}
+
+void RemoteFolderStatsIndex::untrack(mega::MegaHandle folderHandle)
+{
+    if (!mTrackedFolders.remove(folderHandle))
+    {
+        return;
+    }
+
+    mChangedTrackedFolders.remove(folderHandle);
+    eraseDetachedItems();
+}
+
+bool RemoteFolderStatsIndex::getStats(mega::MegaHandle folderHandle, Stats& stats) const
+{
+    auto itemIt(mItems.constFind(folderHandle));
+    if (itemIt == mItems.constEnd() || itemIt->isFile)
+    {
+        return false;
+    }
+
+    stats = itemIt->stats;
+    return true;
+}
+
+qint64 RemoteFolderStatsIndex::getSize(mega::MegaHandle folderHandle) const
+{
+    Stats stats;
+    return getStats(folderHandle, stats) ? stats.size : -1;
+}
+
+void RemoteFolderStatsIndex::clear()
+{
+    mItems.clear();
+    mTrackedFolders.clear();
+    mUpdatesWhileWalking.clear();
+    mWalkedFolders.clear();
+    mChangedTrackedFolders.clear();
+    mHasDetachedItems = false;
+}
+
+void RemoteFolderStatsIndex::onNodesUpdate(mega::MegaApi*, mega::MegaNodeList* nodes)
+{
+    // Full reload of the nodes
+    if (!nodes)
+    {
+        mItems.clear();
+        mUpdatesWhileWalking.clear();
+        mWalkedFolders.clear();
+        for (auto folderHandle : qAsConst(mTrackedFolders))
+        {
+            if (!mWalkingFolders.contains(folderHandle))
+            {
+                startWalk(folderHandle);
+            }
+        }
+        return;
+    }
+
+    if (mTrackedFolders.isEmpty())
+    {
+        return;
+    }
+
+    std::vector<NodeUpdate> updates;
+    updates.reserve(static_cast<size_t>(nodes->size()));
+    for (int index = 0; index < nodes->size(); ++index)
+    {
+        auto node(nodes->get(index));
+
+        NodeUpdate update;
+        update.handle = node->getHandle();
+        update.parent = node->getParentHandle();
+        update.isFile = node->isFile();
+        update.size = update.isFile ? std::max<qint64>(node->getSize(), 0) : 0;
+        update.removed = node->getChanges() & mega::MegaNode::CHANGE_TYPE_REMOVED;
+        update.moved = node->getChanges() & mega::MegaNode::CHANGE_TYPE_PARENT;
+        updates.push_back(update);
+    }
+
+    applyUpdates(updates);
+    if (!mWalkingFolders.isEmpty())
+    {
+        mUpdatesWhileWalking.insert(mUpdatesWhileWalking.end(), updates.begin(), updates.end());
+    }
+
+    emitChangedStats();
+}
+
+void RemoteFolderStatsIndex::onSyncRemoved(std::shared_ptr<SyncSettings> syncSettings)
+{
+    if (syncSettings)
+    {
+        untrack(syncSettings->getMegaHandle());
+    }
+}
+
+std::shared_ptr<RemoteFolderStatsIndex::Items>
+    RemoteFolderStatsIndex::walk(mega::MegaHandle folderHandle)
+{
+    auto items(std::make_shared<Items>());
+    auto megaApi(MegaSyncApp->getMegaApi());
+
+    std::unique_ptr<mega::MegaNode> folder(megaApi->getNodeByHandle(folderHandle));
+    if (!folder || folder->isFile())
+    {
+        return items;
+    }
+
+    Item root;
+    root.parent = folder->getParentHandle();
+    items->insert(folderHandle, root);
+
+    // Every node is added after its parent
+    std::vector<mega::MegaHandle> walkOrder{folderHandle};
+    std::vector<std::unique_ptr<mega::MegaNode>> pendingFolders;
+    pendingFolders.push_back(std::move(folder));
+    while (!pendingFolders.empty())
+    {
+        if (ThreadPool::isThreadInterrupted())
+        {
+            items->clear();
+            return items;
+        }
+
+        folder = std::move(pendingFolders.back());
+        pendingFolders.pop_back();
+
+        std::unique_ptr<mega::MegaNodeList> children(megaApi->getChildren(folder.get()));
+        for (int index = 0; index < children->size(); ++index)
+        {
+            auto child(children->get(index));
+
+            Item item;
+            item.parent = folder->getHandle();
+            item.isFile = child->isFile();
+            if (item.isFile)
+            {
+                item.stats.size = std::max<qint64>(child->getSize(), 0);
+            }
+            else
+            {
+                pendingFolders.emplace_back(child->copy());
+            }
+
+            items->insert(child->getHandle(), item);
+            walkOrder.push_back(child->getHandle());
+        }
+    }
+
+    // Backwards, the contents of each folder are complete before adding it to its parent
+    for (auto handleIt = walkOrder.crbegin(); handleIt != walkOrder.crend() - 1; ++handleIt)
+    {
+        const Item& item((*items)[*handleIt]);
+        const Stats contribution(getContribution(item));
+        Stats& parentStats((*items)[item.parent].stats);
+        parentStats.size += contribution.size;
+        parentStats.files += contribution.files;
+        parentStats.folders += contribution.folders;
+    }
+
+    return items;
+}
+
+RemoteFolderStatsIndex::Stats RemoteFolderStatsIndex::getContribution(const Item& item)
+{
+    Stats contribution(item.stats);
+    if (item.isFile)
+    {
+        ++contribution.files;
+    }
+    else
+    {
+        ++contribution.folders;
+    }
+    return contribution;
+}
+
+void RemoteFolderStatsIndex::startWalk(mega::MegaHandle folderHandle)
+{
+    mWalkingFolders.insert(folderHandle);
+    ThreadPoolSingleton::getInstance()->push(
+        [this, folderHandle]()
+        {
+            auto items(walk(folderHandle));
+            QMetaObject::invokeMethod(
+                this,
+                [this, folderHandle, items]()
+                {
+                    onWalkFinished(folderHandle, items);
+                },
+                Qt::QueuedConnection);
+        },
+        ThreadPool::Priority::BACKGROUND);
+}
+
+void RemoteFolderStatsIndex::onWalkFinished(mega::MegaHandle folderHandle,
+                                            std::shared_ptr<Items> items)
+{
+    mWalkingFolders.remove(folderHandle);
+    mWalkedFolders.insert(folderHandle);
+
+    const bool isTracked(mTrackedFolders.contains(folderHandle));
+    auto rootIt(items->constFind(folderHandle));
+    // Folders moved in are dropped if they have been moved out again meanwhile
+    if (rootIt != items->constEnd() && (isTracked || mItems.contains(rootIt->parent)))
+    {
+        const Item root(rootIt.value());
+
+        // What was known about the walked nodes is replaced
+        auto previousRootIt(mItems.constFind(folderHandle));
+        if (previousRootIt != mItems.constEnd())
+        {
+            addToAncestors(previousRootIt->parent, getContribution(previousRootIt.value()), -1);
+        }
+
+        if (mItems.isEmpty())
+        {
+            mItems.swap(*items);
+        }
+        else
+        {
+            for (auto itemIt = items->constBegin(); itemIt != items->constEnd(); ++itemIt)
+            {
+                mItems.insert(itemIt.key(), itemIt.value());
+            }
+        }
+
+        addToAncestors(root.parent, getContribution(root), 1);
+        if (isTracked)
+        {
+            mChangedTrackedFolders.insert(folderHandle);
+        }
+    }
+
+    // Applying them again is harmless for the nodes the walk already had in their last state
+    applyUpdates(mUpdatesWhileWalking);
+    if (mWalkingFolders.isEmpty())
+    {
+        mUpdatesWhileWalking.clear();
+        mWalkedFolders.clear();
+    }
+
+    emitChangedStats();
+}
+
+void RemoteFolderStatsIndex::applyUpdates(const std::vector<NodeUpdate>& updates)
+{
+    std::vector<const NodeUpdate*> pendingUpdates;
+    pendingUpdates.reserve(updates.size());
+    for (const auto& update : updates)
+    {
+        pendingUpdates.push_back(&update);
+    }
+
+    // The children of new folders can come before them
+    bool applied(true);
+    while (!pendingUpdates.empty() && applied)
+    {
+        applied = false;
+        std::vector<const NodeUpdate*> unknownParentUpdates;
+        for (auto update : pendingUpdates)
+        {
+            if (applyUpdate(*update))
+            {
+                applied = true;
+            }
+            else
+            {
+                unknownParentUpdates.push_back(update);
+            }
+        }
+        pendingUpdates.swap(unknownParentUpdates);
+    }
+
+    if (mHasDetachedItems)
+    {
+        eraseDetachedItems();
+    }
+}
+
+bool RemoteFolderStatsIndex::applyUpdate(const NodeUpdate& update)
+{
+    auto itemIt(mItems.find(update.handle));
+    if (itemIt != mItems.end())
+    {
+        if (!update.removed && itemIt->parent == update.parent)
+        {
+            // Renamed or any other change that does not move it
+            return true;
+        }
+
+        addToAncestors(itemIt->parent, getContribution(itemIt.value()), -1);
+
+        auto parentIt(mItems.constFind(update.parent));
+        const bool isInTrackedFolder(parentIt != mItems.constEnd() && !parentIt->isFile);
+        if (update.removed || (!isInTrackedFolder && !mTrackedFolders.contains(update.handle)))
+        {
+            // Removed, moved out of the tracked folders or now a previous version of a file.
+            // The contents are erased once the updates are applied, as the updates of some of
+            // them may come next.
+            mHasDetachedItems |= !itemIt->isFile;
+            mItems.erase(itemIt);
+        }
+        else
+        {
+            itemIt->parent = update.parent;
+            addToAncestors(update.parent, getContribution(itemIt.value()), 1);
+        }
+        return true;
+    }
+
+    if (update.removed)
+    {
+        return true;
+    }
+
+    auto parentIt(mItems.constFind(update.parent));
+    if (parentIt == mItems.constEnd())
+    {
+        return false;
+    }
+
+    // Previous versions of files are not counted
+    if (parentIt->isFile)
+    {
+        return true;
+    }
+
+    // Moved in with its contents
+    if (!update.isFile && update.moved)
+    {
+        // Not again when the update is applied on top of the walk results
+        if (!mWalkingFolders.contains(update.handle) && !mWalkedFolders.contains(update.handle))
+        {
+            startWalk(update.handle);
+        }
+        return true;
+    }
+
+    Item item;
+    item.parent = update.parent;
+    item.isFile = update.isFile;
+    item.stats.size = update.size;
+    mItems.insert(update.handle, item);
+    addToAncestors(update.parent, getContribution(item), 1);
+    return true;
+}
+
+void RemoteFolderStatsIndex::addToAncestors(mega::MegaHandle parent, const Stats& stats, int sign)
+{
+    for (auto itemIt = mItems.find(parent); itemIt != mItems.end();
+         itemIt = mItems.find(itemIt->parent))
+    {
+        itemIt->stats.size += sign * stats.size;
+        itemIt->stats.files += sign * stats.files;
+        itemIt->stats.folders += sign * stats.folders;
+
+        if (mTrackedFolders.contains(itemIt.key()))
+        {
+            mChangedTrackedFolders.insert(itemIt.key());
+        }
+    }
+}
+
+void RemoteFolderStatsIndex::eraseDetachedItems()
+{
+    mHasDetachedItems = false;
+
+    // Whether the items reach a tracked folder through their ancestors, known for every item
+    // once visited, so each one is only visited once
+    QHash<mega::MegaHandle, bool> attachedItems;
+    attachedItems.reserve(mItems.size());
+    std::vector<mega::MegaHandle> path;
+    for (auto itemIt = mItems.constBegin(); itemIt != mItems.constEnd(); ++itemIt)
+    {
+        path.clear();
+        bool attached(false);
+        auto handle(itemIt.key());
+        for (;;)
+        {
+            auto attachedIt(attachedItems.constFind(handle));
+            if (attachedIt != attachedItems.constEnd())
+            {
+                attached = attachedIt.value();
+                break;
+            }
+
+            auto ancestorIt(mItems.constFind(handle));
+            if (ancestorIt == mItems.constEnd())
+            {
+                break;
+            }
+
+            path.push_back(handle);
+            if (mTrackedFolders.contains(handle))
+            {
+                attached = true;
+                break;
+            }
+            handle = ancestorIt->parent;
+        }
+
+        for (auto pathHandle : path)
+        {
+            attachedItems.insert(pathHandle, attached);
+        }
+    }
+
+    for (auto itemIt = mItems.begin(); itemIt != mItems.end();)
+    {
+        if (attachedItems.value(itemIt.key()))
+        {
+            ++itemIt;
+        }
+        else
+        {
+            itemIt = mItems.erase(itemIt);
+        }
+    }
+}
+
+void RemoteFolderStatsIndex::emitChangedStats()
+{
+    const auto changedFolders(mChangedTrackedFolders);
+    mChangedTrackedFolders.clear();
+    for (auto folderHandle : changedFolders)
+    {
+        emit statsChanged(folderHandle);
+    }
+}
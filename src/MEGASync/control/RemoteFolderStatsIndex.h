@@ -0,0 +1,114 @@
+#ifndef REMOTE_FOLDER_STATS_INDEX_H
+#define REMOTE_FOLDER_STATS_INDEX_H
+
+#include "megaapi.h"
+#include "QTMegaGlobalListener.h"
+#include "SyncSettings.h"
+
+#include <QHash>
+#include <QObject>
+#include <QSet>
+
+#include <memory>
+#include <vector>
+
+/*
+ * Size, file count and folder count of the remote folders inside the tracked folders.
+ *
+ * A tracked folder is walked once in the thread pool, keeping the parent and the stats of every
+ * node below it. From then on the node updates (new, removed and moved nodes, new versions) are
+ * applied as deltas to the ancestors of the changed nodes, so the stats of any of those folders
+ * are a hash lookup instead of a walk of the subtree.
+ *
+ * It keeps an entry for each node of the tracked folders, so only the ones whose stats are
+ * shown all the time, as the sync and backup roots, should be tracked. The roots of the removed
+ * syncs are untracked, and everything is cleared on logout. It must be used from the GUI thread.
+ */
+class RemoteFolderStatsIndex : public QObject, public mega::MegaGlobalListener
+{
+    Q_OBJECT
+
+public:
+    struct Stats
+    {
+        qint64 size = 0;
+        qint64 files = 0;
+        qint64 folders = 0;
+    };
+
+    static RemoteFolderStatsIndex& instance()
+    {
+        static RemoteFolderStatsIndex instance;
+        return instance;
+    }
+
+    RemoteFolderStatsIndex(const RemoteFolderStatsIndex&) = delete;
+    RemoteFolderStatsIndex& operator=(const RemoteFolderStatsIndex&) = delete;
+
+    // statsChanged is emitted once the folder has been walked
+    void track(mega::MegaHandle folderHandle);
+    // Drops the nodes of the folder, unless they are inside another tracked folder
+    void untrack(mega::MegaHandle folderHandle);
+
+    // False for the folders not walked yet
+    bool getStats(mega::MegaHandle folderHandle, Stats& stats) const;
+    // -1 for the folders not walked yet
+    qint64 getSize(mega::MegaHandle folderHandle) const;
+
+    void clear();
+
+    void onNodesUpdate(mega::MegaApi* api, mega::MegaNodeList* nodes) override;
+
+signals:
+    void statsChanged(mega::MegaHandle trackedFolderHandle);
+
+private slots:
+    void onSyncRemoved(std::shared_ptr<SyncSettings> syncSettings);
+
+private:
+    struct Item
+    {
+        mega::MegaHandle parent = mega::INVALID_HANDLE;
+        // Own size for files, the one of the contents for folders
+        Stats stats;
+        bool isFile = false;
+    };
+
+    struct NodeUpdate
+    {
+        mega::MegaHandle handle = mega::INVALID_HANDLE;
+        mega::MegaHandle parent = mega::INVALID_HANDLE;
+        qint64 size = 0;
+        bool isFile = false;
+        bool removed = false;
+        bool moved = false;
+    };
+
+    using Items = QHash<mega::MegaHandle, Item>;
+
+    RemoteFolderStatsIndex();
+
+    static std::shared_ptr<Items> walk(mega::MegaHandle folderHandle);
+    static Stats getContribution(const Item& item);
+
+    void startWalk(mega::MegaHandle folderHandle);
+    void onWalkFinished(mega::MegaHandle folderHandle, std::shared_ptr<Items> items);
+    void applyUpdates(const std::vector<NodeUpdate>& updates);
+    bool applyUpdate(const NodeUpdate& update);
+    void addToAncestors(mega::MegaHandle parent, const Stats& stats, int sign);
+    void eraseDetachedItems();
+    void emitChangedStats();
+
+    Items mItems;
+    QSet<mega::MegaHandle> mTrackedFolders;
+    QSet<mega::MegaHandle> mWalkingFolders;
+    // Received while walking, they are applied again on top of the walk results
+    std::vector<NodeUpdate> mUpdatesWhileWalking;
+    QSet<mega::MegaHandle> mWalkedFolders;
+    QSet<mega::MegaHandle> mChangedTrackedFolders;
+    // Set when a folder is erased, its contents are left to eraseDetachedItems()
+    bool mHasDetachedItems;
+    std::unique_ptr<mega::QTMegaGlobalListener> mGlobalListener;
+};
+
+#endif // REMOTE_FOLDER_STATS_INDEX_H
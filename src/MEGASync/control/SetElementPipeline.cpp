@@ -0,0 +1,109 @@
+#include "SetElementPipeline.h"
+
+#include <QSet>
+
+#include <algorithm>
+
+// Enough to hide the round trip of each request without delaying other requests of the app
+const int SetElementPipeline::DEFAULT_MAX_PENDING_REQUESTS = 32;
+
+SetElementPipeline::SetElementPipeline(int maxPendingRequests):
+    mMaxPendingRequests(std::max(maxPendingRequests, 1)),
+    mTotal(0),
+    mNext(0),
+    mFinished(0),
+    mRequesting(false)
+{}
+
+QList<mega::MegaHandle>
+    SetElementPipeline::selectElements(const QList<mega::MegaHandle>& setElements,
+                                       const QList<mega::MegaHandle>& requestedElements)
+{
+    const auto requested(QSet<mega::MegaHandle>(requestedElements.cbegin(),
+                                                requestedElements.cend()));
+
+    const int maxSelectedElements(requested.isEmpty() ? setElements.size() : requested.size());
+    QList<mega::MegaHandle> selectedElements;
+    selectedElements.reserve(maxSelectedElements);
+
+    QSet<mega::MegaHandle> added;
+    added.reserve(maxSelectedElements);
+    for (auto handle : setElements)
+    {
+        if ((requested.isEmpty() || requested.contains(handle)) && !added.contains(handle))
+        {
+            added.insert(handle);
+            selectedElements.push_back(handle);
+        }
+    }
+
+    return selectedElements;
+}
+
+void SetElementPipeline::start(int total, std::function<void(int)> requestFunc)
+{
+    clear();
+    mTotal = std::max(total, 0);
+    mRequestFunc = std::move(requestFunc);
+    requestNext();
+}
+
+bool SetElementPipeline::onRequestFinished()
+{
+    if (!isRunning() || getPending() == 0)
+    {
+        return false;
+    }
+
+    mFinished++;
+    const bool lastRequest(mFinished == mTotal);
+
+    // Requests finished from inside the request function are refilled by the running loop,
+    // instead of nesting one call per Element
+    if (!mRequesting)
+    {
+        requestNext();
+    }
+
+    return lastRequest;
+}
+
+void SetElementPipeline::clear()
+{
+    mTotal = 0;
+    mNext = 0;
+    mFinished = 0;
+    mRequestFunc = nullptr;
+}
+
+bool SetElementPipeline::isRunning() const
+{
+    return mFinished < mTotal;
+}
+
+int SetElementPipeline::getFinished() const
+{
+    return mFinished;
+}
+
+int SetElementPipeline::getTotal() const
+{
+    return mTotal;
+}
+
+int SetElementPipeline::getPending() const
+{
+    return mNext - mFinished;
+}
+
+void SetElementPipeline::requestNext()
+{
+    mRequesting = true;
+    while (mNext < mTotal && getPending() < mMaxPendingRequests)
+    {
+        // The function can clear the pipeline
+        auto requestFunc(mRequestFunc);
+        requestFunc(mNext++);
+    }
+    mRequesting = false;
+}
@@ -0,0 +1,56 @@
+#ifndef SET_ELEMENT_PIPELINE_H
+#define SET_ELEMENT_PIPELINE_H
+
+#include "megaapi.h"
+
+#include <QList>
+
+#include <functional>
+
+//!
+//! \brief Keeps a bounded number of SDK requests in flight over the Elements of a Set.
+//!
+//! Each Element of a Set needs its own request to fetch its node, and another one to copy it
+//! when the Set is imported. Sending them all at once floods the SDK request queue with
+//! thousands of requests for large Sets, and sending them one after the other pays a full round
+//! trip per Element, so up to maxPendingRequests are kept in flight: every finished request
+//! makes room for the next one.
+//!
+//! The request function may finish the request right away (e.g. when there is nothing to copy)
+//! by calling onRequestFinished from inside it.
+//!
+class SetElementPipeline
+{
+public:
+    static const int DEFAULT_MAX_PENDING_REQUESTS;
+
+    explicit SetElementPipeline(int maxPendingRequests = DEFAULT_MAX_PENDING_REQUESTS);
+
+    // The Elements of setElements, in their order and without duplicates, that are in
+    // requestedElements. All of them if requestedElements is empty.
+    static QList<mega::MegaHandle> selectElements(const QList<mega::MegaHandle>& setElements,
+                                                  const QList<mega::MegaHandle>& requestedElements);
+
+    // Requests the Elements with index 0 to total - 1, in order
+    void start(int total, std::function<void(int index)> requestFunc);
+    // Returns true when it was the last request
+    bool onRequestFinished();
+    void clear();
+
+    bool isRunning() const;
+    int getFinished() const;
+    int getTotal() const;
+    int getPending() const;
+
+private:
+    void requestNext();
+
+    int mMaxPendingRequests;
+    int mTotal;
+    int mNext;
+    int mFinished;
+    bool mRequesting;
+    std::function<void(int)> mRequestFunc;
+};
+
+#endif // SET_ELEMENT_PIPELINE_H
@@ -310,6 +310,12 @@ void SetManager::handleStateWAIT_FOR_PREVIEW_SET_TO_GET_DATA(const ActionParams&
         break;
 
     case ActionType::HANDLE_ELEMENT_IN_PREVIEW_MODE:
+        if (!mElementNodeRequests.isRunning())
+        {
+            // Keep the nodes in the order of their Elements, whatever order they arrived in
+            mCurrentSet.nodeList = mFetchedElementNodes.toList();
+        }
+
         if (mCurrentSet.isComplete())
         {
             // Notify observers
@@ -351,9 +357,9 @@ void SetManager::handleStateWAIT_FOR_PREVIEW_SET_TO_DOWNLOAD_FROM_LINK(const Act
 
     case ActionType::HANDLE_ELEMENT_IN_PREVIEW_MODE:
         // A new Set Element node has been fetched
-        if (!mCurrentSet.nodeList.isEmpty())
+        if (action.elementNode)
         {
-            startDownload(mCurrentSet.nodeList.last().get(), mCurrentDownloadPath);
+            startDownload(action.elementNode.get(), mCurrentDownloadPath);
         }
         break;
 
@@ -546,13 +552,26 @@ void SetManager::handleGetPreviewElementNodeResponse(MegaRequest* request, MegaE
         return;
     }
 
+    // Responses to the requests of a Set that is not the current one anymore are dropped
+    const int index = mElementIndexByHandle.value(request->getNodeHandle(), -1);
+    if (index < 0 || mFetchedElementNodes.at(index)) { return; }
+
     // Do not expose the raw pointer in a variable, to prevent 'double-free' vulnerability
     MegaNodeSPtr nodeSPtr(request->getPublicMegaNode());
-    mCurrentSet.nodeList.push_back(nodeSPtr);
+    if (!nodeSPtr)
+    {
+        resetAndHandleStates();
+        return;
+    }
+    mFetchedElementNodes[index] = nodeSPtr;
+
+    // Make room for the next Element request
+    mElementNodeRequests.onRequestFinished();
 
     // Delegate to State Machine
     ActionParams action;
     action.type = ActionType::HANDLE_ELEMENT_IN_PREVIEW_MODE;
+    action.elementNode = nodeSPtr;
     mInternalActionQueue.push(action);
     handleStates();
 }
@@ -583,19 +602,37 @@ void SetManager::handleCreateFolderResponse(MegaRequest* request, MegaError* err
         return;
     }
 
-    // Copy (import) all Elements to the Cloud Drive
-    for (const auto& node : mCurrentSet.nodeList)
+    // The Elements already in the target destination, with the same name and size, are skipped
+    const auto existingNamesAndSizes(getNamesAndSizes(createdNode));
+    for (const auto& node : qAsConst(mCurrentSet.nodeList))
     {
-        if (!copyNode(node, createdNode))
+        QString name(QString::fromUtf8(node->getName()));
+        const auto nameAndSize(qMakePair(name, static_cast<long long>(node->getSize())));
+        if (existingNamesAndSizes.contains(nameAndSize))
         {
-            // The Element node already exists in the target destination
-            mAlreadyExistingImportElements.push_back(QString::fromUtf8(node->getName()));
+            mAlreadyExistingImportElements.push_back(name);
+        }
+        else
+        {
+            mElementNodesToCopy.push_back(node);
         }
     }
 
     // It could be, that all Elements already exist in the target destination
     // In that case, import has been completed
-    checkandHandleFinishedImport();
+    if (mElementNodesToCopy.isEmpty())
+    {
+        checkandHandleFinishedImport();
+        return;
+    }
+
+    // Copy (import) the rest of Elements to the Cloud Drive
+    mImportFolderNode = createdNode;
+    mCopyNodeRequests.start(mElementNodesToCopy.size(),
+                            [this](int index)
+                            {
+                                copyNode(mElementNodesToCopy.at(index), mImportFolderNode);
+                            });
 }
 
 void SetManager::handleCopyNodeResponse(MegaRequest* request, MegaError* error)
@@ -607,6 +644,9 @@ void SetManager::handleCopyNodeResponse(MegaRequest* request, MegaError* error)
         return;
     }
 
+    // Responses to the requests of a Set that is not the current one anymore are dropped
+    if (!mCopyNodeRequests.isRunning()) { return; }
+
     // Do not expose the raw pointer in a variable, to prevent 'double-free' vulnerability
     MegaNodeSPtr nodeSPtr(request->getPublicMegaNode());
     QString elementNodeName = QString::fromUtf8(nodeSPtr->getName());
@@ -620,6 +660,9 @@ void SetManager::handleCopyNodeResponse(MegaRequest* request, MegaError* error)
         mFailedImportElements.push_back(elementNodeName);
     }
 
+    // Make room for the next copy request
+    mCopyNodeRequests.onRequestFinished();
+
     checkandHandleFinishedImport();
 }
 
@@ -681,24 +724,19 @@ bool SetManager::getPreviewSetData()
     if (!elements) { return false; }
 
     const unsigned int nrElements = elements->size();
+    QList<MegaHandle> setElementHandleList;
+    setElementHandleList.reserve(static_cast<int>(nrElements));
     for (unsigned int i = 0; i < nrElements; i++)
     {
-        MegaHandle handle = elements->get(i)->id();
-
-        // Only process Elements that were specifically requested by the user:
-        // If no specific Elements were requested, then request all of them
-        if (mCurrentElementHandleList.isEmpty() ||
-            mCurrentElementHandleList.contains(handle))
-        {
-            // Avoid duplicates
-            if (!mCurrentSet.elementHandleList.contains(handle))
-            {
-                mCurrentSet.elementHandleList.push_back(handle);
-            }
-        }
-     }
+        setElementHandleList.push_back(elements->get(i)->id());
+    }
     delete elements;
 
+    // Only process Elements that were specifically requested by the user, without duplicates:
+    // If no specific Elements were requested, then request all of them
+    mCurrentSet.elementHandleList =
+        SetElementPipeline::selectElements(setElementHandleList, mCurrentElementHandleList);
+
     return true;
 }
 
@@ -718,11 +756,12 @@ AlbumCollection SetManager::filterSet(const AlbumCollection& srcSet, const QList
     dstSet.name = srcSet.name;
     dstSet.link = srcSet.link;
 
+    const QSet<MegaHandle> keptHandles(elementHandleList.cbegin(), elementHandleList.cend());
     const int nrElements = srcSet.elementHandleList.size();
     for (int i = 0; i < nrElements; i++)
     {
         MegaHandle handle = srcSet.elementHandleList[i];
-        if (elementHandleList.contains(handle))
+        if (keptHandles.contains(handle))
         {
             // This handle and its corresponding node can be included
             dstSet.elementHandleList.push_back(handle);
@@ -736,16 +775,29 @@ AlbumCollection SetManager::filterSet(const AlbumCollection& srcSet, const QList
 //!
 //! \brief SetManager::getPreviewElementNodes
 //! \Requests the nodes of the Set Elements with an ID in @mCurrentSet.elementIDList.
+//! \Only a window of requests is in flight, each response sends the next request.
 //! NOTE: Caller must ensure that the Set in preview, otherwise the request will fail.
 bool SetManager::getPreviewElementNodes()
 {
     if (mCurrentSet.elementHandleList.isEmpty()) { return false; }
 
-    // Fetch all Elements
-    for (const auto& handle : mCurrentSet.elementHandleList)
+    const int nrElements = mCurrentSet.elementHandleList.size();
+    mElementIndexByHandle.clear();
+    mElementIndexByHandle.reserve(nrElements);
+    for (int i = 0; i < nrElements; i++)
     {
-        mMegaApi->getPreviewElementNode(handle, mDelegateListener.get());
+        mElementIndexByHandle.insert(mCurrentSet.elementHandleList.at(i), i);
     }
+    mFetchedElementNodes = QVector<MegaNodeSPtr>(nrElements);
+
+    // Fetch all Elements
+    mElementNodeRequests.start(nrElements,
+                               [this](int index)
+                               {
+                                   mMegaApi->getPreviewElementNode(
+                                       mCurrentSet.elementHandleList.at(index),
+                                       mDelegateListener.get());
+                               });
 
     return true;
 }
@@ -762,6 +814,12 @@ void SetManager::reset()
     mSucceededImportElements.clear();
     mFailedImportElements.clear();
     mAlreadyExistingImportElements.clear();
+    mElementNodeRequests.clear();
+    mCopyNodeRequests.clear();
+    mElementIndexByHandle.clear();
+    mFetchedElementNodes.clear();
+    mElementNodesToCopy.clear();
+    mImportFolderNode = nullptr;
 }
 
 void SetManager::resetAndHandleStates()
@@ -791,39 +849,35 @@ void SetManager::startDownload(MegaNode* linkNode, const QString& localPath)
 //! \brief SetManager::copyNode
 //! \param linkNode: the source node to copy
 //! \param importParentNode: import parent destination folder on Cloud Drive
-//! \Copies @linkNode to @importParentNode, if a node with the same name and
-//! \size doesn't already exist at the destination.
-//! \Returns true if a copy/import request was made to SDK, false otherwise
+//! \Requests to copy @linkNode to @importParentNode.
 //!
-bool SetManager::copyNode(MegaNodeSPtr linkNode, MegaNodeSPtr importParentNode)
+void SetManager::copyNode(MegaNodeSPtr linkNode, MegaNodeSPtr importParentNode)
 {
-    if (!linkNode || !importParentNode) { return false; }
-
-    // Returns true if a similar node to @node, with the same name and size,
-    // already exists in import folder @importNode. Returns false otherwise.
-    auto alreadyExists = [&](MegaNodeSPtr node, MegaNodeSPtr importNode) -> bool {
-        std::unique_ptr<MegaNodeList> children(mMegaApi->getChildren(importNode.get()));
-        const char* srcName = node->getName();
-        const long long srcSize = node->getSize();
-        const int nrChildren = children->size();
+    if (!linkNode || !importParentNode) { return; }
 
-        for (int i = 0; i < nrChildren; i++)
-        {
-            MegaNode* child = children->get(i);
-            if (!strcmp(srcName, child->getName()) && (srcSize == child->getSize()))
-            {
-                return true;
-            }
-        }
+    mMegaApi->copyNode(linkNode.get(), importParentNode.get(), mDelegateListener.get());
+}
 
-        return false;
-    };
+//!
+//! \brief SetManager::getNamesAndSizes
+//! \param folderNode: import parent destination folder on Cloud Drive
+//! \Returns the name and size of every child of @folderNode, to find the Elements that already
+//! \exist at the destination without going through the children once per Element.
+//!
+QSet<QPair<QString, long long>> SetManager::getNamesAndSizes(MegaNodeSPtr folderNode)
+{
+    QSet<QPair<QString, long long>> namesAndSizes;
+    if (!folderNode) { return namesAndSizes; }
 
-    if (!alreadyExists(linkNode, importParentNode))
+    std::unique_ptr<MegaNodeList> children(mMegaApi->getChildren(folderNode.get()));
+    const int nrChildren = children->size();
+    namesAndSizes.reserve(nrChildren);
+    for (int i = 0; i < nrChildren; i++)
     {
-        mMegaApi->copyNode(linkNode.get(), importParentNode.get(), mDelegateListener.get());
-        return true;
+        MegaNode* child = children->get(i);
+        namesAndSizes.insert(qMakePair(QString::fromUtf8(child->getName()),
+                                       static_cast<long long>(child->getSize())));
     }
 
-    return false;
+    return namesAndSizes;
 }
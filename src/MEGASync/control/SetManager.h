@@ -4,11 +4,16 @@
 #include "AsyncHandler.h"
 #include "megaapi.h"
 #include "QTMegaTransferListener.h"
+#include "SetElementPipeline.h"
 #include "SetTypes.h"
 
+#include <QHash>
 #include <QList>
 #include <QMutex>
 #include <QObject>
+#include <QPair>
+#include <QSet>
+#include <QVector>
 
 #include <memory>
 
@@ -45,6 +50,7 @@ struct ActionParams
     QList<mega::MegaHandle> elementHandleList;
     QString downloadPath;
     MegaNodeSPtr importParentNode;
+    MegaNodeSPtr elementNode;
 };
 
 class SetManager: public QObject, public mega::MegaTransferListener, public AsyncHandler<bool>
@@ -109,8 +115,9 @@ private:
     void reset();
     void resetAndHandleStates();
     void startDownload(mega::MegaNode* linkNode, const QString& localPath);
-    bool copyNode(MegaNodeSPtr linkNode, MegaNodeSPtr importParentNode);
+    void copyNode(MegaNodeSPtr linkNode, MegaNodeSPtr importParentNode);
     void checkandHandleFinishedImport();
+    QSet<QPair<QString, long long>> getNamesAndSizes(MegaNodeSPtr folderNode);
 
 private:
     mega::MegaApi* mMegaApi;
@@ -129,6 +136,14 @@ private:
     QStringList mSucceededImportElements;
     QStringList mAlreadyExistingImportElements;
 
+    // Requests in flight over the Elements of the current Set
+    SetElementPipeline mElementNodeRequests;
+    SetElementPipeline mCopyNodeRequests;
+    QHash<mega::MegaHandle, int> mElementIndexByHandle;
+    QVector<MegaNodeSPtr> mFetchedElementNodes;
+    QList<MegaNodeSPtr> mElementNodesToCopy;
+    MegaNodeSPtr mImportFolderNode;
+
     // State machine
     QMutex mSetManagerStateMutex;
     SetManagerState mSetManagerState;
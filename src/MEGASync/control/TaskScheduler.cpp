@@ -0,0 +1,172 @@
+#include "TaskScheduler.h"
+
+#include "megaapi.h"
+
+#include <algorithm>
+
+using namespace mega;
+
+TaskScheduler::TaskScheduler(QObject* parent):
+    QObject(parent),
+    mRunning(false)
+{
+}
+
+TaskScheduler::TaskId TaskScheduler::addTask(const QString& name,
+                                             std::function<Result()> task,
+                                             int minIntervalMs,
+                                             int maxIntervalMs,
+                                             bool wakeOnUserActivity)
+{
+    auto newTask = std::make_unique<Task>();
+    newTask->name = name;
+    newTask->function = std::move(task);
+    newTask->minIntervalMs = minIntervalMs;
+    newTask->maxIntervalMs = std::max(minIntervalMs, maxIntervalMs);
+    newTask->intervalMs = minIntervalMs;
+    newTask->wakeOnUserActivity = wakeOnUserActivity;
+    newTask->runs = 0;
+    newTask->wakeUps = 0;
+    newTask->timer.setSingleShot(true);
+    // Let the OS group these wakeups with the rest of the app ones
+    newTask->timer.setTimerType(Qt::CoarseTimer);
+
+    Task* taskPtr = newTask.get();
+    connect(&taskPtr->timer, &QTimer::timeout, this, [this, taskPtr]() { runTask(taskPtr); });
+
+    mTasks.push_back(std::move(newTask));
+
+    if (mRunning)
+    {
+        taskPtr->timer.start(taskPtr->intervalMs);
+    }
+
+    return static_cast<TaskId>(mTasks.size() - 1);
+}
+
+void TaskScheduler::start()
+{
+    mRunning = true;
+    for (auto& task : mTasks)
+    {
+        if (!task->timer.isActive())
+        {
+            task->timer.start(task->intervalMs);
+        }
+    }
+}
+
+void TaskScheduler::stop()
+{
+    mRunning = false;
+    for (auto& task : mTasks)
+    {
+        task->timer.stop();
+    }
+}
+
+void TaskScheduler::runNow(TaskId taskId)
+{
+    auto task = getTask(taskId);
+    if (task && mRunning)
+    {
+        // Several requests in a row end up in a single run
+        task->timer.start(0);
+    }
+}
+
+void TaskScheduler::wakeUp(TaskId taskId)
+{
+    auto task = getTask(taskId);
+    if (task)
+    {
+        wakeUp(task);
+    }
+}
+
+void TaskScheduler::registerUserActivity()
+{
+    for (auto& task : mTasks)
+    {
+        if (task->wakeOnUserActivity)
+        {
+            wakeUp(task.get());
+        }
+    }
+}
+
+QList<TaskScheduler::TaskStats> TaskScheduler::getStats() const
+{
+    QList<TaskStats> stats;
+    for (const auto& task : mTasks)
+    {
+        TaskStats taskStats;
+        taskStats.name = task->name;
+        taskStats.runs = task->runs;
+        taskStats.wakeUps = task->wakeUps;
+        taskStats.intervalMs = task->intervalMs;
+        stats.append(taskStats);
+    }
+    return stats;
+}
+
+void TaskScheduler::logStats() const
+{
+    for (const auto& taskStats : getStats())
+    {
+        MegaApi::log(MegaApi::LOG_LEVEL_DEBUG,
+                     QString::fromUtf8("Scheduled task %1: %2 runs, %3 wake ups, interval %4 ms")
+                         .arg(taskStats.name)
+                         .arg(taskStats.runs)
+                         .arg(taskStats.wakeUps)
+                         .arg(taskStats.intervalMs)
+                         .toUtf8()
+                         .constData());
+    }
+}
+
+TaskScheduler::Task* TaskScheduler::getTask(TaskId taskId) const
+{
+    if (taskId < 0 || taskId >= static_cast<TaskId>(mTasks.size()))
+    {
+        return nullptr;
+    }
+    return mTasks[static_cast<size_t>(taskId)].get();
+}
+
+void TaskScheduler::runTask(Task* task)
+{
+    task->timer.stop();
+    ++task->runs;
+
+    if (task->function() == Result::BUSY)
+    {
+        task->intervalMs = task->minIntervalMs;
+    }
+    else
+    {
+        task->intervalMs = std::min(task->intervalMs * 2, task->maxIntervalMs);
+    }
+
+    // The task may have stopped the scheduler, or asked to run again
+    if (mRunning && !task->timer.isActive())
+    {
+        task->timer.start(task->intervalMs);
+    }
+}
+
+void TaskScheduler::wakeUp(Task* task)
+{
+    if (task->intervalMs == task->minIntervalMs && task->timer.isActive())
+    {
+        return;
+    }
+
+    task->intervalMs = task->minIntervalMs;
+    if (mRunning &&
+        (!task->timer.isActive() || task->timer.remainingTime() > task->minIntervalMs))
+    {
+        ++task->wakeUps;
+        task->timer.start(task->minIntervalMs);
+    }
+}
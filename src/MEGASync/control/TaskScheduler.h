@@ -0,0 +1,86 @@
+#ifndef TASKSCHEDULER_H
+#define TASKSCHEDULER_H
+
+#include <QList>
+#include <QObject>
+#include <QString>
+#include <QTimer>
+
+#include <functional>
+#include <memory>
+#include <vector>
+
+//!
+//! \brief Runs the recurring tasks of the app only as often as they can have something to do.
+//!
+//! Every task has its own coarse single shot timer. After each run the task tells whether it
+//! found work: busy tasks run again after their minimum interval, idle ones double their interval
+//! up to the maximum. The events a task depends on (SDK updates, user activity...) wake it up,
+//! which brings the interval back to the minimum, or run it right away.
+//!
+//! The runs and wake ups of every task are counted to keep track of the timer wakeups.
+//!
+class TaskScheduler: public QObject
+{
+    Q_OBJECT
+
+public:
+    enum class Result
+    {
+        BUSY,
+        IDLE
+    };
+
+    using TaskId = int;
+    static const TaskId INVALID_TASK = -1;
+
+    struct TaskStats
+    {
+        QString name;
+        quint64 runs = 0;
+        quint64 wakeUps = 0;
+        int intervalMs = 0;
+    };
+
+    explicit TaskScheduler(QObject* parent = nullptr);
+
+    //! \brief Tasks with the same min and max interval run at a fixed rate.
+    TaskId addTask(const QString& name,
+                   std::function<Result()> task,
+                   int minIntervalMs,
+                   int maxIntervalMs,
+                   bool wakeOnUserActivity = false);
+
+    void start();
+    void stop();
+
+    void runNow(TaskId taskId);
+    void wakeUp(TaskId taskId);
+    void registerUserActivity();
+
+    QList<TaskStats> getStats() const;
+    void logStats() const;
+
+private:
+    struct Task
+    {
+        QString name;
+        std::function<Result()> function;
+        int minIntervalMs;
+        int maxIntervalMs;
+        int intervalMs;
+        bool wakeOnUserActivity;
+        quint64 runs;
+        quint64 wakeUps;
+        QTimer timer;
+    };
+
+    Task* getTask(TaskId taskId) const;
+    void runTask(Task* task);
+    void wakeUp(Task* task);
+
+    std::vector<std::unique_ptr<Task>> mTasks;
+    bool mRunning;
+};
+
+#endif // TASKSCHEDULER_H
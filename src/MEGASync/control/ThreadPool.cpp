@@ -1,7 +1,11 @@
 #include "ThreadPool.h"
 
+#include "megaapi.h"
+
+#include <QString>
 #include <QtGlobal>
 
+#include <algorithm>
 #include <string>
 
 #ifdef Q_OS_LINUX
@@ -9,10 +13,30 @@
 #endif
 
 thread_local std::atomic<bool>* ThreadPool::mLocalToThreadDone = nullptr;
+thread_local ThreadPool* ThreadPool::mLocalPool = nullptr;
+thread_local std::size_t ThreadPool::mLocalWorkerIndex = 0;
+
+namespace
+{
+const char* PRIORITY_NAMES[ThreadPool::PRIORITIES] = {"interactive", "normal", "background"};
+const int INTERACTIVE = static_cast<int>(ThreadPool::Priority::INTERACTIVE);
+}
 
 ThreadPool::ThreadPool(const std::size_t threadCount)
 {
     Q_ASSERT(threadCount > 0);
+    // Keep a worker for the tasks somebody is waiting for, and another one for the normal ones
+    for (int priority = 0; priority < PRIORITIES; ++priority)
+    {
+        const auto reserved = static_cast<std::size_t>(priority);
+        mMaxWorkers[priority] = threadCount > reserved ? threadCount - reserved : 1;
+    }
+
+    for (std::size_t i = 0; i < threadCount; ++i)
+    {
+        mWorkers.push_back(std::make_unique<Worker>());
+    }
+
     for (std::size_t i = 0; i < threadCount; ++i)
     {
         std::thread thread;
@@ -43,13 +67,78 @@ ThreadPool::~ThreadPool()
     shutdown();
 }
 
-void ThreadPool::push(std::function<void()> functor)
+void ThreadPool::push(std::function<void()> functor, Priority priority)
+{
+    Task task;
+    task.functor = std::move(functor);
+    enqueue(std::move(task), priority);
+}
+
+void ThreadPool::push(std::function<void()> functor, Priority priority, CancellationToken token)
+{
+    Task task;
+    task.functor = std::move(functor);
+    task.token = std::move(token);
+    enqueue(std::move(task), priority);
+}
+
+ThreadPool::Stats ThreadPool::getStats() const
 {
+    Stats stats;
+    qint64 totalLatencyUs[PRIORITIES] = {};
+    for (const auto& worker : mWorkers)
     {
-        std::lock_guard<std::mutex> lock{mMutex};
-        mFunctors.push(std::move(functor));
+        for (int priority = 0; priority < PRIORITIES; ++priority)
+        {
+            stats.executed[priority] += worker->executed[priority];
+            totalLatencyUs[priority] += worker->totalLatencyUs[priority];
+            stats.maxLatencyUs[priority] =
+                std::max(stats.maxLatencyUs[priority], worker->maxLatencyUs[priority].load());
+        }
+        stats.stolen += worker->stolen;
+        stats.cancelled += worker->cancelled;
+    }
+
+    for (int priority = 0; priority < PRIORITIES; ++priority)
+    {
+        stats.queued[priority] = mPending[priority];
+        if (stats.executed[priority])
+        {
+            stats.averageLatencyUs[priority] =
+                totalLatencyUs[priority] / static_cast<qint64>(stats.executed[priority]);
+        }
+    }
+    return stats;
+}
+
+void ThreadPool::logStats() const
+{
+    const Stats stats(getStats());
+    for (int priority = 0; priority < PRIORITIES; ++priority)
+    {
+        mega::MegaApi::log(
+            mega::MegaApi::LOG_LEVEL_DEBUG,
+            QString::fromUtf8("Thread pool %1 tasks: %2 run, %3 queued, latency %4 us (max %5 us)")
+                .arg(QString::fromUtf8(PRIORITY_NAMES[priority]))
+                .arg(stats.executed[priority])
+                .arg(stats.queued[priority])
+                .arg(stats.averageLatencyUs[priority])
+                .arg(stats.maxLatencyUs[priority])
+                .toUtf8()
+                .constData());
     }
-    mCv.notify_one();
+
+    mega::MegaApi::log(mega::MegaApi::LOG_LEVEL_DEBUG,
+                       QString::fromUtf8("Thread pool: %1 tasks stolen, %2 cancelled")
+                           .arg(stats.stolen)
+                           .arg(stats.cancelled)
+                           .toUtf8()
+                           .constData());
+}
+
+std::size_t ThreadPool::getThreadCount() const
+{
+    return mWorkers.size();
 }
 
 bool ThreadPool::isThreadInterrupted()
@@ -64,6 +153,172 @@ bool ThreadPool::isThreadInterrupted()
     }
 }
 
+void ThreadPool::enqueue(Task task, Priority priority)
+{
+    const int queue = static_cast<int>(priority);
+    task.queuedTime = Clock::now();
+
+    // Tasks pushed from a worker stay with it, the rest are spread among all of them
+    const std::size_t index = mLocalPool == this ? mLocalWorkerIndex
+                                                 : mNextWorker++ % mWorkers.size();
+    {
+        auto& worker = *mWorkers[index];
+        std::lock_guard<std::mutex> lock{worker.mutex};
+        worker.queues[queue].push_back(std::move(task));
+        ++mPending[queue];
+    }
+    wakeWorker();
+}
+
+bool ThreadPool::takeTask(std::size_t index, Task& task, int& priority)
+{
+    for (priority = 0; priority < PRIORITIES; ++priority)
+    {
+        if (!mPending[priority])
+        {
+            continue;
+        }
+
+        if (!acquireSlot(priority))
+        {
+            return false;
+        }
+
+        if (takeTaskWithPriority(index, priority, task))
+        {
+            return true;
+        }
+
+        releaseSlot(priority);
+    }
+
+    return false;
+}
+
+bool ThreadPool::acquireSlot(int priority)
+{
+    // A task counts for its priority and the more urgent ones but the interactive one, which
+    // has no limit
+    for (int level = priority; level > INTERACTIVE; --level)
+    {
+        // When closing, the pending tasks are run on all the workers
+        const bool slotAvailable = mRunning[level]++ < mMaxWorkers[level];
+        if (!slotAvailable && !mDone)
+        {
+            for (int acquired = level; acquired <= priority; ++acquired)
+            {
+                --mRunning[acquired];
+            }
+            return false;
+        }
+    }
+    return true;
+}
+
+void ThreadPool::releaseSlot(int priority)
+{
+    for (int level = priority; level > INTERACTIVE; --level)
+    {
+        --mRunning[level];
+    }
+}
+
+bool ThreadPool::takeTaskWithPriority(std::size_t index, int priority, Task& task)
+{
+    // The oldest task from its own queue first...
+    {
+        auto& worker = *mWorkers[index];
+        std::lock_guard<std::mutex> lock{worker.mutex};
+        auto& queue = worker.queues[priority];
+        if (!queue.empty())
+        {
+            task = std::move(queue.front());
+            queue.pop_front();
+            --mPending[priority];
+            return true;
+        }
+    }
+
+    // ...then the newest one of another worker, the one its owner would get to last
+    for (std::size_t offset = 1; offset < mWorkers.size(); ++offset)
+    {
+        auto& victim = *mWorkers[(index + offset) % mWorkers.size()];
+        std::lock_guard<std::mutex> lock{victim.mutex};
+        auto& queue = victim.queues[priority];
+        if (!queue.empty())
+        {
+            task = std::move(queue.back());
+            queue.pop_back();
+            --mPending[priority];
+            ++mWorkers[index]->stolen;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+bool ThreadPool::hasRunnableTask() const
+{
+    if (mPending[INTERACTIVE])
+    {
+        return true;
+    }
+
+    for (int priority = INTERACTIVE + 1; priority < PRIORITIES; ++priority)
+    {
+        if (!mDone && mRunning[priority] >= mMaxWorkers[priority])
+        {
+            // Neither these tasks nor the less urgent ones can start
+            return false;
+        }
+
+        if (mPending[priority])
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+bool ThreadPool::waitForTask()
+{
+    std::unique_lock<std::mutex> lock{mMutex};
+    // Counted before checking for tasks: a task pushed after the check sees it and wakes it up
+    ++mSleeping;
+    mCv.wait(lock, [this]
+    {
+        return mDone || hasRunnableTask();
+    });
+    --mSleeping;
+    return !mDone || hasRunnableTask();
+}
+
+void ThreadPool::wakeWorker()
+{
+    if (mSleeping)
+    {
+        // Taken so that the worker is either waiting or has not checked for tasks yet
+        std::lock_guard<std::mutex> lock{mMutex};
+        mCv.notify_one();
+    }
+}
+
+void ThreadPool::updateStats(std::size_t index, int priority, Clock::time_point queuedTime)
+{
+    const qint64 latencyUs =
+        std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - queuedTime).count();
+
+    auto& worker = *mWorkers[index];
+    ++worker.executed[priority];
+    worker.totalLatencyUs[priority] += latencyUs;
+    if (latencyUs > worker.maxLatencyUs[priority])
+    {
+        worker.maxLatencyUs[priority] = latencyUs;
+    }
+}
+
 void ThreadPool::worker(const std::size_t index)
 {
     const auto threadName = "TPw" + std::to_string(index);
@@ -75,30 +330,47 @@ void ThreadPool::worker(const std::size_t index)
     }
 #endif
     mLocalToThreadDone = &mDone;
+    mLocalPool = this;
+    mLocalWorkerIndex = index;
     for (;;)
     {
-        std::function<void()> functor;
+        if (!hasRunnableTask() && !waitForTask())
+        {
+            break;
+        }
+
+        Task task;
+        int priority;
+        if (!takeTask(index, task, priority))
+        {
+            // Another worker was faster
+            continue;
+        }
+
+        if (task.token && task.token->isCancelled())
+        {
+            ++mWorkers[index]->cancelled;
+        }
+        else
         {
-            std::unique_lock<std::mutex> lock{mMutex};
-            mCv.wait(lock, [this]
+            updateStats(index, priority, task.queuedTime);
+            try
             {
-                return mDone || !mFunctors.empty();
-            });
-            if (mDone && mFunctors.empty())
+                task.functor();
+            }
+            catch (const std::exception& e)
             {
-                break;
+                qCritical("ThreadPool: Error: %s", e.what());
+                Q_ASSERT(false);
             }
-            functor = std::move(mFunctors.front());
-            mFunctors.pop();
-        }
-        try
-        {
-            functor();
         }
-        catch (const std::exception& e)
+
+        if (priority != INTERACTIVE)
         {
-            qCritical("ThreadPool: Error: %s", e.what());
-            Q_ASSERT(false);
+            releaseSlot(priority);
+
+            // A worker may be waiting for a slot
+            wakeWorker();
         }
     }
 }
@@ -116,4 +388,3 @@ void ThreadPool::shutdown()
     }
     mThreads.clear();
 }
-
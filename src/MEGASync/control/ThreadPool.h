@@ -1,39 +1,211 @@
 #ifndef THREAD_POOL_H
 #define THREAD_POOL_H
 
+#include <QFuture>
+#include <QFutureInterface>
 #include <QtGlobal>
 
+#include <atomic>
+#include <chrono>
 #include <condition_variable>
 #include <cstddef>
+#include <deque>
 #include <functional>
+#include <memory>
 #include <mutex>
-#include <queue>
+#include <optional>
 #include <thread>
+#include <type_traits>
 #include <vector>
 
+//!
+//! \brief Shared flag to cancel a task pushed to the ThreadPool.
+//!
+//! Tasks cancelled before they start are dropped by the pool. Long tasks should check
+//! isCancelled() every now and then and return early. Copies share the same flag.
+//!
+class CancellationToken
+{
+public:
+    CancellationToken():
+        mCancelled(std::make_shared<std::atomic<bool>>(false))
+    {
+    }
+
+    void cancel()
+    {
+        *mCancelled = true;
+    }
+
+    bool isCancelled() const
+    {
+        return *mCancelled;
+    }
+
+private:
+    std::shared_ptr<std::atomic<bool>> mCancelled;
+};
+
+//!
+//! \brief Runs the background work of the app, also the one done with QtConcurrent before.
+//!
+//! Every worker has its own queue per priority. Tasks pushed from a worker go to its own queues,
+//! the rest are spread among the workers, and idle workers steal from the queues of the others.
+//! Pushing and taking a task only lock the queues involved: the pool lock is only taken to put a
+//! worker with nothing to run to sleep, and to wake it up. Workers always take the most urgent task
+//! available. One worker never takes normal or background tasks and another one never takes
+//! background tasks, so neither long jobs such as folder walks nor a burst of normal tasks can
+//! delay the work the UI is waiting for.
+//!
 class ThreadPool
 {
 public:
+    enum class Priority
+    {
+        INTERACTIVE, // The UI is blocked or the user is waiting for the result
+        NORMAL,
+        BACKGROUND, // Long jobs nobody is waiting for
+    };
+    static constexpr int PRIORITIES = 3;
+
+    struct Stats
+    {
+        // Indexed by priority
+        std::size_t queued[PRIORITIES] = {};
+        quint64 executed[PRIORITIES] = {};
+        qint64 averageLatencyUs[PRIORITIES] = {};
+        qint64 maxLatencyUs[PRIORITIES] = {};
+
+        quint64 stolen = 0;
+        quint64 cancelled = 0;
+    };
 
     explicit ThreadPool(std::size_t threadCount);
     ~ThreadPool();
 
     Q_DISABLE_COPY(ThreadPool)
 
-    void push(std::function<void()> functor);
+    void push(std::function<void()> functor, Priority priority = Priority::NORMAL);
+    void push(std::function<void()> functor, Priority priority, CancellationToken token);
+
+    //!
+    //! \brief Replacement of QtConcurrent::run: the result is reported through the future.
+    //!
+    //! The functor is not run if the future is cancelled before it starts. The future is
+    //! finished even if the functor throws, with a default constructed result.
+    //!
+    template<typename Functor>
+    QFuture<std::invoke_result_t<Functor>> run(Priority priority, Functor functor);
+
+    Stats getStats() const;
+    void logStats() const;
+
+    std::size_t getThreadCount() const;
+
     static bool isThreadInterrupted();
 
 private:
+    using Clock = std::chrono::steady_clock;
+
+    struct Task
+    {
+        std::function<void()> functor;
+        std::optional<CancellationToken> token;
+        Clock::time_point queuedTime;
+    };
+
+    struct Worker
+    {
+        std::mutex mutex;
+        std::deque<Task> queues[PRIORITIES];
+
+        // Only written by the thread of the worker
+        std::atomic<quint64> executed[PRIORITIES] {};
+        std::atomic<qint64> totalLatencyUs[PRIORITIES] {};
+        std::atomic<qint64> maxLatencyUs[PRIORITIES] {};
+        std::atomic<quint64> stolen {0};
+        std::atomic<quint64> cancelled {0};
+    };
+
+    void enqueue(Task task, Priority priority);
+    bool takeTask(std::size_t index, Task& task, int& priority);
+    bool acquireSlot(int priority);
+    void releaseSlot(int priority);
+    bool takeTaskWithPriority(std::size_t index, int priority, Task& task);
+    bool hasRunnableTask() const;
+    bool waitForTask();
+    void wakeWorker();
+    void updateStats(std::size_t index, int priority, Clock::time_point queuedTime);
+
     void worker(std::size_t index);
 
     void shutdown();
 
     std::atomic<bool> mDone {false} ;
     static thread_local std::atomic<bool>* mLocalToThreadDone;
+    static thread_local ThreadPool* mLocalPool;
+    static thread_local std::size_t mLocalWorkerIndex;
 
+    std::vector<std::unique_ptr<Worker>> mWorkers;
     std::vector<std::thread> mThreads;
-    std::queue<std::function<void()>> mFunctors;
+    std::atomic<std::size_t> mNextWorker {0};
+    std::atomic<std::size_t> mPending[PRIORITIES] {};
+    // Limits of the workers running tasks of each priority or lower, indexed by priority
+    std::atomic<std::size_t> mRunning[PRIORITIES] {};
+    std::size_t mMaxWorkers[PRIORITIES];
+    // Workers waiting for a task, the pool lock is only taken to wake them up
+    std::atomic<std::size_t> mSleeping {0};
     std::condition_variable mCv;
     std::mutex mMutex;
 };
+
+template<typename Functor>
+QFuture<std::invoke_result_t<Functor>> ThreadPool::run(Priority priority, Functor functor)
+{
+    using Result = std::invoke_result_t<Functor>;
+
+    auto futureInterface = std::make_shared<QFutureInterface<Result>>();
+    futureInterface->reportStarted();
+    auto future = futureInterface->future();
+
+    push(
+        [futureInterface, functor = std::move(functor)]() mutable
+        {
+            // Reported finished in any case, nobody waits forever for a functor that threw
+            struct FinishReporter
+            {
+                QFutureInterface<Result>& futureInterface;
+
+                ~FinishReporter()
+                {
+                    futureInterface.reportFinished();
+                }
+            } finishReporter{*futureInterface};
+
+            if (!futureInterface->isCanceled())
+            {
+                if constexpr (std::is_void_v<Result>)
+                {
+                    functor();
+                }
+                else
+                {
+                    // The watchers read the result once finished, they get a default one
+                    try
+                    {
+                        futureInterface->reportResult(functor());
+                    }
+                    catch (...)
+                    {
+                        futureInterface->reportResult(Result());
+                        throw;
+                    }
+                }
+            }
+        },
+        priority);
+
+    return future;
+}
+
 #endif
@@ -3,6 +3,7 @@
 // clang-format off
 #include "Platform.h"
 #include "gzjoin.h"
+#include "ImageCache.h"
 #include "MegaApiSynchronizedRequest.h"
 #include "MegaApplication.h"
 #include "Preferences.h"
@@ -556,6 +557,9 @@ void Utilities::removeAvatars()
     {
         avatarsDirectory.remove(avatar);
     }
+
+    // Rendered avatars are also persisted in the image cache
+    ImageCache::instance().clear();
 }
 
 bool Utilities::removeRecursively(QString path)
@@ -1244,7 +1248,6 @@ void Utilities::getDaysAndHoursToTimestamp(int64_t secsTimestamps, int64_t &rema
 
 QString Utilities::getNonDuplicatedNodeName(MegaNode *node, MegaNode *parentNode, const QString &currentName, bool unescapeName, const QStringList& itemsBeingRenamed)
 {
-    QString newName;
     QString nodeName;
     QString suffix;
 
@@ -1273,108 +1276,19 @@ QString Utilities::getNonDuplicatedNodeName(MegaNode *node, MegaNode *parentNode
         nodeName = QString::fromUtf8(MegaSyncApp->getMegaApi()->unescapeFsIncompatible(nodeName.toUtf8().constData()));
     }
 
-    int counter(1);
-    while(newName.isEmpty())
-    {
-        bool nameFound = false;
-        QString suggestedName = nodeName + QString(QLatin1String("(%1)")).arg(QString::number(counter));
-        if(node)
-        {
-            if(node->isFile() && !suffix.isEmpty())
-            {
-                suggestedName.append(suffix);
-            }
-        }
-
-        if(!itemsBeingRenamed.contains(suggestedName, Qt::CaseInsensitive))
-        {
-            std::unique_ptr<MegaNodeList>nodes(MegaSyncApp->getMegaApi()->getChildren(parentNode));
-            for(int index = 0; index < nodes->size(); ++index)
-            {
-                QString nodeName(QString::fromUtf8(nodes->get(index)->getName()));
-                if(suggestedName.compare(nodeName, Qt::CaseInsensitive) == 0)
-                {
-                    nameFound = true;
-                }
-            }
-
-
-            if(!nameFound)
-            {
-                newName = suggestedName;
-            }
-        }
-
-        counter++;
-    }
-
-    return newName;
+    return FolderNameIndex::instance().suggestNonDuplicatedName(parentNode, nodeName, suffix, itemsBeingRenamed);
 }
 
-QString Utilities::getNonDuplicatedLocalName(const QFileInfo &currentFile, bool unescapeName, const QStringList& itemsBeingRenamed)
+QString Utilities::getNonDuplicatedLocalName(const QFileInfo &currentFile, const QStringList& itemsBeingRenamed)
 {
-    QString repeatedName;
+    // The new name is checked against the names on disk, which are not unescaped
     QString suffix = currentFile.completeSuffix();
-
-    QString fileName;
-    if(unescapeName)
-    {
-        fileName = QString::fromUtf8(MegaSyncApp->getMegaApi()->unescapeFsIncompatible(currentFile.baseName().toUtf8().constData()));
-    }
-    else
-    {
-        fileName = currentFile.baseName();
-    }
-
-    QDirIterator filesIt(currentFile.path(), QDir::Files | QDir::Dirs | QDir::NoDotAndDotDot | QDir::NoSymLinks, QDirIterator::NoIteratorFlags);
-
-    int counter(0);
-    bool notFound(true);
-    do
-    {
-        notFound = true;
-        counter++;
-
-        QString suggestedName = fileName + QString(QLatin1String("(%1)")).arg(QString::number(counter));
-        if(!suffix.isEmpty())
-        {
-            suggestedName += QString(QLatin1String(".%1")).arg(suffix);
-        }
-
-        if(!itemsBeingRenamed.contains(suggestedName))
-        {
-            while (filesIt.hasNext())
-            {
-                QString checkFileName;
-
-                if(unescapeName)
-                {
-                    checkFileName = QString::fromUtf8(MegaSyncApp->getMegaApi()->unescapeFsIncompatible(filesIt.fileName().toUtf8().constData()));
-                }
-                else
-                {
-                    checkFileName = filesIt.fileName();
-                }
-
-                if (checkFileName.compare(suggestedName, Qt::CaseInsensitive) == 0)
-                {
-                    notFound = false;
-                    break;
-                }
-
-                filesIt.next();
-            }
-        }
-
-    } while(!notFound);
-
-    repeatedName = currentFile.baseName() + QString(QLatin1String("(%1)")).arg(QString::number(counter));
     if(!suffix.isEmpty())
     {
-        repeatedName += QString(QLatin1String(".%1")).arg(suffix);
+        suffix.prepend(QLatin1Char('.'));
     }
 
-    return repeatedName;
+    return FolderNameIndex::instance().suggestNonDuplicatedLocalName(currentFile.path(), currentFile.baseName(), suffix, itemsBeingRenamed);
 }
 
 QPair<QString, QString> Utilities::getFilenameBasenameAndSuffix(const QString& fileName)
@@ -1438,7 +1352,12 @@ bool Utilities::isBusinessAccount()
 
 QFuture<bool> Utilities::openUrl(QUrl url)
 {
-    return QtConcurrent::run(QDesktopServices::openUrl, url);
+    // The user is waiting for it, and it can block for a while
+    return ThreadPoolSingleton::getInstance()->run(ThreadPool::Priority::INTERACTIVE,
+                                                   [url]()
+                                                   {
+                                                       return QDesktopServices::openUrl(url);
+                                                   });
 }
 
 void Utilities::openAppDataPath()
@@ -17,6 +17,7 @@
 #include <QProgressDialog>
 #include <QQueue>
 #include <QString>
+#include <QThread>
 #include <QTimer>
 #include <sys/stat.h>
 
@@ -232,7 +233,9 @@ class ThreadPoolSingleton
         {
             if (instance == nullptr)
             {
-                instance.reset(new ThreadPool(5));
+                // It also runs what used to go to the QtConcurrent pool
+                const int threadCount = qBound(5, QThread::idealThreadCount(), 16);
+                instance.reset(new ThreadPool(static_cast<std::size_t>(threadCount)));
             }
 
             return instance.get();
@@ -385,8 +388,9 @@ public:
     // i.e. for 1 day & 3 hours remaining, remainingHours will be 27, not 3.
     static void getDaysAndHoursToTimestamp(int64_t secsTimestamps, int64_t &remaininDays, int64_t &remainingHours);
 
+    // The names are only suggested, the code using them asynchronously reserves them in FolderNameIndex
     static QString getNonDuplicatedNodeName(mega::MegaNode* node, mega::MegaNode* parentNode, const QString& currentName, bool unescapeName, const QStringList &itemsBeingRenamed);
-    static QString getNonDuplicatedLocalName(const QFileInfo& currentFile, bool unescapeName, const QStringList &itemsBeingRenamed);
+    static QString getNonDuplicatedLocalName(const QFileInfo& currentFile, const QStringList &itemsBeingRenamed);
     static QPair<QString, QString> getFilenameBasenameAndSuffix(const QString& fileName);
 
     static void upgradeClicked();
@@ -0,0 +1,145 @@
+#include "WebTransferProgressTracker.h"
+
+#include <QDateTime>
+
+using namespace mega;
+
+namespace
+{
+long long currentSecsSinceEpoch()
+{
+    return QDateTime::currentMSecsSinceEpoch() / 1000;
+}
+}
+
+bool WebTransferProgress::isFinished() const
+{
+    return state == MegaTransfer::STATE_CANCELLED || state == MegaTransfer::STATE_COMPLETED ||
+           state == MegaTransfer::STATE_FAILED;
+}
+
+WebTransferProgressTracker::WebTransferProgressTracker():
+    QObject(nullptr)
+{
+    mPublishTimer.setSingleShot(true);
+    mPublishTimer.setInterval(PUBLISH_INTERVAL_MS);
+    connect(&mPublishTimer, &QTimer::timeout, this, &WebTransferProgressTracker::publish);
+}
+
+void WebTransferProgressTracker::registerHandle(MegaHandle handle)
+{
+    TrackedTransfer transfer;
+    transfer.pending.tsStart = currentSecsSinceEpoch();
+    transfer.published = transfer.pending;
+
+    mTransfers.insert(handle, transfer);
+    mDirtyHandles.remove(handle);
+}
+
+bool WebTransferProgressTracker::isTracked(MegaHandle handle) const
+{
+    return mTransfers.contains(handle);
+}
+
+void WebTransferProgressTracker::onTransferData(MegaHandle handle,
+                                                int state,
+                                                long long progress,
+                                                long long size,
+                                                long long speed,
+                                                const char* localPath)
+{
+    auto it = mTransfers.find(handle);
+    if (it == mTransfers.end())
+    {
+        return;
+    }
+
+    auto& record(it->pending);
+    const bool stateChanged(record.state != state);
+
+    record.state = state;
+    record.progress = progress;
+    record.size = size;
+    record.speed = speed;
+
+    if (stateChanged)
+    {
+        if (record.isFinished())
+        {
+            record.tsEnd = currentSecsSinceEpoch();
+        }
+
+        if (localPath && (it->localPath.isEmpty() || record.isFinished()))
+        {
+            QString path(QString::fromUtf8(localPath));
+#ifdef WIN32
+            if (path.startsWith(QString::fromLatin1("\\\\?\\")))
+            {
+                path = path.mid(4);
+            }
+#endif
+            if (!path.isEmpty())
+            {
+                it->localPath = path;
+            }
+        }
+
+        it->published = record;
+        mDirtyHandles.remove(handle);
+        return;
+    }
+
+    mDirtyHandles.insert(handle);
+    if (!mPublishTimer.isActive())
+    {
+        mPublishTimer.start();
+    }
+}
+
+bool WebTransferProgressTracker::getProgress(MegaHandle handle, WebTransferProgress& progress) const
+{
+    auto it = mTransfers.constFind(handle);
+    if (it == mTransfers.constEnd())
+    {
+        return false;
+    }
+
+    progress = it->published;
+    return true;
+}
+
+QString WebTransferProgressTracker::getLocalPath(MegaHandle handle) const
+{
+    return mTransfers.value(handle).localPath;
+}
+
+void WebTransferProgressTracker::purgeFinished(long long maxAgeSecs)
+{
+    const auto now(currentSecsSinceEpoch());
+    for (auto it = mTransfers.begin(); it != mTransfers.end();)
+    {
+        const auto& record(it->published);
+        if (record.isFinished() && (now - record.tsEnd) > maxAgeSecs)
+        {
+            mDirtyHandles.remove(it.key());
+            it = mTransfers.erase(it);
+        }
+        else
+        {
+            ++it;
+        }
+    }
+}
+
+void WebTransferProgressTracker::publish()
+{
+    for (auto handle: qAsConst(mDirtyHandles))
+    {
+        auto it = mTransfers.find(handle);
+        if (it != mTransfers.end())
+        {
+            it->published = it->pending;
+        }
+    }
+    mDirtyHandles.clear();
+}
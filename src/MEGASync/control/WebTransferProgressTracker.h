@@ -0,0 +1,84 @@
+#ifndef WEB_TRANSFER_PROGRESS_TRACKER_H
+#define WEB_TRANSFER_PROGRESS_TRACKER_H
+
+#include "megaapi.h"
+
+#include <QHash>
+#include <QObject>
+#include <QSet>
+#include <QTimer>
+
+// Fixed-size progress record of a download started from the webclient
+struct WebTransferProgress
+{
+    int state = mega::MegaTransfer::STATE_NONE;
+    long long progress = 0;
+    long long size = 0;
+    long long speed = 0;
+    long long tsStart = 0;
+    long long tsEnd = -1;
+
+    bool isFinished() const;
+};
+
+/*
+ * Keeps the progress of the downloads the webclient asked for, so it can query it through the
+ * HTTP server.
+ *
+ * Only handles registered by a webclient request are tracked; transfer callbacks for any other
+ * handle are discarded with a single hash lookup. Progress updates are folded into the pending
+ * record of the handle and published at most every PUBLISH_INTERVAL_MS, except state changes,
+ * which are published immediately. The local path is only converted from the raw SDK string when
+ * the transfer starts or finishes.
+ *
+ * Must be used from the GUI thread.
+ */
+class WebTransferProgressTracker : public QObject
+{
+    Q_OBJECT
+
+public:
+    static constexpr int PUBLISH_INTERVAL_MS = 250;
+
+    static WebTransferProgressTracker& instance()
+    {
+        static WebTransferProgressTracker instance;
+        return instance;
+    }
+
+    WebTransferProgressTracker(const WebTransferProgressTracker&) = delete;
+    WebTransferProgressTracker& operator=(const WebTransferProgressTracker&) = delete;
+
+    void registerHandle(mega::MegaHandle handle);
+    bool isTracked(mega::MegaHandle handle) const;
+
+    void onTransferData(mega::MegaHandle handle,
+                        int state,
+                        long long progress,
+                        long long size,
+                        long long speed,
+                        const char* localPath);
+
+    bool getProgress(mega::MegaHandle handle, WebTransferProgress& progress) const;
+    QString getLocalPath(mega::MegaHandle handle) const;
+
+    void purgeFinished(long long maxAgeSecs);
+
+private:
+    WebTransferProgressTracker();
+
+    struct TrackedTransfer
+    {
+        WebTransferProgress pending;
+        WebTransferProgress published;
+        QString localPath;
+    };
+
+    void publish();
+
+    QHash<mega::MegaHandle, TrackedTransfer> mTransfers;
+    QSet<mega::MegaHandle> mDirtyHandles;
+    QTimer mPublishTimer;
+};
+
+#endif // WEB_TRANSFER_PROGRESS_TRACKER_H
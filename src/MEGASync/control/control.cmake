@@ -3,6 +3,7 @@ set(DESKTOP_APP_CONTROL_HEADERS
     control/AccountStatusController.h
     control/AppState.h
     control/AppStatsEvents.h
+    control/AppStatusSnapshot.h
     control/AsyncHandler.h
     control/ConnectivityChecker.h
     control/CrashHandler.h
@@ -14,15 +15,21 @@ set(DESKTOP_APP_CONTROL_HEADERS
     control/ExportProcessor.h
     control/FileFolderAttributes.h
     control/FatalEventHandler.h
+    control/FolderNameIndex.h
+    control/RemoteFolderStatsIndex.h
     control/HTTPServer.h
+    control/ImageCache.h
     control/ImageDownloader.h
     control/IntervalExecutioner.h
+    control/LinkInfoScheduler.h
     control/LinkProcessor.h
     control/LinkObject.h
+    control/LocalFolderStatsWalker.h
     control/LoginController.h
     control/MegaDownloader.h
     control/MegaSyncLogger.h
     control/MegaUploader.h
+    control/TaskScheduler.h
     control/TextDecorator.h
     control/ThreadPool.h
     control/TransferBatch.h
@@ -30,9 +37,11 @@ set(DESKTOP_APP_CONTROL_HEADERS
     control/UpdateTask.h
     control/UserAttributesManager.h
     control/RequestListenerManager.h
+    control/SetElementPipeline.h
     control/SetManager.h
     control/SetTypes.h
     control/Utilities.h
+    control/WebTransferProgressTracker.h
     control/Version.h
     control/gzjoin.h
     control/qrcodegen.h
@@ -62,17 +71,24 @@ set(DESKTOP_APP_CONTROL_SOURCES
     control/ExportProcessor.cpp
     control/FileFolderAttributes.cpp
     control/FatalEventHandler.cpp
+    control/FolderNameIndex.cpp
+    control/RemoteFolderStatsIndex.cpp
     control/HTTPServer.cpp
+    control/ImageCache.cpp
     control/ImageDownloader.cpp
     control/IntervalExecutioner.cpp
+    control/LinkInfoScheduler.cpp
     control/LinkProcessor.cpp
     control/LinkObject.cpp
+    control/LocalFolderStatsWalker.cpp
     control/LoginController.cpp
     control/MegaDownloader.cpp
     control/MegaSyncLogger.cpp
     control/MegaUploader.cpp
     control/RequestListenerManager.cpp
+    control/SetElementPipeline.cpp
     control/SetManager.cpp
+    control/TaskScheduler.cpp
     control/TextDecorator.cpp
     control/ThreadPool.cpp
     control/TransferBatch.cpp
@@ -80,6 +96,7 @@ set(DESKTOP_APP_CONTROL_SOURCES
     control/UpdateTask.cpp
     control/UserAttributesManager.cpp
     control/Utilities.cpp
+    control/WebTransferProgressTracker.cpp
     control/qrcodegen.c
     control/MergeMEGAFolders.cpp
     control/MEGAPathCreator.cpp
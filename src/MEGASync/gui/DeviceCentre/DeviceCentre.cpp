@@ -7,6 +7,7 @@
 #include "MegaApplication.h"
 #include "QmlDialogWrapper.h"
 #include "QmlUtils.h"
+#include "RemoteFolderStatsIndex.h"
 #include "StalledIssuesModel.h"
 #include "SyncController.h"
 #include "SyncExclusions.h"
@@ -17,7 +18,6 @@
 
 namespace
 {
-const uint DELAY_TO_NEXT_CALL_IN_MS = 1000u;
 static bool qmlRegistrationDone = false;
 }
 
@@ -35,15 +35,11 @@ DeviceCentre::DeviceCentre(QObject* parent):
     mDelegateListener = std::make_unique<mega::QTMegaListener>(mMegaApi, this);
     mMegaApi->addListener(mDelegateListener.get());
 
-    mSizeInfoTimer.setInterval(DELAY_TO_NEXT_CALL_IN_MS);
-    mSizeInfoTimer.setSingleShot(true);
-    connect(&mSizeInfoTimer,
-            &QTimer::timeout,
+    // The sizes are kept up to date from the node updates, no need to ask for the backups again
+    connect(&RemoteFolderStatsIndex::instance(),
+            &RemoteFolderStatsIndex::statsChanged,
             this,
-            [this]()
-            {
-                mMegaApi->getBackupInfo();
-            });
+            &DeviceCentre::onRemoteFolderStatsChanged);
     SyncInfo::instance()->dismissUnattendedDisabledSyncs(
         {mega::MegaSync::SyncType::TYPE_BACKUP, mega::MegaSync::SyncType::TYPE_TWOWAY});
 }
@@ -51,7 +47,6 @@ DeviceCentre::DeviceCentre(QObject* parent):
 DeviceCentre::~DeviceCentre()
 {
     mMegaApi->removeListener(mDelegateListener.get());
-    mSizeInfoTimer.stop();
 }
 
 void DeviceCentre::onRequestFinish(mega::MegaApi* api,
@@ -86,15 +81,11 @@ void DeviceCentre::onRequestFinish(mega::MegaApi* api,
             mega::MegaBackupInfoList* backupList = request->getMegaBackupInfoList();
             requestDeviceNames(*backupList);
             updateLocalData(*backupList);
-            if (mSyncModel->hasUpdatingStatus())
-            {
-                mSizeInfoTimer.start();
-            }
             emit deviceDataUpdated();
         }
         else if (request->getType() == mega::MegaRequest::TYPE_ADD_SYNC)
         {
-            const QmlSyncData syncObject(request, mMegaApi);
+            const QmlSyncData syncObject(request);
             mSyncModel->addOrUpdate(syncObject);
 
             mMegaApi->getBackupInfo();
@@ -142,6 +133,15 @@ void DeviceCentre::onSyncStatsUpdated(mega::MegaApi*, mega::MegaSyncStats* syncS
     }
 }
 
+void DeviceCentre::onRemoteFolderStatsChanged(mega::MegaHandle folderHandle)
+{
+    if (mSyncModel->setSize(folderHandle, RemoteFolderStatsIndex::instance().getSize(folderHandle)))
+    {
+        updateDeviceData();
+        emit deviceDataUpdated();
+    }
+}
+
 void DeviceCentre::onSyncDeleted(mega::MegaApi* api, mega::MegaSync* sync)
 {
     mSyncModel->remove(sync->getBackupId());
@@ -219,7 +219,7 @@ void DeviceCentre::updateLocalData(const mega::MegaBackupInfoList& backupList)
     mCachedDeviceData.os = DeviceOs::getCurrentOS();
     for (const auto& backup: deviceBackupList)
     {
-        QmlSyncData newSync(backup, mMegaApi);
+        QmlSyncData newSync(backup);
         mSyncModel->addOrUpdate(newSync);
     }
     updateDeviceData();
@@ -7,8 +7,6 @@
 #include "QTMegaListener.h"
 #include "SyncModel.h"
 
-#include <QTimer>
-
 class DeviceCentre: public QMLComponent, public mega::MegaListener
 {
     Q_OBJECT
@@ -60,6 +58,9 @@ signals:
     void deviceDataUpdated();
     void rowCountChanged();
 
+private slots:
+    void onRemoteFolderStatsChanged(mega::MegaHandle folderHandle);
+
 private:
     using BackupList = QList<const mega::MegaBackupInfo*>;
     void updateLocalData(const mega::MegaBackupInfoList& backupList);
@@ -75,7 +76,6 @@ private:
     SyncModel* mSyncModel;
     std::unique_ptr<mega::QTMegaListener> mDelegateListener;
     QString mDeviceIdFromLastRequest;
-    QTimer mSizeInfoTimer;
 
     DeviceData mCachedDeviceData;
     DeviceModel* mDeviceModel;
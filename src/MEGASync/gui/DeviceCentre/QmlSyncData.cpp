@@ -1,5 +1,6 @@
 #include "QmlSyncData.h"
 
+#include "RemoteFolderStatsIndex.h"
 #include "SyncInfo.h"
 
 QmlSyncData::QmlSyncData(mega::MegaSync* sync):
@@ -16,18 +17,18 @@ QmlSyncData::QmlSyncData(mega::MegaSyncStats* syncStats):
     status((syncStats->isScanning()) ? SyncStatus::UPDATING : SyncStatus::UP_TO_DATE)
 {}
 
-QmlSyncData::QmlSyncData(const mega::MegaBackupInfo* backupInfo, mega::MegaApi* api):
+QmlSyncData::QmlSyncData(const mega::MegaBackupInfo* backupInfo):
     syncID(backupInfo->id()),
     nodeHandle(backupInfo->root()),
     localFolder(QString::fromUtf8(backupInfo->localFolder())),
     type(convertSyncType(backupInfo)),
     name(QString::fromUtf8(backupInfo->name())),
-    size(api->getSize(api->getNodeByHandle(backupInfo->root()))),
+    size(getRemoteSize(backupInfo->root())),
     dateModified(QDateTime::fromSecsSinceEpoch(static_cast<qint64>(backupInfo->ts()))),
     status(convertStatus(backupInfo))
 {}
 
-QmlSyncData::QmlSyncData(mega::MegaRequest* request, mega::MegaApi* api)
+QmlSyncData::QmlSyncData(mega::MegaRequest* request)
 {
     syncID = request->getParentHandle();
     type = (request->getParamType() == mega::MegaSync::TYPE_TWOWAY) ? QmlSyncType::SYNC :
@@ -35,7 +36,7 @@ QmlSyncData::QmlSyncData(mega::MegaRequest* request, mega::MegaApi* api)
     nodeHandle = request->getNodeHandle();
     localFolder = QString::fromUtf8(request->getFile());
     name = QString::fromUtf8(request->getName());
-    size = api->getSize(api->getNodeByHandle(request->getNodeHandle()));
+    size = getRemoteSize(request->getNodeHandle());
 }
 
 void QmlSyncData::updateFields(const QmlSyncData& other)
@@ -105,3 +106,11 @@ SyncStatus::Value QmlSyncData::convertStatus(const mega::MegaBackupInfo* backupI
     }
     return convertStatus(syncSetting->getSync());
 }
+
+qint64 QmlSyncData::getRemoteSize(mega::MegaHandle nodeHandle)
+{
+    // -1 until the folder has been walked, the size is updated when the stats change
+    auto& remoteFolderStats(RemoteFolderStatsIndex::instance());
+    remoteFolderStats.track(nodeHandle);
+    return remoteFolderStats.getSize(nodeHandle);
+}
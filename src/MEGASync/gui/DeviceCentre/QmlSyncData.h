@@ -11,8 +11,8 @@ struct QmlSyncData
     QmlSyncData() = default;
     QmlSyncData(mega::MegaSync* sync);
     QmlSyncData(mega::MegaSyncStats* syncStats);
-    QmlSyncData(const mega::MegaBackupInfo* backupInfo, mega::MegaApi* api);
-    QmlSyncData(mega::MegaRequest* request, mega::MegaApi* api);
+    QmlSyncData(const mega::MegaBackupInfo* backupInfo);
+    QmlSyncData(mega::MegaRequest* request);
 
     void updateFields(const QmlSyncData& other);
     QString toString() const;
@@ -31,6 +31,7 @@ private:
     static QmlSyncType::Type convertSyncType(const mega::MegaBackupInfo* backupInfo);
     static SyncStatus::Value convertStatus(const mega::MegaSync* sync);
     static SyncStatus::Value convertStatus(const mega::MegaBackupInfo* backupInfo);
+    static qint64 getRemoteSize(mega::MegaHandle nodeHandle);
 };
 
 #endif // QMLSYNCDATA_H
@@ -8,9 +8,17 @@
 
 #include <algorithm>
 
+// About a frame: a scan updates the syncs much more often than that
+constexpr int SYNCS_CHANGED_INTERVAL_MS = 16;
+
 SyncModel::SyncModel(QObject* parent):
     QAbstractListModel(parent)
 {
+    mSyncsChangedTimer.setSingleShot(true);
+    mSyncsChangedTimer.setInterval(SYNCS_CHANGED_INTERVAL_MS);
+    connect(&mSyncsChangedTimer, &QTimer::timeout, this, &SyncModel::sendSyncsChanged);
+
+
     connect(SyncInfo::instance(),
             &SyncInfo::syncRemoteRootChanged,
             this,
@@ -35,6 +43,7 @@ QHash<int, QByteArray> SyncModel::roleNames() const
 void SyncModel::add(const QmlSyncData& newSync)
 {
     beginInsertRows(QModelIndex(), rowCount(), rowCount());
+    mRowBySyncID.insert(newSync.syncID, mSyncObjects.size());
     mSyncObjects.append(newSync);
     endInsertRows();
 }
@@ -49,8 +58,33 @@ void SyncModel::addOrUpdate(const QmlSyncData& newSync)
     else
     {
         mSyncObjects[row.value()].updateFields(newSync);
-        const QModelIndex modelIndex = QAbstractListModel::index(row.value());
-        emit dataChanged(modelIndex, modelIndex);
+        mChangedSyncIDs.insert(newSync.syncID);
+        if (!mSyncsChangedTimer.isActive())
+        {
+            mSyncsChangedTimer.start();
+        }
+    }
+}
+
+void SyncModel::sendSyncsChanged()
+{
+    int firstRow = mSyncObjects.size();
+    int lastRow = -1;
+    for (auto syncID : qAsConst(mChangedSyncIDs))
+    {
+        auto row = findRowByHandle(syncID);
+        if (row.has_value())
+        {
+            firstRow = std::min(firstRow, row.value());
+            lastRow = std::max(lastRow, row.value());
+        }
+    }
+    mChangedSyncIDs.clear();
+
+    // A single range is cheaper to repaint than a signal for every sync
+    if (lastRow >= 0)
+    {
+        emit dataChanged(index(firstRow), index(lastRow));
     }
 }
 
@@ -64,6 +98,8 @@ void SyncModel::remove(mega::MegaHandle handle)
     {
         beginRemoveRows(QModelIndex(), row.value(), row.value());
         mSyncObjects.removeAt(row.value());
+        mRowBySyncID.remove(handle);
+        updateRows(row.value());
         endRemoveRows();
     }
 }
@@ -71,22 +107,28 @@ void SyncModel::remove(mega::MegaHandle handle)
 void SyncModel::clear()
 {
     mSyncObjects.clear();
+    mRowBySyncID.clear();
+    mChangedSyncIDs.clear();
 }
 
 std::optional<int> SyncModel::findRowByHandle(mega::MegaHandle handle) const
 {
-    auto finder = [handle](const QmlSyncData& obj)
-    {
-        return obj.syncID == handle;
-    };
-    auto itSyncObj = std::find_if(mSyncObjects.begin(), mSyncObjects.end(), finder);
-    if (itSyncObj != mSyncObjects.end())
+    auto rowIt = mRowBySyncID.constFind(handle);
+    if (rowIt != mRowBySyncID.constEnd())
     {
-        return std::distance(mSyncObjects.begin(), itSyncObj);
+        return rowIt.value();
     }
     return std::nullopt;
 }
 
+void SyncModel::updateRows(int firstRow)
+{
+    for (int row = firstRow; row < mSyncObjects.size(); ++row)
+    {
+        mRowBySyncID.insert(mSyncObjects.at(row).syncID, row);
+    }
+}
+
 SyncStatus::Value SyncModel::computeDeviceStatus() const
 {
     SyncStatus::Value deviceStatus = SyncStatus::UP_TO_DATE;
@@ -105,7 +147,8 @@ qint64 SyncModel::computeTotalSize() const
 {
     const qint64 startValue = 0;
     auto accumulator = [](qint64 total, const auto& sync) {
-        return total + sync.size;
+        // Not known yet
+        return sync.size < 0 ? total : total + sync.size;
     };
     return std::accumulate(mSyncObjects.begin(), mSyncObjects.end(), startValue, accumulator);
 }
@@ -113,7 +156,7 @@ qint64 SyncModel::computeTotalSize() const
 void SyncModel::setStatus(mega::MegaHandle handle, const SyncStatus::Value status)
 {
     auto row = findRowByHandle(handle);
-    if (!row.has_value())
+    if (row.has_value())
     {
         mSyncObjects[row.value()].status = status;
 
@@ -122,6 +165,23 @@ void SyncModel::setStatus(mega::MegaHandle handle, const SyncStatus::Value statu
     }
 }
 
+bool SyncModel::setSize(mega::MegaHandle nodeHandle, qint64 size)
+{
+    // Several syncs can share the remote folder
+    bool changed = false;
+    for (int row = 0; row < mSyncObjects.size(); ++row)
+    {
+        if (mSyncObjects[row].nodeHandle == nodeHandle && mSyncObjects[row].size != size)
+        {
+            mSyncObjects[row].size = size;
+            const QModelIndex modelIndex = index(row);
+            emit dataChanged(modelIndex, modelIndex, {SIZE});
+            changed = true;
+        }
+    }
+    return changed;
+}
+
 bool SyncModel::hasUpdatingStatus() const
 {
     auto finder = [](const QmlSyncData& obj) {
@@ -192,6 +252,10 @@ QString SyncModel::getName(int row) const
 
 QString SyncModel::getSize(int row) const
 {
+    if (mSyncObjects[row].size < 0)
+    {
+        return QString();
+    }
     return Utilities::getSizeString(mSyncObjects[row].size);
 }
 
@@ -5,6 +5,9 @@
 #include "QmlSyncData.h"
 
 #include <QAbstractListModel>
+#include <QHash>
+#include <QSet>
+#include <QTimer>
 
 #include <memory>
 #include <optional>
@@ -43,6 +46,7 @@ public:
     qint64 computeTotalSize() const;
 
     void setStatus(mega::MegaHandle handle, const SyncStatus::Value status);
+    bool setSize(mega::MegaHandle nodeHandle, qint64 size);
     bool hasUpdatingStatus() const;
     std::optional<mega::MegaHandle> getHandle(int row) const;
     std::optional<mega::MegaHandle> getSyncID(int row) const;
@@ -52,6 +56,7 @@ public:
 
 private slots:
     void onSyncRootChanged(std::shared_ptr<SyncSettings> syncSettings);
+    void sendSyncsChanged();
 
 private:
     QString getName(int row) const;
@@ -60,8 +65,14 @@ private:
     SyncStatus::Value getStatus(int row) const;
     QString getErrorMessage(int row) const;
     std::optional<int> findRowByHandle(mega::MegaHandle handle) const;
+    void updateRows(int firstRow);
 
     QList<QmlSyncData> mSyncObjects;
+    // Row of each sync in mSyncObjects
+    QHash<mega::MegaHandle, int> mRowBySyncID;
+    // Updated since the last repaint, they are sent together
+    QSet<mega::MegaHandle> mChangedSyncIDs;
+    QTimer mSyncsChangedTimer;
 };
 
 #endif // SYNC_MODEL_H
@@ -363,6 +363,16 @@ void InfoDialog::setBandwidthOverquotaState(QuotaState state)
     setUsage();
 }
 
+void InfoDialog::fillStatusSnapshot(AppStatusSnapshot& status)
+{
+    status.infoDialogStorageState = storageState;
+    status.transferQuotaState = static_cast<int>(transferQuotaState);
+    status.transferOverQuotaAlert = transferOverquotaAlertEnabled;
+    status.transferAlmostOverQuotaAlert = transferAlmostOverquotaAlertEnabled;
+    status.psaReady = ui->wPSA->isPSAready();
+    status.transferScanActive = mTransferScanCancelUi && mTransferScanCancelUi->isActive();
+}
+
 void InfoDialog::updateUsageAndAccountType()
 {
     setUsage();
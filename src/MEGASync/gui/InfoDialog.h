@@ -1,6 +1,7 @@
 #ifndef INFODIALOG_H
 #define INFODIALOG_H
 
+#include "AppStatusSnapshot.h"
 #include "FilterAlertWidget.h"
 #include "HighDpiResize.h"
 #include "MegaDelegateHoverManager.h"
@@ -97,6 +98,9 @@ public:
 
     void setTransferManager(TransferManager *transferManager);
 
+    // Fills the inputs of updateDialogState() kept by the dialog
+    void fillStatusSnapshot(AppStatusSnapshot& status);
+
 private:
     InfoDialog() = delete;
     void animateStates(bool opt);
@@ -1,6 +1,7 @@
 #include "NodeNameSetterDialog.h"
 
 #include "CommonMessages.h"
+#include "FolderNameIndex.h"
 #include "MegaApplication.h"
 #include "ui_NodeNameSetterDialog.h"
 #include "Utilities.h"
@@ -82,15 +83,11 @@ void NodeNameSetterDialog::showError(const QString &errorText)
 
 bool NodeNameSetterDialog::checkAlreadyExistingNode(const QString& nodeName, std::shared_ptr<mega::MegaNode> parentNode)
 {
-    std::unique_ptr<mega::MegaNodeList>nodes(MegaSyncApp->getMegaApi()->getChildren(parentNode.get()));
-    for(int index = 0; index < nodes->size(); ++index)
+    FolderNameIndex::Entry existingNode;
+    if(FolderNameIndex::instance().findName(parentNode.get(), nodeName, &existingNode))
     {
-        QString remoteNodeName(QString::fromUtf8(nodes->get(index)->getName()));
-        if(nodeName.compare(remoteNodeName, Qt::CaseInsensitive) == 0)
-        {
-            showAlreadyExistingNodeError(nodes->get(index)->isFile());
-            return true;
-        }
+        showAlreadyExistingNodeError(existingNode.isFile);
+        return true;
     }
 
     return false;
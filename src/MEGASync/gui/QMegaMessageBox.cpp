@@ -1,6 +1,7 @@
 #include "QMegaMessageBox.h"
 
 #include "DialogOpener.h"
+#include "MegaApplication.h"
 
 #include <QDebug>
 #include <QDialogButtonBox>
@@ -52,8 +53,61 @@ bool QMegaMessageBox::event(QEvent *event)
     return QMessageBox::event(event);
 }
 
+int QMegaMessageBox::getRejectedResult(StandardButtons buttons)
+{
+    // The button of the Escape key, as chosen by QMessageBox when there is no escape button
+    for (auto button : {Cancel, No, Close, Abort, Ignore})
+    {
+        if (buttons.testFlag(button))
+        {
+            return button;
+        }
+    }
+
+    for (uint mask = FirstButton; mask <= LastButton; mask <<= 1)
+    {
+        if (static_cast<uint>(buttons) == mask)
+        {
+            return static_cast<int>(mask);
+        }
+    }
+
+    return QDialog::Rejected;
+}
+
 void QMegaMessageBox::showNewMessageBox(Icon icon, const MessageBoxInfo& info)
 {
+    // Nobody can answer it without a display, leave it in the logs instead
+    if (MegaSyncApp->isHeadless())
+    {
+        QString message =
+            info.title.isEmpty() ? info.text : info.title + QLatin1String(": ") + info.text;
+        if (!info.informativeText.isEmpty())
+        {
+            message += QLatin1Char(' ') + info.informativeText;
+        }
+        mega::MegaApi::log(icon == Critical ? mega::MegaApi::LOG_LEVEL_ERROR
+                                            : mega::MegaApi::LOG_LEVEL_WARNING,
+                           message.toUtf8().constData());
+
+        // The callers wait for the answer, they get the one of closing the box
+        if (info.finishFunc)
+        {
+            auto finishFunc = [info]()
+            {
+                QPointer<QMessageBox> msgBox(new QMegaMessageBox(info.parent));
+                msgBox->setResult(getRejectedResult(info.buttons));
+                info.finishFunc(msgBox);
+                if (msgBox)
+                {
+                    msgBox->deleteLater();
+                }
+            };
+            Utilities::queueFunctionInAppThread(finishFunc);
+        }
+        return;
+    }
+
     auto showMsgBox = [icon, info]()
     {
         QMessageBox* msgBox = new QMegaMessageBox(info.parent);
@@ -61,6 +61,7 @@ protected:
     bool event(QEvent *event) override;
 
 private:
+    static int getRejectedResult(StandardButtons buttons);
     static void showNewMessageBox(Icon icon, const MessageBoxInfo& info);
 };
 
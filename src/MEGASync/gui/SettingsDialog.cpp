@@ -28,7 +28,6 @@
 #include <QMessageBox>
 #include <QRect>
 #include <QShortcut>
-#include <QtConcurrent/QtConcurrent>
 #include <QTranslator>
 #include <QUrl>
 
@@ -301,7 +300,8 @@ void SettingsDialog::loadSettings()
                 &QFutureWatcher<long long>::finished,
                 this,
                 &SettingsDialog::onLocalCacheSizeAvailable);
-        QFuture<long long> futureCacheSize = QtConcurrent::run(calculateCacheSize);
+        QFuture<long long> futureCacheSize =
+            mThreadPool->run(ThreadPool::Priority::BACKGROUND, calculateCacheSize);
         mCacheSizeWatcher.setFuture(futureCacheSize);
 
         connect(&mRemoteCacheSizeWatcher,
@@ -309,7 +309,11 @@ void SettingsDialog::loadSettings()
                 this,
                 &SettingsDialog::onRemoteCacheSizeAvailable);
         QFuture<long long> futureRemoteCacheSize =
-            QtConcurrent::run(calculateRemoteCacheSize, mMegaApi);
+            mThreadPool->run(ThreadPool::Priority::BACKGROUND,
+                             [megaApi = mMegaApi]()
+                             {
+                                 return calculateRemoteCacheSize(megaApi);
+                             });
         mRemoteCacheSizeWatcher.setFuture(futureRemoteCacheSize);
     }
 
@@ -563,7 +567,7 @@ void SettingsDialog::on_bClearCache_clicked()
     {
         if (msg->result() == QMessageBox::Yes)
         {
-            QtConcurrent::run(deleteCache);
+            mThreadPool->push(deleteCache, ThreadPool::Priority::BACKGROUND);
             mCacheSize = 0;
             onCacheSizeAvailable();
         }
@@ -602,7 +606,12 @@ void SettingsDialog::on_bClearRemoteCache_clicked()
     {
         if (msg->result() == QMessageBox::Yes)
         {
-            QtConcurrent::run(deleteRemoteCache, mMegaApi);
+            mThreadPool->push(
+                [megaApi = mMegaApi]()
+                {
+                    deleteRemoteCache(megaApi);
+                },
+                ThreadPool::Priority::BACKGROUND);
             mRemoteCacheSize = 0;
             onCacheSizeAvailable();
         }
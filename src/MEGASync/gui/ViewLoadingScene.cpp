@@ -1,6 +1,7 @@
 #include "ViewLoadingScene.h"
 
 #include "ui_ViewLoadingScene.h"
+#include "Utilities.h"
 
 #include <QDebug>
 #include <QKeyEvent>
@@ -186,7 +187,18 @@ void LoadingSceneMessageHandler::updateMessage(std::shared_ptr<MessageInfo> info
 
         if(info->total != 0)
         {
-            ui->lProgressLabel->setText(tr("%1 of %2").arg(info->count).arg(info->total));
+            if(info->remainingSeconds >= 0)
+            {
+                ui->lProgressLabel->setText(
+                    tr("%1 of %2 (%3 left)")
+                        .arg(info->count)
+                        .arg(info->total)
+                        .arg(Utilities::getTimeString(info->remainingSeconds, true, false)));
+            }
+            else
+            {
+                ui->lProgressLabel->setText(tr("%1 of %2").arg(info->count).arg(info->total));
+            }
             ui->pbProgressBar->setMaximum(info->total);
             ui->pbProgressBar->setValue(info->count);
         }
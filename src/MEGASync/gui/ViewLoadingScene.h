@@ -213,6 +213,8 @@ struct MessageInfo
     QString message;
     int count = 0;
     int total = 0;
+    // Shown next to the progress when known (not -1)
+    long long remainingSeconds = -1;
     ButtonType buttonType;
 };
 
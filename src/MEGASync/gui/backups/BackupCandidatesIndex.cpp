@@ -0,0 +1,105 @@
+#include "BackupCandidatesIndex.h"
+
+#include "BackupsModel.h"
+
+#include <QDir>
+
+bool BackupCandidatesIndex::update(BackupFolder* folder)
+{
+    if(!folder->mSelected || folder->mDone)
+    {
+        return remove(folder);
+    }
+
+    const Entry entry{folder->getFolder(), folder->mName};
+    auto indexed = mEntries.find(folder);
+    if(indexed != mEntries.end())
+    {
+        if(indexed->folder == entry.folder && indexed->name == entry.name)
+        {
+            return false;
+        }
+        removeEntry(indexed.value());
+        indexed.value() = entry;
+    }
+    else
+    {
+        mEntries.insert(folder, entry);
+    }
+
+    insertEntry(folder, entry);
+    return true;
+}
+
+bool BackupCandidatesIndex::remove(BackupFolder* folder)
+{
+    auto indexed = mEntries.find(folder);
+    if(indexed == mEntries.end())
+    {
+        return false;
+    }
+
+    removeEntry(indexed.value());
+    mEntries.erase(indexed);
+    return true;
+}
+
+QList<BackupFolder*> BackupCandidatesIndex::getRelatedFolders(const QString& folder) const
+{
+    QList<BackupFolder*> related;
+    const QChar separator(QDir::separator());
+
+    // Containing folders: the prefixes of the path that end before a separator
+    for(int position = folder.indexOf(separator, 1); position > 0;
+        position = folder.indexOf(separator, position + 1))
+    {
+        auto parent = mFolders.find(folder.left(position));
+        if(parent != mFolders.end())
+        {
+            related.append(parent->second);
+        }
+    }
+
+    // Contained folders
+    const QString prefix(folder + separator);
+    for(auto child = mFolders.lower_bound(prefix);
+        child != mFolders.end() && child->first.startsWith(prefix); ++child)
+    {
+        related.append(child->second);
+    }
+
+    return related;
+}
+
+int BackupCandidatesIndex::getNameCount(const QString& name) const
+{
+    return mNameCounts.value(name);
+}
+
+QStringList BackupCandidatesIndex::getFolders() const
+{
+    QStringList folders;
+    folders.reserve(static_cast<int>(mFolders.size()));
+    for(const auto& folder : mFolders)
+    {
+        folders.append(folder.first);
+    }
+    return folders;
+}
+
+void BackupCandidatesIndex::insertEntry(BackupFolder* folder, const Entry& entry)
+{
+    mFolders[entry.folder] = folder;
+    ++mNameCounts[entry.name];
+}
+
+void BackupCandidatesIndex::removeEntry(const Entry& entry)
+{
+    mFolders.erase(entry.folder);
+
+    auto nameCount = mNameCounts.find(entry.name);
+    if(nameCount != mNameCounts.end() && --nameCount.value() <= 0)
+    {
+        mNameCounts.erase(nameCount);
+    }
+}
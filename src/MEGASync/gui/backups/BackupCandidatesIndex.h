@@ -0,0 +1,48 @@
+#ifndef BACKUPCANDIDATESINDEX_H
+#define BACKUPCANDIDATESINDEX_H
+
+#include <QHash>
+#include <QList>
+#include <QString>
+#include <QStringList>
+
+#include <map>
+
+class BackupFolder;
+
+//!
+//! \brief The folders selected to be backed up and not done yet, indexed by path and by name.
+//!
+//! It is updated row by row, so the path relations and the duplicated names of a folder are
+//! found without comparing it with every other row.
+//!
+class BackupCandidatesIndex
+{
+public:
+    //! \brief Adds, updates or removes the folder depending on whether it is still a candidate.
+    //! \return Whether the indexed folders or names changed.
+    bool update(BackupFolder* folder);
+    bool remove(BackupFolder* folder);
+
+    //! \brief The candidates that contain the folder or are contained by it.
+    QList<BackupFolder*> getRelatedFolders(const QString& folder) const;
+    int getNameCount(const QString& name) const;
+    QStringList getFolders() const;
+
+private:
+    struct Entry
+    {
+        QString folder;
+        QString name;
+    };
+
+    void insertEntry(BackupFolder* folder, const Entry& entry);
+    void removeEntry(const Entry& entry);
+
+    QHash<BackupFolder*, Entry> mEntries;
+    // Sorted, so the folders contained by another one are contiguous
+    std::map<QString, BackupFolder*> mFolders;
+    QHash<QString, int> mNameCounts;
+};
+
+#endif // BACKUPCANDIDATESINDEX_H
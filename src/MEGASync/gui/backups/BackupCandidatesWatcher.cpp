@@ -0,0 +1,135 @@
+#include "BackupCandidatesWatcher.h"
+
+#include <QDir>
+#include <QFileInfo>
+
+BackupCandidatesWatcher::BackupCandidatesWatcher(QObject* parent)
+    : QObject(parent)
+{
+    connect(&mWatcher, &QFileSystemWatcher::directoryChanged,
+            this, &BackupCandidatesWatcher::onDirectoryChanged);
+}
+
+void BackupCandidatesWatcher::setFolders(const QStringList& folders)
+{
+    const QSet<QString> newFolders(folders.cbegin(), folders.cend());
+
+    for(auto it = mFolders.begin(); it != mFolders.end();)
+    {
+        if(newFolders.contains(it.key()))
+        {
+            ++it;
+        }
+        else
+        {
+            unwatch(it.key(), it.value());
+            it = mFolders.erase(it);
+        }
+    }
+
+    for(const auto& folder : newFolders)
+    {
+        if(mFolders.contains(folder))
+        {
+            continue;
+        }
+
+        WatchedFolder& watchedFolder = mFolders[folder];
+        watchedFolder.exists = QFileInfo(folder).isDir();
+        watch(folder, watchedFolder);
+        if(!watchedFolder.exists)
+        {
+            emit folderDisappeared(folder);
+        }
+    }
+}
+
+bool BackupCandidatesWatcher::exists(const QString& folder) const
+{
+    return mFolders.value(folder).exists;
+}
+
+void BackupCandidatesWatcher::onDirectoryChanged(const QString& path)
+{
+    const QSet<QString> folders(mFoldersByWatchedPath.value(path));
+    if(!QFileInfo(path).isDir())
+    {
+        // The watch is gone with the directory
+        mWatcher.removePath(path);
+        mFoldersByWatchedPath.remove(path);
+    }
+
+    for(const auto& folder : folders)
+    {
+        auto watchedFolder = mFolders.find(folder);
+        if(watchedFolder == mFolders.end())
+        {
+            continue;
+        }
+
+        // The nearest existing parent may be another one now
+        unwatch(folder, watchedFolder.value());
+        const bool existed = watchedFolder->exists;
+        watchedFolder->exists = QFileInfo(folder).isDir();
+        watch(folder, watchedFolder.value());
+
+        if(existed && !watchedFolder->exists)
+        {
+            emit folderDisappeared(folder);
+        }
+        else if(!existed && watchedFolder->exists)
+        {
+            emit folderAppeared(folder);
+        }
+    }
+}
+
+QString BackupCandidatesWatcher::getNearestExistingParent(const QString& folder)
+{
+    QFileInfo parent(QFileInfo(folder).absolutePath());
+    while(!parent.isDir() && !parent.isRoot())
+    {
+        parent.setFile(parent.absolutePath());
+    }
+    return parent.absoluteFilePath();
+}
+
+void BackupCandidatesWatcher::watch(const QString& folder, WatchedFolder& watchedFolder)
+{
+    // The folder itself for unmounts, its parent for deletions, renames and creations
+    if(watchedFolder.exists)
+    {
+        watchedFolder.watchedPaths.append(QDir::fromNativeSeparators(folder));
+    }
+    watchedFolder.watchedPaths.append(getNearestExistingParent(folder));
+
+    for(const auto& path : qAsConst(watchedFolder.watchedPaths))
+    {
+        auto& watchers = mFoldersByWatchedPath[path];
+        if(watchers.isEmpty())
+        {
+            mWatcher.addPath(path);
+        }
+        watchers.insert(folder);
+    }
+}
+
+void BackupCandidatesWatcher::unwatch(const QString& folder, WatchedFolder& watchedFolder)
+{
+    for(const auto& path : qAsConst(watchedFolder.watchedPaths))
+    {
+        auto watchers = mFoldersByWatchedPath.find(path);
+        if(watchers == mFoldersByWatchedPath.end())
+        {
+            continue;
+        }
+
+        watchers->remove(folder);
+        if(watchers->isEmpty())
+        {
+            mFoldersByWatchedPath.erase(watchers);
+            mWatcher.removePath(path);
+        }
+    }
+    watchedFolder.watchedPaths.clear();
+}
@@ -0,0 +1,53 @@
+#ifndef BACKUPCANDIDATESWATCHER_H
+#define BACKUPCANDIDATESWATCHER_H
+
+#include <QFileSystemWatcher>
+#include <QHash>
+#include <QObject>
+#include <QSet>
+#include <QStringList>
+
+//!
+//! \brief Tells when the folders selected to be backed up disappear or appear again.
+//!
+//! Every folder is watched together with its nearest existing parent, so they are only checked
+//! when the file system reports a change in them (inotify, FSEvents or ReadDirectoryChangesW)
+//! instead of being polled.
+//!
+class BackupCandidatesWatcher : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit BackupCandidatesWatcher(QObject* parent = nullptr);
+
+    //! \brief Starts watching the new folders and stops watching the ones not in the list.
+    void setFolders(const QStringList& folders);
+    bool exists(const QString& folder) const;
+
+signals:
+    void folderAppeared(const QString& folder);
+    void folderDisappeared(const QString& folder);
+
+private slots:
+    void onDirectoryChanged(const QString& path);
+
+private:
+    struct WatchedFolder
+    {
+        bool exists = false;
+        QStringList watchedPaths;
+    };
+
+    static QString getNearestExistingParent(const QString& folder);
+
+    void watch(const QString& folder, WatchedFolder& watchedFolder);
+    void unwatch(const QString& folder, WatchedFolder& watchedFolder);
+
+    QFileSystemWatcher mWatcher;
+    QHash<QString, WatchedFolder> mFolders;
+    // A parent can be shared by several folders
+    QHash<QString, QSet<QString>> mFoldersByWatchedPath;
+};
+
+#endif // BACKUPCANDIDATESWATCHER_H
@@ -91,8 +91,6 @@ bool BackupFolder::createFileFolderAttributes()
     return false;
 }
 
-int BackupsModel::CHECK_DIRS_TIME = 1000;
-
 BackupsModel::BackupsModel(QObject* parent)
     : QAbstractListModel(parent)
     , mSelectedRowsTotal(0)
@@ -111,13 +109,14 @@ BackupsModel::BackupsModel(QObject* parent)
             this, &BackupsModel::onBackupsCreationFinished);
     connect(&BackupsController::instance(), &BackupsController::backupFinished,
             this, &BackupsModel::onBackupFinished);
-    connect(&mCheckDirsTimer, &QTimer::timeout, this, &BackupsModel::checkDirectories);
+    // Queued, as folders can be found missing while the model is being changed
+    connect(&mFoldersWatcher, &BackupCandidatesWatcher::folderAppeared,
+            this, &BackupsModel::onFolderAppeared, Qt::QueuedConnection);
+    connect(&mFoldersWatcher, &BackupCandidatesWatcher::folderDisappeared,
+            this, &BackupsModel::onFolderDisappeared, Qt::QueuedConnection);
 
     QmlManager::instance()->setRootContextProperty(this);
     QmlManager::instance()->addImageProvider(QLatin1String("standardicons"), new StandardIconProvider);
-
-    mCheckDirsTimer.setInterval(CHECK_DIRS_TIME);
-    mCheckDirsTimer.start();
 }
 
 BackupsModel::~BackupsModel()
@@ -186,6 +185,7 @@ bool BackupsModel::setData(const QModelIndex& index, const QVariant& value, int
 
         if(result)
         {
+            updateCandidate(item);
             emit dataChanged(index, index, { role } );
         }
     }
@@ -359,6 +359,7 @@ void BackupsModel::insert(const QString &folder)
     beginInsertRows(QModelIndex(), newBackupFolderModelIndex, newBackupFolderModelIndex);
     mBackupFolderList.append(data);
     endInsertRows();
+    updateCandidate(data);
 
     emit newFolderAdded(newBackupFolderModelIndex);
 
@@ -375,6 +376,7 @@ void BackupsModel::setAllSelected(bool selected)
         if(checkPermissions(backupFolder->getFolder()))
         {
             backupFolder->mSelected = selected;
+            updateCandidate(backupFolder);
         }
     }
     emit dataChanged(index(0), index(mBackupFolderList.size() - 1), {SELECTED_ROLE});
@@ -510,41 +512,12 @@ bool BackupsModel::selectIfExistsInsertion(const QString& inputPath)
     return false;
 }
 
-bool BackupsModel::folderContainsOther(const QString& folder,
-                                            const QString& other) const
-{
-    if(folder == other)
-    {
-        return true;
-    }
-    return folder.startsWith(other) && folder[other.size()] == QDir::separator();
-}
-
-bool BackupsModel::isRelatedFolder(const QString& folder,
-                                        const QString& existingPath) const
-{
-    return folderContainsOther(folder, existingPath) || folderContainsOther(existingPath, folder);
-}
-
 QModelIndex BackupsModel::getModelIndex(QList<BackupFolder*>::iterator item)
 {
     int row = static_cast<int>(std::distance(mBackupFolderList.begin(), item));
     return QModelIndex(index(static_cast<int>(row), 0));
 }
 
-QList<QList<BackupFolder*>::const_iterator> BackupsModel::getRepeatedNameItList(const QString& name)
-{
-    QList<QList<BackupFolder*>::const_iterator> ret;
-    for (auto it = mBackupFolderList.cbegin() ; it != mBackupFolderList.cend(); ++it)
-    {
-        if((*it)->mName == name)
-        {
-            ret.append(it);
-        }
-    }
-    return ret;
-}
-
 void BackupsModel::reviewConflicts()
 {
     auto item = mBackupFolderList.cbegin();
@@ -619,69 +592,68 @@ void BackupsModel::reviewConflicts()
     }
 }
 
-void BackupsModel::checkDuplicatedBackups(const QStringList& candidateList)
+void BackupsModel::updateCandidate(BackupFolder* folder)
 {
-    QSet<QString> remoteSet = BackupsController::instance().getRemoteFolders();
-    QSet<QString> localSet;
-    QStringListIterator it(candidateList);
-    while(it.hasNext())
+    if(mCandidatesIndex.update(folder))
     {
-        auto name = it.next();
-
-        BackupErrorCode error = BackupErrorCode::NONE;
+        mFoldersWatcher.setFolders(mCandidatesIndex.getFolders());
+    }
+}
 
-        int remoteSize = remoteSet.size();
-        remoteSet.insert(name); //if it fails means that the name already exist in the QSet
-        if(remoteSize == remoteSet.size())
-        {
-            error = BackupErrorCode::EXISTS_REMOTE;
-        }
-        else
-        {
-            remoteSet.remove(name); //It went ok so we don´t want the name in the set
-        }
+void BackupsModel::removeCandidate(BackupFolder* folder)
+{
+    if(mCandidatesIndex.remove(folder))
+    {
+        mFoldersWatcher.setFolders(mCandidatesIndex.getFolders());
+    }
+}
 
-        if(error == BackupErrorCode::NONE)
-        {
-            int localSize = localSet.size();
-            localSet.insert(name); //if it fails means that the name already exist in the QSet
-            if(localSize == localSet.size())
-            {
-                error = BackupErrorCode::DUPLICATED_NAME;
-            }
-        }
+void BackupsModel::checkCandidate(BackupFolder* folder,
+                                  const QSet<QString>& remoteFolders,
+                                  bool refreshSize)
+{
+    QString message;
+    if (folder->mError == BackupErrorCode::NONE
+        && !markRelatedFolders(folder)
+        && BackupsController::instance().isLocalFolderSyncable(folder->getFolder(),
+                                                               mega::MegaSync::TYPE_BACKUP,
+                                                               message)
+               != SyncController::CAN_SYNC)
+    {
+        QDir dir(folder->getFolder());
+        folder->mError = dir.exists() ? BackupErrorCode::SYNC_CONFLICT : BackupErrorCode::UNAVAILABLE_DIR;
+    }
+    else if (refreshSize || !folder->mFolderSizeReady)
+    {
+        // Sizes are kept between checks, the selected view refreshes them all
+        folder->calculateFolderSize();
+    }
 
-        if(error != BackupErrorCode::NONE)
-        {
-            foreach(auto foldIt, getRepeatedNameItList(name))
-            {
-                (*foldIt)->setError(error);
-            }
-        }
+    if (remoteFolders.contains(folder->mName))
+    {
+        folder->setError(BackupErrorCode::EXISTS_REMOTE);
+    }
+    else if (mCandidatesIndex.getNameCount(folder->mName) > 1)
+    {
+        folder->setError(BackupErrorCode::DUPLICATED_NAME);
     }
 }
 
-bool BackupsModel::existOtherRelatedFolder(const int currentRow)
+bool BackupsModel::markRelatedFolders(BackupFolder* folder)
 {
-    if(currentRow > mBackupFolderList.size())
+    const auto relatedFolders = mCandidatesIndex.getRelatedFolders(folder->getFolder());
+    for (auto relatedFolder : relatedFolders)
     {
-        return false;
+        relatedFolder->mError = BackupErrorCode::PATH_RELATION;
     }
 
-    bool found = false;
-    QString folder(mBackupFolderList[currentRow]->getFolder());
-    int conflictRow = 1;
-    while(!found && conflictRow < rowCount())
+    if (relatedFolders.isEmpty())
     {
-        if((found = mBackupFolderList[conflictRow]->mSelected
-            && conflictRow!=currentRow &&isRelatedFolder(folder, mBackupFolderList[conflictRow]->getFolder())))
-        {
-            mBackupFolderList[currentRow]->mError = BackupErrorCode::PATH_RELATION;
-            mBackupFolderList[conflictRow]->mError = BackupErrorCode::PATH_RELATION;
-        }
-        conflictRow++;
+        return false;
     }
-    return found;
+
+    folder->mError = BackupErrorCode::PATH_RELATION;
+    return true;
 }
 
 void BackupsModel::check()
@@ -698,30 +670,15 @@ void BackupsModel::check()
 
     mGlobalError = BackupErrorCode::NONE;
 
-    QStringList candidateList;
+    const QSet<QString> remoteFolders = BackupsController::instance().getRemoteFolders();
     for (int row = 0; row < rowCount(); row++)
     {
         if (mBackupFolderList[row]->mSelected && !mBackupFolderList[row]->mDone)
         {
-            QString message;
-            candidateList.append(mBackupFolderList[row]->mName);
-            if (mBackupFolderList[row]->mError == BackupErrorCode::NONE
-                && !existOtherRelatedFolder(row)
-                && BackupsController::instance().isLocalFolderSyncable(mBackupFolderList[row]->getFolder(), mega::MegaSync::TYPE_BACKUP, message)
-                    != SyncController::CAN_SYNC)
-            {
-                QDir dir(mBackupFolderList[row]->getFolder());
-                mBackupFolderList[row]->mError = dir.exists() ? BackupErrorCode::SYNC_CONFLICT : BackupErrorCode::UNAVAILABLE_DIR;
-            }
-            else
-            {
-                mBackupFolderList[row]->calculateFolderSize();
-            }
+            checkCandidate(mBackupFolderList[row], remoteFolders, false);
         }
     }
 
-    checkDuplicatedBackups(candidateList);
-
     reviewConflicts();
 
     // Change final errors
@@ -824,6 +781,7 @@ void BackupsModel::remove(const QString& folder)
             const auto row = static_cast<int>(std::distance(mBackupFolderList.begin(), item));
             if(row >= 0)
             {
+                removeCandidate(*item);
                 beginRemoveRows(QModelIndex(), row, row);
                 item = mBackupFolderList.erase(item);
                 endRemoveRows();
@@ -908,6 +866,7 @@ void BackupsModel::clean(bool resetErrors)
                 const auto row = static_cast<int>(std::distance(mBackupFolderList.begin(), item));
                 if(row >= 0)
                 {
+                    removeCandidate(*item);
                     beginRemoveRows(QModelIndex(), row, row);
                     item = mBackupFolderList.erase(item);
                     endRemoveRows();
@@ -1016,6 +975,51 @@ bool BackupsModel::checkDirectories()
     return success;
 }
 
+void BackupsModel::onFolderAppeared(const QString& folder)
+{
+    const int row = getRow(folder);
+    if(row >= rowCount())
+    {
+        return;
+    }
+
+    BackupFolder* backupFolder = mBackupFolderList[row];
+    if(!backupFolder->mSelected || backupFolder->mDone
+        || backupFolder->mError != BackupErrorCode::UNAVAILABLE_DIR)
+    {
+        return;
+    }
+
+    // Only this folder is checked again, its contents may have changed meanwhile
+    backupFolder->mError = BackupErrorCode::NONE;
+    checkCandidate(backupFolder, BackupsController::instance().getRemoteFolders(), true);
+
+    mGlobalError = BackupErrorCode::NONE;
+    reviewConflicts();
+    emit dataChanged(index(0, 0), index(rowCount() - 1, 0), { ERROR_ROLE });
+    if(mGlobalError == BackupErrorCode::NONE)
+    {
+        emit globalErrorChanged();
+    }
+}
+
+void BackupsModel::onFolderDisappeared(const QString& folder)
+{
+    const int row = getRow(folder);
+    if(row >= rowCount())
+    {
+        return;
+    }
+
+    BackupFolder* backupFolder = mBackupFolderList[row];
+    if(backupFolder->mSelected && !backupFolder->mDone
+        && backupFolder->mError != BackupErrorCode::SDK_CREATION)
+    {
+        setData(index(row, 0), QVariant(BackupErrorCode::UNAVAILABLE_DIR), ERROR_ROLE);
+        reviewConflicts();
+    }
+}
+
 // ************************************************************************************************
 // * BackupsProxyModel
 // ************************************************************************************************
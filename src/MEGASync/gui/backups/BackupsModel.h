@@ -1,12 +1,13 @@
 #ifndef BACKUPSMODEL_H
 #define BACKUPSMODEL_H
 
+#include "BackupCandidatesIndex.h"
+#include "BackupCandidatesWatcher.h"
 #include "BackupsController.h"
 #include "FileFolderAttributes.h"
 
 #include <QAbstractListModel>
 #include <QSortFilterProxyModel>
-#include <QTimer>
 
 class BackupFolder : public QObject
 {
@@ -132,8 +133,6 @@ signals:
     void newFolderAdded(int newFolderIndex);
 
 private:
-    static int CHECK_DIRS_TIME;
-
     QList<BackupFolder*> mBackupFolderList;
     int mSelectedRowsTotal;
     long long mBackupsTotalSize;
@@ -141,7 +140,8 @@ private:
     int mConflictsSize;
     Qt::CheckState mCheckAllState;
     int mGlobalError;
-    QTimer mCheckDirsTimer;
+    BackupCandidatesIndex mCandidatesIndex;
+    BackupCandidatesWatcher mFoldersWatcher;
     int mSdkCount;
     int mRemoteCount;
 
@@ -149,19 +149,15 @@ private:
     void checkSelectedAll();
     bool isLocalFolderSyncable(const QString& inputPath);
     bool selectIfExistsInsertion(const QString& inputPath);
-    QList<QList<BackupFolder*>::const_iterator> getRepeatedNameItList(const QString& name);
-
-    bool folderContainsOther(const QString& folder,
-                             const QString& other) const;
-    bool isRelatedFolder(const QString& folder,
-                         const QString& existingPath) const;
     QModelIndex getModelIndex(QList<BackupFolder*>::iterator item);
     void setAllSelected(bool selected);
     bool checkPermissions(const QString& inputPath);
-    void checkDuplicatedBackups(const QStringList &candidateList);
+    void updateCandidate(BackupFolder* folder);
+    void removeCandidate(BackupFolder* folder);
+    void checkCandidate(BackupFolder* folder, const QSet<QString>& remoteFolders, bool refreshSize);
+    bool markRelatedFolders(BackupFolder* folder);
     void reviewConflicts();
     void changeConflictsNotificationText(const QString& text);
-    bool existOtherRelatedFolder(const int currentRow);
     bool existsFolder(const QString& inputPath);
     void setGlobalError(BackupErrorCode error);
     void setTotalSizeReady(bool ready);
@@ -172,6 +168,8 @@ private slots:
     void onSyncRemoved(std::shared_ptr<SyncSettings> syncSettings);
     void onBackupsCreationFinished(bool success);
     void onBackupFinished(const QString& folder, int errorCode, int syncErrorCode);
+    void onFolderAppeared(const QString& folder);
+    void onFolderDisappeared(const QString& folder);
 
 };
 
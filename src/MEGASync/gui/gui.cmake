@@ -102,6 +102,8 @@ set(DESKTOP_APP_GUI_HEADERS
     gui/SyncExclusions/SyncExclusions.h
     gui/tokenizer/TokenParserWidgetManager.h
     gui/tokenizer/IconTokenizer.h
+    gui/backups/BackupCandidatesIndex.h
+    gui/backups/BackupCandidatesWatcher.h
     gui/backups/Backups.h
     gui/backups/BackupsController.h
     gui/backups/BackupsModel.h
@@ -230,6 +232,8 @@ set(DESKTOP_APP_GUI_SOURCES
     gui/SyncExclusions/SyncExclusions.cpp
     gui/tokenizer/TokenParserWidgetManager.cpp
     gui/tokenizer/IconTokenizer.cpp
+    gui/backups/BackupCandidatesIndex.cpp
+    gui/backups/BackupCandidatesWatcher.cpp
     gui/backups/Backups.cpp
     gui/backups/BackupsController.cpp
     gui/backups/BackupsModel.cpp
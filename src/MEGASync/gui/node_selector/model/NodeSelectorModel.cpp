@@ -903,7 +903,7 @@ void NodeSelectorModel::removeNodes(const QList<mega::MegaHandle>& nodeHandles,
 {
     emit blockUi(true);
     //It will be unblocked when all requestFinish calls are received (check onRequestFinish)
-    QtConcurrent::run([this, nodeHandles, permanently]() {
+    auto removeTask = [this, nodeHandles, permanently]() {
         foreach(auto handle, nodeHandles)
         {
             std::shared_ptr<mega::MegaNode> node(
@@ -927,7 +927,8 @@ void NodeSelectorModel::removeNodes(const QList<mega::MegaHandle>& nodeHandles,
                 }
             }
         }
-    });
+    };
+    ThreadPoolSingleton::getInstance()->push(removeTask, ThreadPool::Priority::INTERACTIVE);
 }
 
 bool NodeSelectorModel::areAllNodesEligibleForDeletion(const QList<mega::MegaHandle>& handles)
@@ -1137,14 +1138,7 @@ QVariant NodeSelectorModel::getText(const QModelIndex &index, NodeSelectorModelI
     {
         case COLUMN::NODE:
         {
-            if(item->isVault() || item->isCloudDrive())
-            {
-                return MegaNodeNames::getRootNodeName(item->getNode().get());
-            }
-            else
-            {
-                return MegaNodeNames::getNodeName(item->getNode().get());
-            }
+            return item->getName();
         }
         case COLUMN::DATE:
         {
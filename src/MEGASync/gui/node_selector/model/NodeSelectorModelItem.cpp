@@ -3,11 +3,30 @@
 #include "Avatar.h"
 #include "FullName.h"
 #include "MegaApplication.h"
+#include "MegaNodeNames.h"
 
 const int NodeSelectorModelItem::ICON_SIZE = 17;
 
 using namespace mega;
 
+namespace
+{
+const QCollator& getSortCollator()
+{
+    // QCollator is not thread safe, and the models are sorted in the ThreadPool. The keys of
+    // collators with the same locale and options can be compared with each other.
+    thread_local QCollator collator = []()
+    {
+        QCollator newCollator;
+        newCollator.setCaseSensitivity(Qt::CaseInsensitive);
+        newCollator.setNumericMode(true);
+        newCollator.setIgnorePunctuation(false);
+        return newCollator;
+    }();
+    return collator;
+}
+}
+
 NodeSelectorModelItem::NodeSelectorModelItem(std::unique_ptr<MegaNode> node, bool showFiles, NodeSelectorModelItem *parentItem) :
     QObject(parentItem),
     mOwnerEmail(QString()),
@@ -42,6 +61,38 @@ std::shared_ptr<mega::MegaNode> NodeSelectorModelItem::getNode() const
     return mNode;
 }
 
+QString NodeSelectorModelItem::getName()
+{
+    if(isVault() || isCloudDrive())
+    {
+        return MegaNodeNames::getRootNodeName(mNode.get());
+    }
+
+    return MegaNodeNames::getNodeName(mNode.get());
+}
+
+std::shared_ptr<const NodeSelectorModelItem::SortData> NodeSelectorModelItem::getSortData()
+{
+    // Reset from the GUI thread while a sort may be reading it
+    auto sortData(std::atomic_load(&mSortData));
+    if(!sortData)
+    {
+        const QCollator& collator(getSortCollator());
+        sortData = std::make_shared<const SortData>(SortData{collator.sortKey(getName()),
+                                                             collator.sortKey(getOwnerName()),
+                                                             mNode->getCreationTime(),
+                                                             mNode->isFile()});
+        std::atomic_store(&mSortData, sortData);
+    }
+
+    return sortData;
+}
+
+void NodeSelectorModelItem::resetSortData()
+{
+    std::atomic_store(&mSortData, std::shared_ptr<const SortData>());
+}
+
 void NodeSelectorModelItem::createChildItems(std::unique_ptr<mega::MegaNodeList> nodeList)
 {
     if(!mNode->isFile())
@@ -144,6 +195,7 @@ void NodeSelectorModelItem::setOwner(std::unique_ptr<mega::MegaUser> user)
 
     mOwner = std::move(user);
     mOwnerEmail = QString::fromUtf8(mOwner->getEmail());
+    resetSortData();
     mFullNameAttribute = UserAttributes::FullName::requestFullName(mOwner->getEmail());
     if(mFullNameAttribute)
     {
@@ -166,6 +218,7 @@ void NodeSelectorModelItem::setOwner(std::unique_ptr<mega::MegaUser> user)
 
 void NodeSelectorModelItem::onFullNameAttributeReady()
 {
+    resetSortData();
     emit infoUpdated(Qt::DisplayRole);
 }
 
@@ -281,6 +334,7 @@ int NodeSelectorModelItem::row()
 void NodeSelectorModelItem::updateNode(std::shared_ptr<mega::MegaNode> node)
 {
     mNode = node;
+    resetSortData();
 }
 
 void NodeSelectorModelItem::calculateSyncStatus()
@@ -3,6 +3,7 @@
 
 #include "megaapi.h"
 
+#include <QCollator>
 #include <QIcon>
 #include <QList>
 
@@ -28,10 +29,24 @@ public:
         NONE,
     };
 
+    // What the proxy models sort by, so that comparing two items is comparing these fields
+    // instead of getting the data through QVariant and collating the strings every time
+    struct SortData
+    {
+        QCollatorSortKey nameKey;
+        QCollatorSortKey ownerNameKey;
+        int64_t creationTime;
+        bool isFile;
+    };
+
     explicit NodeSelectorModelItem(std::unique_ptr<mega::MegaNode> node, bool showFiles, NodeSelectorModelItem *parentItem = 0);
     ~NodeSelectorModelItem();
 
     std::shared_ptr<mega::MegaNode> getNode() const;
+    QString getName();
+    // Created on first use, usually by the thread sorting the model, and kept until the name or
+    // the owner name change
+    std::shared_ptr<const SortData> getSortData();
 
     void createChildItems(std::unique_ptr<mega::MegaNodeList> nodeList);
     bool areChildrenInitialized() const;
@@ -66,6 +81,7 @@ signals:
 
 protected:
     void calculateSyncStatus();
+    void resetSortData();
 
     QString mOwnerEmail;
     Status mStatus;
@@ -78,6 +94,7 @@ protected:
     std::shared_ptr<mega::MegaNode> mNode;
     QList<QPointer<NodeSelectorModelItem>> mChildItems;
     std::unique_ptr<mega::MegaUser> mOwner;
+    std::shared_ptr<const SortData> mSortData;
 
 private slots:
     void onFullNameAttributeReady();
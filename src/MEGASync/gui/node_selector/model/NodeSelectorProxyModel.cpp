@@ -3,6 +3,7 @@
 #include "megaapi.h"
 #include "MegaApplication.h"
 #include "NodeSelectorModel.h"
+#include "Utilities.h"
 #include "QThread"
 
 #include <QDebug>
@@ -14,10 +15,6 @@ NodeSelectorProxyModel::NodeSelectorProxyModel(QObject* parent) :
     mExpandMapped(true),
     mForceInvalidate(false)
 {
-    mCollator.setCaseSensitivity(Qt::CaseInsensitive);
-    mCollator.setNumericMode(true);
-    mCollator.setIgnorePunctuation(false);
-
     connect(&mFilterWatcher, &QFutureWatcher<void>::finished,
             this, &NodeSelectorProxyModel::onModelSortedFiltered);
 }
@@ -37,7 +34,7 @@ void NodeSelectorProxyModel::sort(int column, Qt::SortOrder order)
     emit layoutAboutToBeChanged();
     if(mFilterWatcher.isFinished())
     {
-        QFuture<void> filtered = QtConcurrent::run([this, column, order](){
+        auto sortAndFilter = [this, column, order](){
             auto itemModel = dynamic_cast<NodeSelectorModel*>(sourceModel());
             if(itemModel)
             {
@@ -57,7 +54,9 @@ void NodeSelectorProxyModel::sort(int column, Qt::SortOrder order)
                 blockSignals(false);
                 sourceModel()->blockSignals(false);
             }
-        });
+        };
+        QFuture<void> filtered = ThreadPoolSingleton::getInstance()->run(
+            ThreadPool::Priority::INTERACTIVE, sortAndFilter);
         mFilterWatcher.setFuture(filtered);
     }
 }
@@ -131,55 +130,55 @@ void NodeSelectorProxyModel::removeNode(const QModelIndex& item)
 
 bool NodeSelectorProxyModel::lessThan(const QModelIndex &left, const QModelIndex &right) const
 {
-    bool lIsFile = left.data(toInt(NodeSelectorModelRoles::IS_FILE_ROLE)).toBool();
-    bool rIsFile = right.data(toInt(NodeSelectorModelRoles::IS_FILE_ROLE)).toBool();
-
-    auto result(false);
-
-    if(lIsFile && !rIsFile)
+    auto leftItem(static_cast<NodeSelectorModelItem*>(left.internalPointer()));
+    auto rightItem(static_cast<NodeSelectorModelItem*>(right.internalPointer()));
+    if(!leftItem || !rightItem)
     {
-        result = sortOrder() == Qt::DescendingOrder;
+        return QSortFilterProxyModel::lessThan(left, right);
     }
-    else if(!lIsFile && rIsFile)
+
+    return isItemLessThan(leftItem, rightItem, left.column(), sortOrder());
+}
+
+bool NodeSelectorProxyModel::isItemLessThan(NodeSelectorModelItem* left,
+                                            NodeSelectorModelItem* right,
+                                            int column,
+                                            Qt::SortOrder order)
+{
+    auto leftData(left->getSortData());
+    auto rightData(right->getSortData());
+
+    // Folders always go first
+    if(leftData->isFile != rightData->isFile)
     {
-        result = sortOrder() != Qt::DescendingOrder;
+        return leftData->isFile == (order == Qt::DescendingOrder);
     }
-    else
+
+    switch(column)
     {
-        if(left.column() == NodeSelectorModel::DATE && right.column() == NodeSelectorModel::DATE)
+        case NodeSelectorModel::DATE:
         {
-            result = left.data(toInt(NodeSelectorModelRoles::DATE_ROLE)).value<int64_t>() < right.data(toInt(NodeSelectorModelRoles::DATE_ROLE)).value<int64_t>();
+            return leftData->creationTime < rightData->creationTime;
         }
-        else
+        case NodeSelectorModel::STATUS:
         {
-            int lStatus(0);
-            int rStatus(0);
-
-            if(left.column() == NodeSelectorModel::STATUS && right.column() == NodeSelectorModel::STATUS)
-            {
-                lStatus = left.data(toInt(NodeSelectorModelRoles::STATUS_ROLE)).toInt();
-                rStatus = right.data(toInt(NodeSelectorModelRoles::STATUS_ROLE)).toInt();
-            }
-
-            if(lStatus != rStatus)
-            {
-                result = lStatus < rStatus;
-            }
-            else if(left.column() == NodeSelectorModel::USER && right.column() == NodeSelectorModel::USER)
-            {
-                result = mCollator.compare(left.data(Qt::ToolTipRole).toString(),
-                                           right.data(Qt::ToolTipRole).toString()) < 0;
-            }
-            else
-            {
-                result = mCollator.compare(left.data(Qt::DisplayRole).toString(),
-                                           right.data(Qt::DisplayRole).toString())<0;
-            }
+            return left->getStatus() < right->getStatus();
+        }
+        case NodeSelectorModel::USER:
+        {
+            return leftData->ownerNameKey.compare(rightData->ownerNameKey) < 0;
+        }
+        case NodeSelectorModel::NODE:
+        {
+            return leftData->nameKey.compare(rightData->nameKey) < 0;
+        }
+        default:
+        {
+            break;
         }
-
     }
 
-    return result;
+    return false;
 }
 
 void NodeSelectorProxyModel::setSourceModel(QAbstractItemModel *sourceModel)
@@ -5,7 +5,6 @@
 #include "NodeSelectorModelItem.h"
 
 #include <QSortFilterProxyModel>
-#include <QCollator>
 #include <QFutureWatcher>
 #include <QEventLoop>
 
@@ -34,6 +33,10 @@ public:
     QVector<QModelIndex> getRelatedModelIndexes(const std::shared_ptr<mega::MegaNode> node);
     void removeNode(const QModelIndex &item);
     bool lessThan(const QModelIndex &left, const QModelIndex &right) const override;
+    static bool isItemLessThan(NodeSelectorModelItem* left,
+                               NodeSelectorModelItem* right,
+                               int column,
+                               Qt::SortOrder order);
     void setSourceModel(QAbstractItemModel *sourceModel) override;
     void setExpandMapped(bool value){mExpandMapped = value;}
     NodeSelectorModel* getMegaModel();
@@ -49,7 +52,6 @@ signals:
 
 private:
     QVector<QModelIndex> forEach(std::shared_ptr<mega::MegaNodeList> parentNodeList, QModelIndex parent = QModelIndex());
-    QCollator mCollator;
     int mSortColumn;
     Qt::SortOrder mOrder;
     QFutureWatcher<void> mFilterWatcher;
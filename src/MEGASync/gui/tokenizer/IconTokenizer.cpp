@@ -3,27 +3,41 @@
 #include <QDebug>
 #include <QWidget>
 #include <QBitmap>
+#include <QPainter>
 #include <QToolButton>
 
 static const QString ButtonId = QString::fromUtf8("Button");
+// Tinted pixmaps kept between dialogs and theme changes, each button icon needs one per theme
+static const int MAX_TINTED_PIXMAPS = 256;
 
 IconTokenizer::IconTokenizer(QObject* parent)
     : QObject{parent}
 { }
 
-void IconTokenizer::process(QWidget* widget, const QString& mode, const QString& state, const ColorTokens& colorTokens,
-                            const QString& targetElementId, const QString& targetElementProperty, const QString& tokenId)
+bool IconTokenizer::TintedPixmapKey::operator==(const TintedPixmapKey& other) const
 {
-    if (widget == nullptr || mode.isEmpty() || state.isEmpty() || colorTokens.empty()|| targetElementId.isEmpty() || targetElementProperty.isEmpty() || tokenId.isEmpty())
+    return pixmapKey == other.pixmapKey && color == other.color && size == other.size
+           && qFuzzyCompare(devicePixelRatio, other.devicePixelRatio);
+}
+
+uint qHash(const IconTokenizer::TintedPixmapKey& key, uint seed)
+{
+    return qHash(key.pixmapKey, seed) ^ qHash(key.color, seed)
+           ^ qHash(qMakePair(key.size.width(), key.size.height()), seed);
+}
+
+void IconTokenizer::process(QWidget* widget, const QString& mode, const QString& state, const QColor& toColor,
+                            const QString& targetElementId, const QString& targetElementProperty)
+{
+    if (widget == nullptr || mode.isEmpty() || state.isEmpty() || !toColor.isValid() || targetElementId.isEmpty() || targetElementProperty.isEmpty())
     {
         qWarning() << __func__ << " Error on function arguments :"
                  << "\n widget is nullptr : " << QVariant(widget == nullptr).toString()
                  << "\n mode is empty : " << QVariant(mode.isEmpty()).toString()
                  << "\n state is empty : " << QVariant(state.isEmpty()).toString()
-                 << "\n colorTokens are empty : " << QVariant(colorTokens.isEmpty()).toString()
+                 << "\n color is invalid : " << QVariant(!toColor.isValid()).toString()
                  << "\n targetElementId is empty : " << QVariant(targetElementId.isEmpty()).toString()
-                 << "\n targetElementProperty is empty : " << QVariant(targetElementProperty.isEmpty()).toString()
-                 << "\n tokenId is empty : " << QVariant(tokenId.isEmpty()).toString();
+                 << "\n targetElementProperty is empty : " << QVariant(targetElementProperty.isEmpty()).toString();
 
         return;
     }
@@ -75,15 +89,7 @@ void IconTokenizer::process(QWidget* widget, const QString& mode, const QString&
                 return;
             }
 
-            if (!colorTokens.contains(tokenId))
-            {
-                qWarning() << __func__ << " Error token id not found : " << tokenId;
-                return;
-            }
-
-            QColor toColor(colorTokens.value(tokenId));
-
-            auto tintedPixmap = changePixmapColor(pixmap, toColor);
+            auto tintedPixmap = getTintedPixmap(pixmap, toColor);
 
             if (tintedPixmap.has_value())
             {
@@ -130,6 +136,30 @@ std::optional<QIcon::State> IconTokenizer::getIconState(const QString& state)
     return std::nullopt;
 }
 
+//!
+//! \brief IconTokenizer::getTintedPixmap
+//! \returns @pixmap tinted with @toColor, reusing the result of previous calls with the same
+//! pixmap, color, size and device pixel ratio.
+//!
+std::optional<QPixmap> IconTokenizer::getTintedPixmap(const QPixmap& pixmap, const QColor& toColor)
+{
+    static QCache<TintedPixmapKey, QPixmap> tintedPixmaps(MAX_TINTED_PIXMAPS);
+
+    TintedPixmapKey key{pixmap.cacheKey(), toColor.rgba(), pixmap.size(), pixmap.devicePixelRatioF()};
+    if (auto tintedPixmap = tintedPixmaps.object(key))
+    {
+        return *tintedPixmap;
+    }
+
+    auto tintedPixmap = changePixmapColor(pixmap, toColor);
+    if (tintedPixmap.has_value())
+    {
+        tintedPixmaps.insert(key, new QPixmap(tintedPixmap.value()));
+    }
+
+    return tintedPixmap;
+}
+
 std::optional<QPixmap> IconTokenizer::changePixmapColor(const QPixmap& pixmap, QColor toColor)
 {
     if (pixmap.isNull())
@@ -139,7 +169,7 @@ std::optional<QPixmap> IconTokenizer::changePixmapColor(const QPixmap& pixmap, Q
         return std::nullopt;
     }
 
-    QImage image = pixmap.toImage();
+    QImage image = pixmap.toImage().convertToFormat(QImage::Format_ARGB32_Premultiplied);
     if (image.isNull())
     {
         qWarning() << __func__ << " Error image from pixmap is invalid";
@@ -151,15 +181,11 @@ std::optional<QPixmap> IconTokenizer::changePixmapColor(const QPixmap& pixmap, Q
      * we are using the requested color for every pixel on the image
      * only the alpha channel is preserved.
     */
-    for(auto widthIndex = 0; widthIndex < image.width(); ++widthIndex)
-    {
-        for(auto heightIndex = 0; heightIndex < image.height(); ++heightIndex)
-        {
-            QColor color = image.pixelColor(widthIndex, heightIndex);
-            toColor.setAlpha(color.alpha());
-            image.setPixelColor(widthIndex, heightIndex, toColor);
-        }
-    }
+    toColor.setAlpha(255);
+    QPainter painter(&image);
+    painter.setCompositionMode(QPainter::CompositionMode_SourceIn);
+    painter.fillRect(image.rect(), toColor);
+    painter.end();
 
     return QPixmap::fromImage(image);
 }
@@ -1,8 +1,9 @@
 #ifndef ICON_TOKENIZER_H
 #define ICON_TOKENIZER_H
 
-#include <QObject>
+#include <QCache>
 #include <QIcon>
+#include <QObject>
 
 #include <optional>
 
@@ -10,14 +11,24 @@ class IconTokenizer : public QObject
 {
     Q_OBJECT
 
-    using ColorTokens = QMap<QString, QString>;
-
 public:
-    static void process(QWidget* widget, const QString& mode, const QString& state, const ColorTokens& colorTokens, const QString& targetElementId, const QString& targetElementProperty, const QString& tokenId);
+    static void process(QWidget* widget, const QString& mode, const QString& state, const QColor& toColor, const QString& targetElementId, const QString& targetElementProperty);
 
 private:
+    struct TintedPixmapKey
+    {
+        qint64 pixmapKey;
+        QRgb color;
+        QSize size;
+        qreal devicePixelRatio;
+
+        bool operator==(const TintedPixmapKey& other) const;
+    };
+    friend uint qHash(const TintedPixmapKey& key, uint seed);
+
     explicit IconTokenizer(QObject *parent = nullptr);
 
+    static std::optional<QPixmap> getTintedPixmap(const QPixmap& pixmap, const QColor& toColor);
     static std::optional<QPixmap> changePixmapColor(const QPixmap& pixmap, QColor toColor);
     static std::optional<QIcon::Mode> getIconMode(const QString& mode);
     static std::optional<QIcon::State> getIconState(const QString& state);
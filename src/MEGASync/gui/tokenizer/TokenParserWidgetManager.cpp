@@ -7,7 +7,10 @@
 
 #include <QBitmap>
 #include <QComboBox>
+#include <QCryptographicHash>
 #include <QDir>
+#include <QFileInfo>
+#include <QSet>
 #include <QtConcurrent/QtConcurrent>
 #include <QToolButton>
 #include <QWidget>
@@ -20,6 +23,29 @@ namespace // anonymous namespace to hide names from other translation units
 
     static const QString JSON_THEMED_COLOR_TOKEN_FILE = QLatin1String(":/colors/ColorThemedTokens.json");
     static const QString CSS_STANDARD_WIDGETS_COMPONENTS_FILE = QLatin1String(":/style/WidgetsComponentsStyleSheets.css");
+    // Generated by the widgetsStyleSheets target of the DesignTokensImporter
+    static const QString JSON_THEMED_STYLE_SHEETS_FILE = QLatin1String(":/style/ThemedStyleSheets.json");
+
+    static const QString COMPONENTS_KEY = QLatin1String("components");
+    static const QString WIDGETS_KEY = QLatin1String("widgets");
+    static const QString SOURCE_HASH_KEY = QLatin1String("sourceHash");
+    static const QString STYLE_SHEET_KEY = QLatin1String("styleSheet");
+    static const QString ICON_TOKENS_KEY = QLatin1String("iconTokens");
+    static const QString ICON_TOKEN_PROPERTY_KEY = QLatin1String("property");
+    static const QString ICON_TOKEN_ELEMENT_ID_KEY = QLatin1String("elementId");
+    static const QString ICON_TOKEN_MODE_KEY = QLatin1String("mode");
+    static const QString ICON_TOKEN_STATE_KEY = QLatin1String("state");
+    static const QString ICON_TOKEN_COLOR_KEY = QLatin1String("color");
+
+    QSet<QString> getWidgetNames(const char* uiFiles)
+    {
+        QSet<QString> widgetNames;
+        for (const auto& uiFile: QString::fromUtf8(uiFiles).split(QLatin1Char('|')))
+        {
+            widgetNames.insert(QFileInfo(uiFile).completeBaseName());
+        }
+        return widgetNames;
+    }
 
     enum COLOR_TOKEN_CAPTURE_INDEX
     {
@@ -59,10 +85,12 @@ TokenParserWidgetManager::TokenParserWidgetManager(QObject *parent)
     ICON_COLOR_TOKEN_REGULAR_EXPRESSION.optimize();
 
     loadColorThemeJson();
-    loadStandardStyleSheetComponents();
+    auto themedStyleSheets = loadThemedStyleSheetsJson();
+    loadStandardStyleSheetComponents(themedStyleSheets);
+    loadPrecompiledStyleSheets(themedStyleSheets);
 }
 
-void TokenParserWidgetManager::loadStandardStyleSheetComponents()
+void TokenParserWidgetManager::loadStandardStyleSheetComponents(const QJsonObject& themedStyleSheets)
 {
     mThemedStandardComponentsStyleSheet.clear();
 
@@ -81,8 +109,17 @@ void TokenParserWidgetManager::loadStandardStyleSheetComponents()
     }
 
     QString sourceStandardComponentsStyleSheet = QString::fromLatin1(data);
+    auto sourceHash = getSourceHash(sourceStandardComponentsStyleSheet);
+
     for (const auto& theme: mColorThemedTokens.keys())
     {
+        auto components = themedStyleSheets.value(theme).toObject().value(COMPONENTS_KEY).toObject();
+        if (components.value(SOURCE_HASH_KEY).toString() == sourceHash)
+        {
+            mThemedStandardComponentsStyleSheet[theme] = components.value(STYLE_SHEET_KEY).toString();
+            continue;
+        }
+
         const auto& colorTokens = mColorThemedTokens.value(theme);
 
         replaceColorTokens(sourceStandardComponentsStyleSheet, colorTokens);
@@ -127,6 +164,72 @@ void TokenParserWidgetManager::loadColorThemeJson()
     }
 }
 
+//!
+//! \brief TokenParserWidgetManager::loadThemedStyleSheetsJson
+//! \returns the stylesheets resolved for every theme by the DesignTokensImporter, so they do not
+//! need to be parsed when a dialog is opened or the theme changes
+//!
+QJsonObject TokenParserWidgetManager::loadThemedStyleSheetsJson()
+{
+    QFile file(JSON_THEMED_STYLE_SHEETS_FILE);
+    if (!file.open(QIODevice::ReadOnly | QIODevice::Text))
+    {
+        qWarning() << __func__ << " Error opening file : " << file.fileName();
+        return QJsonObject();
+    }
+
+    QJsonDocument jsonDoc = QJsonDocument::fromJson(file.readAll());
+    if (!jsonDoc.isObject())
+    {
+        qWarning() << __func__ << " Error invalid json format on file : " << file.fileName();
+        return QJsonObject();
+    }
+
+    return jsonDoc.object();
+}
+
+void TokenParserWidgetManager::loadPrecompiledStyleSheets(const QJsonObject& themedStyleSheets)
+{
+    mThemedStyleSheets.clear();
+
+    for (auto themeIt = themedStyleSheets.begin(); themeIt != themedStyleSheets.end(); ++themeIt)
+    {
+        const auto& theme = themeIt.key();
+        auto& styleSheets = mThemedStyleSheets[theme];
+        auto widgets = themeIt.value().toObject().value(WIDGETS_KEY).toObject();
+
+        for (auto widgetIt = widgets.begin(); widgetIt != widgets.end(); ++widgetIt)
+        {
+            const auto& widgetName = widgetIt.key();
+            if (!isTokenized(widgetName))
+            {
+                continue;
+            }
+
+            auto widget = widgetIt.value().toObject();
+
+            ThemedStyleSheet themedStyleSheet;
+            themedStyleSheet.sourceHash = widget.value(SOURCE_HASH_KEY).toString();
+            themedStyleSheet.styleSheet =
+                (isRoot(widgetName) ? mThemedStandardComponentsStyleSheet[theme] : QString()) %
+                widget.value(STYLE_SHEET_KEY).toString();
+
+            for (const auto& value: widget.value(ICON_TOKENS_KEY).toArray())
+            {
+                auto iconToken = value.toObject();
+                themedStyleSheet.iconTokens.append(
+                    {iconToken.value(ICON_TOKEN_PROPERTY_KEY).toString(),
+                     iconToken.value(ICON_TOKEN_ELEMENT_ID_KEY).toString(),
+                     iconToken.value(ICON_TOKEN_MODE_KEY).toString(),
+                     iconToken.value(ICON_TOKEN_STATE_KEY).toString(),
+                     QColor(iconToken.value(ICON_TOKEN_COLOR_KEY).toString())});
+            }
+
+            styleSheets.insert(widgetName, themedStyleSheet);
+        }
+    }
+}
+
 void TokenParserWidgetManager::onUpdateRequested()
 {
     applyCurrentTheme();
@@ -150,24 +253,24 @@ void TokenParserWidgetManager::applyCurrentTheme(QWidget* dialog)
 #endif
 }
 
-bool TokenParserWidgetManager::isTokenized(QWidget* widget)
+bool TokenParserWidgetManager::isTokenized(const QString& widgetName)
 {
-    static QStringList tokenizedUiFiles =
-        QString::fromUtf8(DESKTOP_APP_GUI_UI_FILES).split(QLatin1Char('|'));
-
-    QString uiFileName = QLatin1String("ui/%0.ui").arg(widget->objectName());
+    static const QSet<QString> tokenizedWidgets = getWidgetNames(DESKTOP_APP_GUI_UI_FILES);
 
-    return !tokenizedUiFiles.filter(uiFileName).empty();
+    return tokenizedWidgets.contains(widgetName);
 }
 
-bool TokenParserWidgetManager::isRoot(QWidget* widget)
+bool TokenParserWidgetManager::isRoot(const QString& widgetName)
 {
-    static QStringList tokenizedRootUiFiles =
-        QString::fromUtf8(DESKTOP_APP_GUI_UI_FILES_ROOT).split(QLatin1Char('|'));
+    static const QSet<QString> tokenizedRootWidgets = getWidgetNames(DESKTOP_APP_GUI_UI_FILES_ROOT);
 
-    QString uiFileName = QLatin1String("ui/%0.ui").arg(widget->objectName());
+    return tokenizedRootWidgets.contains(widgetName);
+}
 
-    return !tokenizedRootUiFiles.filter(uiFileName).empty();
+QString TokenParserWidgetManager::getSourceHash(const QString& styleSheet)
+{
+    return QString::fromLatin1(
+        QCryptographicHash::hash(styleSheet.toUtf8(), QCryptographicHash::Md5).toHex());
 }
 
 void TokenParserWidgetManager::applyCurrentTheme()
@@ -212,43 +315,101 @@ QColor TokenParserWidgetManager::getColor(const QString& colorToken, const QStri
 
 void TokenParserWidgetManager::applyTheme(QWidget* widget)
 {
-    if (!isTokenized(widget))
+    if (!isTokenized(widget->objectName()))
     {
         return;
     }
 
     auto currentTheme = ThemeManager::instance()->getSelectedThemeString();
 
-    QString widgetStyleSheet;
-    if (mWidgetsStyleSheets.contains(widget->objectName()))
+    if (!mColorThemedTokens.contains(currentTheme))
     {
-        widgetStyleSheet = mWidgetsStyleSheets[widget->objectName()];
+        qWarning() << __func__ << " Error theme not found : " << currentTheme;
+        return;
     }
-    else
+
+    const auto& themedStyleSheet = getThemedStyleSheet(widget, currentTheme);
+
+    for (const auto& iconToken: themedStyleSheet.iconTokens)
     {
-        widgetStyleSheet = widget->styleSheet();
-        mWidgetsStyleSheets[widget->objectName()] = widgetStyleSheet;
+        IconTokenizer::process(widget,
+                               iconToken.mode,
+                               iconToken.state,
+                               iconToken.color,
+                               iconToken.targetElementId,
+                               iconToken.targetElementProperty);
     }
 
-    if (!mColorThemedTokens.contains(currentTheme))
+    removeFrameOnDialogCombos(widget);
+
+    // Setting the same stylesheet again would polish the whole dialog for nothing
+    if (widget->styleSheet() != themedStyleSheet.styleSheet)
     {
-        qWarning() << __func__ << " Error theme not found : " << currentTheme;
-        return;
+        widget->setStyleSheet(themedStyleSheet.styleSheet);
+    }
+}
+
+const TokenParserWidgetManager::ThemedStyleSheet&
+    TokenParserWidgetManager::getThemedStyleSheet(QWidget* widget, const QString& currentTheme)
+{
+    const auto& sourceStyleSheet = getSourceStyleSheet(widget);
+
+    auto& styleSheets = mThemedStyleSheets[currentTheme];
+    auto styleSheetIt = styleSheets.find(widget->objectName());
+    if (styleSheetIt == styleSheets.end())
+    {
+        // Not generated by the DesignTokensImporter, it is resolved only once per theme
+        styleSheetIt = styleSheets.insert(
+            widget->objectName(),
+            createThemedStyleSheet(widget->objectName(), sourceStyleSheet, currentTheme));
+    }
+
+    return styleSheetIt.value();
+}
+
+const QString& TokenParserWidgetManager::getSourceStyleSheet(QWidget* widget)
+{
+    auto styleSheetIt = mWidgetsStyleSheets.find(widget->objectName());
+    if (styleSheetIt == mWidgetsStyleSheets.end())
+    {
+        styleSheetIt = mWidgetsStyleSheets.insert(widget->objectName(), widget->styleSheet());
+
+        // The precompiled stylesheets are discarded if the .ui file changed after they were
+        // generated
+        auto sourceHash = getSourceHash(styleSheetIt.value());
+        for (auto& styleSheets: mThemedStyleSheets)
+        {
+            auto themedStyleSheetIt = styleSheets.find(widget->objectName());
+            if (themedStyleSheetIt != styleSheets.end() &&
+                themedStyleSheetIt.value().sourceHash != sourceHash)
+            {
+                styleSheets.erase(themedStyleSheetIt);
+            }
+        }
     }
 
+    return styleSheetIt.value();
+}
+
+TokenParserWidgetManager::ThemedStyleSheet
+    TokenParserWidgetManager::createThemedStyleSheet(const QString& widgetName,
+                                                     const QString& sourceStyleSheet,
+                                                     const QString& currentTheme)
+{
     const auto& colorTokens = mColorThemedTokens.value(currentTheme);
 
+    QString widgetStyleSheet(sourceStyleSheet);
     replaceColorTokens(widgetStyleSheet, colorTokens);
-    replaceIconColorTokens(widget, widgetStyleSheet, colorTokens);
     replaceThemeTokens(widgetStyleSheet, currentTheme);
 
-    removeFrameOnDialogCombos(widget);
-
-    QString styleSheet =
-        (isRoot(widget) ? mThemedStandardComponentsStyleSheet[currentTheme] : QLatin1String()) %
+    ThemedStyleSheet themedStyleSheet;
+    themedStyleSheet.sourceHash = getSourceHash(sourceStyleSheet);
+    themedStyleSheet.iconTokens = getIconColorTokens(sourceStyleSheet, colorTokens);
+    themedStyleSheet.styleSheet =
+        (isRoot(widgetName) ? mThemedStandardComponentsStyleSheet[currentTheme] : QString()) %
         widgetStyleSheet;
 
-    widget->setStyleSheet(styleSheet);
+    return themedStyleSheet;
 }
 
 void TokenParserWidgetManager::removeFrameOnDialogCombos(QWidget* widget)
@@ -291,10 +452,12 @@ void TokenParserWidgetManager::replaceColorTokens(QString& styleSheet,
     }
 }
 
-void TokenParserWidgetManager::replaceIconColorTokens(QWidget* widget,
-                                                      QString& styleSheet,
-                                                      const ColorTokens& colorTokens)
+QList<TokenParserWidgetManager::IconToken>
+    TokenParserWidgetManager::getIconColorTokens(const QString& styleSheet,
+                                                 const ColorTokens& colorTokens)
 {
+    QList<IconToken> iconTokens;
+
     QRegularExpressionMatchIterator matchIterator = ICON_COLOR_TOKEN_REGULAR_EXPRESSION.globalMatch(styleSheet);
     while (matchIterator.hasNext())
     {
@@ -302,15 +465,22 @@ void TokenParserWidgetManager::replaceIconColorTokens(QWidget* widget,
 
         if (match.lastCapturedIndex() == ICON_TOKEN_CAPTURE_INDEX::ICON_TOKEN_DESIGN_TOKEN_NAME)
         {
-            const QString& targetElementProperty = match.captured(ICON_TOKEN_CAPTURE_INDEX::ICON_TOKEN_TARGET_PROPERTY);
-            const QString& targetElementId = match.captured(ICON_TOKEN_CAPTURE_INDEX::ICON_TOKEN_TARGET_ELEMENT_ID);
-            const QString& mode = match.captured(ICON_TOKEN_CAPTURE_INDEX::ICON_TOKEN_TARGET_MODE);
-            const QString& state = match.captured(ICON_TOKEN_CAPTURE_INDEX::ICON_TOKEN_TARGET_STATE);
             const QString& tokenId = match.captured(ICON_TOKEN_CAPTURE_INDEX::ICON_TOKEN_DESIGN_TOKEN_NAME);
+            if (!colorTokens.contains(tokenId))
+            {
+                qWarning() << __func__ << " Error token id not found : " << tokenId;
+                continue;
+            }
 
-            IconTokenizer::process(widget, mode, state, colorTokens, targetElementId, targetElementProperty, tokenId);
+            iconTokens.append({match.captured(ICON_TOKEN_CAPTURE_INDEX::ICON_TOKEN_TARGET_PROPERTY),
+                               match.captured(ICON_TOKEN_CAPTURE_INDEX::ICON_TOKEN_TARGET_ELEMENT_ID),
+                               match.captured(ICON_TOKEN_CAPTURE_INDEX::ICON_TOKEN_TARGET_MODE),
+                               match.captured(ICON_TOKEN_CAPTURE_INDEX::ICON_TOKEN_TARGET_STATE),
+                               QColor(colorTokens.value(tokenId))});
         }
     }
+
+    return iconTokens;
 }
 
 void TokenParserWidgetManager::replaceThemeTokens(QString& styleSheet, const QString& currentTheme)
@@ -3,8 +3,10 @@
 
 #include "Preferences/Preferences.h"
 
-#include <QObject>
+#include <QHash>
 #include <QIcon>
+#include <QJsonObject>
+#include <QObject>
 
 class TokenParserWidgetManager : public QObject
 {
@@ -20,24 +22,49 @@ public:
 private:
     using ColorTokens = QMap<QString, QString>;
 
+    struct IconToken
+    {
+        QString targetElementProperty;
+        QString targetElementId;
+        QString mode;
+        QString state;
+        QColor color;
+    };
+
+    // Stylesheet of a tokenized widget with its tokens already resolved for one theme
+    struct ThemedStyleSheet
+    {
+        QString sourceHash;
+        QString styleSheet;
+        QList<IconToken> iconTokens;
+    };
+
     explicit TokenParserWidgetManager(QObject *parent = nullptr);
     void loadColorThemeJson();
-    void loadStandardStyleSheetComponents();
+    QJsonObject loadThemedStyleSheetsJson();
+    void loadStandardStyleSheetComponents(const QJsonObject& themedStyleSheets);
+    void loadPrecompiledStyleSheets(const QJsonObject& themedStyleSheets);
     void onThemeChanged(Preferences::ThemeType theme);
     void onUpdateRequested();
     void applyTheme(QWidget* widget);
+    const ThemedStyleSheet& getThemedStyleSheet(QWidget* widget, const QString& currentTheme);
+    const QString& getSourceStyleSheet(QWidget* widget);
+    ThemedStyleSheet createThemedStyleSheet(const QString& widgetName,
+                                            const QString& sourceStyleSheet,
+                                            const QString& currentTheme);
     void replaceThemeTokens(QString& styleSheet, const QString& currentTheme);
-    void replaceIconColorTokens(QWidget* widget,
-                                QString& styleSheet,
-                                const ColorTokens& colorTokens);
+    QList<IconToken> getIconColorTokens(const QString& styleSheet, const ColorTokens& colorTokens);
     void replaceColorTokens(QString& styleSheet, const ColorTokens& colorTokens);
     void removeFrameOnDialogCombos(QWidget* widget);
-    bool isTokenized(QWidget* widget);
-    bool isRoot(QWidget* widget);
+    bool isTokenized(const QString& widgetName);
+    bool isRoot(const QString& widgetName);
+    static QString getSourceHash(const QString& styleSheet);
 
     QMap<QString, ColorTokens> mColorThemedTokens;
     QMap<QString, QString> mThemedStandardComponentsStyleSheet;
-    QMap<QString, QString> mWidgetsStyleSheets;
+    QHash<QString, QString> mWidgetsStyleSheets;
+    // Theme -> widget name -> resolved stylesheet
+    QHash<QString, QHash<QString, ThemedStyleSheet>> mThemedStyleSheets;
 };
 
 #endif // THEMEWIDGET_H
@@ -7,6 +7,16 @@
 #include "UserNotification.h"
 
 #include <QDateTime>
+#include <QSet>
+
+#include <algorithm>
+
+namespace
+{
+// Number of inserted and removed alerts from which the model is reset instead of
+// notifying every row change
+constexpr int MODEL_RESET_THRESHOLD = 500;
+}
 
 UserMessageModel::~UserMessageModel()
 {
@@ -60,14 +70,96 @@ Qt::ItemFlags UserMessageModel::flags(const QModelIndex& index) const
     return QAbstractItemModel::flags(index) | Qt::ItemIsEnabled | Qt::ItemIsEditable;
 }
 
-auto UserMessageModel::findById(unsigned id, UserMessage::Type type)
+UserMessageModel::MessageKey UserMessageModel::key(UserMessage::Type type, unsigned id)
+{
+    return qMakePair(static_cast<int>(type), id);
+}
+
+UserMessage* UserMessageModel::findById(unsigned id, UserMessage::Type type) const
+{
+    return mUserMessagesByKey.value(key(type, id), nullptr);
+}
+
+int UserMessageModel::rowOf(const UserMessage* message)
+{
+    if (mRowsDirty)
+    {
+        mRowsByMessage.clear();
+        mRowsByMessage.reserve(mUserMessages.size());
+        for (int row = 0; row < mUserMessages.size(); ++row)
+        {
+            mRowsByMessage.insert(mUserMessages.at(row), row);
+        }
+        mRowsDirty = false;
+    }
+
+    return mRowsByMessage.value(message, -1);
+}
+
+void UserMessageModel::indexMessage(UserMessage* message)
+{
+    mUserMessagesByKey.insert(key(message->getType(), message->id()), message);
+    mRowsDirty = true;
+}
+
+void UserMessageModel::removeMessageRows(QList<int> rows)
+{
+    rows.removeAll(-1);
+    if (rows.isEmpty())
+    {
+        return;
+    }
+
+    // Remove from the bottom, one contiguous range at a time
+    std::sort(rows.begin(), rows.end(), std::greater<int>());
+    rows.erase(std::unique(rows.begin(), rows.end()), rows.end());
+
+    int rangeIndex = 0;
+    while (rangeIndex < rows.size())
+    {
+        int last = rows.at(rangeIndex);
+        int first = last;
+        while (rangeIndex + 1 < rows.size() && rows.at(rangeIndex + 1) == first - 1)
+        {
+            ++rangeIndex;
+            first = rows.at(rangeIndex);
+        }
+        ++rangeIndex;
+
+        if (!mResettingModel)
+        {
+            beginRemoveRows(QModelIndex(), first, last);
+        }
+
+        for (int row = first; row <= last; ++row)
+        {
+            auto item = mUserMessages.at(row);
+            mUserMessagesByKey.remove(key(item->getType(), item->id()));
+            delete item;
+        }
+        mUserMessages.erase(mUserMessages.begin() + first, mUserMessages.begin() + last + 1);
+        mRowsDirty = true;
+
+        if (!mResettingModel)
+        {
+            endRemoveRows();
+        }
+    }
+}
+
+void UserMessageModel::emitRowsChanged(const QList<int>& rows)
 {
-    auto it = std::find_if(mUserMessages.begin(),
-                           mUserMessages.end(),
-                           [id, type](const UserMessage* current) {
-                               return current->isOfType(type) && current->hasSameId(id);
-                           });
-    return it;
+    if (mResettingModel || rows.isEmpty())
+    {
+        return;
+    }
+
+    auto minMax = std::minmax_element(rows.begin(), rows.end());
+    if (*minMax.first >= 0)
+    {
+        emit dataChanged(index(*minMax.first, 0, QModelIndex()),
+                         index(*minMax.second, 0, QModelIndex()));
+    }
 }
 
 void UserMessageModel::processAlerts(mega::MegaUserAlertList* alerts)
@@ -76,32 +168,58 @@ void UserMessageModel::processAlerts(mega::MegaUserAlertList* alerts)
     if (numAlerts)
     {
         QList<mega::MegaUserAlert*> newAlerts;
+        QHash<unsigned, int> newAlertsPositions;
         QList<mega::MegaUserAlert*> updatedAlerts;
-        QList<mega::MegaUserAlert*> removedAlerts;
+        QList<UserMessage*> removedAlerts;
         for (int i = 0; i < numAlerts; i++)
         {
             mega::MegaUserAlert* alert = alerts->get(i);
-            auto it = findById(alert->getId(), UserMessage::Type::ALERT);
-            if (it == mUserMessages.end())
+            auto item = findById(alert->getId(), UserMessage::Type::ALERT);
+            if (!item)
             {
-                if (alert->isRemoved())
+                // The same alert may come several times in the list, keep only the last state
+                auto newAlertPosition = newAlertsPositions.constFind(alert->getId());
+                if (newAlertPosition != newAlertsPositions.constEnd())
                 {
-                    removedAlerts.append(alert);
+                    delete newAlerts[newAlertPosition.value()];
+                    newAlerts[newAlertPosition.value()] =
+                        alert->isRemoved() ? nullptr : alert->copy();
                 }
-                else
+                else if (!alert->isRemoved())
                 {
+                    newAlertsPositions.insert(alert->getId(), newAlerts.size());
                     newAlerts.append(alert->copy());
                 }
             }
-            else if (!alert->isRemoved())
+            else if (alert->isRemoved())
+            {
+                removedAlerts.append(item);
+            }
+            else
             {
                 updatedAlerts.append(alert->copy());
             }
         }
+        newAlerts.removeAll(nullptr);
+
+        // For huge deltas, a single reset is cheaper for the views than thousands of row changes
+        const bool resetModel(newAlerts.size() + removedAlerts.size() > MODEL_RESET_THRESHOLD);
+        if (resetModel)
+        {
+            beginResetModel();
+            mResettingModel = true;
+        }
 
         removeAlerts(removedAlerts);
         insertAlerts(newAlerts);
         updateAlerts(updatedAlerts);
+        removeExceedingAlerts();
+
+        if (resetModel)
+        {
+            mResettingModel = false;
+            endResetModel();
+        }
     }
 }
 
@@ -112,19 +230,29 @@ void UserMessageModel::insertAlerts(const QList<mega::MegaUserAlert*>& alerts)
         return;
     }
 
-    beginInsertRows(QModelIndex(), 0, alerts.size() - 1);
+    if (!mResettingModel)
+    {
+        beginInsertRows(QModelIndex(), 0, alerts.size() - 1);
+    }
+
+    mUserMessages.reserve(mUserMessages.size() + alerts.size());
     for (auto& alert: alerts)
     {
         auto alertItem = new UserAlert(alert);
         connect(alertItem, &UserAlert::uiUpdated, this, &UserMessageModel::onUiUpdated);
         mUserMessages.prepend(alertItem);
+        indexMessage(alertItem);
 
         if (!alertItem->isSeen())
         {
             mSeenStatusManager.markAsUnseen(alertItem->getMessageType());
         }
     }
-    endInsertRows();
+
+    if (!mResettingModel)
+    {
+        endInsertRows();
+    }
 }
 
 void UserMessageModel::updateAlerts(const QList<mega::MegaUserAlert*>& alerts)
@@ -134,14 +262,14 @@ void UserMessageModel::updateAlerts(const QList<mega::MegaUserAlert*>& alerts)
         return;
     }
 
+    QList<int> changedRows;
+    changedRows.reserve(alerts.size());
     for (auto& alert: alerts)
     {
-        auto it = findById(alert->getId(), UserMessage::Type::ALERT);
-        if (it != mUserMessages.end())
+        auto alertItem =
+            qobject_cast<UserAlert*>(findById(alert->getId(), UserMessage::Type::ALERT));
+        if (alertItem)
         {
-            int row = static_cast<int>(std::distance(mUserMessages.begin(), it));
-            auto alertItem = qobject_cast<UserAlert*>(mUserMessages[row]);
-
             if (alertItem->isSeen() && !alert->getSeen())
             {
                 mSeenStatusManager.markAsUnseen(alertItem->getMessageType());
@@ -152,55 +280,62 @@ void UserMessageModel::updateAlerts(const QList<mega::MegaUserAlert*>& alerts)
             }
 
             alertItem->reset(alert);
-            emit dataChanged(index(row, 0, QModelIndex()), index(row, 0, QModelIndex()));
+            changedRows.append(rowOf(alertItem));
+        }
+        else
+        {
+            delete alert;
         }
     }
+
+    emitRowsChanged(changedRows);
 }
 
-void UserMessageModel::removeAlerts(const QList<mega::MegaUserAlert*>& alerts)
+void UserMessageModel::removeAlerts(const QList<UserMessage*>& alerts)
 {
     if (alerts.size() <= 0)
     {
         return;
     }
 
-    // Remove alerts that are not in the list of removed alerts
-    for (auto& alert: alerts)
+    QList<int> rows;
+    rows.reserve(alerts.size());
+    for (auto& item: alerts)
     {
-        auto it = findById(alert->getId(), UserMessage::Type::ALERT);
-        if (it != mUserMessages.end())
+        auto alertItem = qobject_cast<UserAlert*>(item);
+        if (alertItem && !alertItem->isSeen())
         {
-            int row = static_cast<int>(std::distance(mUserMessages.begin(), it));
-            auto alertItem = qobject_cast<UserAlert*>(mUserMessages[row]);
-            if (!alertItem->isSeen())
-            {
-                mSeenStatusManager.markAsSeen(alertItem->getMessageType());
-            }
-
-            beginRemoveRows(QModelIndex(), row, row);
-            delete mUserMessages[row];
-            mUserMessages.erase(it);
-            endRemoveRows();
+            mSeenStatusManager.markAsSeen(alertItem->getMessageType());
         }
+
+        rows.append(rowOf(item));
     }
 
+    removeMessageRows(rows);
+}
+
+void UserMessageModel::removeExceedingAlerts()
+{
     // Remove the oldest items if the list is too long
-    if (static_cast<unsigned>(mUserMessages.size()) > Preferences::MAX_COMPLETED_ITEMS)
+    auto exceedingItems(static_cast<long long>(mUserMessages.size()) -
+                        static_cast<long long>(Preferences::MAX_COMPLETED_ITEMS));
+    if (exceedingItems <= 0)
     {
-        int row = mUserMessages.size() - 1;
-        while (row >= 0 &&
-               static_cast<unsigned>(mUserMessages.size()) > Preferences::MAX_COMPLETED_ITEMS)
+        return;
+    }
+
+    QList<int> rows;
+    int row = mUserMessages.size() - 1;
+    while (row >= 0 && rows.size() < exceedingItems)
+    {
+        if (mUserMessages.at(row)->isOfType(UserMessage::Type::ALERT))
         {
-            if (mUserMessages[row]->isOfType(UserMessage::Type::ALERT))
-            {
-                beginRemoveRows(QModelIndex(), row, row);
-                delete mUserMessages[row];
-                mUserMessages.removeAt(row);
-                endRemoveRows();
-            }
-            --row;
+            rows.append(row);
         }
+        --row;
     }
+
+    removeMessageRows(rows);
 }
 
 bool UserMessageModel::hasAlertsOfType(MessageType type)
@@ -234,16 +369,15 @@ void UserMessageModel::processNotifications(const mega::MegaNotificationList* no
                 continue;
             }
 
-            auto it = findById(static_cast<unsigned>(notification->getID()),
-                               UserMessage::Type::NOTIFICATION);
-            if (it == mUserMessages.end())
+            auto item = findById(static_cast<unsigned>(notification->getID()),
+                                 UserMessage::Type::NOTIFICATION);
+            if (!item)
             {
                 newNotifications.append(notification->copy());
             }
             else
             {
-                updateNotification(static_cast<int>(std::distance(mUserMessages.begin(), it)),
-                                   notification);
+                updateNotification(rowOf(item), notification);
             }
         }
 
@@ -271,6 +405,7 @@ void UserMessageModel::insertNotifications(const QList<mega::MegaNotification*>&
         auto item = new UserNotification(notification);
         connect(item, &UserAlert::uiUpdated, this, &UserMessageModel::onUiUpdated);
         mUserMessages.push_back(item);
+        indexMessage(item);
 
         if (!mSeenStatusManager.markNotificationAsUnseen(item->id()))
         {
@@ -294,40 +429,33 @@ void UserMessageModel::updateNotification(int row, const mega::MegaNotification*
 
 void UserMessageModel::removeNotifications(const mega::MegaNotificationList* notifications)
 {
+    QSet<unsigned> currentIds;
+    if (notifications)
+    {
+        for (unsigned i = 0; i < notifications->size(); ++i)
+        {
+            currentIds.insert(static_cast<unsigned>(notifications->get(i)->getID()));
+        }
+    }
+
+    QList<int> rows;
     for (int row = mUserMessages.size() - 1; row >= 0; --row)
     {
         auto item = mUserMessages.at(row);
-        if (!item->isOfType(UserMessage::Type::NOTIFICATION))
+        if (!item->isOfType(UserMessage::Type::NOTIFICATION) || currentIds.contains(item->id()))
         {
             continue;
         }
 
-        bool found = false;
-        auto notification = qobject_cast<UserNotification*>(item);
-        if (notifications)
+        if (!item->isSeen())
         {
-            unsigned i = 0;
-            while (i < notifications->size() && !found)
-            {
-                found =
-                    notification->hasSameId(static_cast<unsigned>(notifications->get(i)->getID()));
-                ++i;
-            }
+            mSeenStatusManager.markAsSeen(MessageType::NOTIFICATIONS);
         }
 
-        if (!found)
-        {
-            if (!notification->isSeen())
-            {
-                mSeenStatusManager.markAsSeen(MessageType::NOTIFICATIONS);
-            }
-
-            beginRemoveRows(QModelIndex(), row, row);
-            delete mUserMessages[row];
-            mUserMessages.removeAt(row);
-            endRemoveRows();
-        }
+        rows.append(row);
     }
+
+    removeMessageRows(rows);
 }
 
 UnseenUserMessagesMap UserMessageModel::getUnseenNotifications() const
@@ -381,14 +509,9 @@ void UserMessageModel::setLastSeenNotification(uint32_t id)
 void UserMessageModel::onExpired(unsigned id)
 {
     // For now, only notifications can expire
-    auto it = findById(id, UserMessage::Type::NOTIFICATION);
-    if (it != mUserMessages.end())
+    if (auto item = findById(id, UserMessage::Type::NOTIFICATION))
     {
-        int row = static_cast<int>(std::distance(mUserMessages.begin(), it));
-        beginRemoveRows(QModelIndex(), row, row);
-        delete mUserMessages[row];
-        mUserMessages.erase(it);
-        endRemoveRows();
+        removeMessageRows({rowOf(item)});
     }
 }
 
@@ -397,7 +520,7 @@ void UserMessageModel::onUiUpdated()
     auto userMessage(qobject_cast<UserMessage*>(sender()));
     if (userMessage)
     {
-        int row = mUserMessages.indexOf(userMessage);
+        int row = rowOf(userMessage);
         emit dataChanged(index(row, 0, QModelIndex()), index(row, 0, QModelIndex()));
     }
 }
@@ -5,6 +5,8 @@
 #include "UserMessage.h"
 
 #include <QAbstractItemModel>
+#include <QHash>
+#include <QPair>
 
 namespace mega
 {
@@ -65,18 +67,32 @@ private:
 
     };
 
+    // (type, id) of a user message
+    using MessageKey = QPair<int, unsigned>;
+
     QList<UserMessage*> mUserMessages;
+    QHash<MessageKey, UserMessage*> mUserMessagesByKey;
+    // Row of every message, rebuilt on demand after rows are inserted or removed
+    QHash<const UserMessage*, int> mRowsByMessage;
+    bool mRowsDirty = true;
+    bool mResettingModel = false;
     SeenStatusManager mSeenStatusManager;
 
     void insertAlerts(const QList<mega::MegaUserAlert*>& alerts);
     void updateAlerts(const QList<mega::MegaUserAlert*>& alerts);
-    void removeAlerts(const QList<mega::MegaUserAlert*>& alerts);
+    void removeAlerts(const QList<UserMessage*>& alerts);
+    void removeExceedingAlerts();
 
     void insertNotifications(const QList<mega::MegaNotification*>& notifications);
     void updateNotification(int row, const mega::MegaNotification* notification);
     void removeNotifications(const mega::MegaNotificationList* notifications);
 
-    auto findById(unsigned id, UserMessage::Type type);
+    static MessageKey key(UserMessage::Type type, unsigned id);
+    UserMessage* findById(unsigned id, UserMessage::Type type) const;
+    int rowOf(const UserMessage* message);
+    void indexMessage(UserMessage* message);
+    void removeMessageRows(QList<int> rows);
+    void emitRowsChanged(const QList<int>& rows);
 
 };
 
@@ -463,6 +463,16 @@ int main(int argc, char *argv[])
     {
         QApplication::setDesktopSettingsAware(false);
     }
+
+    // Headless mode does not create any window, so it does not need a display server either
+    for (int i = 1; i < argc; i++)
+    {
+        if (!strcmp(argv[i], "--headless"))
+        {
+            qputenv("QT_QPA_PLATFORM", "offscreen");
+            break;
+        }
+    }
 #endif
 
     MegaApplication app(argc, argv);
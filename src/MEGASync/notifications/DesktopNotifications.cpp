@@ -12,7 +12,8 @@
 #include "TransferNotificationBuilder.h"
 
 #include <QCoreApplication>
-#include <QtConcurrent/QtConcurrent>
+
+#include <algorithm>
 
 const QString iconPrefix{QStringLiteral("://images/")};
 const QString iconFolderName{QStringLiteral("icons")};
@@ -23,6 +24,8 @@ const QString failedToDownloadIconName{QStringLiteral("Failed_to_download@3x.png
 const QString folderIconName{QStringLiteral("Folder@3x.png")};
 const QString fileDownloadSucceedIconName{QStringLiteral("File_download_succeed@3x.png")};
 constexpr int maxNumberOfUnseenNotifications{3};
+// The alerts received meanwhile are notified together
+constexpr int alertBatchWindowMs{500};
 
 bool checkIfActionIsValid(DesktopAppNotification::Action action)
 {
@@ -73,11 +76,19 @@ DesktopNotifications::DesktopNotifications(const QString &appName, QSystemTrayIc
     copyIconsToAppFolder(getIconsPath());
 
     QObject::connect(&mDelayedNotificator, &NotificationDelayer::sendClusteredAlert, this, &DesktopNotifications::receiveClusteredAlert);
+
+    mAlertBatchTimer.setSingleShot(true);
+    mAlertBatchTimer.setInterval(alertBatchWindowMs);
+    QObject::connect(&mAlertBatchTimer, &QTimer::timeout, this, &DesktopNotifications::sendAlertBatch);
 }
 
-QString DesktopNotifications::getItemsAddedText(mega::MegaUserAlert *info)
+const DesktopNotifications::AlertCounters& DesktopNotifications::getAlertCounters() const
+{
+    return mAlertCounters;
+}
+
+QString DesktopNotifications::getItemsAddedText(mega::MegaUserAlert *info, int updatedItems)
 {
-    const int updatedItems = static_cast<int>(info->getNumber(1) + info->getNumber(0));
     auto FullNameRequest = UserAttributes::FullName::requestFullName(info->getEmail());
     QString message(tr("[A] added %n item", "", updatedItems));
     if(FullNameRequest)
@@ -123,25 +134,23 @@ QString DesktopNotifications::createDeletedShareMessage(mega::MegaUserAlert* inf
     return message;
 }
 
-int DesktopNotifications::countUnseenAlerts(mega::MegaUserAlertList *alertList)
+void DesktopNotifications::onUserAlertsUpdated(mega::MegaUserAlertList* alertList)
 {
-    auto count = 0;
+    // alerts are sent again after seen state updated, so lets only notify the unseen alerts
+    std::vector<mega::MegaUserAlert*> unseenAlerts;
     for(int iAlert = 0; iAlert < alertList->size(); iAlert++)
     {
-        auto alert = alertList->get(iAlert);
+        const auto alert = alertList->get(iAlert);
         if(!alert->getSeen() && !alert->isRemoved())
         {
-            count++;
+            unseenAlerts.push_back(alert);
         }
     }
-    return count;
-}
+    mAlertCounters.receivedAlerts += static_cast<int>(unseenAlerts.size());
 
-void DesktopNotifications::onUserAlertsUpdated(mega::MegaUserAlertList* alertList)
-{
     if(mPreferences->isAnyNotificationEnabled())
     {
-        const auto unseenAlertsCount = countUnseenAlerts(alertList);
+        const auto unseenAlertsCount = static_cast<int>(unseenAlerts.size());
         const bool tooManyAlertsUnseen{unseenAlertsCount > maxNumberOfUnseenNotifications};
         if(tooManyAlertsUnseen || (mIsFirstTime && unseenAlertsCount))
         {
@@ -152,81 +161,180 @@ void DesktopNotifications::onUserAlertsUpdated(mega::MegaUserAlertList* alertLis
         mIsFirstTime = false;
     }
 
-    for(int iAlert = 0; iAlert < alertList->size(); iAlert++)
+    for(const auto alert : unseenAlerts)
     {
-        const auto alert = alertList->get(iAlert);
+        mAlertBatch.addAlert(alert);
+    }
 
-        // alerts are sent again after seen state updated, so lets only notify the unseen alerts
-        if(!alert->getSeen() && !alert->isRemoved())
-        {
-            sendAlert(alert);
-        }
+    if(!mAlertBatch.isEmpty() && !mAlertBatchTimer.isActive())
+    {
+        mAlertBatchTimer.start();
     }
 }
 
-void DesktopNotifications::sendAlert(mega::MegaUserAlert* alert)
+void DesktopNotifications::sendAlertBatch()
 {
-    auto userHandle = alert->getUserHandle();
+    if(mAlertBatch.isEmpty())
+    {
+        return;
+    }
+
+    mAlertCounters.batches++;
+    const auto alertCount = mAlertBatch.getAlertCount();
+    auto groups = mAlertBatch.takeGroups();
+    mAlertCounters.coalescedAlerts += alertCount - static_cast<int>(groups.size());
 
-    if (userHandle != mega::INVALID_HANDLE)
+    // A backlog of alerts received in several updates is not shown one by one either
+    const bool tooManyNotifications{static_cast<int>(groups.size()) > maxNumberOfUnseenNotifications};
+    if(tooManyNotifications && mPreferences->isAnyNotificationEnabled())
     {
-        if(alert->getEmail() != nullptr)
-        {
-            auto email = QString::fromUtf8(alert->getEmail());
+        notifyUnreadNotifications();
+        return;
+    }
 
-            requestFullName(alert, email);
-        }
-        else
-        {
-            requestEmail(alert);
-        }
+    for(auto& group : groups)
+    {
+        sendAlertGroup(group);
+    }
+}
+
+void DesktopNotifications::sendAlertGroup(UserAlertBatch::Group& group)
+{
+    if (group.userHandle == mega::INVALID_HANDLE)
+    {
+        processAlertGroup(group);
+        return;
+    }
+
+    if (group.email.isEmpty())
+    {
+        group.email = EmailRequester::instance()->getEmail(group.userHandle);
+    }
+
+    if (group.email.isEmpty())
+    {
+        requestEmail(group);
     }
     else
     {
-        processAlert(alert);
+        requestFullName(group);
     }
 }
 
-void DesktopNotifications::requestEmail(mega::MegaUserAlert* alert)
+void DesktopNotifications::requestEmail(const UserAlertBatch::Group& group)
 {
-    auto email = EmailRequester::instance()->getEmail(alert->getUserHandle());
+    const bool alreadyRequested = mGroupsWaitingForEmail.contains(group.userHandle);
+    mGroupsWaitingForEmail.insert(group.userHandle, group);
+    if (alreadyRequested)
+    {
+        return;
+    }
 
+    mAlertCounters.emailRequests++;
+    auto requestInfo = EmailRequester::getRequest(group.userHandle);
+
+    // The request info lives as long as the email requester, so the connection is dropped
+    // once used
+    const auto userHandle = group.userHandle;
+    auto connection = std::make_shared<QMetaObject::Connection>();
+    *connection = connect(requestInfo, &RequestInfo::emailChanged, this,
+        [this, userHandle, connection](QString email) {
+            disconnect(*connection);
+            onContactEmailReady(userHandle, email);
+        }, Qt::QueuedConnection);
+}
+
+void DesktopNotifications::onContactEmailReady(mega::MegaHandle userHandle, const QString& email)
+{
+    auto groups = mGroupsWaitingForEmail.values(userHandle);
+    mGroupsWaitingForEmail.remove(userHandle);
     if (email.isEmpty())
     {
-        mega::MegaUserAlert* alertCopy = alert->copy();
+        return;
+    }
 
-        auto requestInfo = EmailRequester::getRequest(alert->getUserHandle());
+    // values() returns the most recent first
+    std::reverse(groups.begin(), groups.end());
+    for (auto& group : groups)
+    {
+        group.email = email;
+        requestFullName(group);
+    }
+}
 
-        connect(requestInfo, &RequestInfo::emailChanged, this, [this, alertCopy](QString email) {
-                std::unique_ptr<mega::MegaUserAlert> alert(alertCopy);
-                if (!email.isEmpty())
-                {
-                    requestFullName(alertCopy, email);
-                }
-            }, Qt::QueuedConnection);
+void DesktopNotifications::requestFullName(const UserAlertBatch::Group& group)
+{
+    auto fullNameUserAttributes = UserAttributes::FullName::requestFullName(group.email.toUtf8().constData());
+    if(fullNameUserAttributes && !fullNameUserAttributes->isAttributeReady())
+    {
+        const bool alreadyRequested = mGroupsWaitingForFullName.contains(group.email);
+        mGroupsWaitingForFullName.insert(group.email, group);
+        if (!alreadyRequested)
+        {
+            mAlertCounters.fullNameRequests++;
+            connect(fullNameUserAttributes.get(), &UserAttributes::FullName::fullNameReady,
+                    this, &DesktopNotifications::OnUserAttributesReady, Qt::UniqueConnection);
+        }
     }
     else
     {
-        requestFullName(alert, email);
+        processAlertGroup(group);
     }
 }
 
-void DesktopNotifications::requestFullName(mega::MegaUserAlert* alert, QString email)
+void DesktopNotifications::processAlertGroup(const UserAlertBatch::Group& group)
 {
-    auto fullNameUserAttributes = UserAttributes::FullName::requestFullName(email.toUtf8().constData());
-    if(fullNameUserAttributes)
+    mAlertCounters.notifiedGroups++;
+
+    if (group.alerts.size() == 1)
     {
-        connect(fullNameUserAttributes.get(), &UserAttributes::FullName::fullNameReady,
-                this, &DesktopNotifications::OnUserAttributesReady, Qt::UniqueConnection);
+        processAlert(group.alerts.front().get(), group.email);
+        return;
     }
 
-    if(fullNameUserAttributes && !fullNameUserAttributes->isAttributeReady())
+    // Several alerts of the same user and type, see UserAlertBatch::canBeCoalesced
+    auto firstAlert = group.alerts.front().get();
+    switch (group.type)
     {
-        mPendingUserAlerts.insert(email, alert->copy());
+    case mega::MegaUserAlert::TYPE_NEWSHARE:
+    {
+        if(mPreferences->isNotificationEnabled(Preferences::NotificationsTypes::NEW_FOLDERS_SHARED_WITH_ME))
+        {
+            QString fullName = group.email;
+            auto FullNameRequest = UserAttributes::FullName::requestFullName(group.email.toUtf8().constData());
+            if (FullNameRequest)
+            {
+                fullName = FullNameRequest->getFullName();
+            }
+
+            const int sharedFolders = static_cast<int>(group.alerts.size());
+            notifyNewShares(tr("[A] shared %n folder with you", "", sharedFolders)
+                                .replace(QString::fromUtf8("[A]"), fullName));
+        }
+        break;
     }
-    else
+    case mega::MegaUserAlert::TYPE_NEWSHAREDNODES:
     {
-        processAlert(alert, email);
+        if(mPreferences->isNotificationEnabled(Preferences::NotificationsTypes::NODES_SHARED_WITH_ME_CREATED_OR_REMOVED))
+        {
+            int64_t updatedItems = 0;
+            for (const auto& alert : group.alerts)
+            {
+                updatedItems += alert->getNumber(1) + alert->getNumber(0);
+            }
+            notifySharedUpdate(firstAlert, getItemsAddedText(firstAlert, static_cast<int>(updatedItems)),
+                               NEW_SHARED_NODES);
+        }
+        break;
+    }
+    default:
+    {
+        for (const auto& alert : group.alerts)
+        {
+            processAlert(alert.get(), group.email);
+        }
+        break;
+    }
     }
 }
 
@@ -332,7 +440,8 @@ void DesktopNotifications::processAlert(mega::MegaUserAlert* alert, const QStrin
     {
         if(mPreferences->isNotificationEnabled(Preferences::NotificationsTypes::NODES_SHARED_WITH_ME_CREATED_OR_REMOVED))
         {
-            notifySharedUpdate(alert, getItemsAddedText(alert), NEW_SHARED_NODES);
+            const int updatedItems = static_cast<int>(alert->getNumber(1) + alert->getNumber(0));
+            notifySharedUpdate(alert, getItemsAddedText(alert, updatedItems), NEW_SHARED_NODES);
         }
         break;
     }
@@ -492,6 +601,17 @@ void DesktopNotifications::notifySharedUpdate(mega::MegaUserAlert *alert, const
     mNotificator->notify(notification);
 }
 
+void DesktopNotifications::notifyNewShares(const QString& message) const
+{
+    auto notification = new DesktopAppNotification();
+    notification->setTitle(tr("Shared Folder Received"));
+    notification->setText(message);
+    notification->setActions(QStringList() << tr("View"));
+    QObject::connect(notification, &DesktopAppNotification::activated, this, &DesktopNotifications::viewOnInfoDialogNotifications);
+    notification->setImagePath(mFolderIconPath);
+    mNotificator->notify(notification);
+}
+
 void DesktopNotifications::notifyUnreadNotifications() const
 {
     auto notification = new DesktopAppNotification();
@@ -884,8 +1004,7 @@ void DesktopNotifications::actionPressedOnDownloadFinishedTransferNotification(D
                         }
                         else
                         {
-                            QtConcurrent::run(QDesktopServices::openUrl,
-                                              QUrl::fromLocalFile(data->getLocalTargetPath()));
+                            Utilities::openUrl(QUrl::fromLocalFile(data->getLocalTargetPath()));
                         }
                     }
                     break;
@@ -897,7 +1016,7 @@ void DesktopNotifications::actionPressedOnDownloadFinishedTransferNotification(D
                         auto localPaths = data->getLocalPaths();
                         if(!localPaths.isEmpty())
                         {
-                            QtConcurrent::run(QDesktopServices::openUrl, QUrl::fromLocalFile(localPaths.first()));
+                            Utilities::openUrl(QUrl::fromLocalFile(localPaths.first()));
                         }
                     }
                     else
@@ -1095,15 +1214,14 @@ void DesktopNotifications::OnUserAttributesReady()
     auto UserAttribute = dynamic_cast<UserAttributes::FullName*>(sender());
     if(UserAttribute)
     {
-        auto pendingAlerts = mPendingUserAlerts.values(UserAttribute->getEmail());
-        if(!pendingAlerts.isEmpty())
+        auto pendingGroups = mGroupsWaitingForFullName.values(UserAttribute->getEmail());
+        mGroupsWaitingForFullName.remove(UserAttribute->getEmail());
+
+        // values() returns the most recent first
+        std::reverse(pendingGroups.begin(), pendingGroups.end());
+        for (const auto& group : qAsConst(pendingGroups))
         {
-            foreach(auto alert, pendingAlerts)
-            {
-                processAlert(alert, UserAttribute->getEmail());
-                delete alert;
-            }
-            mPendingUserAlerts.remove(UserAttribute->getEmail());
+            processAlertGroup(group);
         }
 
         //Disconnect the full name attribute request as it still lives
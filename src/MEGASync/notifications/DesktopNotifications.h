@@ -4,8 +4,11 @@
 #include "NotificationDelayer.h"
 #include "Notificator.h"
 #include "Preferences.h"
+#include "UserAlertBatch.h"
 
+#include <QHash>
 #include <QObject>
+#include <QTimer>
 
 namespace mega {
 class MegaUserAlertList;
@@ -41,11 +44,21 @@ public:
         bool isValid(){return !title.isEmpty() && !message.isEmpty();}
     };
 
+    // What has been done with the user alerts so far
+    struct AlertCounters
+    {
+        int receivedAlerts = 0;
+        int batches = 0;
+        int notifiedGroups = 0;
+        // Alerts shown in the notification of another alert
+        int coalescedAlerts = 0;
+        int emailRequests = 0;
+        int fullNameRequests = 0;
+    };
+
     DesktopNotifications(const QString& appName, QSystemTrayIcon* trayIcon);
 
-    void sendAlert(mega::MegaUserAlert* alert);
-    void requestFullName(mega::MegaUserAlert* alert, QString email);
-    void requestEmail(mega::MegaUserAlert* alert);
+    const AlertCounters& getAlertCounters() const;
     void sendOverStorageNotification(int state) const;
     void sendOverTransferNotification(const QString& title) const;
     void sendFinishedTransferNotification(unsigned long long appDataId) const;
@@ -77,17 +90,24 @@ public slots:
 
 private slots:
     void OnUserAttributesReady();
+    void sendAlertBatch();
 
 private:
     void notifyTakeDown(mega::MegaUserAlert* alert, bool isReinstated = false) const;
     void notifySharedUpdate(mega::MegaUserAlert* alert, const QString& message, int type) const;
     void notifyUnreadNotifications() const;
 
-    QString getItemsAddedText(mega::MegaUserAlert* info);
+    void notifyNewShares(const QString& message) const;
+
+    QString getItemsAddedText(mega::MegaUserAlert* info, int updatedItems);
     QString createDeletedShareMessage(mega::MegaUserAlert* info);
     QString createTakeDownMessage(mega::MegaUserAlert* alert, bool isReinstated = false) const;
-    int countUnseenAlerts(mega::MegaUserAlertList *alertList);
 
+    void sendAlertGroup(UserAlertBatch::Group& group);
+    void requestEmail(const UserAlertBatch::Group& group);
+    void requestFullName(const UserAlertBatch::Group& group);
+    void onContactEmailReady(mega::MegaHandle userHandle, const QString& email);
+    void processAlertGroup(const UserAlertBatch::Group& group);
     void processAlert(mega::MegaUserAlert* alert, const QString& email = QString());
     DesktopAppNotification* CreateContactNotification(const QString& title,
                                                const QString& message,
@@ -100,7 +120,12 @@ private:
     std::shared_ptr<Preferences> mPreferences;
     bool mIsFirstTime;//Check first time alerts are added to show unified message of unread.
 
-    QMultiMap<QString, mega::MegaUserAlert*> mPendingUserAlerts;
+    UserAlertBatch mAlertBatch;
+    QTimer mAlertBatchTimer;
+    // Waiting for the contact info, only the first group of each user requests it
+    QMultiHash<mega::MegaHandle, UserAlertBatch::Group> mGroupsWaitingForEmail;
+    QMultiHash<QString, UserAlertBatch::Group> mGroupsWaitingForFullName;
+    AlertCounters mAlertCounters;
     QString mSetDownloadPath;
 };
 #endif
@@ -0,0 +1,67 @@
+#include "UserAlertBatch.h"
+
+void UserAlertBatch::addAlert(const mega::MegaUserAlert* alert)
+{
+    if (!alert || mAlertIds.contains(alert->getId()))
+    {
+        return;
+    }
+    mAlertIds.insert(alert->getId());
+
+    std::shared_ptr<mega::MegaUserAlert> alertCopy(alert->copy());
+    const int type(alertCopy->getType());
+    const auto userHandle(alertCopy->getUserHandle());
+
+    if (canBeCoalesced(type))
+    {
+        // The nodes added to different folders are told apart, the new shares are not
+        const auto nodeHandle(type == mega::MegaUserAlert::TYPE_NEWSHAREDNODES ?
+                                  alertCopy->getNodeHandle() :
+                                  mega::INVALID_HANDLE);
+        const QString key(QString::number(type) + QLatin1Char(':') + QString::number(userHandle) +
+                          QLatin1Char(':') + QString::number(nodeHandle));
+
+        auto groupIt(mCoalescedGroupByKey.constFind(key));
+        if (groupIt != mCoalescedGroupByKey.constEnd())
+        {
+            mGroups[groupIt.value()].alerts.push_back(alertCopy);
+            return;
+        }
+        mCoalescedGroupByKey.insert(key, mGroups.size());
+    }
+
+    Group group;
+    group.type = type;
+    group.userHandle = userHandle;
+    if (alertCopy->getEmail())
+    {
+        group.email = QString::fromUtf8(alertCopy->getEmail());
+    }
+    group.alerts.push_back(alertCopy);
+    mGroups.push_back(group);
+}
+
+bool UserAlertBatch::isEmpty() const
+{
+    return mGroups.empty();
+}
+
+int UserAlertBatch::getAlertCount() const
+{
+    return mAlertIds.size();
+}
+
+std::vector<UserAlertBatch::Group> UserAlertBatch::takeGroups()
+{
+    std::vector<Group> groups;
+    groups.swap(mGroups);
+    mCoalescedGroupByKey.clear();
+    mAlertIds.clear();
+    return groups;
+}
+
+bool UserAlertBatch::canBeCoalesced(int type)
+{
+    return type == mega::MegaUserAlert::TYPE_NEWSHARE ||
+           type == mega::MegaUserAlert::TYPE_NEWSHAREDNODES;
+}
@@ -0,0 +1,44 @@
+#ifndef USER_ALERT_BATCH_H
+#define USER_ALERT_BATCH_H
+
+#include "megaapi.h"
+
+#include <QHash>
+#include <QSet>
+#include <QString>
+
+#include <memory>
+#include <vector>
+
+// Unseen user alerts received within a short window, grouped by user and type so that the
+// contact of each user is looked up once and related alerts are notified together
+class UserAlertBatch
+{
+public:
+    struct Group
+    {
+        int type = 0;
+        mega::MegaHandle userHandle = mega::INVALID_HANDLE;
+        // Empty until known, the alerts of some types do not carry it
+        QString email;
+        std::vector<std::shared_ptr<mega::MegaUserAlert>> alerts;
+    };
+
+    // The alert is copied. Alerts already in the batch are ignored.
+    void addAlert(const mega::MegaUserAlert* alert);
+    bool isEmpty() const;
+    int getAlertCount() const;
+
+    // Groups in the order of their first alert, the batch is emptied
+    std::vector<Group> takeGroups();
+
+    // Whether several alerts of this type can be shown in a single notification
+    static bool canBeCoalesced(int type);
+
+private:
+    std::vector<Group> mGroups;
+    QHash<QString, size_t> mCoalescedGroupByKey;
+    QSet<unsigned> mAlertIds;
+};
+
+#endif // USER_ALERT_BATCH_H
@@ -4,6 +4,7 @@ set(DESKTOP_APP_NOTIFICATIONS_HEADERS
     notifications/TransferNotificationBuilder.h
     notifications/NotificatorBase.h
     notifications/NotificationDelayer.h
+    notifications/UserAlertBatch.h
 )
 
 set(DESKTOP_APP_NOTIFICATIONS_SOURCES
@@ -11,6 +12,7 @@ set(DESKTOP_APP_NOTIFICATIONS_SOURCES
     notifications/TransferNotificationBuilder.cpp
     notifications/NotificatorBase.cpp
     notifications/NotificationDelayer.cpp
+    notifications/UserAlertBatch.cpp
 )
 
 target_sources_conditional(MEGAsync
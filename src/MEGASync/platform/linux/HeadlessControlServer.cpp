@@ -0,0 +1,398 @@
+#include "HeadlessControlServer.h"
+
+#include "MegaApplication.h"
+#include "Preferences.h"
+#include "StalledIssuesModel.h"
+#include "SyncInfo.h"
+#include "SyncSettings.h"
+#include "SyncStatsRecorder.h"
+#include "TaskScheduler.h"
+#include "TransfersModel.h"
+
+#include <QDir>
+#include <QFile>
+#include <QJsonDocument>
+#include <QLocalServer>
+#include <QLocalSocket>
+
+#include <sys/resource.h>
+#include <unistd.h>
+
+using namespace mega;
+
+namespace
+{
+const char* CONTROL_SOCKET_NAME = "control.socket";
+
+QString getRunStateName(int runState)
+{
+    switch (runState)
+    {
+        case MegaSync::RUNSTATE_PENDING:
+            return QLatin1String("pending");
+        case MegaSync::RUNSTATE_LOADING:
+            return QLatin1String("loading");
+        case MegaSync::RUNSTATE_RUNNING:
+            return QLatin1String("running");
+        case MegaSync::RUNSTATE_PAUSED:
+            return QLatin1String("paused");
+        case MegaSync::RUNSTATE_SUSPENDED:
+            return QLatin1String("suspended");
+        case MegaSync::RUNSTATE_DISABLED:
+            return QLatin1String("disabled");
+        default:
+            return QLatin1String("unknown");
+    }
+}
+
+QString getStorageStateName(int storageState)
+{
+    switch (storageState)
+    {
+        case MegaApi::STORAGE_STATE_GREEN:
+            return QLatin1String("green");
+        case MegaApi::STORAGE_STATE_ORANGE:
+            return QLatin1String("orange");
+        case MegaApi::STORAGE_STATE_RED:
+            return QLatin1String("red");
+        case MegaApi::STORAGE_STATE_PAYWALL:
+            return QLatin1String("paywall");
+        default:
+            return QLatin1String("unknown");
+    }
+}
+}
+
+HeadlessControlServer::HeadlessControlServer(QObject* parent):
+    QObject(parent),
+    mServer(new QLocalServer(this))
+{
+    const QString sockPath = socketPath();
+
+    // make sure previous socket file is removed
+    QLocalServer::removeServer(sockPath);
+
+    // The status includes the account email and the syncs paths
+    mServer->setSocketOptions(QLocalServer::UserAccessOption);
+
+    if (!mServer->listen(sockPath))
+    {
+        MegaApi::log(MegaApi::LOG_LEVEL_ERROR,
+                     QString::fromUtf8("Headless control server failed to listen on %1: %2")
+                         .arg(sockPath, mServer->errorString())
+                         .toUtf8()
+                         .constData());
+        return;
+    }
+
+    MegaApi::log(MegaApi::LOG_LEVEL_INFO,
+                 QString::fromUtf8("Headless control server listening on %1")
+                     .arg(sockPath)
+                     .toUtf8()
+                     .constData());
+
+    connect(mServer, &QLocalServer::newConnection, this, &HeadlessControlServer::onNewConnection);
+}
+
+HeadlessControlServer::~HeadlessControlServer()
+{
+    qDeleteAll(mClients);
+    mServer->close();
+    QLocalServer::removeServer(socketPath());
+}
+
+bool HeadlessControlServer::isListening() const
+{
+    return mServer->isListening();
+}
+
+QString HeadlessControlServer::socketPath()
+{
+    return MegaApplication::applicationDataPath() + QDir::separator()
+           + QString::fromLatin1(CONTROL_SOCKET_NAME);
+}
+
+void HeadlessControlServer::onNewConnection()
+{
+    while (mServer->hasPendingConnections())
+    {
+        QLocalSocket* client = mServer->nextPendingConnection();
+        if (!client)
+        {
+            return;
+        }
+
+        connect(client, &QLocalSocket::readyRead, this, &HeadlessControlServer::onClientData);
+        connect(client, &QLocalSocket::disconnected,
+                this, &HeadlessControlServer::onClientDisconnected);
+
+        mClients.append(client);
+    }
+}
+
+void HeadlessControlServer::onClientData()
+{
+    auto client = qobject_cast<QLocalSocket*>(sender());
+    if (!client || !mClients.contains(client))
+    {
+        return;
+    }
+
+    while (client->canReadLine())
+    {
+        const QByteArray command = client->readLine().trimmed();
+        if (command.isEmpty())
+        {
+            continue;
+        }
+
+        const QJsonObject answer = getAnswerToCommand(command);
+        client->write(QJsonDocument(answer).toJson(QJsonDocument::Compact));
+        client->write("\n");
+    }
+    client->flush();
+}
+
+void HeadlessControlServer::onClientDisconnected()
+{
+    auto client = qobject_cast<QLocalSocket*>(sender());
+    if (!client)
+    {
+        return;
+    }
+
+    mClients.removeAll(client);
+    client->deleteLater();
+}
+
+QJsonObject HeadlessControlServer::getAnswerToCommand(const QByteArray& command)
+{
+    QJsonObject answer;
+
+    if (command == "status")
+    {
+        answer = getStatus();
+    }
+    else if (command == "account")
+    {
+        answer.insert(QStringLiteral("account"), getAccountStatus());
+    }
+    else if (command == "state")
+    {
+        answer.insert(QStringLiteral("state"), getGlobalState());
+    }
+    else if (command == "transfers")
+    {
+        answer.insert(QStringLiteral("transfers"), getTransfersStatus());
+    }
+    else if (command == "stalls")
+    {
+        answer.insert(QStringLiteral("stalls"), getStalledIssuesStatus());
+    }
+    else if (command == "syncs")
+    {
+        answer.insert(QStringLiteral("syncs"), getSyncsStatus());
+    }
+    else if (command == "scheduler")
+    {
+        answer.insert(QStringLiteral("scheduler"), getSchedulerStatus());
+    }
+    else if (command == "syncstats")
+    {
+        answer.insert(QStringLiteral("syncstats"), SyncStatsRecorder::instance().toJson());
+    }
+    else if (command == "resources")
+    {
+        answer.insert(QStringLiteral("resources"), getResourceUsage());
+    }
+    else if (command == "exit")
+    {
+        MegaApi::log(MegaApi::LOG_LEVEL_INFO, "Exit requested through the headless control server");
+        answer.insert(QStringLiteral("exiting"), true);
+        // Answer before the app starts closing
+        QMetaObject::invokeMethod(this, &HeadlessControlServer::exitRequested, Qt::QueuedConnection);
+    }
+    else
+    {
+        answer.insert(QStringLiteral("error"),
+                      QString::fromLatin1("Unknown command: %1").arg(QString::fromUtf8(command)));
+    }
+
+    return answer;
+}
+
+QJsonObject HeadlessControlServer::getStatus() const
+{
+    QJsonObject status;
+    status.insert(QStringLiteral("version"), Preferences::VERSION_STRING);
+    status.insert(QStringLiteral("account"), getAccountStatus());
+    status.insert(QStringLiteral("state"), getGlobalState());
+    status.insert(QStringLiteral("transfers"), getTransfersStatus());
+    status.insert(QStringLiteral("stalls"), getStalledIssuesStatus());
+    status.insert(QStringLiteral("syncs"), getSyncsStatus());
+    return status;
+}
+
+QJsonObject HeadlessControlServer::getAccountStatus() const
+{
+    auto preferences = Preferences::instance();
+    auto megaApi = MegaSyncApp->getMegaApi();
+
+    QJsonObject account;
+    account.insert(QStringLiteral("loggedIn"),
+                   megaApi && megaApi->isLoggedIn() && preferences->logged());
+    if (preferences->logged())
+    {
+        account.insert(QStringLiteral("email"), preferences->email());
+        account.insert(QStringLiteral("storageState"),
+                       getStorageStateName(MegaSyncApp->getAppliedStorageState()));
+    }
+    return account;
+}
+
+QJsonObject HeadlessControlServer::getGlobalState() const
+{
+    auto megaApi = MegaSyncApp->getMegaApi();
+
+    QJsonObject state;
+    state.insert(QStringLiteral("paused"), Preferences::instance()->getGlobalPaused());
+    if (megaApi)
+    {
+        state.insert(QStringLiteral("scanning"), megaApi->isScanning());
+        state.insert(QStringLiteral("syncing"), megaApi->isSyncing());
+        state.insert(QStringLiteral("waiting"), megaApi->isWaiting());
+        state.insert(QStringLiteral("stalled"), megaApi->isSyncStalled());
+    }
+    return state;
+}
+
+QJsonObject HeadlessControlServer::getTransfersStatus() const
+{
+    QJsonObject transfers;
+
+    auto transfersModel = MegaSyncApp->getTransfersModel();
+    if (!transfersModel)
+    {
+        return transfers;
+    }
+
+    const auto count = transfersModel->getTransfersCount();
+
+    QJsonObject uploads;
+    uploads.insert(QStringLiteral("total"), static_cast<int>(count.totalUploads));
+    uploads.insert(QStringLiteral("pending"), static_cast<int>(count.pendingUploads));
+    uploads.insert(QStringLiteral("failed"), static_cast<int>(count.failedUploads));
+    uploads.insert(QStringLiteral("completedBytes"), static_cast<double>(count.completedUploadBytes));
+    uploads.insert(QStringLiteral("totalBytes"), static_cast<double>(count.totalUploadBytes));
+
+    QJsonObject downloads;
+    downloads.insert(QStringLiteral("total"), static_cast<int>(count.totalDownloads));
+    downloads.insert(QStringLiteral("pending"), static_cast<int>(count.pendingDownloads));
+    downloads.insert(QStringLiteral("failed"), static_cast<int>(count.failedDownloads));
+    downloads.insert(QStringLiteral("completedBytes"),
+                     static_cast<double>(count.completedDownloadBytes));
+    downloads.insert(QStringLiteral("totalBytes"), static_cast<double>(count.totalDownloadBytes));
+
+    transfers.insert(QStringLiteral("uploads"), uploads);
+    transfers.insert(QStringLiteral("downloads"), downloads);
+    return transfers;
+}
+
+QJsonObject HeadlessControlServer::getStalledIssuesStatus() const
+{
+    QJsonObject stalls;
+
+    auto stalledIssuesModel = MegaSyncApp->getStalledIssuesModel();
+    if (!stalledIssuesModel)
+    {
+        return stalls;
+    }
+
+    stalls.insert(QStringLiteral("issues"), stalledIssuesModel->rowCount(QModelIndex()));
+    stalls.insert(QStringLiteral("pending"), !stalledIssuesModel->isEmpty());
+    return stalls;
+}
+
+QJsonArray HeadlessControlServer::getSyncsStatus() const
+{
+    QJsonArray syncs;
+
+    for (const auto& syncSettings : SyncInfo::instance()->getAllSyncSettings())
+    {
+        QJsonObject sync;
+        sync.insert(QStringLiteral("name"), syncSettings->name());
+        sync.insert(QStringLiteral("type"),
+                    syncSettings->getType() == MegaSync::TYPE_BACKUP ? QLatin1String("backup")
+                                                                      : QLatin1String("twoway"));
+        sync.insert(QStringLiteral("localPath"), syncSettings->getLocalFolder());
+        sync.insert(QStringLiteral("remotePath"), syncSettings->getMegaFolder());
+        sync.insert(QStringLiteral("runState"), getRunStateName(syncSettings->getRunState()));
+
+        if (syncSettings->getError())
+        {
+            sync.insert(QStringLiteral("error"),
+                        QString::fromUtf8(MegaSync::getMegaSyncErrorCode(syncSettings->getError())));
+        }
+
+        syncs.append(sync);
+    }
+
+    return syncs;
+}
+
+QJsonArray HeadlessControlServer::getSchedulerStatus() const
+{
+    QJsonArray tasks;
+
+    auto taskScheduler = MegaSyncApp->getTaskScheduler();
+    if (!taskScheduler)
+    {
+        return tasks;
+    }
+
+    for (const auto& taskStats : taskScheduler->getStats())
+    {
+        QJsonObject task;
+        task.insert(QStringLiteral("name"), taskStats.name);
+        task.insert(QStringLiteral("runs"), static_cast<double>(taskStats.runs));
+        task.insert(QStringLiteral("wakeUps"), static_cast<double>(taskStats.wakeUps));
+        task.insert(QStringLiteral("intervalMs"), taskStats.intervalMs);
+        tasks.append(task);
+    }
+
+    return tasks;
+}
+
+QJsonObject HeadlessControlServer::getResourceUsage() const
+{
+    QJsonObject resources;
+
+    struct rusage usage = {};
+    if (getrusage(RUSAGE_SELF, &usage) == 0)
+    {
+        // ru_maxrss is in KiB on Linux
+        resources.insert(QStringLiteral("peakRssKb"), static_cast<double>(usage.ru_maxrss));
+        resources.insert(QStringLiteral("userCpuMs"),
+                         static_cast<double>(usage.ru_utime.tv_sec) * 1000.0
+                             + static_cast<double>(usage.ru_utime.tv_usec) / 1000.0);
+        resources.insert(QStringLiteral("systemCpuMs"),
+                         static_cast<double>(usage.ru_stime.tv_sec) * 1000.0
+                             + static_cast<double>(usage.ru_stime.tv_usec) / 1000.0);
+    }
+
+    // The second field of statm is the resident set, in pages
+    QFile statm(QString::fromLatin1("/proc/self/statm"));
+    if (statm.open(QIODevice::ReadOnly))
+    {
+        const auto fields = statm.readAll().split(' ');
+        bool ok = false;
+        const qint64 residentPages = fields.size() > 1 ? fields[1].toLongLong(&ok) : 0;
+        if (ok)
+        {
+            resources.insert(QStringLiteral("rssKb"),
+                             static_cast<double>(residentPages * sysconf(_SC_PAGESIZE) / 1024));
+        }
+    }
+
+    return resources;
+}
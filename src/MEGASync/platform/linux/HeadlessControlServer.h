@@ -0,0 +1,62 @@
+#ifndef HEADLESSCONTROLSERVER_H
+#define HEADLESSCONTROLSERVER_H
+
+#include <QJsonArray>
+#include <QJsonObject>
+#include <QList>
+#include <QObject>
+
+class QLocalServer;
+class QLocalSocket;
+
+//!
+//! \brief Local socket to query the app when it runs with --headless, as there is no tray icon or
+//! dialog to look at.
+//!
+//! Every line received is a command, answered with one line of compact JSON:
+//! - status: account, global state, transfers, stalled issues and syncs.
+//! - account, state, transfers, stalls, syncs: only that part of the status.
+//! - scheduler: runs, wake ups and current interval of the scheduled tasks.
+//! - syncstats: recorded time series of scan and sync times, pending transfers and speeds of
+//!   every sync.
+//! - resources: current and peak resident memory and CPU time used by the process, to compare
+//!   with the ones of the GUI mode in /proc/<pid>/status.
+//! - exit: closes the app, even with transfers in progress.
+//!
+class HeadlessControlServer: public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit HeadlessControlServer(QObject* parent = nullptr);
+    ~HeadlessControlServer() override;
+
+    bool isListening() const;
+
+    static QString socketPath();
+
+signals:
+    void exitRequested();
+
+private slots:
+    void onNewConnection();
+    void onClientData();
+    void onClientDisconnected();
+
+private:
+    QJsonObject getAnswerToCommand(const QByteArray& command);
+
+    QJsonObject getStatus() const;
+    QJsonObject getAccountStatus() const;
+    QJsonObject getGlobalState() const;
+    QJsonObject getTransfersStatus() const;
+    QJsonObject getStalledIssuesStatus() const;
+    QJsonArray getSyncsStatus() const;
+    QJsonArray getSchedulerStatus() const;
+    QJsonObject getResourceUsage() const;
+
+    QLocalServer* mServer;
+    QList<QLocalSocket*> mClients;
+};
+
+#endif // HEADLESSCONTROLSERVER_H
@@ -0,0 +1,418 @@
+#include "MimeAppResolver.h"
+
+#include "megaapi.h"
+
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QFileSystemWatcher>
+#include <QTextStream>
+
+using namespace mega;
+
+namespace
+{
+const QString DESKTOP_ENTRY_GROUP = QString::fromUtf8("Desktop Entry");
+const QString DEFAULT_APPLICATIONS_GROUP = QString::fromUtf8("Default Applications");
+const QString ADDED_ASSOCIATIONS_GROUP = QString::fromUtf8("Added Associations");
+const QString REMOVED_ASSOCIATIONS_GROUP = QString::fromUtf8("Removed Associations");
+const QString MIMEAPPS_LIST = QString::fromUtf8("mimeapps.list");
+const QString DESKTOP_SUFFIX = QString::fromUtf8(".desktop");
+
+QString getDir(const char* variable, const QString& defaultDir)
+{
+    const QString dir = QString::fromLocal8Bit(qgetenv(variable));
+    // Relative paths are invalid and must be ignored
+    return QDir::isAbsolutePath(dir) ? dir : defaultDir;
+}
+
+QStringList getDirs(const char* variable, const QStringList& defaultDirs)
+{
+    QStringList dirs;
+    const auto paths = QString::fromLocal8Bit(qgetenv(variable)).split(QLatin1Char(':'));
+    for (const auto& path : paths)
+    {
+        if (QDir::isAbsolutePath(path))
+        {
+            dirs.append(path);
+        }
+    }
+    return dirs.isEmpty() ? defaultDirs : dirs;
+}
+}
+
+MimeAppResolver::XdgDirs MimeAppResolver::XdgDirs::fromEnvironment()
+{
+    XdgDirs dirs;
+    dirs.configDirs.append(
+        getDir("XDG_CONFIG_HOME", QDir::homePath() + QString::fromUtf8("/.config")));
+    dirs.configDirs.append(getDirs("XDG_CONFIG_DIRS", {QString::fromUtf8("/etc/xdg")}));
+
+    dirs.dataDirs.append(
+        getDir("XDG_DATA_HOME", QDir::homePath() + QString::fromUtf8("/.local/share")));
+    dirs.dataDirs.append(getDirs(
+        "XDG_DATA_DIRS",
+        {QString::fromUtf8("/usr/local/share"), QString::fromUtf8("/usr/share")}));
+
+    const auto desktops = QString::fromLocal8Bit(qgetenv("XDG_CURRENT_DESKTOP"))
+                              .split(QLatin1Char(':'), Qt::SkipEmptyParts);
+    for (const auto& desktop : desktops)
+    {
+        dirs.desktops.append(desktop.toLower());
+    }
+    return dirs;
+}
+
+MimeAppResolver::MimeAppResolver(QObject* parent):
+    MimeAppResolver(XdgDirs::fromEnvironment(), parent)
+{
+}
+
+MimeAppResolver::MimeAppResolver(const XdgDirs& dirs, QObject* parent):
+    QObject(parent),
+    mDirs(dirs),
+    mDirty(true),
+    mWatcher(new QFileSystemWatcher(this))
+{
+    connect(mWatcher, &QFileSystemWatcher::directoryChanged,
+            this, &MimeAppResolver::onXdgDirChanged);
+    connect(mWatcher, &QFileSystemWatcher::fileChanged,
+            this, &MimeAppResolver::onXdgDirChanged);
+}
+
+QString MimeAppResolver::getDefaultDesktopId(const QString& mimeType)
+{
+    buildIndexIfNeeded();
+    return mDefaultIds.value(mimeType);
+}
+
+QString MimeAppResolver::getDefaultCommand(const QString& mimeType)
+{
+    buildIndexIfNeeded();
+    auto defaultId = mDefaultIds.constFind(mimeType);
+    if (defaultId == mDefaultIds.constEnd())
+    {
+        return QString();
+    }
+    return mDesktopEntries.value(defaultId.value()).command;
+}
+
+void MimeAppResolver::invalidate()
+{
+    mDirty = true;
+}
+
+void MimeAppResolver::onXdgDirChanged()
+{
+    invalidate();
+}
+
+MimeAppResolver::IniGroups MimeAppResolver::readIniFile(const QString& path)
+{
+    IniGroups groups;
+    QFile file(path);
+    if (!file.open(QFile::ReadOnly | QFile::Text))
+    {
+        return groups;
+    }
+
+    QTextStream in(&file);
+    in.setCodec("UTF-8");
+    QHash<QString, QString>* group = nullptr;
+    while (!in.atEnd())
+    {
+        const QString line = in.readLine().trimmed();
+        if (line.isEmpty() || line.startsWith(QLatin1Char('#')))
+        {
+            continue;
+        }
+
+        if (line.startsWith(QLatin1Char('[')) && line.endsWith(QLatin1Char(']')))
+        {
+            group = &groups[line.mid(1, line.size() - 2)];
+            continue;
+        }
+
+        const int separator = line.indexOf(QLatin1Char('='));
+        // The first value of a repeated key wins
+        if (group && separator > 0)
+        {
+            const QString key = line.left(separator).trimmed();
+            if (!group->contains(key))
+            {
+                group->insert(key, line.mid(separator + 1).trimmed());
+            }
+        }
+    }
+    return groups;
+}
+
+QStringList MimeAppResolver::splitList(const QString& value)
+{
+    QStringList items;
+    const auto parts = value.split(QLatin1Char(';'), Qt::SkipEmptyParts);
+    for (const auto& part : parts)
+    {
+        const QString item = part.trimmed();
+        if (!item.isEmpty())
+        {
+            items.append(item);
+        }
+    }
+    return items;
+}
+
+QString MimeAppResolver::getExecCommand(const QString& exec)
+{
+    const QString trimmedExec = exec.trimmed();
+    if (!trimmedExec.startsWith(QLatin1Char('"')))
+    {
+        return trimmedExec.section(QLatin1Char(' '), 0, 0);
+    }
+
+    // Quoted program path, with backslash escapes
+    QString command;
+    for (int i = 1; i < trimmedExec.size(); ++i)
+    {
+        const QChar character = trimmedExec.at(i);
+        if (character == QLatin1Char('"'))
+        {
+            break;
+        }
+        if (character == QLatin1Char('\\') && i + 1 < trimmedExec.size())
+        {
+            ++i;
+        }
+        command.append(trimmedExec.at(i));
+    }
+    return command;
+}
+
+void MimeAppResolver::buildIndexIfNeeded()
+{
+    if (!mDirty)
+    {
+        return;
+    }
+    mDirty = false;
+    mDesktopEntries.clear();
+    mDefaultIds.clear();
+
+    // The first desktop file with an id wins, even if it is hidden
+    QSet<QString> seenIds;
+    QStringList installedIds;
+    for (const auto& dataDir : qAsConst(mDirs.dataDirs))
+    {
+        loadDesktopEntries(dataDir + QString::fromUtf8("/applications"),
+                           QString(),
+                           seenIds,
+                           installedIds);
+    }
+
+    // Candidates of every MIME type, most preferred first
+    QHash<QString, QStringList> associations;
+    // Removed associations only apply to the less important files and to the desktop files
+    QHash<QString, QSet<QString>> removedAssociations;
+    const auto mimeAppsLists = getMimeAppsLists();
+    for (const auto& mimeAppsList : mimeAppsLists)
+    {
+        const IniGroups groups = readIniFile(mimeAppsList);
+
+        const auto defaults = groups.value(DEFAULT_APPLICATIONS_GROUP);
+        for (auto it = defaults.constBegin(); it != defaults.constEnd(); ++it)
+        {
+            if (mDefaultIds.contains(it.key()))
+            {
+                continue;
+            }
+
+            const auto ids = splitList(it.value());
+            for (const auto& id : ids)
+            {
+                if (mDesktopEntries.contains(id))
+                {
+                    mDefaultIds.insert(it.key(), id);
+                    break;
+                }
+            }
+        }
+
+        const auto added = groups.value(ADDED_ASSOCIATIONS_GROUP);
+        for (auto it = added.constBegin(); it != added.constEnd(); ++it)
+        {
+            const auto removed = removedAssociations.value(it.key());
+            auto& candidates = associations[it.key()];
+            const auto ids = splitList(it.value());
+            for (const auto& id : ids)
+            {
+                if (mDesktopEntries.contains(id) && !removed.contains(id)
+                    && !candidates.contains(id))
+                {
+                    candidates.append(id);
+                }
+            }
+        }
+
+        const auto removed = groups.value(REMOVED_ASSOCIATIONS_GROUP);
+        for (auto it = removed.constBegin(); it != removed.constEnd(); ++it)
+        {
+            const auto ids = splitList(it.value());
+            auto& removedIds = removedAssociations[it.key()];
+            for (const auto& id : ids)
+            {
+                removedIds.insert(id);
+            }
+        }
+    }
+
+    for (const auto& id : qAsConst(installedIds))
+    {
+        const auto& entry = mDesktopEntries[id];
+        for (const auto& mimeType : entry.mimeTypes)
+        {
+            auto& candidates = associations[mimeType];
+            if (!removedAssociations.value(mimeType).contains(id) && !candidates.contains(id))
+            {
+                candidates.append(id);
+            }
+        }
+    }
+
+    for (auto it = associations.constBegin(); it != associations.constEnd(); ++it)
+    {
+        if (!it.value().isEmpty() && !mDefaultIds.contains(it.key()))
+        {
+            mDefaultIds.insert(it.key(), it.value().first());
+        }
+    }
+
+    watchXdgDirs();
+
+    MegaApi::log(MegaApi::LOG_LEVEL_DEBUG,
+                 QString::fromUtf8("MIME app resolver: %1 applications, %2 MIME types")
+                     .arg(mDesktopEntries.size())
+                     .arg(mDefaultIds.size())
+                     .toUtf8()
+                     .constData());
+}
+
+void MimeAppResolver::loadDesktopEntries(const QString& applicationsDir,
+                                         const QString& idPrefix,
+                                         QSet<QString>& seenIds,
+                                         QStringList& installedIds)
+{
+    QDir dir(applicationsDir);
+    if (!dir.exists())
+    {
+        return;
+    }
+    mWatchedDirs.append(applicationsDir);
+
+    // Sorted, so that the order of the candidates does not depend on the file system
+    const auto files = dir.entryInfoList(QDir::Files | QDir::Dirs | QDir::NoDotAndDotDot,
+                                         QDir::Name);
+    for (const auto& file : files)
+    {
+        if (file.isDir())
+        {
+            // applications/kde4/foo.desktop has the id kde4-foo.desktop
+            loadDesktopEntries(file.absoluteFilePath(),
+                               idPrefix + file.fileName() + QLatin1Char('-'),
+                               seenIds,
+                               installedIds);
+            continue;
+        }
+
+        if (!file.fileName().endsWith(DESKTOP_SUFFIX))
+        {
+            continue;
+        }
+
+        const QString id = idPrefix + file.fileName();
+        if (seenIds.contains(id))
+        {
+            continue;
+        }
+        seenIds.insert(id);
+
+        const auto desktopEntry = readIniFile(file.absoluteFilePath()).value(DESKTOP_ENTRY_GROUP);
+        if (desktopEntry.value(QString::fromUtf8("Hidden")) == QLatin1String("true"))
+        {
+            continue;
+        }
+
+        DesktopEntry entry;
+        entry.command = getExecCommand(desktopEntry.value(QString::fromUtf8("Exec")));
+        if (entry.command.isEmpty())
+        {
+            // Nothing to launch, e.g. links
+            continue;
+        }
+        entry.mimeTypes = splitList(desktopEntry.value(QString::fromUtf8("MimeType")));
+        mDesktopEntries.insert(id, entry);
+        installedIds.append(id);
+    }
+}
+
+QStringList MimeAppResolver::getMimeAppsLists() const
+{
+    QStringList lists;
+    auto addLists = [this, &lists](const QString& dir)
+    {
+        for (const auto& desktop : mDirs.desktops)
+        {
+            lists.append(dir + QLatin1Char('/') + desktop + QLatin1Char('-') + MIMEAPPS_LIST);
+        }
+        lists.append(dir + QLatin1Char('/') + MIMEAPPS_LIST);
+    };
+
+    for (const auto& configDir : mDirs.configDirs)
+    {
+        addLists(configDir);
+    }
+
+    for (const auto& dataDir : mDirs.dataDirs)
+    {
+        const QString applicationsDir = dataDir + QString::fromUtf8("/applications");
+        addLists(applicationsDir);
+        // Deprecated, but still the only one written by some distributions
+        lists.append(applicationsDir + QString::fromUtf8("/defaults.list"));
+    }
+    return lists;
+}
+
+void MimeAppResolver::watchXdgDirs()
+{
+    // Files replaced by renaming are no longer watched, so start again with every rebuild
+    const QStringList watched = mWatcher->files() + mWatcher->directories();
+    if (!watched.isEmpty())
+    {
+        mWatcher->removePaths(watched);
+    }
+
+    QStringList paths;
+    for (const auto& configDir : qAsConst(mDirs.configDirs))
+    {
+        if (QFileInfo(configDir).isDir())
+        {
+            paths.append(configDir);
+        }
+    }
+
+    // The directories only tell about created, removed or renamed files, not edited ones
+    const auto mimeAppsLists = getMimeAppsLists();
+    for (const auto& mimeAppsList : mimeAppsLists)
+    {
+        if (QFileInfo::exists(mimeAppsList))
+        {
+            paths.append(mimeAppsList);
+        }
+    }
+
+    paths.append(mWatchedDirs);
+    mWatchedDirs.clear();
+    if (!paths.isEmpty())
+    {
+        mWatcher->addPaths(paths);
+    }
+}
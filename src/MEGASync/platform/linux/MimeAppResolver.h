@@ -0,0 +1,79 @@
+#ifndef MIMEAPPRESOLVER_H
+#define MIMEAPPRESOLVER_H
+
+#include <QHash>
+#include <QObject>
+#include <QSet>
+#include <QString>
+#include <QStringList>
+
+class QFileSystemWatcher;
+
+//!
+//! \brief Finds the default application of a MIME type as xdg-mime does, without running it.
+//!
+//! The mimeapps.list files and the desktop files of the XDG directories are read once into a
+//! MIME type -> command index, so lookups are a hash hit. Those directories are watched and the
+//! index is built again on the next lookup after any of them changes.
+//!
+class MimeAppResolver: public QObject
+{
+    Q_OBJECT
+
+public:
+    struct XdgDirs
+    {
+        // Most important first, as in the XDG Base Directory specification
+        QStringList configDirs;
+        QStringList dataDirs;
+        // Lowercase names of XDG_CURRENT_DESKTOP, for the $desktop-mimeapps.list files
+        QStringList desktops;
+
+        static XdgDirs fromEnvironment();
+    };
+
+    explicit MimeAppResolver(QObject* parent = nullptr);
+    explicit MimeAppResolver(const XdgDirs& dirs, QObject* parent = nullptr);
+
+    //! \brief Id of the desktop file of the default application, e.g. "org.gnome.Nautilus.desktop".
+    QString getDefaultDesktopId(const QString& mimeType);
+
+    //! \brief First token of the Exec key of the default application, e.g. "nautilus".
+    QString getDefaultCommand(const QString& mimeType);
+
+    void invalidate();
+
+private slots:
+    void onXdgDirChanged();
+
+private:
+    struct DesktopEntry
+    {
+        QString command;
+        QStringList mimeTypes;
+    };
+
+    // Group name -> key -> value, for the .ini like XDG files
+    using IniGroups = QHash<QString, QHash<QString, QString>>;
+
+    static IniGroups readIniFile(const QString& path);
+    static QStringList splitList(const QString& value);
+    static QString getExecCommand(const QString& exec);
+
+    void buildIndexIfNeeded();
+    void loadDesktopEntries(const QString& applicationsDir,
+                            const QString& idPrefix,
+                            QSet<QString>& seenIds,
+                            QStringList& installedIds);
+    QStringList getMimeAppsLists() const;
+    void watchXdgDirs();
+
+    XdgDirs mDirs;
+    bool mDirty;
+    QFileSystemWatcher* mWatcher;
+    QStringList mWatchedDirs;
+    QHash<QString, DesktopEntry> mDesktopEntries;
+    QHash<QString, QString> mDefaultIds;
+};
+
+#endif // MIMEAPPRESOLVER_H
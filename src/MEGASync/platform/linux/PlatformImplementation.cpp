@@ -253,52 +253,11 @@ QString PlatformImplementation::getDefaultOpenApp(QString extension)
 
 QString PlatformImplementation::getDefaultOpenAppByMimeType(QString mimeType)
 {
-    QString getDefaultAppDesktopFileName = QString::fromUtf8("xdg-mime query default ") + mimeType;
-
-    QProcess process;
-    process.start(getDefaultAppDesktopFileName,
-                  QIODevice::ReadWrite | QIODevice::Text);
-    if(!process.waitForFinished(5000))
-    {
-        return QString();
-    }
-
-    QString desktopFileName = QString::fromUtf8(process.readAllStandardOutput());
-    desktopFileName = desktopFileName.trimmed();
-    desktopFileName.replace(QString::fromUtf8(";"), QString::fromUtf8(""));
-    if (!desktopFileName.size())
-    {
-        return QString();
-    }
-
-    QFileInfo desktopFile(QString::fromUtf8("/usr/share/applications/") + desktopFileName);
-    if (!desktopFile.exists())
-    {
-        return QString();
-    }
-
-    QFile f(desktopFile.absoluteFilePath());
-    if (!f.open(QFile::ReadOnly | QFile::Text))
-    {
-        return QString();
-    }
-
-    QTextStream in(&f);
-    QStringList contents = in.readAll().split(QString::fromUtf8("\n"));
-    contents = contents.filter(QRegExp(QString::fromUtf8("^Exec=")));
-    if (!contents.size())
-    {
-        return QString();
-    }
-
-    QString line = contents.first();
-    QRegExp captureRegexCommand(QString::fromUtf8("^Exec=([^' ']*)"));
-    if (captureRegexCommand.indexIn(line) != -1)
+    if (!mMimeAppResolver)
     {
-        return captureRegexCommand.cap(1); // return first group from regular expression.
+        mMimeAppResolver = std::make_unique<MimeAppResolver>();
     }
-
-    return QString();
+    return mMimeAppResolver->getDefaultCommand(mimeType);
 }
 
 bool PlatformImplementation::getValue(const char * const name, const bool default_value)
@@ -405,23 +364,19 @@ bool PlatformImplementation::registerUpdateJob()
 bool PlatformImplementation::shouldRunHttpServer()
 {
     QStringList data = getListRunningProcesses();
-    if (data.size() > 1)
-    {
-        for (int i = 1; i < data.size(); i++)
+    for (const auto& command : data)
+    {
+        // The MEGA webclient sends request to MEGAsync to improve the
+        // user experience. We check if web browsers are running because
+        // otherwise it isn't needed to run the local web server for this purpose.
+        // Here is the list or web browsers that allow HTTP communications
+        // with 127.0.0.1 inside HTTPS webs.
+        if (command.contains(QString::fromUtf8("firefox"), Qt::CaseInsensitive)
+                || command.contains(QString::fromUtf8("chrome"), Qt::CaseInsensitive)
+                || command.contains(QString::fromUtf8("chromium"), Qt::CaseInsensitive)
+                )
         {
-            // The MEGA webclient sends request to MEGAsync to improve the
-            // user experience. We check if web browsers are running because
-            // otherwise it isn't needed to run the local web server for this purpose.
-            // Here is the list or web browsers that allow HTTP communications
-            // with 127.0.0.1 inside HTTPS webs.
-            QString command = data.at(i).trimmed();
-            if (command.contains(QString::fromUtf8("firefox"), Qt::CaseInsensitive)
-                    || command.contains(QString::fromUtf8("chrome"), Qt::CaseInsensitive)
-                    || command.contains(QString::fromUtf8("chromium"), Qt::CaseInsensitive)
-                    )
-            {
-                return true;
-            }
+            return true;
         }
     }
     return false;
@@ -530,29 +485,35 @@ QString PlatformImplementation::getGfxProviderPath()
 
 QStringList PlatformImplementation::getListRunningProcesses()
 {
-    QProcess p;
-    p.start(QString::fromUtf8("ps ax -o comm"));
-    p.waitForFinished(2000);
-    QString output = QString::fromUtf8(p.readAllStandardOutput().constData());
-    QString e = QString::fromUtf8(p.readAllStandardError().constData());
-    if (e.size())
+    // Read the command name and the executable of every process straight from /proc instead of
+    // running "ps" and "readlink", which blocked the caller for up to 2 seconds each
+    QStringList data;
+    const auto pids(QDir(QLatin1String("/proc")).entryList(QDir::Dirs | QDir::NoDotAndDotDot));
+    for (const auto& pid : pids)
     {
-        MegaApi::log(MegaApi::LOG_LEVEL_ERROR, "Error for \"ps ax -o comm\" command:");
-        MegaApi::log(MegaApi::LOG_LEVEL_ERROR, e.toUtf8().constData());
-    }
+        bool isPid(false);
+        pid.toUInt(&isPid);
+        if (!isPid)
+        {
+            continue;
+        }
 
-    p.start(QString::fromUtf8("/bin/bash -c \"readlink /proc/*/exe\""));
-    p.waitForFinished(2000);
-    QString output2 = QString::fromUtf8(p.readAllStandardOutput().constData());
-    e = QString::fromUtf8(p.readAllStandardError().constData());
-    if (e.size())
-    {
-        MegaApi::log(MegaApi::LOG_LEVEL_ERROR, "Error for \"readlink /proc/*/exe\" command:");
-        MegaApi::log(MegaApi::LOG_LEVEL_ERROR, e.toUtf8().constData());
-    }
-    QStringList data = output.split(QString::fromUtf8("\n"));
+        const QString processDir(QLatin1String("/proc/") + pid);
 
-    data.append(output2.split(QString::fromUtf8("\n")));
+        // The process may have exited since /proc was listed
+        QFile comm(processDir + QLatin1String("/comm"));
+        if (comm.open(QIODevice::ReadOnly | QIODevice::Text))
+        {
+            data.append(QString::fromUtf8(comm.readLine()).trimmed());
+        }
+
+        // Empty when the process belongs to another user
+        const QString exe(QFileInfo(processDir + QLatin1String("/exe")).symLinkTarget());
+        if (!exe.isEmpty())
+        {
+            data.append(exe);
+        }
+    }
 
     return data;
 }
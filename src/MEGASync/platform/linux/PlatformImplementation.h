@@ -3,11 +3,14 @@
 
 #include "AbstractPlatform.h"
 #include "ExtServer.h"
+#include "MimeAppResolver.h"
 #include "NotifyServer.h"
 
 #include <xcb/xcb.h>
 #include <xcb/xproto.h>
 
+#include <memory>
+
 class PlatformImplementation : public AbstractPlatform
 {
 public:
@@ -63,6 +66,7 @@ private:
 
     ExtServer *ext_server = nullptr;
     NotifyServer *notify_server = nullptr;
+    std::unique_ptr<MimeAppResolver> mMimeAppResolver;
     QString autostart_dir;
     QString desktop_file;
     QString custom_icon;
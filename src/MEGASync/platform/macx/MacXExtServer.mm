@@ -2,15 +2,12 @@
 
 #include "CommonMessages.h"
 #include "megaapi.h"
+#include "Utilities.h"
 
 #include <QThread>
 
 #include <cassert>
 
-#if QT_VERSION >= 0x050000
-#include <QtConcurrent/QtConcurrent>
-#endif
-
 using namespace mega;
 using namespace std;
 
@@ -262,7 +259,7 @@ bool MacXExtServer::GetAnswerToRequest(const char *buf, QByteArray *response)
             QFileInfo file(filePath);
             if (file.exists())
             {
-                QtConcurrent::run(QDesktopServices::openUrl, QUrl::fromLocalFile(filePath));
+                Utilities::openUrl(QUrl::fromLocalFile(filePath));
             }
             return false;
         }
@@ -82,11 +82,15 @@ target_sources_conditional(MEGAsync
    platform/linux/PlatformImplementation.h
    platform/linux/ExtServer.h
    platform/linux/NotifyServer.h
+   platform/linux/HeadlessControlServer.h
+   platform/linux/MimeAppResolver.h
    platform/linux/DolphinFileManager.h
    platform/linux/NautilusFileManager.h
    platform/linux/PlatformImplementation.cpp
    platform/linux/ExtServer.cpp
    platform/linux/NotifyServer.cpp
+   platform/linux/HeadlessControlServer.cpp
+   platform/linux/MimeAppResolver.cpp
    platform/linux/PowerOptions.cpp
    platform/linux/PlatformStrings.cpp
    platform/linux/DolphinFileManager.cpp
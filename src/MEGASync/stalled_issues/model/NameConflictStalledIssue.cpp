@@ -1,5 +1,6 @@
 #include "NameConflictStalledIssue.h"
 
+#include "FolderNameIndex.h"
 #include "MegaApiSynchronizedRequest.h"
 #include "MergeMEGAFolders.h"
 #include "MoveToMEGABin.h"
@@ -536,6 +537,7 @@ bool NameConflictedStalledIssue::renameCloudNodesAutomatically(const QList<std::
                         },
                         conflictedNode.get(),
                         newName.toUtf8().constData());
+                    FolderNameIndex::instance().invalidate(conflictedNode->getParentHandle());
 
                     if(error)
                     {
@@ -589,10 +591,12 @@ bool NameConflictedStalledIssue::renameLocalItemsAutomatically(const QList<std::
                 if(file.exists())
                 {
                     bool isFile(fileInfo.isFile());
-                    auto newName = Utilities::getNonDuplicatedLocalName(fileInfo, true, cloudItemsBeingRenamed);
+                    auto newName = Utilities::getNonDuplicatedLocalName(fileInfo, cloudItemsBeingRenamed);
 
                     fileInfo.setFile(fileInfo.path(), newName);
-                    if(file.rename(QDir::toNativeSeparators(fileInfo.filePath())))
+                    const bool renamed(file.rename(QDir::toNativeSeparators(fileInfo.filePath())));
+                    FolderNameIndex::instance().invalidateLocal(fileInfo.path());
+                    if(renamed)
                     {
                         localConflictedName->solveByRename(newName);
                         renameCloudSibling(cloudConflictedName, newName);
@@ -635,6 +639,7 @@ bool NameConflictedStalledIssue::renameCloudSibling(std::shared_ptr<ConflictedNa
                 },
                 conflictedNode.get(),
                 newName.toUtf8().constData());
+            FolderNameIndex::instance().invalidate(conflictedNode->getParentHandle());
 
             error ? item->setFailed(RenameRemoteNodeDialog::renamedFailedErrorString(
                         error.get(),
@@ -660,6 +665,7 @@ bool NameConflictedStalledIssue::renameLocalSibling(std::shared_ptr<ConflictedNa
             auto isFile(fileInfo.isFile());
             fileInfo.setFile(fileInfo.path(), newName);
             result = file.rename(QDir::toNativeSeparators(fileInfo.filePath()));
+            FolderNameIndex::instance().invalidateLocal(fileInfo.path());
             result ?  item->solveByRename(newName) : item->setFailed(RenameLocalNodeDialog::renamedFailedErrorString(isFile));
         }
     }
@@ -0,0 +1,249 @@
+#include "StalledIssuesBulkSolver.h"
+
+#include "megaapi.h"
+#include "ThreadPool.h"
+#include "Utilities.h"
+
+#include <QElapsedTimer>
+#include <QHash>
+#include <QStringList>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+
+namespace
+{
+constexpr int PROGRESS_CHECK_INTERVAL_MS = 250;
+// Time needed to get a throughput worth showing
+constexpr qint64 MIN_ETA_ELAPSED_MS = 1000;
+
+struct SharedState
+{
+    std::mutex mutex;
+    std::condition_variable finishedCondition;
+    std::deque<std::pair<int, StalledIssuesBulkSolver::Result>> finishedJobs;
+    size_t nextGroup = 0;
+    int runningWorkers = 0;
+    std::atomic<bool> stopped {false};
+};
+}
+
+// The solvers spend most of the time waiting for SDK requests, not using the CPU, but the more
+// groups the more ThreadPool workers they keep busy
+const int StalledIssuesBulkSolver::DEFAULT_PARALLEL_GROUPS = 4;
+
+StalledIssuesBulkSolver::StalledIssuesBulkSolver(int maxParallelGroups, Executor executor):
+    mMaxParallelGroups(std::max(maxParallelGroups, 1)),
+    mExecutor(std::move(executor))
+{
+    if (!mExecutor)
+    {
+        // The groups block their workers. The pool keeps one worker for the interactive tasks,
+        // and one more is left for the rest of the normal ones.
+        auto threadPool(ThreadPoolSingleton::getInstance());
+        const auto threadCount(static_cast<int>(threadPool->getThreadCount()));
+        mMaxParallelGroups = std::max(std::min(mMaxParallelGroups, threadCount - 2), 1);
+        mExecutor = [threadPool](std::function<void()> task)
+        {
+            threadPool->push(std::move(task), ThreadPool::Priority::NORMAL);
+        };
+    }
+}
+
+void StalledIssuesBulkSolver::setFinishedFunc(std::function<void(int, Result)> finishedFunc)
+{
+    mFinishedFunc = std::move(finishedFunc);
+}
+
+void StalledIssuesBulkSolver::setProgressFunc(std::function<void(const Progress&)> progressFunc)
+{
+    mProgressFunc = std::move(progressFunc);
+}
+
+void StalledIssuesBulkSolver::setStopFunc(std::function<bool()> stopFunc)
+{
+    mStopFunc = std::move(stopFunc);
+}
+
+QHash<QString, QString> StalledIssuesBulkSolver::getRootKeys(const std::vector<Job>& jobs)
+{
+    // With the separator appended, the keys inside a folder come right after the folder once
+    // sorted, and no other key is in between ("/a b/" goes before "/a/" and "/a/b/")
+    QStringList keys;
+    for (const auto& job : jobs)
+    {
+        keys.append(job.groupKey);
+    }
+    keys.removeDuplicates();
+    std::sort(keys.begin(),
+              keys.end(),
+              [](const QString& first, const QString& second)
+              {
+                  return first + QLatin1Char('/') < second + QLatin1Char('/');
+              });
+
+    QHash<QString, QString> rootKeys;
+    QString rootKey;
+    for (const auto& key : keys)
+    {
+        if (rootKey.isNull() || !(key + QLatin1Char('/')).startsWith(rootKey + QLatin1Char('/')))
+        {
+            rootKey = key;
+        }
+        rootKeys.insert(key, rootKey);
+    }
+    return rootKeys;
+}
+
+std::vector<StalledIssuesBulkSolver::Result>
+    StalledIssuesBulkSolver::solve(const std::vector<Job>& jobs)
+{
+    std::vector<Result> results(jobs.size(), Result::NOT_RUN);
+    if (jobs.empty())
+    {
+        return results;
+    }
+
+    // Groups in the order of their first issue, and the issues in the order received
+    const auto rootKeys(getRootKeys(jobs));
+    auto groups(std::make_shared<std::vector<std::vector<int>>>());
+    QHash<QString, size_t> groupByKey;
+    for (int jobIndex = 0; jobIndex < static_cast<int>(jobs.size()); ++jobIndex)
+    {
+        const auto& rootKey(rootKeys.value(jobs[jobIndex].groupKey));
+        auto groupIt(groupByKey.constFind(rootKey));
+        if (groupIt == groupByKey.constEnd())
+        {
+            groupIt = groupByKey.insert(rootKey, groups->size());
+            groups->emplace_back();
+        }
+        (*groups)[groupIt.value()].push_back(jobIndex);
+    }
+
+    // The jobs are copied, the workers do not access the caller memory once it has returned
+    auto sharedJobs(std::make_shared<std::vector<Job>>(jobs));
+    auto state(std::make_shared<SharedState>());
+
+    auto worker = [state, groups, sharedJobs]()
+    {
+        for (;;)
+        {
+            size_t groupIndex(0);
+            {
+                std::lock_guard<std::mutex> lock(state->mutex);
+                if (state->stopped || state->nextGroup >= groups->size())
+                {
+                    --state->runningWorkers;
+                    state->finishedCondition.notify_one();
+                    return;
+                }
+                groupIndex = state->nextGroup++;
+            }
+
+            for (auto jobIndex : (*groups)[groupIndex])
+            {
+                if (state->stopped)
+                {
+                    break;
+                }
+
+                auto result((*sharedJobs)[static_cast<size_t>(jobIndex)].solveFunc());
+
+                std::lock_guard<std::mutex> lock(state->mutex);
+                state->finishedJobs.emplace_back(jobIndex, result);
+                state->finishedCondition.notify_one();
+            }
+        }
+    };
+
+    const int workers(std::min(mMaxParallelGroups, static_cast<int>(groups->size())));
+    state->runningWorkers = workers;
+    for (int index = 0; index < workers; ++index)
+    {
+        mExecutor(worker);
+    }
+
+    QElapsedTimer elapsedTimer;
+    elapsedTimer.start();
+
+    Progress progress;
+    progress.total = static_cast<int>(jobs.size());
+
+    std::unique_lock<std::mutex> lock(state->mutex);
+    for (;;)
+    {
+        state->finishedCondition.wait_for(lock,
+                                          std::chrono::milliseconds(PROGRESS_CHECK_INTERVAL_MS),
+                                          [&state]()
+                                          {
+                                              return !state->finishedJobs.empty() ||
+                                                     state->runningWorkers == 0;
+                                          });
+
+        auto finishedJobs(std::move(state->finishedJobs));
+        state->finishedJobs.clear();
+        const bool allFinished(state->runningWorkers == 0);
+
+        // The callbacks may take their time, the workers go on meanwhile
+        lock.unlock();
+
+        for (const auto& finishedJob : finishedJobs)
+        {
+            results[static_cast<size_t>(finishedJob.first)] = finishedJob.second;
+            if (mFinishedFunc)
+            {
+                mFinishedFunc(finishedJob.first, finishedJob.second);
+            }
+        }
+
+        if (!finishedJobs.empty())
+        {
+            progress.finished += static_cast<int>(finishedJobs.size());
+
+            const auto elapsedMs(elapsedTimer.elapsed());
+            progress.issuesPerSecond =
+                elapsedMs > 0 ? progress.finished * 1000.0 / static_cast<double>(elapsedMs) : 0.0;
+            if (elapsedMs >= MIN_ETA_ELAPSED_MS && progress.issuesPerSecond > 0.0)
+            {
+                progress.remainingSeconds = static_cast<qint64>(
+                    (progress.total - progress.finished) / progress.issuesPerSecond);
+            }
+
+            if (mProgressFunc)
+            {
+                mProgressFunc(progress);
+            }
+        }
+
+        if (allFinished)
+        {
+            break;
+        }
+
+        if (mStopFunc && !state->stopped && mStopFunc())
+        {
+            state->stopped = true;
+        }
+
+        lock.lock();
+    }
+
+    const auto elapsedMs(elapsedTimer.elapsed());
+    mega::MegaApi::log(mega::MegaApi::LOG_LEVEL_INFO,
+                       QString::fromUtf8("Stalled issues bulk solver: %1 of %2 issues in %3 ms, "
+                                         "%4 groups, %5 issues/s")
+                           .arg(progress.finished)
+                           .arg(progress.total)
+                           .arg(elapsedMs)
+                           .arg(groups->size())
+                           .arg(progress.issuesPerSecond, 0, 'f', 1)
+                           .toUtf8()
+                           .constData());
+
+    return results;
+}
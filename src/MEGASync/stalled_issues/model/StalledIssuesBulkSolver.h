@@ -0,0 +1,76 @@
+#ifndef STALLEDISSUESBULKSOLVER_H
+#define STALLEDISSUESBULKSOLVER_H
+
+#include <QHash>
+#include <QString>
+
+#include <functional>
+#include <vector>
+
+//!
+//! \brief Solves a long list of stalled issues several at a time.
+//!
+//! The issues are grouped by a key, the sync and the parent folder of the issue with '/'
+//! separators. The issues of a group are solved one after the other, as solving one of them
+//! (e.g. a rename) changes what the next one finds in the same folder, while up to
+//! maxParallelGroups groups are solved at the same time in the ThreadPool. Keys inside the folder
+//! of another key join its group, as solving an issue of a folder may rename or move the
+//! subfolders. The external changes check is part of each job, so it runs in the groups too.
+//!
+//! solve() blocks the calling thread until the issues are solved or the solving is stopped, and
+//! the callbacks are always run from the calling thread.
+//!
+class StalledIssuesBulkSolver
+{
+public:
+    enum class Result
+    {
+        NOT_RUN,
+        SOLVED,
+        FAILED,
+        EXTERNALLY_CHANGED
+    };
+
+    struct Job
+    {
+        QString groupKey;
+        std::function<Result()> solveFunc;
+    };
+
+    struct Progress
+    {
+        int finished = 0;
+        int total = 0;
+        double issuesPerSecond = 0.0;
+        // -1 while the throughput is not known yet
+        qint64 remainingSeconds = -1;
+    };
+
+    // Runs the task in another thread, the ThreadPool by default. With the ThreadPool the
+    // parallel groups are limited to two less than its workers.
+    using Executor = std::function<void(std::function<void()>)>;
+
+    static const int DEFAULT_PARALLEL_GROUPS;
+
+    explicit StalledIssuesBulkSolver(int maxParallelGroups = DEFAULT_PARALLEL_GROUPS,
+                                     Executor executor = nullptr);
+
+    void setFinishedFunc(std::function<void(int jobIndex, Result result)> finishedFunc);
+    void setProgressFunc(std::function<void(const Progress& progress)> progressFunc);
+    // Checked every now and then, the jobs not started when it returns true are not run
+    void setStopFunc(std::function<bool()> stopFunc);
+
+    std::vector<Result> solve(const std::vector<Job>& jobs);
+
+private:
+    // The key of the outermost folder of every key
+    static QHash<QString, QString> getRootKeys(const std::vector<Job>& jobs);
+
+    int mMaxParallelGroups;
+    Executor mExecutor;
+    std::function<void(int, Result)> mFinishedFunc;
+    std::function<void(const Progress&)> mProgressFunc;
+    std::function<bool()> mStopFunc;
+};
+
+#endif // STALLEDISSUESBULKSOLVER_H
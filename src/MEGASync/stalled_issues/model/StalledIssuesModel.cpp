@@ -1021,12 +1021,15 @@ void StalledIssuesModel::sendFinishSolvingMessage(
     }
 }
 
-void StalledIssuesModel::sendFixingIssuesMessage(int issue, int totalIssues)
+void StalledIssuesModel::sendFixingIssuesMessage(int issue,
+                                                 int totalIssues,
+                                                 long long remainingSeconds)
 {
     auto info = std::make_shared<MessageInfo>();
     info->message = fixingIssuesString();
     info->count = issue;
     info->total = totalIssues;
+    info->remainingSeconds = remainingSeconds;
     info->buttonType = MessageInfo::ButtonType::STOP;
     emit updateLoadingMessage(info);
 }
@@ -1048,64 +1051,74 @@ void StalledIssuesModel::solveListOfIssues(const SolveListInfo &info)
         StalledIssuesCreator::IssuesCount count;
         int issuesExternallyChanged(0);
         auto totalRows(info.indexes.size());
-        foreach(auto index, info.indexes)
+        if (info.parallel && !info.async)
         {
-            if (checkIfUserStopSolving())
-            {
-                break;
-            }
-
-            // Don´t block the UI if the issue is being solve asynchronously
-            if (!info.async)
-            {
-                sendFixingIssuesMessage(count.currentIssueBeingSolved, totalRows);
-            }
-
-            if (mThreadFinished)
+            if (!solveListOfIssuesInParallel(info, count, issuesExternallyChanged))
             {
                 return;
             }
-
-            auto potentialIndex = getSolveIssueIndex(index);
-            mModelMutex.lockForRead();
-            auto issue(mStalledIssues.at(potentialIndex.row()));
-            mModelMutex.unlock();
-
-            if (issue.getData())
+        }
+        else
+        {
+            foreach(auto index, info.indexes)
             {
-                if (issue.getData()->isFailed())
+                if (checkIfUserStopSolving())
                 {
-                    mFailedStalledIssues.removeOne(issue);
-                    mCountByFilterCriterion[static_cast<int>(
-                        StalledIssueFilterCriterion::FAILED_CONFLICTS)]--;
+                    break;
                 }
 
-                if (issue.getData()->checkForExternalChanges())
+                // Don´t block the UI if the issue is being solve asynchronously
+                if (!info.async)
                 {
-                    issuesExternallyChanged++;
-                    count.issuesFailed++;
+                    sendFixingIssuesMessage(count.currentIssueBeingSolved, totalRows);
                 }
-                else
+
+                if (mThreadFinished)
+                {
+                    return;
+                }
+
+                auto potentialIndex = getSolveIssueIndex(index);
+                mModelMutex.lockForRead();
+                auto issue(mStalledIssues.at(potentialIndex.row()));
+                mModelMutex.unlock();
+
+                if (issue.getData())
                 {
-                    if (info.solveFunc)
+                    if (issue.getData()->isFailed())
                     {
-                        auto result(info.solveFunc(potentialIndex.row()));
-                        if (!info.async)
+                        mFailedStalledIssues.removeOne(issue);
+                        mCountByFilterCriterion[static_cast<int>(
+                            StalledIssueFilterCriterion::FAILED_CONFLICTS)]--;
+                    }
+
+                    if (issue.getData()->checkForExternalChanges())
+                    {
+                        issuesExternallyChanged++;
+                        count.issuesFailed++;
+                    }
+                    else
+                    {
+                        if (info.solveFunc)
                         {
-                            if (result)
+                            auto result(info.solveFunc(potentialIndex.row()));
+                            if (!info.async)
                             {
-                                count.issuesFixed++;
-                            }
-                            else
-                            {
-                                count.issuesFailed++;
+                                if (result)
+                                {
+                                    count.issuesFixed++;
+                                }
+                                else
+                                {
+                                    count.issuesFailed++;
+                                }
+                                issueSolvingFinished(issue.getData().get(), result);
                             }
-                            issueSolvingFinished(issue.getData().get(), result);
                         }
                     }
                 }
+                count.currentIssueBeingSolved++;
             }
-            count.currentIssueBeingSolved++;
         }
 
         if (!info.async)
@@ -1135,6 +1148,113 @@ void StalledIssuesModel::solveListOfIssues(const SolveListInfo &info)
     });
 }
 
+bool StalledIssuesModel::solveListOfIssuesInParallel(const SolveListInfo& info,
+                                                     StalledIssuesCreator::IssuesCount& count,
+                                                     int& issuesExternallyChanged)
+{
+    auto totalRows(info.indexes.size());
+    sendFixingIssuesMessage(count.currentIssueBeingSolved, totalRows);
+
+    std::vector<StalledIssuesBulkSolver::Job> jobs;
+    std::vector<StalledIssueVariant> issues;
+    jobs.reserve(static_cast<size_t>(totalRows));
+    issues.reserve(static_cast<size_t>(totalRows));
+    foreach(auto index, info.indexes)
+    {
+        auto potentialIndex = getSolveIssueIndex(index);
+        auto issue(getStalledIssueByRow(potentialIndex.row()));
+        if (!issue.getData())
+        {
+            count.currentIssueBeingSolved++;
+            continue;
+        }
+
+        if (issue.getData()->isFailed())
+        {
+            mFailedStalledIssues.removeOne(issue);
+            mCountByFilterCriterion[static_cast<int>(
+                StalledIssueFilterCriterion::FAILED_CONFLICTS)]--;
+        }
+
+        StalledIssuesBulkSolver::Job job;
+        job.groupKey = getSolveGroupKey(issue);
+        job.solveFunc =
+            [data = issue.getData(), row = potentialIndex.row(), solveFunc = info.solveFunc]()
+        {
+            if (data->checkForExternalChanges())
+            {
+                return StalledIssuesBulkSolver::Result::EXTERNALLY_CHANGED;
+            }
+
+            return solveFunc(row) ? StalledIssuesBulkSolver::Result::SOLVED :
+                                    StalledIssuesBulkSolver::Result::FAILED;
+        };
+        jobs.push_back(std::move(job));
+        issues.push_back(issue);
+    }
+
+    StalledIssuesBulkSolver bulkSolver;
+    bulkSolver.setStopFunc(
+        [this]()
+        {
+            return checkIfUserStopSolving();
+        });
+    bulkSolver.setFinishedFunc(
+        [this, &issues, &count, &issuesExternallyChanged](int jobIndex,
+                                                          StalledIssuesBulkSolver::Result result)
+        {
+            if (result == StalledIssuesBulkSolver::Result::EXTERNALLY_CHANGED)
+            {
+                issuesExternallyChanged++;
+                count.issuesFailed++;
+            }
+            else
+            {
+                auto solved(result == StalledIssuesBulkSolver::Result::SOLVED);
+                if (solved)
+                {
+                    count.issuesFixed++;
+                }
+                else
+                {
+                    count.issuesFailed++;
+                }
+                issueSolvingFinished(issues[static_cast<size_t>(jobIndex)].getData().get(),
+                                     solved);
+            }
+            count.currentIssueBeingSolved++;
+        });
+    bulkSolver.setProgressFunc(
+        [this, &count, totalRows](const StalledIssuesBulkSolver::Progress& progress)
+        {
+            sendFixingIssuesMessage(count.currentIssueBeingSolved,
+                                    totalRows,
+                                    progress.remainingSeconds);
+        });
+    bulkSolver.solve(jobs);
+
+    return !mThreadFinished;
+}
+
+QString StalledIssuesModel::getSolveGroupKey(const StalledIssueVariant& issue)
+{
+    // The issues of the same folder are solved one after the other
+    QString folder;
+    if (issue.consultData()->consultLocalData())
+    {
+        folder = QDir::fromNativeSeparators(
+            issue.consultData()->consultLocalData()->getNativePath());
+    }
+    else if (issue.consultData()->consultCloudData())
+    {
+        folder = issue.consultData()->consultCloudData()->getNativePath();
+    }
+
+    auto syncId(issue.consultData()->syncIds().isEmpty() ? mega::INVALID_HANDLE :
+                                                          issue.consultData()->firstSyncId());
+    return QString::number(syncId) + QLatin1Char(':') + folder;
+}
+
 void StalledIssuesModel::showIssueExternallyChangedMessageBox()
 {
     QMegaMessageBox::MessageBoxInfo msgInfo;
@@ -1294,6 +1414,7 @@ void StalledIssuesModel::chooseBothSides(const QModelIndexList& list)
     };
 
     SolveListInfo info(list, resolveIssue);
+    info.parallel = true;
     solveListOfIssues(info);
 }
 
@@ -1618,6 +1739,7 @@ void StalledIssuesModel::fixFolderMatchedAgainstFile(const QModelIndexList& list
     };
 
     SolveListInfo info(list, resolveIssue);
+    info.parallel = true;
     solveListOfIssues(info);
 }
 
@@ -1653,18 +1775,16 @@ void StalledIssuesModel::semiAutoSolveNameConflictIssues(const QModelIndexList&
     {
         auto result(false);
         auto item(getStalledIssueByRow(row));
-        if(!item.getData()->checkForExternalChanges())
+        // The external changes have already been checked by solveListOfIssues
+        if(item.consultData()->getReason() == mega::MegaSyncStall::SyncStallReason::NamesWouldClashWhenSynced)
         {
-            if(item.consultData()->getReason() == mega::MegaSyncStall::SyncStallReason::NamesWouldClashWhenSynced)
+            if(auto nameConflict = item.convert<NameConflictedStalledIssue>())
             {
-                if(auto nameConflict = item.convert<NameConflictedStalledIssue>())
-                {
-                    result = nameConflict->semiAutoSolveIssue(static_cast<NameConflictedStalledIssue::ActionsSelected>(option));
+                result = nameConflict->semiAutoSolveIssue(static_cast<NameConflictedStalledIssue::ActionsSelected>(option));
 
-                    if(result)
-                    {
-                        MegaSyncApp->getStatsEventHandler()->sendEvent(AppStatsEvents::EventType::SI_NAMECONFLICT_SOLVED_SEMI_AUTOMATICALLY);
-                    }
+                if(result)
+                {
+                    MegaSyncApp->getStatsEventHandler()->sendEvent(AppStatsEvents::EventType::SI_NAMECONFLICT_SOLVED_SEMI_AUTOMATICALLY);
                 }
             }
         }
@@ -1673,6 +1793,7 @@ void StalledIssuesModel::semiAutoSolveNameConflictIssues(const QModelIndexList&
     };
 
     SolveListInfo info(list, resolveIssue);
+    info.parallel = true;
     solveListOfIssues(info);
 }
 
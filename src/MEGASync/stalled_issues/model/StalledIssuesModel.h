@@ -6,6 +6,7 @@
 #include "QTMegaGlobalListener.h"
 #include "QTMegaRequestListener.h"
 #include "StalledIssue.h"
+#include "StalledIssuesBulkSolver.h"
 #include "StalledIssuesFactory.h"
 #include "StalledIssuesUtilities.h"
 #include "TextDecorator.h"
@@ -284,7 +285,7 @@ private:
     void finishSolvingIssues(StalledIssuesCreator::IssuesCount count, bool sendMessage = true);
     void sendFinishSolvingMessage(StalledIssuesCreator::IssuesCount count, bool sendMessage = true);
 
-    void sendFixingIssuesMessage(int issue, int totalIssues);
+    void sendFixingIssuesMessage(int issue, int totalIssues, long long remainingSeconds = -1);
 
     struct SolveListInfo
     {
@@ -296,6 +297,8 @@ private:
         }
 
         bool async = false;
+        // The solveFunc of different folders can run at the same time, see StalledIssuesBulkSolver
+        bool parallel = false;
         QModelIndexList indexes;
         std::function<bool(int)> solveFunc = nullptr;
         std::function<void ()> startFunc = nullptr;
@@ -303,6 +306,10 @@ private:
     };
 
     void solveListOfIssues(const SolveListInfo& info);
+    bool solveListOfIssuesInParallel(const SolveListInfo& info,
+                                     StalledIssuesCreator::IssuesCount& count,
+                                     int& issuesExternallyChanged);
+    static QString getSolveGroupKey(const StalledIssueVariant& issue);
     bool issueSolvingFinished(const StalledIssue* issue);
     bool issueSolvingFinished(StalledIssue* issue, bool wasSuccessful);
     bool issueSolved(const StalledIssue* issue);
@@ -1,9 +1,9 @@
 #include "StalledIssuesProxyModel.h"
 
 #include "StalledIssuesModel.h"
+#include "Utilities.h"
 
 #include <QElapsedTimer>
-#include <QtConcurrent/QtConcurrent>
 
 StalledIssuesProxyModel::StalledIssuesProxyModel(QObject *parent) :QSortFilterProxyModel(parent)
   , mFilterCriterion(StalledIssueFilterCriterion::ALL_ISSUES)
@@ -34,7 +34,7 @@ void StalledIssuesProxyModel::filter(StalledIssueFilterCriterion filterCriterion
         sourceM->blockUi();
 
         //Test if it is worth it, because there is not sorting and the sort takes longer than filtering.
-        auto filterAction = QtConcurrent::run([this, sourceM]()
+        auto filterTask = [this, sourceM]()
         {
             blockSignals(true);
             sourceM->blockSignals(true);
@@ -49,8 +49,10 @@ void StalledIssuesProxyModel::filter(StalledIssueFilterCriterion filterCriterion
 
             blockSignals(false);
             sourceM->blockSignals(false);
-        });
+        };
 
+        auto filterAction = ThreadPoolSingleton::getInstance()->run(
+            ThreadPool::Priority::INTERACTIVE, filterTask);
         mFilterWatcher.setFuture(filterAction);
     }
     else
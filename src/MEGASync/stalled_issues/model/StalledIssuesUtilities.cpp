@@ -1,6 +1,7 @@
 #include "StalledIssuesUtilities.h"
 
 #include "DialogOpener.h"
+#include "FolderNameIndex.h"
 #include "MegaApiSynchronizedRequest.h"
 #include "MegaApplication.h"
 #include "MegaDownloader.h"
@@ -170,7 +171,7 @@ void StalledIssuesUtilities::openLink(bool isCloud, const QString& path)
         auto url(getLink(isCloud, path));
         if (!url.isEmpty())
         {
-            QtConcurrent::run(QDesktopServices::openUrl, QUrl(url));
+            Utilities::openUrl(QUrl(url));
         }
         else
         {
@@ -186,10 +187,12 @@ void StalledIssuesUtilities::openLink(bool isCloud, const QString& path)
         QFile file(path);
         if(file.exists())
         {
-            QtConcurrent::run([=]
+            ThreadPoolSingleton::getInstance()->push(
+                [=]
                 {
                     Platform::getInstance()->showInFolder(path);
-                });
+                },
+                ThreadPool::Priority::INTERACTIVE);
         }
         else
         {
@@ -235,6 +238,7 @@ StalledIssuesUtilities::KeepBothSidesState StalledIssuesUtilities::KeepBothSides
                 MegaSyncApp->getMegaApi(),
                 node.get(),
                 result.newName.toUtf8().constData());
+            FolderNameIndex::instance().invalidate(parentNode->getHandle());
 
             if(result.error)
             {
@@ -246,9 +250,11 @@ StalledIssuesUtilities::KeepBothSidesState StalledIssuesUtilities::KeepBothSides
                 QFile file(currentFile.filePath());
                 if(file.exists())
                 {
-                    result.newName = Utilities::getNonDuplicatedLocalName(currentFile, true, QStringList());
+                    result.newName = Utilities::getNonDuplicatedLocalName(currentFile, QStringList());
                     currentFile.setFile(currentFile.path(), result.newName);
-                    if(file.rename(QDir::toNativeSeparators(currentFile.filePath())))
+                    const bool renamed(file.rename(QDir::toNativeSeparators(currentFile.filePath())));
+                    FolderNameIndex::instance().invalidateLocal(currentFile.path());
+                    if(renamed)
                     {
                         result.sideRenamed = KeepBothSidesState::Side::LOCAL;
 
@@ -0,0 +1,315 @@
+#include "SyncStatsRecorder.h"
+
+#include "MegaApplication.h"
+#include "SyncInfo.h"
+#include "ThreadPool.h"
+#include "Utilities.h"
+
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QJsonObject>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QSaveFile>
+
+namespace
+{
+const char* SYNC_STATS_FILE_NAME = "syncstats.dat";
+
+QMutex fileMutex;
+quint64 lastFileSequence = 0;
+
+// The writes run in the thread pool, a write that runs after a newer one is dropped.
+// Empty data removes the file.
+void writeFile(const QString& path, const QByteArray& data, quint64 sequence)
+{
+    QMutexLocker locker(&fileMutex);
+    if (sequence <= lastFileSequence)
+    {
+        return;
+    }
+    lastFileSequence = sequence;
+
+    if (data.isEmpty())
+    {
+        QFile::remove(path);
+        return;
+    }
+
+    QSaveFile file(path);
+    if (!file.open(QIODevice::WriteOnly) || file.write(data) != data.size() || !file.commit())
+    {
+        mega::MegaApi::log(mega::MegaApi::LOG_LEVEL_WARNING,
+                           QString::fromUtf8("Unable to save the sync stats to %1: %2")
+                               .arg(path, file.errorString())
+                               .toUtf8()
+                               .constData());
+    }
+}
+}
+
+SyncStatsRecorder::SyncStatsRecorder():
+    mSyncFoldersDirty(true),
+    mStarted(false),
+    mUnsavedSamples(0),
+    mSamplesUntilSave(SAVE_INTERVAL_SAMPLES),
+    mFileSequence(0)
+{}
+
+void SyncStatsRecorder::start()
+{
+    if (mStarted)
+    {
+        return;
+    }
+    mStarted = true;
+
+    QFile file(filePath());
+    if (file.exists())
+    {
+        if (!file.open(QIODevice::ReadOnly) || !mTimeSeries.deserialize(file.readAll()))
+        {
+            mega::MegaApi::log(mega::MegaApi::LOG_LEVEL_WARNING,
+                               "Discarding the saved sync stats, they could not be read");
+        }
+    }
+
+    auto syncInfo(SyncInfo::instance());
+    connect(syncInfo, &SyncInfo::syncStatsUpdated, this, &SyncStatsRecorder::onSyncStatsUpdated);
+    connect(syncInfo, &SyncInfo::syncStateChanged, this, &SyncStatsRecorder::onSyncStateChanged);
+    connect(syncInfo, &SyncInfo::syncRemoved, this, &SyncStatsRecorder::onSyncRemoved);
+}
+
+void SyncStatsRecorder::finish()
+{
+    if (mStarted && mUnsavedSamples > 0)
+    {
+        save(true);
+    }
+}
+
+void SyncStatsRecorder::clear()
+{
+    mTimeSeries.clear();
+    mTrackedTransfers.clear();
+    mSyncFolders.clear();
+    mSyncFoldersDirty = true;
+    mUnsavedSamples = 0;
+    removeFile();
+}
+
+void SyncStatsRecorder::onTransferUpdate(mega::MegaTransfer* transfer)
+{
+    if (transfer->isSyncTransfer() && !transfer->isFolderTransfer())
+    {
+        addTransferredBytes(transfer, false);
+    }
+}
+
+void SyncStatsRecorder::onTransferFinish(mega::MegaTransfer* transfer)
+{
+    if (transfer->isSyncTransfer() && !transfer->isFolderTransfer())
+    {
+        addTransferredBytes(transfer, true);
+    }
+}
+
+int SyncStatsRecorder::takeSamples()
+{
+    if (!mStarted)
+    {
+        return 0;
+    }
+
+    const int recordedSamples(mTimeSeries.takeSamples(QDateTime::currentMSecsSinceEpoch()));
+    mUnsavedSamples += recordedSamples;
+
+    if (--mSamplesUntilSave <= 0)
+    {
+        mSamplesUntilSave = SAVE_INTERVAL_SAMPLES;
+        if (mUnsavedSamples > 0)
+        {
+            save(false);
+        }
+    }
+
+    return recordedSamples;
+}
+
+QJsonArray SyncStatsRecorder::toJson() const
+{
+    QJsonArray syncs;
+    for (const auto& backupId : mTimeSeries.getBackupIds())
+    {
+        std::unique_ptr<char[]> backupIdStr(mega::MegaApi::userHandleToBase64(backupId));
+
+        QJsonObject sync;
+        sync.insert(QStringLiteral("backupId"), QString::fromUtf8(backupIdStr.get()));
+        sync.insert(QStringLiteral("name"), getSyncName(backupId));
+        sync.insert(QStringLiteral("samples"), mTimeSeries.toJson(backupId));
+        syncs.append(sync);
+    }
+    return syncs;
+}
+
+QString SyncStatsRecorder::getSummary() const
+{
+    QString summary;
+    for (const auto& backupId : mTimeSeries.getBackupIds())
+    {
+        summary.append(QString::fromUtf8("%1: %2\n")
+                           .arg(getSyncName(backupId), mTimeSeries.getSummary(backupId)));
+    }
+    return summary;
+}
+
+QString SyncStatsRecorder::filePath()
+{
+    return MegaApplication::applicationDataPath() + QDir::separator() +
+           QString::fromLatin1(SYNC_STATS_FILE_NAME);
+}
+
+void SyncStatsRecorder::onSyncStatsUpdated(std::shared_ptr<::mega::MegaSyncStats> stats)
+{
+    SyncStatsTimeSeries::StatsUpdate update;
+    update.scanning = stats->isScanning();
+    update.syncing = stats->isSyncing();
+    update.pendingUploads = static_cast<int>(stats->getUploadCount());
+    update.pendingDownloads = static_cast<int>(stats->getDownloadCount());
+    mTimeSeries.updateStats(stats->getBackupId(), update, QDateTime::currentMSecsSinceEpoch());
+    emit syncActivity();
+}
+
+void SyncStatsRecorder::onSyncStateChanged(std::shared_ptr<SyncSettings>)
+{
+    mSyncFoldersDirty = true;
+    emit syncActivity();
+}
+
+void SyncStatsRecorder::onSyncRemoved(std::shared_ptr<SyncSettings> syncSettings)
+{
+    mSyncFoldersDirty = true;
+    if (syncSettings)
+    {
+        mTimeSeries.removeSync(syncSettings->backupId());
+    }
+}
+
+void SyncStatsRecorder::addTransferredBytes(mega::MegaTransfer* transfer, bool finished)
+{
+    const int tag(transfer->getTag());
+    const long long transferredBytes(transfer->getTransferredBytes());
+
+    auto transferIt(mTrackedTransfers.find(tag));
+    if (transferIt == mTrackedTransfers.end())
+    {
+        TrackedTransfer trackedTransfer;
+        trackedTransfer.backupId = getBackupIdByPath(transfer->getPath());
+        trackedTransfer.isUpload = transfer->getType() == mega::MegaTransfer::TYPE_UPLOAD;
+        // Only the bytes transferred from now on, unless it finished before being seen
+        trackedTransfer.transferredBytes = finished ? 0 : transferredBytes;
+        transferIt = mTrackedTransfers.insert(tag, trackedTransfer);
+    }
+
+    // The bytes go back to zero when a transfer is retried
+    const long long deltaBytes(transferredBytes - transferIt->transferredBytes);
+    transferIt->transferredBytes = transferredBytes;
+    if (deltaBytes > 0 && transferIt->backupId != mega::INVALID_HANDLE)
+    {
+        if (transferIt->isUpload)
+        {
+            mTimeSeries.addUploadedBytes(transferIt->backupId, deltaBytes);
+        }
+        else
+        {
+            mTimeSeries.addDownloadedBytes(transferIt->backupId, deltaBytes);
+        }
+    }
+
+    if (finished)
+    {
+        mTrackedTransfers.erase(transferIt);
+    }
+}
+
+mega::MegaHandle SyncStatsRecorder::getBackupIdByPath(const char* path)
+{
+    if (!path)
+    {
+        return mega::INVALID_HANDLE;
+    }
+
+    if (mSyncFoldersDirty)
+    {
+        mSyncFoldersDirty = false;
+        mSyncFolders.clear();
+        for (const auto& syncSettings : SyncInfo::instance()->getAllSyncSettings())
+        {
+            QString syncFolder(QDir::fromNativeSeparators(syncSettings->getLocalFolder()));
+            if (!syncFolder.endsWith(QLatin1Char('/')))
+            {
+                syncFolder.append(QLatin1Char('/'));
+            }
+            mSyncFolders.emplace_back(syncFolder, syncSettings->backupId());
+        }
+    }
+
+    QString filePath(QString::fromUtf8(path));
+#ifdef WIN32
+    if (filePath.startsWith(QString::fromUtf8("\\\\?\\")))
+    {
+        filePath = filePath.mid(4);
+    }
+#endif
+    filePath = QDir::fromNativeSeparators(filePath);
+
+    for (const auto& syncFolder : mSyncFolders)
+    {
+        if (filePath.startsWith(syncFolder.first))
+        {
+            return syncFolder.second;
+        }
+    }
+    return mega::INVALID_HANDLE;
+}
+
+QString SyncStatsRecorder::getSyncName(mega::MegaHandle backupId) const
+{
+    auto syncSettings(SyncInfo::instance()->getSyncSettingByTag(backupId));
+    return syncSettings ? syncSettings->name() : QString::fromUtf8("Removed sync");
+}
+
+void SyncStatsRecorder::save(bool synchronous)
+{
+    mUnsavedSamples = 0;
+
+    const QString path(filePath());
+    const QByteArray data(mTimeSeries.serialize());
+    const quint64 sequence(++mFileSequence);
+    if (synchronous)
+    {
+        writeFile(path, data, sequence);
+    }
+    else
+    {
+        ThreadPoolSingleton::getInstance()->push(
+            [path, data, sequence]()
+            {
+                writeFile(path, data, sequence);
+            },
+            ThreadPool::Priority::BACKGROUND);
+    }
+}
+
+void SyncStatsRecorder::removeFile()
+{
+    const QString path(filePath());
+    const quint64 sequence(++mFileSequence);
+    ThreadPoolSingleton::getInstance()->push(
+        [path, sequence]()
+        {
+            writeFile(path, QByteArray(), sequence);
+        },
+        ThreadPool::Priority::BACKGROUND);
+}
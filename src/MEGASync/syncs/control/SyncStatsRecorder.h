@@ -0,0 +1,99 @@
+#ifndef SYNC_STATS_RECORDER_H
+#define SYNC_STATS_RECORDER_H
+
+#include "megaapi.h"
+#include "SyncSettings.h"
+#include "SyncStatsTimeSeries.h"
+
+#include <QHash>
+#include <QJsonArray>
+#include <QObject>
+#include <QString>
+
+#include <memory>
+#include <utility>
+#include <vector>
+
+/*
+ * Records the SyncStatsTimeSeries of the syncs of the account, to diagnose slow syncs.
+ *
+ * It is fed with the stats updates of SyncInfo and with the transfers of the syncs, which the
+ * app passes from its transfer callbacks. takeSamples() is run by the task scheduler, which backs
+ * off while the syncs are idle and is woken up by syncActivity(). The samples are saved to a small binary file in the app data folder every few
+ * samples and when the app exits, and loaded again on start. They are removed on logout.
+ *
+ * The samples are exported in the bug reports and through the headless control server.
+ * It must be used from the GUI thread.
+ */
+class SyncStatsRecorder: public QObject
+{
+    Q_OBJECT
+
+public:
+    static const int SAVE_INTERVAL_SAMPLES = 10;
+
+    static SyncStatsRecorder& instance()
+    {
+        static SyncStatsRecorder instance;
+        return instance;
+    }
+
+    SyncStatsRecorder(const SyncStatsRecorder&) = delete;
+    SyncStatsRecorder& operator=(const SyncStatsRecorder&) = delete;
+
+    // Loads the saved samples and starts listening to the sync stats
+    void start();
+    // Saves the samples synchronously, to be called when the app exits
+    void finish();
+    // Drops the samples and removes the file
+    void clear();
+
+    // Only the sync transfers are recorded, the rest return straight away
+    void onTransferUpdate(mega::MegaTransfer* transfer);
+    void onTransferFinish(mega::MegaTransfer* transfer);
+
+    // Returns the number of samples recorded
+    int takeSamples();
+
+    QJsonArray toJson() const;
+    QString getSummary() const;
+
+    static QString filePath();
+
+signals:
+    // A sync reported new stats or changed its state
+    void syncActivity();
+
+private slots:
+    void onSyncStatsUpdated(std::shared_ptr<::mega::MegaSyncStats> stats);
+    void onSyncStateChanged(std::shared_ptr<SyncSettings> syncSettings);
+    void onSyncRemoved(std::shared_ptr<SyncSettings> syncSettings);
+
+private:
+    struct TrackedTransfer
+    {
+        mega::MegaHandle backupId = mega::INVALID_HANDLE;
+        bool isUpload = false;
+        long long transferredBytes = 0;
+    };
+
+    SyncStatsRecorder();
+
+    void addTransferredBytes(mega::MegaTransfer* transfer, bool finished);
+    mega::MegaHandle getBackupIdByPath(const char* path);
+    QString getSyncName(mega::MegaHandle backupId) const;
+    void save(bool synchronous);
+    void removeFile();
+
+    SyncStatsTimeSeries mTimeSeries;
+    QHash<int, TrackedTransfer> mTrackedTransfers;
+    // Local folders of the syncs, with the trailing separator. Built when first needed.
+    std::vector<std::pair<QString, mega::MegaHandle>> mSyncFolders;
+    bool mSyncFoldersDirty;
+    bool mStarted;
+    int mUnsavedSamples;
+    int mSamplesUntilSave;
+    quint64 mFileSequence;
+};
+
+#endif // SYNC_STATS_RECORDER_H
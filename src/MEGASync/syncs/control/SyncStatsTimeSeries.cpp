@@ -0,0 +1,362 @@
+#include "SyncStatsTimeSeries.h"
+
+#include <QDataStream>
+#include <QDateTime>
+#include <QJsonObject>
+
+#include <algorithm>
+#include <cstddef>
+#include <limits>
+
+namespace
+{
+const quint32 FILE_MAGIC = 0x4D535453; // "MSTS"
+const quint8 FILE_VERSION = 1;
+
+quint32 toDuration(qint64 ms)
+{
+    return static_cast<quint32>(
+        std::min(std::max(ms, qint64(0)),
+                 static_cast<qint64>(std::numeric_limits<quint32>::max())));
+}
+
+qint64 toBytesPerSecond(qint64 bytes, quint32 intervalMs)
+{
+    return intervalMs > 0 ? bytes * 1000 / intervalMs : 0;
+}
+}
+
+bool SyncStatsTimeSeries::Sample::isIdle() const
+{
+    return scanningMs == 0 && syncingMs == 0 && finishedScanMs == 0 && pendingUploads == 0 &&
+           pendingDownloads == 0 && uploadBytesPerSecond == 0 && downloadBytesPerSecond == 0;
+}
+
+SyncStatsTimeSeries::SyncStatsTimeSeries(int capacity):
+    mCapacity(std::max(capacity, 1))
+{}
+
+void SyncStatsTimeSeries::updateStats(mega::MegaHandle backupId,
+                                      const StatsUpdate& update,
+                                      qint64 nowMs)
+{
+    auto& series(mSeries[backupId]);
+    const bool wasScanning(series.hasUpdate && series.lastUpdate.scanning);
+
+    if (series.hasUpdate)
+    {
+        accountState(series, nowMs);
+    }
+    else
+    {
+        series.hasUpdate = true;
+        series.intervalStartMs = nowMs;
+        series.accountedMs = nowMs;
+    }
+
+    if (update.scanning && !wasScanning)
+    {
+        series.scanStartMs = nowMs;
+    }
+    else if (!update.scanning && wasScanning && series.scanStartMs >= 0)
+    {
+        series.finishedScanMs = std::max(series.finishedScanMs, nowMs - series.scanStartMs);
+        series.scanStartMs = -1;
+    }
+
+    series.lastUpdate = update;
+}
+
+void SyncStatsTimeSeries::addUploadedBytes(mega::MegaHandle backupId, qint64 bytes)
+{
+    auto seriesIt(mSeries.find(backupId));
+    if (seriesIt != mSeries.end() && seriesIt->hasUpdate)
+    {
+        seriesIt->uploadedBytes += bytes;
+    }
+}
+
+void SyncStatsTimeSeries::addDownloadedBytes(mega::MegaHandle backupId, qint64 bytes)
+{
+    auto seriesIt(mSeries.find(backupId));
+    if (seriesIt != mSeries.end() && seriesIt->hasUpdate)
+    {
+        seriesIt->downloadedBytes += bytes;
+    }
+}
+
+int SyncStatsTimeSeries::takeSamples(qint64 nowMs)
+{
+    int recordedSamples(0);
+    for (auto& series : mSeries)
+    {
+        if (!series.hasUpdate || nowMs <= series.intervalStartMs)
+        {
+            continue;
+        }
+
+        accountState(series, nowMs);
+
+        Sample sample;
+        sample.timestampMs = nowMs;
+        sample.intervalMs = toDuration(nowMs - series.intervalStartMs);
+        sample.scanningMs = toDuration(series.scanningMs);
+        sample.syncingMs = toDuration(series.syncingMs);
+        sample.finishedScanMs = toDuration(series.finishedScanMs);
+        sample.pendingUploads = series.lastUpdate.pendingUploads;
+        sample.pendingDownloads = series.lastUpdate.pendingDownloads;
+        sample.uploadBytesPerSecond = toBytesPerSecond(series.uploadedBytes, sample.intervalMs);
+        sample.downloadBytesPerSecond = toBytesPerSecond(series.downloadedBytes, sample.intervalMs);
+
+        const Sample* lastSample(getLastSample(series));
+        if (!sample.isIdle() || !lastSample || !lastSample->isIdle())
+        {
+            append(series, sample);
+            recordedSamples++;
+        }
+
+        series.intervalStartMs = nowMs;
+        series.scanningMs = 0;
+        series.syncingMs = 0;
+        series.finishedScanMs = 0;
+        series.uploadedBytes = 0;
+        series.downloadedBytes = 0;
+    }
+
+    return recordedSamples;
+}
+
+int SyncStatsTimeSeries::getCapacity() const
+{
+    return mCapacity;
+}
+
+QList<mega::MegaHandle> SyncStatsTimeSeries::getBackupIds() const
+{
+    return mSeries.keys();
+}
+
+std::vector<SyncStatsTimeSeries::Sample>
+    SyncStatsTimeSeries::getSamples(mega::MegaHandle backupId) const
+{
+    std::vector<Sample> samples;
+    auto seriesIt(mSeries.constFind(backupId));
+    if (seriesIt != mSeries.constEnd())
+    {
+        const auto& buffer(seriesIt->samples);
+        samples.reserve(buffer.size());
+        samples.insert(samples.end(),
+                       buffer.cbegin() + static_cast<std::ptrdiff_t>(seriesIt->first),
+                       buffer.cend());
+        samples.insert(samples.end(),
+                       buffer.cbegin(),
+                       buffer.cbegin() + static_cast<std::ptrdiff_t>(seriesIt->first));
+    }
+    return samples;
+}
+
+void SyncStatsTimeSeries::removeSync(mega::MegaHandle backupId)
+{
+    mSeries.remove(backupId);
+}
+
+void SyncStatsTimeSeries::clear()
+{
+    mSeries.clear();
+}
+
+QByteArray SyncStatsTimeSeries::serialize() const
+{
+    QByteArray data;
+    QDataStream stream(&data, QIODevice::WriteOnly);
+    stream.setVersion(QDataStream::Qt_5_0);
+
+    stream << FILE_MAGIC << FILE_VERSION << static_cast<quint32>(mSeries.size());
+    for (auto seriesIt = mSeries.constBegin(); seriesIt != mSeries.constEnd(); ++seriesIt)
+    {
+        const auto samples(getSamples(seriesIt.key()));
+        stream << static_cast<quint64>(seriesIt.key()) << static_cast<quint32>(samples.size());
+        for (const auto& sample : samples)
+        {
+            stream << sample.timestampMs << sample.intervalMs << sample.scanningMs
+                   << sample.syncingMs << sample.finishedScanMs << sample.pendingUploads
+                   << sample.pendingDownloads << sample.uploadBytesPerSecond
+                   << sample.downloadBytesPerSecond;
+        }
+    }
+
+    return data;
+}
+
+bool SyncStatsTimeSeries::deserialize(const QByteArray& data)
+{
+    mSeries.clear();
+
+    QDataStream stream(data);
+    stream.setVersion(QDataStream::Qt_5_0);
+
+    quint32 magic(0);
+    quint8 version(0);
+    quint32 seriesCount(0);
+    stream >> magic >> version >> seriesCount;
+    if (stream.status() != QDataStream::Ok || magic != FILE_MAGIC || version != FILE_VERSION)
+    {
+        return false;
+    }
+
+    for (quint32 i = 0; i < seriesCount && stream.status() == QDataStream::Ok; i++)
+    {
+        quint64 backupId(0);
+        quint32 sampleCount(0);
+        stream >> backupId >> sampleCount;
+
+        // Only the latest samples fit if the capacity was reduced
+        const quint32 skippedSamples(
+            sampleCount > static_cast<quint32>(mCapacity) ?
+                sampleCount - static_cast<quint32>(mCapacity) :
+                0);
+        Series series;
+        for (quint32 j = 0; j < sampleCount && stream.status() == QDataStream::Ok; j++)
+        {
+            Sample sample;
+            stream >> sample.timestampMs >> sample.intervalMs >> sample.scanningMs >>
+                sample.syncingMs >> sample.finishedScanMs >> sample.pendingUploads >>
+                sample.pendingDownloads >> sample.uploadBytesPerSecond >>
+                sample.downloadBytesPerSecond;
+            if (j >= skippedSamples)
+            {
+                series.samples.push_back(sample);
+            }
+        }
+        mSeries.insert(static_cast<mega::MegaHandle>(backupId), series);
+    }
+
+    if (stream.status() != QDataStream::Ok)
+    {
+        mSeries.clear();
+        return false;
+    }
+
+    return true;
+}
+
+QJsonArray SyncStatsTimeSeries::toJson(mega::MegaHandle backupId) const
+{
+    QJsonArray jsonSamples;
+    for (const auto& sample : getSamples(backupId))
+    {
+        QJsonObject jsonSample;
+        jsonSample.insert(QStringLiteral("timestamp"), static_cast<double>(sample.timestampMs));
+        jsonSample.insert(QStringLiteral("intervalMs"), static_cast<double>(sample.intervalMs));
+        jsonSample.insert(QStringLiteral("scanningMs"), static_cast<double>(sample.scanningMs));
+        jsonSample.insert(QStringLiteral("syncingMs"), static_cast<double>(sample.syncingMs));
+        jsonSample.insert(QStringLiteral("finishedScanMs"),
+                          static_cast<double>(sample.finishedScanMs));
+        jsonSample.insert(QStringLiteral("pendingUploads"), sample.pendingUploads);
+        jsonSample.insert(QStringLiteral("pendingDownloads"), sample.pendingDownloads);
+        jsonSample.insert(QStringLiteral("uploadBytesPerSecond"),
+                          static_cast<double>(sample.uploadBytesPerSecond));
+        jsonSample.insert(QStringLiteral("downloadBytesPerSecond"),
+                          static_cast<double>(sample.downloadBytesPerSecond));
+        jsonSamples.append(jsonSample);
+    }
+    return jsonSamples;
+}
+
+QString SyncStatsTimeSeries::getSummary(mega::MegaHandle backupId) const
+{
+    const auto samples(getSamples(backupId));
+    if (samples.empty())
+    {
+        return QLatin1String("no samples");
+    }
+
+    qint64 totalMs(0);
+    qint64 scanningMs(0);
+    qint64 syncingMs(0);
+    quint32 longestScanMs(0);
+    qint32 maxPendingUploads(0);
+    qint32 maxPendingDownloads(0);
+    qint64 uploadedBytes(0);
+    qint64 downloadedBytes(0);
+    qint64 peakUploadBytesPerSecond(0);
+    qint64 peakDownloadBytesPerSecond(0);
+    for (const auto& sample : samples)
+    {
+        totalMs += sample.intervalMs;
+        scanningMs += sample.scanningMs;
+        syncingMs += sample.syncingMs;
+        longestScanMs = std::max(longestScanMs, sample.finishedScanMs);
+        maxPendingUploads = std::max(maxPendingUploads, sample.pendingUploads);
+        maxPendingDownloads = std::max(maxPendingDownloads, sample.pendingDownloads);
+        uploadedBytes += sample.uploadBytesPerSecond * sample.intervalMs / 1000;
+        downloadedBytes += sample.downloadBytesPerSecond * sample.intervalMs / 1000;
+        peakUploadBytesPerSecond = std::max(peakUploadBytesPerSecond,
+                                            sample.uploadBytesPerSecond);
+        peakDownloadBytesPerSecond = std::max(peakDownloadBytesPerSecond,
+                                              sample.downloadBytesPerSecond);
+    }
+
+    const auto& firstSample(samples.front());
+    const auto since(QDateTime::fromMSecsSinceEpoch(firstSample.timestampMs -
+                                                    firstSample.intervalMs)
+                         .toUTC()
+                         .toString(Qt::ISODate));
+    const auto percentage = [totalMs](qint64 ms)
+    {
+        return totalMs > 0 ? ms * 100 / totalMs : 0;
+    };
+
+    return QString::fromUtf8("%1 samples since %2, scanning %3%, syncing %4%, longest scan %5 s, "
+                             "max pending %6 up %7 down, up %8 B/s (peak %9), "
+                             "down %10 B/s (peak %11)")
+        .arg(static_cast<int>(samples.size()))
+        .arg(since)
+        .arg(percentage(scanningMs))
+        .arg(percentage(syncingMs))
+        .arg(longestScanMs / 1000)
+        .arg(maxPendingUploads)
+        .arg(maxPendingDownloads)
+        .arg(toBytesPerSecond(uploadedBytes, toDuration(totalMs)))
+        .arg(peakUploadBytesPerSecond)
+        .arg(toBytesPerSecond(downloadedBytes, toDuration(totalMs)))
+        .arg(peakDownloadBytesPerSecond);
+}
+
+void SyncStatsTimeSeries::append(Series& series, const Sample& sample) const
+{
+    if (series.samples.size() < static_cast<size_t>(mCapacity))
+    {
+        series.samples.push_back(sample);
+    }
+    else
+    {
+        series.samples[series.first] = sample;
+        series.first = (series.first + 1) % series.samples.size();
+    }
+}
+
+const SyncStatsTimeSeries::Sample* SyncStatsTimeSeries::getLastSample(const Series& series) const
+{
+    if (series.samples.empty())
+    {
+        return nullptr;
+    }
+
+    const size_t last(series.first > 0 ? series.first - 1 : series.samples.size() - 1);
+    return &series.samples[last];
+}
+
+void SyncStatsTimeSeries::accountState(Series& series, qint64 nowMs)
+{
+    const qint64 elapsedMs(std::max(nowMs - series.accountedMs, qint64(0)));
+    if (series.lastUpdate.scanning)
+    {
+        series.scanningMs += elapsedMs;
+    }
+    if (series.lastUpdate.syncing)
+    {
+        series.syncingMs += elapsedMs;
+    }
+    series.accountedMs = std::max(nowMs, series.accountedMs);
+}
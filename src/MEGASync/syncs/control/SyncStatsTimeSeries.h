@@ -0,0 +1,113 @@
+#ifndef SYNC_STATS_TIME_SERIES_H
+#define SYNC_STATS_TIME_SERIES_H
+
+#include "megaapi.h"
+
+#include <QByteArray>
+#include <QHash>
+#include <QJsonArray>
+#include <QList>
+#include <QString>
+
+#include <vector>
+
+/*
+ * Time series of the activity of every sync: how long it spends scanning and syncing, its
+ * pending transfers and its throughput.
+ *
+ * The stats updates and the bytes transferred are accumulated as they arrive, which is a hash
+ * lookup and a few additions, and every call to takeSamples() closes the current interval of
+ * every sync into one sample. The samples of each sync are kept in a ring buffer of bounded
+ * size. A sync that stays idle only records the first idle interval, so the buffer keeps the
+ * last activity instead of hours of idle samples.
+ *
+ * The times are given by the caller, in ms since the epoch, so the series can be fed with
+ * synthetic stats.
+ */
+class SyncStatsTimeSeries
+{
+public:
+    static const int DEFAULT_CAPACITY = 720;
+
+    struct StatsUpdate
+    {
+        bool scanning = false;
+        bool syncing = false;
+        int pendingUploads = 0;
+        int pendingDownloads = 0;
+    };
+
+    struct Sample
+    {
+        // End of the interval
+        qint64 timestampMs = 0;
+        quint32 intervalMs = 0;
+        quint32 scanningMs = 0;
+        quint32 syncingMs = 0;
+        // Longest scan finished in the interval, 0 if none finished
+        quint32 finishedScanMs = 0;
+        qint32 pendingUploads = 0;
+        qint32 pendingDownloads = 0;
+        qint64 uploadBytesPerSecond = 0;
+        qint64 downloadBytesPerSecond = 0;
+
+        bool isIdle() const;
+    };
+
+    explicit SyncStatsTimeSeries(int capacity = DEFAULT_CAPACITY);
+
+    void updateStats(mega::MegaHandle backupId, const StatsUpdate& update, qint64 nowMs);
+    // The bytes of syncs without stats updates yet are ignored
+    void addUploadedBytes(mega::MegaHandle backupId, qint64 bytes);
+    void addDownloadedBytes(mega::MegaHandle backupId, qint64 bytes);
+
+    // Returns the number of samples recorded
+    int takeSamples(qint64 nowMs);
+
+    int getCapacity() const;
+    QList<mega::MegaHandle> getBackupIds() const;
+    // Oldest first
+    std::vector<Sample> getSamples(mega::MegaHandle backupId) const;
+
+    void removeSync(mega::MegaHandle backupId);
+    void clear();
+
+    // Only the samples are saved, the intervals in progress start again after loading
+    QByteArray serialize() const;
+    // False if the data is not a valid time series, the samples are left empty then
+    bool deserialize(const QByteArray& data);
+
+    QJsonArray toJson(mega::MegaHandle backupId) const;
+    // One line overview of the samples of the sync
+    QString getSummary(mega::MegaHandle backupId) const;
+
+private:
+    struct Series
+    {
+        std::vector<Sample> samples;
+        // Oldest sample once the buffer is full
+        size_t first = 0;
+
+        StatsUpdate lastUpdate;
+        bool hasUpdate = false;
+        qint64 intervalStartMs = 0;
+        // Last time the scanning and syncing times were accounted
+        qint64 accountedMs = 0;
+        qint64 scanStartMs = -1;
+
+        qint64 scanningMs = 0;
+        qint64 syncingMs = 0;
+        qint64 finishedScanMs = 0;
+        qint64 uploadedBytes = 0;
+        qint64 downloadedBytes = 0;
+    };
+
+    void append(Series& series, const Sample& sample) const;
+    const Sample* getLastSample(const Series& series) const;
+    static void accountState(Series& series, qint64 nowMs);
+
+    int mCapacity;
+    QHash<mega::MegaHandle, Series> mSeries;
+};
+
+#endif // SYNC_STATS_TIME_SERIES_H
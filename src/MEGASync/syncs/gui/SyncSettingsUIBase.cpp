@@ -200,7 +200,7 @@ void SyncSettingsUIBase::openExclusionsDialog(std::shared_ptr<SyncSettings> sync
 void SyncSettingsUIBase::openMegaIgnore(std::shared_ptr<SyncSettings> sync)
 {
     QString ignore(sync->getLocalFolder() + QDir::separator() + QString::fromUtf8(".megaignore"));
-    auto future = QtConcurrent::run(QDesktopServices::openUrl, QUrl::fromLocalFile(ignore));
+    auto future = Utilities::openUrl(QUrl::fromLocalFile(ignore));
     mOpeMegaIgnoreWatcher.setFuture(future);
 }
 
@@ -9,15 +9,24 @@
 #include <QFileInfo>
 #include <QIcon>
 
+#include <algorithm>
+
 const int SyncItemModel::ICON_SIZE = 24;
 const int SyncItemModel::STATES_ICON_SIZE = 16;
 
 const int SyncItemModel::ErrorTooltipRole = Qt::UserRole + 1;
 
+// About a frame: the stats of every sync arrive much more often than that
+constexpr int STATS_CHANGED_INTERVAL_MS = 16;
+
 SyncItemModel::SyncItemModel(QObject* parent):
     QAbstractItemModel(parent),
     mSyncInfo(SyncInfo::instance())
 {
+    mStatsChangedTimer.setSingleShot(true);
+    mStatsChangedTimer.setInterval(STATS_CHANGED_INTERVAL_MS);
+    connect(&mStatsChangedTimer, &QTimer::timeout, this, &SyncItemModel::sendStatsChanged);
+
     connect(mSyncInfo, &SyncInfo::syncStateChanged, this, &SyncItemModel::insertSync);
     connect(mSyncInfo, &SyncInfo::syncStatsUpdated, this, &SyncItemModel::updateSyncStats);
     connect(mSyncInfo, &SyncInfo::syncRemoved, this, &SyncItemModel::removeSync);
@@ -416,23 +425,18 @@ std::shared_ptr<SyncSettings> SyncItemModel::getSyncSettings(const QModelIndex&
 
 void SyncItemModel::insertSync(std::shared_ptr<SyncSettings> sync)
 {
-    if (mList.contains(sync))
+    auto rowIt = mRowByBackupId.constFind(sync->backupId());
+    if (rowIt != mRowByBackupId.constEnd())
     {
-        for (auto it = mList.cbegin(); it != mList.cend(); ++it)
-        {
-            if ((*it) == sync)
-            {
-                int pos = it - mList.cbegin();
-                sendDataChanged(pos);
-                break;
-            }
-        }
+        mList[rowIt.value()] = sync;
+        sendDataChanged(rowIt.value());
     }
     else
     {
         if (sync->getType() == mSyncType)
         {
             beginInsertRows(QModelIndex(), mList.size(), mList.size());
+            mRowByBackupId.insert(sync->backupId(), mList.size());
             mList.append(sync);
             endInsertRows();
         }
@@ -442,39 +446,64 @@ void SyncItemModel::insertSync(std::shared_ptr<SyncSettings> sync)
 
 void SyncItemModel::updateSyncStats(std::shared_ptr<::mega::MegaSyncStats> stats)
 {
-    for (auto it = mList.cbegin(); it != mList.cend(); ++it)
+    if (mRowByBackupId.contains(stats->getBackupId()))
     {
-        if ((*it)->backupId() == stats->getBackupId())
+        mStatsChangedBackupIds.insert(stats->getBackupId());
+        if (!mStatsChangedTimer.isActive())
         {
-            int pos = it - mList.cbegin();
-            sendDataChanged(pos);
-            break;
+            mStatsChangedTimer.start();
         }
     }
 }
 
-void SyncItemModel::removeSync(std::shared_ptr<SyncSettings> sync)
+void SyncItemModel::sendStatsChanged()
 {
-    if (mList.contains(sync))
+    // Only the columns that show stats change, a single range is cheaper to repaint than a
+    // signal for every sync
+    int firstRow = mList.size();
+    int lastRow = -1;
+    for (auto backupId : qAsConst(mStatsChangedBackupIds))
     {
-        for (auto it = mList.cbegin(); it != mList.cend(); ++it)
+        auto rowIt = mRowByBackupId.constFind(backupId);
+        if (rowIt != mRowByBackupId.constEnd())
         {
-            if ((*it) == sync)
-            {
-                int pos = static_cast<int>(std::distance(mList.cbegin(), it));
-                if (pos >= 0)
-                {
-                    beginRemoveRows(QModelIndex(), pos, pos);
-                    mList.removeOne((*it));
-                    endRemoveRows();
-                }
-                break;
-            }
+            firstRow = std::min(firstRow, rowIt.value());
+            lastRow = std::max(lastRow, rowIt.value());
         }
     }
+    mStatsChangedBackupIds.clear();
+
+    if (lastRow >= 0)
+    {
+        emit dataChanged(index(firstRow, Column::STATE, QModelIndex()),
+                         index(lastRow, Column::UPLOADS, QModelIndex()),
+                         QVector<int>() << Qt::DisplayRole);
+    }
+}
+
+void SyncItemModel::removeSync(std::shared_ptr<SyncSettings> sync)
+{
+    auto rowIt = mRowByBackupId.constFind(sync->backupId());
+    if (rowIt != mRowByBackupId.constEnd() && mList.at(rowIt.value()) == sync)
+    {
+        const int pos = rowIt.value();
+        beginRemoveRows(QModelIndex(), pos, pos);
+        mList.removeAt(pos);
+        mRowByBackupId.remove(sync->backupId());
+        updateRows(pos);
+        endRemoveRows();
+    }
     emit syncUpdateFinished(sync);
 }
 
+void SyncItemModel::updateRows(int firstRow)
+{
+    for (int row = firstRow; row < mList.size(); ++row)
+    {
+        mRowByBackupId.insert(mList.at(row)->backupId(), row);
+    }
+}
+
 void SyncItemModel::sendDataChanged(int row)
 {
     emit dataChanged(index(row, Column::ENABLED, QModelIndex()),
@@ -482,7 +511,7 @@ void SyncItemModel::sendDataChanged(int row)
                      QVector<int>() << Qt::CheckStateRole << Qt::DecorationRole << Qt::ToolTipRole);
 }
 
-QList<std::shared_ptr<SyncSettings>> SyncItemModel::getList() const
+const QList<std::shared_ptr<SyncSettings>>& SyncItemModel::getList() const
 {
     return mList;
 }
@@ -490,6 +519,9 @@ QList<std::shared_ptr<SyncSettings>> SyncItemModel::getList() const
 void SyncItemModel::setList(QList<std::shared_ptr<SyncSettings>> list)
 {
     mList = list;
+    mRowByBackupId.clear();
+    mRowByBackupId.reserve(mList.size());
+    updateRows(0);
 }
 
 void SyncItemModel::setMode(mega::MegaSync::SyncType syncType)
@@ -5,7 +5,10 @@
 
 #include <QAbstractItemModel>
 #include <QCollator>
+#include <QHash>
+#include <QSet>
 #include <QSortFilterProxyModel>
+#include <QTimer>
 
 #include <memory>
 
@@ -65,7 +68,7 @@ signals:
     void syncUpdateFinished(std::shared_ptr<SyncSettings> syncSetting);
 
 protected:
-    QList<std::shared_ptr<SyncSettings>> getList() const;
+    const QList<std::shared_ptr<SyncSettings>>& getList() const;
     void setList(QList<std::shared_ptr<SyncSettings>> list);
     mega::MegaSync::SyncType getMode();
     void setMode(mega::MegaSync::SyncType syncType);
@@ -77,10 +80,18 @@ private slots:
     void insertSync(std::shared_ptr<SyncSettings> sync);
     void updateSyncStats(std::shared_ptr<::mega::MegaSyncStats> stats);
     void removeSync(std::shared_ptr<SyncSettings> sync);
+    void sendStatsChanged();
 
 private:
     QList<std::shared_ptr<SyncSettings>> mList;
+    // Row of each sync in mList
+    QHash<mega::MegaHandle, int> mRowByBackupId;
     mega::MegaSync::SyncType mSyncType;
+    // Stats received since the last repaint, they are sent together
+    QSet<mega::MegaHandle> mStatsChangedBackupIds;
+    QTimer mStatsChangedTimer;
+
+    void updateRows(int firstRow);
 
     virtual void sendDataChanged(int row);
     QVariant getColumnStats(int role,
@@ -18,6 +18,8 @@ set(DESKTOP_APP_SYNCS_HEADERS
     syncs/control/SyncController.h
     syncs/control/SyncInfo.h
     syncs/control/SyncSettings.h
+    syncs/control/SyncStatsRecorder.h
+    syncs/control/SyncStatsTimeSeries.h
     syncs/control/CreateRemoveSyncsManager.h
     syncs/control/CreateRemoveBackupsManager.h
 )
@@ -41,6 +43,8 @@ set(DESKTOP_APP_SYNCS_SOURCES
     syncs/control/SyncInfo.cpp
     syncs/control/SyncController.cpp
     syncs/control/SyncSettings.cpp
+    syncs/control/SyncStatsRecorder.cpp
+    syncs/control/SyncStatsTimeSeries.cpp
     syncs/control/CreateRemoveSyncsManager.cpp
     syncs/control/CreateRemoveBackupsManager.cpp
 )
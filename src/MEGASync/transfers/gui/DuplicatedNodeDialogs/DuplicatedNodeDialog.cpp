@@ -2,6 +2,7 @@
 
 #include "DuplicatedNodeItem.h"
 #include "EventUpdater.h"
+#include "FolderNameIndex.h"
 #include "MegaApplication.h"
 #include "ui_DuplicatedNodeDialog.h"
 #include "WordWrapLabel.h"
@@ -51,15 +52,6 @@ DuplicatedNodeDialog::~DuplicatedNodeDialog()
 
 void DuplicatedNodeDialog::checkUploads(QQueue<QString> &nodePaths, std::shared_ptr<mega::MegaNode> parentNode)
 {
-    std::unique_ptr<mega::MegaNodeList>nodes(MegaSyncApp->getMegaApi()->getChildren(parentNode.get()));
-    QHash<QString, mega::MegaNode*> nodesOnCloudDrive;
-
-    for(int index = 0; index < nodes->size(); ++index)
-    {
-        QString nodeName(QString::fromUtf8(nodes->get(index)->getName()));
-        nodesOnCloudDrive.insert(nodeName.toLower(), nodes->get(index));
-    }
-
     QList<std::shared_ptr<DuplicatedNodeInfo>> resolvedInfoList;
     QList<std::shared_ptr<DuplicatedNodeInfo>> filesConflictedInfoList;
     QList<std::shared_ptr<DuplicatedNodeInfo>> foldersConflictedInfoList;
@@ -87,11 +79,10 @@ void DuplicatedNodeDialog::checkUploads(QQueue<QString> &nodePaths, std::shared_
         info->setParentNode(parentNode);
 
         QString nodeToUploadName(localPathInfo.fileName());
-        auto node(nodesOnCloudDrive.value(nodeToUploadName.toLower()));
+        auto node(FolderNameIndex::instance().getNodeByName(parentNode.get(), nodeToUploadName));
         if(node)
         {
-            std::shared_ptr<mega::MegaNode> smartNode(node->copy());
-            info->setRemoteConflictNode(smartNode);
+            info->setRemoteConflictNode(node);
             info->setHasConflict(true);
             info->setName(nodeToUploadName);
 
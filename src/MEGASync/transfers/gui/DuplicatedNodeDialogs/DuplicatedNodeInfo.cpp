@@ -67,7 +67,9 @@ const QString &DuplicatedNodeInfo::getNewName()
     {
         if(mNewName.isEmpty() && mRemoteConflictNode)
         {
-            mNewName = Utilities::getNonDuplicatedNodeName(mRemoteConflictNode.get(), mParentNode.get(), mName, false, mChecker->getCheckedNames());
+            // The name shown is the one uploaded
+            mNewName = mDisplayNewName.isEmpty() ? Utilities::getNonDuplicatedNodeName(mRemoteConflictNode.get(), mParentNode.get(), mName, false, mChecker->getCheckedNames())
+                                                 : mDisplayNewName;
             auto& checkedNames = mChecker->getCheckedNames();
             checkedNames.removeOne(mName);
             checkedNames.append(mNewName);
@@ -81,7 +83,8 @@ const QString &DuplicatedNodeInfo::getDisplayNewName()
 {
     if(mDisplayNewName.isEmpty())
     {
-        mDisplayNewName = Utilities::getNonDuplicatedNodeName(mRemoteConflictNode.get(), mParentNode.get(), mName, false, mChecker->getCheckedNames());
+        mDisplayNewName = mNewName.isEmpty() ? Utilities::getNonDuplicatedNodeName(mRemoteConflictNode.get(), mParentNode.get(), mName, false, mChecker->getCheckedNames())
+                                             : mNewName;
     }
 
     return mDisplayNewName;
@@ -357,6 +357,12 @@ void InfoDialogTransferDelegateWidget::updateFinishedTime()
     mUi->lElapsedTime->setText(Utilities::getAddedTimeString(finishedTime));
 }
 
+QRegion InfoDialogTransferDelegateWidget::dynamicRegion() const
+{
+    return getWidgetsRegion({mUi->pbTransfer, mUi->lSpeed, mUi->bClockDown, mUi->lRemainingTime,
+                             mUi->lElapsedTime});
+}
+
 QSize InfoDialogTransferDelegateWidget::minimumSizeHint() const
 {
     return FullRect.size();
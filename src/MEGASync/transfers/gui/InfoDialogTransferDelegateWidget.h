@@ -42,6 +42,8 @@ public:
     void loadDefaultTransferIcon() {}
     void updateAnimation() {}
 
+    QRegion dynamicRegion() const override;
+
     QSize minimumSizeHint() const override;
     QSize sizeHint() const override;
 
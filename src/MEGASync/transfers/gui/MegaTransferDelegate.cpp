@@ -2,6 +2,7 @@
 
 #include "MegaApplication.h"
 #include "MegaDelegateHoverManager.h"
+#include "MegaTransferView.h"
 #include "TransferBaseDelegateWidget.h"
 #include "TransfersModel.h"
 
@@ -10,17 +11,41 @@
 #include <QPainter>
 #include <QScrollBar>
 #include <QSortFilterProxyModel>
+#include <QTimer>
 #include <QToolTip>
 
 using namespace mega;
 
+namespace
+{
+// Rows kept as pixmaps, a few screens of the biggest transfer list
+constexpr int MAX_CACHED_ROWS = 200;
+// Progress, speed and time of a row are repainted at most every MIN_DYNAMIC_REPAINT_INTERVAL_MS
+constexpr int MIN_DYNAMIC_REPAINT_INTERVAL_MS = 200;
+// Relative times like "1 minute ago" depend on the current time, not only on the transfer data
+constexpr int MAX_FRAME_AGE_MS = 30000;
+}
+
 MegaTransferDelegate::MegaTransferDelegate(TransfersSortFilterProxyBaseModel* model,  QAbstractItemView* view)
     : QStyledItemDelegate(view),
       mProxyModel (model),
       mSourceModel (qobject_cast<TransfersModel*>(
                         mProxyModel->sourceModel())),
-      mView (view)
+      mView (view),
+      mRowsCache(MAX_CACHED_ROWS),
+      mDelayedRepaintTimer(new QTimer(this))
 {
+    mDelayedRepaintTimer->setSingleShot(true);
+    mDelayedRepaintTimer->setInterval(MIN_DYNAMIC_REPAINT_INTERVAL_MS);
+    connect(mDelayedRepaintTimer, &QTimer::timeout, this, [this]()
+    {
+        mView->viewport()->update();
+    });
+
+    connect(mProxyModel, &QAbstractItemModel::modelReset, this, &MegaTransferDelegate::invalidateCache);
+    connect(mProxyModel, &QAbstractItemModel::layoutChanged, this, &MegaTransferDelegate::invalidateCache);
+
+    mView->installEventFilter(this);
 }
 
 MegaTransferDelegate::~MegaTransferDelegate()
@@ -39,12 +64,6 @@ void MegaTransferDelegate::paint(QPainter *painter, const QStyleOptionViewItem &
         auto transferItem (qvariant_cast<TransferItem>(index.data(Qt::DisplayRole)));
         auto data = transferItem.getTransferData();
 
-        TransferBaseDelegateWidget* w (getTransferItemWidget(index, option.rect.size()));
-        if(!w)
-        {
-            return;
-        }
-
 #ifdef Q_OS_MACOS
         auto width = mView->width();
         width -= mView->contentsMargins().left();
@@ -57,6 +76,46 @@ void MegaTransferDelegate::paint(QPainter *painter, const QStyleOptionViewItem &
         auto width (option.rect.width());
 #endif
 
+        // Rows are painted from their last frame when the painted data did not change, and only
+        // their progress, speed and time are repainted when those are the only changes
+        auto useCache (data && canUseCache(painter));
+        auto pixelRatio (painter->device()->devicePixelRatioF());
+        RowCache* rowCache (useCache ? mRowsCache.object(data->mTag) : nullptr);
+        bool fullRender (true);
+
+        if(rowCache && rowCache->frame.size() == QSize(width, height) * pixelRatio
+           && rowCache->frame.devicePixelRatioF() == pixelRatio
+           && rowCache->state == option.state
+           && !rowCache->lastRender.hasExpired(MAX_FRAME_AGE_MS))
+        {
+            auto changes (data->getChanges(*rowCache->data));
+            if(changes == TransferData::CHANGE_NONE)
+            {
+                painter->drawPixmap(pos, rowCache->frame);
+                return;
+            }
+            else if(!(changes & ~TransferData::DYNAMIC_CHANGES_MASK))
+            {
+                if(!rowCache->lastRender.hasExpired(MIN_DYNAMIC_REPAINT_INTERVAL_MS))
+                {
+                    painter->drawPixmap(pos, rowCache->frame);
+                    if(!mDelayedRepaintTimer->isActive())
+                    {
+                        mDelayedRepaintTimer->start();
+                    }
+                    return;
+                }
+
+                fullRender = false;
+            }
+        }
+
+        TransferBaseDelegateWidget* w (getTransferItemWidget(index, option.rect.size()));
+        if(!w)
+        {
+            return;
+        }
+
         // Move if position changed
         if (w->pos() != pos)
         {
@@ -74,11 +133,50 @@ void MegaTransferDelegate::paint(QPainter *painter, const QStyleOptionViewItem &
             w->updateUi(data, row);
         }
 
-        painter->save();
-        painter->translate(pos);
-        w->render(option, painter, QRegion(0, 0, width, height));
+        if(!useCache)
+        {
+            painter->save();
+            painter->translate(pos);
+            w->render(option, painter, QRegion(0, 0, width, height));
+            painter->restore();
+            return;
+        }
+
+        auto dynamicRegion (w->dynamicRegion());
+        if(dynamicRegion.isEmpty() || (rowCache && rowCache->dynamicRegion != dynamicRegion))
+        {
+            fullRender = true;
+        }
+
+        if(fullRender)
+        {
+            rowCache = new RowCache();
+            rowCache->frame = QPixmap(QSize(width, height) * pixelRatio);
+            rowCache->frame.setDevicePixelRatio(pixelRatio);
+            rowCache->frame.fill(Qt::transparent);
+            rowCache->state = option.state;
+            rowCache->dynamicRegion = dynamicRegion;
+
+            QPainter framePainter(&rowCache->frame);
+            w->render(option, &framePainter, QRegion(0, 0, width, height));
+            framePainter.end();
+
+            mRowsCache.insert(data->mTag, rowCache);
+        }
+        else
+        {
+            QPainter framePainter(&rowCache->frame);
+            framePainter.setClipRegion(dynamicRegion);
+            framePainter.setCompositionMode(QPainter::CompositionMode_Source);
+            framePainter.fillRect(dynamicRegion.boundingRect(), Qt::transparent);
+            framePainter.setCompositionMode(QPainter::CompositionMode_SourceOver);
+            w->render(option, &framePainter, dynamicRegion);
+        }
+
+        rowCache->data.reset(new TransferData(data.data()));
+        rowCache->lastRender.start();
 
-        painter->restore();
+        painter->drawPixmap(pos, rowCache->frame);
     }
     else
     {
@@ -139,11 +237,42 @@ TransferBaseDelegateWidget *MegaTransferDelegate::getTransferItemWidget(const QM
         }
 
         item->setCurrentIndex(index);
+
+        // Rows painted from the cache do not update their widget, which may show another transfer
+        auto transferItem (qvariant_cast<TransferItem>(index.data(Qt::DisplayRole)));
+        auto data (transferItem.getTransferData());
+        if(data && (!item->getData() || item->getData()->mTag != data->mTag))
+        {
+            item->updateUi(data, index.row());
+        }
     }
     
     return item;
 }
 
+bool MegaTransferDelegate::canUseCache(QPainter* painter) const
+{
+    // Drag pixmaps and the rows being dragged are painted differently, see the delegate widgets
+    auto view (dynamic_cast<MegaTransferView*>(mView));
+    return painter->device() == mView->viewport()
+           && (!view || view->state() != QAbstractItemView::DraggingState);
+}
+
+void MegaTransferDelegate::invalidateRow(const QModelIndex& index)
+{
+    auto transferItem (qvariant_cast<TransferItem>(index.data(Qt::DisplayRole)));
+    auto data (transferItem.getTransferData());
+    if(data)
+    {
+        mRowsCache.remove(data->mTag);
+    }
+}
+
+void MegaTransferDelegate::invalidateCache()
+{
+    mRowsCache.clear();
+}
+
 bool MegaTransferDelegate::editorEvent(QEvent* event, QAbstractItemModel*,
                                         const QStyleOptionViewItem& option,
                                         const QModelIndex& index)
@@ -211,6 +340,28 @@ bool MegaTransferDelegate::helpEvent(QHelpEvent* event, QAbstractItemView* view,
     return QStyledItemDelegate::helpEvent(event, view, option, index);
 }
 
+bool MegaTransferDelegate::eventFilter(QObject* watched, QEvent* event)
+{
+    if(watched == mView)
+    {
+        switch(event->type())
+        {
+            case QEvent::StyleChange:
+            case QEvent::PaletteChange:
+            case QEvent::FontChange:
+            case QEvent::LanguageChange:
+            {
+                invalidateCache();
+                break;
+            }
+            default:
+                break;
+        }
+    }
+
+    return QStyledItemDelegate::eventFilter(watched, event);
+}
+
 QSize MegaTransferDelegate::sizeHint(const QStyleOptionViewItem&,
                                       const QModelIndex&) const
 {
@@ -223,6 +374,7 @@ void MegaTransferDelegate::onHoverLeave(const QModelIndex& index, const QRect& r
     if(currentRow)
     {
         currentRow->mouseHoverTransfer(false, QPoint());
+        invalidateRow(index);
     }
 }
 
@@ -232,6 +384,7 @@ void MegaTransferDelegate::onHoverEnter(const QModelIndex& index, const QRect& r
     if(currentRow)
     {
         currentRow->mouseHoverTransfer(true, QPoint());
+        invalidateRow(index);
     }
 }
 
@@ -256,6 +409,7 @@ void MegaTransferDelegate::onHoverMove(const QModelIndex &index, const QRect &re
                 }
             }
 
+            invalidateRow(index);
             mView->update(rect);
         }
         else
@@ -5,9 +5,15 @@
 
 #include <QStyledItemDelegate>
 #include <QAbstractItemView>
+#include <QCache>
+#include <QElapsedTimer>
+#include <QPixmap>
+
+#include <memory>
 
 class TransfersSortFilterProxyBaseModel;
 class TransferBaseDelegateWidget;
+class QTimer;
 
 class MegaTransferDelegate : public QStyledItemDelegate
 {
@@ -19,11 +25,14 @@ public:
 
     QSize sizeHint(const QStyleOptionViewItem&, const QModelIndex&) const override;
 
+    void invalidateCache();
+
 protected:
     void paint(QPainter *painter, const QStyleOptionViewItem &option, const QModelIndex &index) const override;
     bool event(QEvent *event) override;
     bool editorEvent(QEvent *event, QAbstractItemModel *model, const QStyleOptionViewItem &option, const QModelIndex &index) override;
     bool helpEvent(QHelpEvent *event, QAbstractItemView *view, const QStyleOptionViewItem &option, const QModelIndex &index) override;
+    bool eventFilter(QObject *watched, QEvent *event) override;
 
 protected slots:
     void onHoverLeave(const QModelIndex& index, const QRect& rect);
@@ -31,12 +40,26 @@ protected slots:
     void onHoverMove(const QModelIndex& index, const QRect& rect, const QPoint& point);
 
 private:
+    // Last frame painted for a transfer and the data it was painted with
+    struct RowCache
+    {
+        QPixmap frame;
+        std::unique_ptr<TransferData> data;
+        QStyle::State state;
+        QRegion dynamicRegion;
+        QElapsedTimer lastRender;
+    };
+
     TransferBaseDelegateWidget *getTransferItemWidget(const QModelIndex &index, const QSize &size) const;
+    bool canUseCache(QPainter *painter) const;
+    void invalidateRow(const QModelIndex& index);
 
     TransfersSortFilterProxyBaseModel* mProxyModel;
     TransfersModel* mSourceModel;
     mutable QVector<TransferBaseDelegateWidget*> mTransferItems;
     QAbstractItemView* mView;
+    mutable QCache<TransferTag, RowCache> mRowsCache;
+    QTimer* mDelayedRepaintTimer;
 };
 
 #endif // MEGATRANSFERDELEGATE_H
@@ -128,6 +128,7 @@ private:
 
     void showOpeningFileError();
 
+    friend class MegaTransferDelegate;
     friend class TransferManagerDelegateWidget;
 
     bool mDisableLink;
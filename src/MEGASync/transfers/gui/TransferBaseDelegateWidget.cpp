@@ -56,7 +56,28 @@ void TransferBaseDelegateWidget::setCurrentIndex(const QModelIndex &currentIndex
 
 void TransferBaseDelegateWidget::render(const QStyleOptionViewItem&, QPainter *painter, const QRegion &sourceRegion)
 {
-    QWidget::render(painter,QPoint(0,0),sourceRegion);
+    //The top left corner of the source region is rendered at the target offset
+    QWidget::render(painter, sourceRegion.boundingRect().topLeft(), sourceRegion);
+}
+
+QRegion TransferBaseDelegateWidget::dynamicRegion() const
+{
+    return QRegion();
+}
+
+QRegion TransferBaseDelegateWidget::getWidgetsRegion(const QList<QWidget*>& widgets) const
+{
+    QRegion region;
+
+    foreach(auto widget, widgets)
+    {
+        if(widget->isVisibleTo(this))
+        {
+            region += QRect(widget->mapTo(this, QPoint(0,0)), widget->size());
+        }
+    }
+
+    return region;
 }
 
 bool TransferBaseDelegateWidget::setActionTransferIcon(QToolButton *button, const QString &iconName)
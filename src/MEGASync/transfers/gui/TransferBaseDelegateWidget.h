@@ -54,6 +54,8 @@ public:
     void setCurrentIndex(const QModelIndex &currentIndex);
 
     virtual void render(const QStyleOptionViewItem &, QPainter *painter, const QRegion &sourceRegion);
+    // Region repainted when only the progress, speed or time changed. Empty to always repaint the whole row
+    virtual QRegion dynamicRegion() const;
 
 signals:
     void retryTransfer();
@@ -72,6 +74,7 @@ protected:
     QString getState(TRANSFER_STATES state);
 
     int getNameAvailableSize(QWidget* nameContainer, QWidget* syncLabel, QSpacerItem* spacer);
+    QRegion getWidgetsRegion(const QList<QWidget*>& widgets) const;
     QString getErrorText();
 
     virtual void reset();
@@ -25,6 +25,11 @@ const TransferData::TransferTypes TransferData::TYPE_MASK = TransferData::Transf
         TransferData::TransferType::TRANSFER_UPLOAD |
         TransferData::TransferType::TRANSFER_DOWNLOAD);
 
+const TransferData::TransferChanges TransferData::DYNAMIC_CHANGES_MASK = TransferData::TransferChanges (
+        TransferData::TransferChange::CHANGE_PROGRESS |
+        TransferData::TransferChange::CHANGE_SPEED |
+        TransferData::TransferChange::CHANGE_TIME);
+
 const TransferData::TransferStates TransferData::FINISHED_STATES_MASK = TransferData::TransferStates (
         TransferData::TransferState::TRANSFER_COMPLETED
         | TransferData::TransferState::TRANSFER_CANCELLED
@@ -136,18 +141,56 @@ void TransferData::update(mega::MegaTransfer* transfer)
 
 bool TransferData::hasChanged(QExplicitlySharedDataPointer<TransferData> data)
 {
-    bool result = true;
+    auto changes (getChanges(*data));
+
+    return changes.testFlag(CHANGE_STATE) || changes.testFlag(CHANGE_PRIORITY) ||
+           (mTransferredBytes != data->mTransferredBytes) ||
+           data->mState == TransferData::TransferState::TRANSFER_COMPLETING;
+}
 
-    if(mState == data->mState && mPriority == data->mPriority)
+TransferData::TransferChanges TransferData::getChanges(const TransferData& previous) const
+{
+    TransferChanges changes (CHANGE_NONE);
+
+    if(mState != previous.mState)
     {
-        if(mTransferredBytes == data->mTransferredBytes &&
-                data->mState != TransferData::TransferState::TRANSFER_COMPLETING)
-        {
-            result = false;
-        }
+        changes |= CHANGE_STATE;
     }
 
-    return result;
+    if(mPriority != previous.mPriority)
+    {
+        changes |= CHANGE_PRIORITY;
+    }
+
+    if(mTag != previous.mTag || mType != previous.mType || mFilename != previous.mFilename
+       || mFileType != previous.mFileType || mPath != previous.mPath)
+    {
+        changes |= CHANGE_NAME;
+    }
+
+    if(mErrorCode != previous.mErrorCode || mErrorValue != previous.mErrorValue
+       || mTemporaryError != previous.mTemporaryError
+       || mFailedTransfer != previous.mFailedTransfer)
+    {
+        changes |= CHANGE_ERROR;
+    }
+
+    if(mTransferredBytes != previous.mTransferredBytes || mTotalSize != previous.mTotalSize)
+    {
+        changes |= CHANGE_PROGRESS;
+    }
+
+    if(mSpeed != previous.mSpeed || mMeanSpeed != previous.mMeanSpeed)
+    {
+        changes |= CHANGE_SPEED;
+    }
+
+    if(mRemainingTime != previous.mRemainingTime || mFinishedTime != previous.mFinishedTime)
+    {
+        changes |= CHANGE_TIME;
+    }
+
+    return changes;
 }
 
 void TransferData::removeFailedTransfer()
@@ -49,6 +49,20 @@ public:
     };
     Q_DECLARE_FLAGS(TransferTypes, TransferType)
 
+    // Fields that changed between two snapshots of the same transfer, as painted by the delegates
+    enum TransferChange
+    {
+        CHANGE_NONE           = 0,
+        CHANGE_STATE          = 1 << 0,
+        CHANGE_PRIORITY       = 1 << 1,
+        CHANGE_NAME           = 1 << 2,
+        CHANGE_ERROR          = 1 << 3,
+        CHANGE_PROGRESS       = 1 << 4,
+        CHANGE_SPEED          = 1 << 5,
+        CHANGE_TIME           = 1 << 6,
+    };
+    Q_DECLARE_FLAGS(TransferChanges, TransferChange)
+
     static const TransferStates FINISHED_STATES_MASK;
     static const TransferStates PAUSABLE_STATES_MASK;
     static const TransferStates CANCELABLE_STATES_MASK;
@@ -59,6 +73,9 @@ public:
 
     static const TransferTypes TYPE_MASK;
 
+    // Changes which only modify the progress, speed and time widgets of a row
+    static const TransferChanges DYNAMIC_CHANGES_MASK;
+
     TransferData(mega::MegaTransfer* transfer = nullptr){update(transfer);}
     ~TransferData(){}
 
@@ -78,6 +95,7 @@ public:
 
     void update(mega::MegaTransfer* transfer);
     bool hasChanged(QExplicitlySharedDataPointer<TransferData> data);
+    TransferChanges getChanges(const TransferData& previous) const;
     void removeFailedTransfer();
 
     void setPauseResume(bool isPaused);
@@ -154,6 +172,7 @@ Q_DECLARE_TYPEINFO(TransferData, Q_MOVABLE_TYPE);
 Q_DECLARE_METATYPE(TransferData)
 Q_DECLARE_OPERATORS_FOR_FLAGS(TransferData::TransferStates)
 Q_DECLARE_OPERATORS_FOR_FLAGS(TransferData::TransferTypes)
+Q_DECLARE_OPERATORS_FOR_FLAGS(TransferData::TransferChanges)
 
 class TransferItem
 {
@@ -526,6 +526,13 @@ void TransferManagerDelegateWidget::render(const QStyleOptionViewItem &option, Q
     TransferBaseDelegateWidget::render(option, painter, sourceRegion);
 }
 
+QRegion TransferManagerDelegateWidget::dynamicRegion() const
+{
+    //The status label is included as it changes from "Starting" when the first bytes are transferred
+    return getWidgetsRegion({mUi->lItemStatus, mUi->lDone, mUi->lTotal, mUi->wProgressBar,
+                             mUi->bItemSpeed, mUi->lItemTime});
+}
+
 void TransferManagerDelegateWidget::mouseDoubleClickEvent(QMouseEvent *event)
 {
     emit openTransfer();
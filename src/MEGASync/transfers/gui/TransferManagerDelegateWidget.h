@@ -24,6 +24,7 @@ public:
     ActionHoverType mouseHoverTransfer(bool isHover, const QPoint &pos) override;
 
     void render(const QStyleOptionViewItem &option, QPainter *painter, const QRegion &sourceRegion) override;
+    QRegion dynamicRegion() const override;
 
     void setColumnManager(QPointer<TransferWidgetColumnsManager> columnManager);
 
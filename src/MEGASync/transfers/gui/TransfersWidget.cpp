@@ -340,6 +340,12 @@ void TransfersWidget::mouseRelease(const QPoint &point)
 void TransfersWidget::setCurrentTab(TM_TAB tab)
 {
     mCurrentTab = tab;
+
+    //Rows show different texts and columns depending on the tab
+    if(tDelegate)
+    {
+        tDelegate->invalidateCache();
+    }
 }
 
 TransfersWidget::TM_TAB TransfersWidget::getCurrentTab()
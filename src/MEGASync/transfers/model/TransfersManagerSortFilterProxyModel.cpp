@@ -58,7 +58,7 @@ void TransfersManagerSortFilterProxyModel::sort(int sortCriterion, Qt::SortOrder
     }
 
     emit layoutAboutToBeChanged();
-    QFuture<void> sorting = QtConcurrent::run([this]()
+    QFuture<void> sorting = mThreadPool->run(ThreadPool::Priority::INTERACTIVE, [this]()
     {
         startProcessingInOtherThread();
         if(sortOrder() == mSortOrder)
@@ -123,7 +123,7 @@ void TransfersManagerSortFilterProxyModel::invalidateModel()
     }
 
     emit layoutAboutToBeChanged();
-    QFuture<void> filtered = QtConcurrent::run([this](){
+    QFuture<void> filtered = mThreadPool->run(ThreadPool::Priority::INTERACTIVE, [this](){
         startProcessingInOtherThread();
 
         invalidate();
@@ -412,7 +412,7 @@ bool TransfersManagerSortFilterProxyModel::lessThan(const QModelIndex &left, con
 }
 
 
-//It is called from a QtConcurrent thread
+//It is called from a thread pool thread
 void TransfersManagerSortFilterProxyModel::onRowsAboutToBeRemoved(const QModelIndex &parent, int first, int last)
 {
    bool searchRowsRemoved(false);
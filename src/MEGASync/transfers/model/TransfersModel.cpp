@@ -818,6 +818,7 @@ TransfersModel::TransfersModel():
     QAbstractItemModel(),
     mMegaApi(MegaSyncApp->getMegaApi()),
     mPreferences(Preferences::instance()),
+    mThreadPool(ThreadPoolSingleton::getInstance()),
     mTransfersProcessChanged(0),
     mUpdateMostPriorityTransfer(0),
     mUiBlockedCounter(0),
@@ -1049,7 +1050,7 @@ void TransfersModel::onProcessTransfers()
                 setUiBlockedMode(true);
                 asynchronousProcessed = true;
 
-                auto future = QtConcurrent::run([this](){
+                auto future = mThreadPool->run(ThreadPool::Priority::NORMAL, [this](){
                     if(mModelMutex.tryLock())
                     {
                         blockModelSignals(true);
@@ -1105,7 +1106,8 @@ void TransfersModel::onProcessTransfers()
                 {
                     asynchronousProcessed = true;
 
-                    auto future = QtConcurrent::run([this, containsTransfersToUpdate](){
+                    auto future = mThreadPool->run(ThreadPool::Priority::NORMAL,
+                                                   [this, containsTransfersToUpdate](){
                         if(mModelMutex.tryLock())
                         {
                             blockModelSignals(true);
@@ -1489,10 +1491,10 @@ void TransfersModel::openFolder(const QFileInfo& info)
 {
     if(info.exists())
     {
-        QtConcurrent::run([this, info]
+        mThreadPool->push([this, info]
         {
             emit showInFolderFinished(Platform::getInstance()->showInFolder(info.filePath()));
-        });
+        }, ThreadPool::Priority::INTERACTIVE);
     }
     else
     {
@@ -1518,7 +1520,7 @@ void TransfersModel::retryTransfers(const QMultiMap<unsigned long long, QExplici
 {
     //This method receives a list of uploads or downloads, never mixed
 
-    QtConcurrent::run([transfersToRetry, this]()
+    mThreadPool->push([transfersToRetry, this]()
     {
         foreach(auto& appData, transfersToRetry.uniqueKeys())
         {
@@ -2039,7 +2041,8 @@ void TransfersModel::clearTransfers(const QMap<QModelIndex, QExplicitlySharedDat
             setUiBlockedMode(true);
             pauseModelProcessing(true);
 
-            auto future = QtConcurrent::run([this, uploads, downloads]()
+            auto future = mThreadPool->run(ThreadPool::Priority::INTERACTIVE,
+                                           [this, uploads, downloads]()
             {
                 blockModelSignals(true);
                 performClearTransfers(uploads, downloads);
@@ -2113,14 +2116,14 @@ void TransfersModel::pauseTransfers(const QModelIndexList& indexes, bool pauseSt
 
         if(indexes.size() > PAUSE_RESUME_THRESHOLD_THREAD)
         {
-            QtConcurrent::run([this, indexes, pauseState]()
+            mThreadPool->push([this, indexes, pauseState]()
             {
                 blockModelSignals(true);
                 performPauseResumeVisibleTransfers(indexes, pauseState, false);
                 blockModelSignals(false);
 
                 emit pauseStateChanged(mAreAllPaused);
-            });
+            }, ThreadPool::Priority::INTERACTIVE);
         }
         else
         {
@@ -2170,14 +2173,14 @@ void TransfersModel::pauseResumeAllTransfers(bool state)
     //The final count can be +- 30 transfers
     if(activeTransfers > PAUSE_RESUME_THRESHOLD_THREAD)
     {
-        QtConcurrent::run([this, activeTransfers]()
+        mThreadPool->push([this, activeTransfers]()
         {
             blockModelSignals(true);
             auto tagsUpdated = performPauseResumeAllTransfers(activeTransfers, false);
             blockModelSignals(false);
 
             setUiBlockedModeByCounter(tagsUpdated);
-        });
+        }, ThreadPool::Priority::INTERACTIVE);
     }
     else
     {
@@ -2490,7 +2493,7 @@ void TransfersModel::setUiBlockedMode(bool state)
         {
             if(!mRowsToCancel.isEmpty() || !mFailedTransferToClear.isEmpty())
             {
-                auto task = QtConcurrent::run([this]()
+                auto task = mThreadPool->run(ThreadPool::Priority::INTERACTIVE, [this]()
                 {
                     if(mModelMutex.tryLock())
                     {
@@ -2618,7 +2621,7 @@ void TransfersModel::mostPriorityTransferMayChanged(bool state)
 
 void TransfersModel::askForMostPriorityTransfer()
 {
-    auto task = QtConcurrent::run([]()
+    auto task = mThreadPool->run(ThreadPool::Priority::NORMAL, []()
     {
         std::unique_ptr<MegaTransfer> nextUTransfer(MegaSyncApp->getMegaApi()->getFirstTransfer(MegaTransfer::TYPE_UPLOAD));
         auto UTag = nextUTransfer ? nextUTransfer->getTag() : -1;
@@ -4,6 +4,7 @@
 #include "megaapi.h"
 #include "Preferences.h"
 #include "QTMegaTransferListener.h"
+#include "ThreadPool.h"
 #include "TransferItem.h"
 #include "TransferMetaData.h"
 
@@ -11,7 +12,6 @@
 #include <QFutureWatcher>
 #include <QLinkedList>
 #include <QReadWriteLock>
-#include <QtConcurrent/QtConcurrent>
 
 #include <memory>
 
@@ -370,9 +370,15 @@ private:
 
     void updateMetaDataBeforeRetryingTransfers(std::shared_ptr<mega::MegaTransfer> transfer);
 
+#ifdef DESKTOP_APP_BENCHMARKS
+    // Feeds the worker with generated transfers, bypassing the SDK listener
+    friend class TransfersModelBenchmark;
+#endif
+
 private:
     mega::MegaApi* mMegaApi;
     std::shared_ptr<Preferences> mPreferences;
+    ThreadPool* mThreadPool;
     QThread* mTransferEventThread;
     TransferThread* mTransferEventWorker;
     QTimer mProcessTransfersTimer;
@@ -0,0 +1,200 @@
+#include "BenchmarkRunner.h"
+
+#include "Version.h"
+
+#include <QCoreApplication>
+#include <QDateTime>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QSysInfo>
+#include <QTextStream>
+
+#include <algorithm>
+#include <numeric>
+#include <vector>
+
+void BenchmarkIteration::start()
+{
+    mTimer.start();
+}
+
+void BenchmarkIteration::stop()
+{
+    mElapsedNs = mTimer.nsecsElapsed();
+}
+
+qint64 BenchmarkIteration::elapsedNs() const
+{
+    return mElapsedNs;
+}
+
+double BenchmarkResult::itemsPerSecond() const
+{
+    return medianNs > 0 ? static_cast<double>(items) * 1e9 / static_cast<double>(medianNs) : 0.0;
+}
+
+void BenchmarkRunner::add(const QString& name, qint64 items, BenchmarkBody body)
+{
+    mBenchmarks.append({name, items, std::move(body)});
+}
+
+int BenchmarkRunner::run(const Options& options)
+{
+    QTextStream err(stderr);
+    QList<BenchmarkResult> results;
+    bool failed(false);
+
+    for (const auto& benchmark: qAsConst(mBenchmarks))
+    {
+        if (!isSelected(benchmark, options.filters))
+        {
+            continue;
+        }
+
+        err << "Running " << benchmark.name << "... ";
+        err.flush();
+
+        BenchmarkResult result;
+        if (runBenchmark(benchmark, std::max(1, options.iterations), result))
+        {
+            err << result.medianNs / 1000 << " us (median)\n";
+            results.append(result);
+        }
+        else
+        {
+            err << "FAILED\n";
+            failed = true;
+        }
+    }
+
+    if (!writeResults(results, options.outputFile))
+    {
+        return 2;
+    }
+
+    return failed ? 1 : 0;
+}
+
+bool BenchmarkRunner::isSelected(const Benchmark& benchmark, const QStringList& filters) const
+{
+    if (filters.isEmpty())
+    {
+        return true;
+    }
+
+    return std::any_of(filters.cbegin(),
+                       filters.cend(),
+                       [&benchmark](const QString& filter)
+                       {
+                           return benchmark.name.startsWith(filter, Qt::CaseInsensitive);
+                       });
+}
+
+bool BenchmarkRunner::runBenchmark(const Benchmark& benchmark,
+                                   int iterations,
+                                   BenchmarkResult& result)
+{
+    // The first run is a warm-up: caches, lazy singletons and thread pools are initialised there
+    BenchmarkIteration warmUp;
+    benchmark.body(warmUp);
+    if (warmUp.elapsedNs() < 0)
+    {
+        return false;
+    }
+
+    std::vector<qint64> samples;
+    samples.reserve(static_cast<size_t>(iterations));
+
+    for (int i = 0; i < iterations; ++i)
+    {
+        BenchmarkIteration iteration;
+        benchmark.body(iteration);
+        if (iteration.elapsedNs() < 0)
+        {
+            return false;
+        }
+
+        samples.push_back(iteration.elapsedNs());
+        QCoreApplication::processEvents();
+    }
+
+    std::sort(samples.begin(), samples.end());
+
+    result.name = benchmark.name;
+    result.items = benchmark.items;
+    result.iterations = iterations;
+    result.minNs = samples.front();
+    result.maxNs = samples.back();
+    result.medianNs = samples[samples.size() / 2];
+    result.meanNs = std::accumulate(samples.cbegin(), samples.cend(), qint64(0)) /
+                    static_cast<qint64>(samples.size());
+    return true;
+}
+
+bool BenchmarkRunner::writeResults(const QList<BenchmarkResult>& results,
+                                   const QString& outputFile) const
+{
+    QJsonArray benchmarks;
+    for (const auto& result: results)
+    {
+        QJsonObject benchmark;
+        benchmark[QLatin1String("name")] = result.name;
+        benchmark[QLatin1String("items")] = result.items;
+        benchmark[QLatin1String("iterations")] = result.iterations;
+        benchmark[QLatin1String("min_ns")] = result.minNs;
+        benchmark[QLatin1String("median_ns")] = result.medianNs;
+        benchmark[QLatin1String("mean_ns")] = result.meanNs;
+        benchmark[QLatin1String("max_ns")] = result.maxNs;
+        benchmark[QLatin1String("items_per_second")] = result.itemsPerSecond();
+        benchmarks.append(benchmark);
+    }
+
+    QJsonObject root;
+    root[QLatin1String("suite")] = QLatin1String("MEGASyncBenchmarks");
+    root[QLatin1String("version")] = QString::fromUtf8(VER_PRODUCTVERSION_STR);
+    root[QLatin1String("sdk")] = QString::fromUtf8(VER_SDK_ID);
+    root[QLatin1String("platform")] = QSysInfo::prettyProductName();
+    root[QLatin1String("cpu_architecture")] = QSysInfo::currentCpuArchitecture();
+    root[QLatin1String("timestamp")] = QDateTime::currentDateTimeUtc().toString(Qt::ISODate);
+    root[QLatin1String("benchmarks")] = benchmarks;
+
+    const auto json(QJsonDocument(root).toJson(QJsonDocument::Indented));
+
+    if (outputFile.isEmpty())
+    {
+        QFile output;
+        output.open(stdout, QIODevice::WriteOnly);
+        output.write(json);
+        return true;
+    }
+
+    QFile output(outputFile);
+    if (!output.open(QIODevice::WriteOnly | QIODevice::Truncate))
+    {
+        QTextStream(stderr) << "Unable to write benchmark results to " << outputFile << "\n";
+        return false;
+    }
+
+    output.write(json);
+    return true;
+}
+
+bool waitUntil(std::function<bool()> condition, int timeoutMs)
+{
+    QElapsedTimer timer;
+    timer.start();
+
+    while (!condition())
+    {
+        if (timer.elapsed() > timeoutMs)
+        {
+            return false;
+        }
+
+        QCoreApplication::processEvents(QEventLoop::AllEvents, 10);
+    }
+
+    return true;
+}
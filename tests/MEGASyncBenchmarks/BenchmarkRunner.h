@@ -0,0 +1,101 @@
+#ifndef BENCHMARK_RUNNER_H
+#define BENCHMARK_RUNNER_H
+
+#include <QElapsedTimer>
+#include <QList>
+#include <QString>
+#include <QStringList>
+
+#include <functional>
+
+/*
+ * Minimal benchmark registry for the MEGASyncBenchmarks target.
+ *
+ * Every benchmark is registered statically with the number of items it processes and a body that
+ * is run once per iteration. The body prepares its fixture and only wraps the measured work
+ * between BenchmarkIteration::start() and stop(), so setup costs are not part of the results.
+ *
+ * Results are written as JSON, one object per benchmark, so they can be compared between
+ * releases.
+ */
+class BenchmarkIteration
+{
+public:
+    void start();
+    void stop();
+
+    qint64 elapsedNs() const;
+
+private:
+    QElapsedTimer mTimer;
+    qint64 mElapsedNs = -1;
+};
+
+using BenchmarkBody = std::function<void(BenchmarkIteration&)>;
+
+struct BenchmarkResult
+{
+    QString name;
+    qint64 items = 0;
+    int iterations = 0;
+    qint64 minNs = 0;
+    qint64 medianNs = 0;
+    qint64 meanNs = 0;
+    qint64 maxNs = 0;
+
+    double itemsPerSecond() const;
+};
+
+class BenchmarkRunner
+{
+public:
+    struct Options
+    {
+        QString outputFile;
+        QStringList filters;
+        int iterations = 5;
+    };
+
+    static BenchmarkRunner& instance()
+    {
+        static BenchmarkRunner instance;
+        return instance;
+    }
+
+    BenchmarkRunner(const BenchmarkRunner&) = delete;
+    BenchmarkRunner& operator=(const BenchmarkRunner&) = delete;
+
+    void add(const QString& name, qint64 items, BenchmarkBody body);
+
+    // Returns the process exit code: 0 if every selected benchmark ran
+    int run(const Options& options);
+
+private:
+    BenchmarkRunner() = default;
+
+    struct Benchmark
+    {
+        QString name;
+        qint64 items;
+        BenchmarkBody body;
+    };
+
+    bool isSelected(const Benchmark& benchmark, const QStringList& filters) const;
+    bool runBenchmark(const Benchmark& benchmark, int iterations, BenchmarkResult& result);
+    bool writeResults(const QList<BenchmarkResult>& results, const QString& outputFile) const;
+
+    QList<Benchmark> mBenchmarks;
+};
+
+struct BenchmarkRegistration
+{
+    BenchmarkRegistration(const QString& name, qint64 items, BenchmarkBody body)
+    {
+        BenchmarkRunner::instance().add(name, items, std::move(body));
+    }
+};
+
+// Spins the event loop until the condition is true or the timeout expires
+bool waitUntil(std::function<bool()> condition, int timeoutMs = 60000);
+
+#endif // BENCHMARK_RUNNER_H
@@ -0,0 +1,76 @@
+#include <QtGlobal>
+
+#ifdef Q_OS_LINUX
+
+#include "BenchmarkRunner.h"
+#include "ExtServer.h"
+#include "MegaApplication.h"
+
+#include <QDir>
+#include <QLocalSocket>
+
+namespace
+{
+constexpr char ASCII_FILE_SEP = 0x1C;
+
+// Overlay state requests, as sent by the file manager extensions while browsing a folder
+BenchmarkBody overlayStateBenchmark(int count)
+{
+    return [count](BenchmarkIteration& iteration)
+    {
+        ExtServer server(MegaSyncApp);
+
+        QLocalSocket client;
+        client.connectToServer(MegaApplication::applicationDataPath() + QDir::separator() +
+                               QString::fromLatin1("mega.socket"));
+        if (!client.waitForConnected())
+        {
+            return;
+        }
+
+        QByteArray requests;
+        for (int i = 0; i < count; ++i)
+        {
+            requests.append("P:/tmp/megasync-benchmarks/file_");
+            requests.append(QByteArray::number(i));
+            requests.append(ASCII_FILE_SEP);
+            requests.append("1\n");
+        }
+
+        int answers(0);
+        QObject::connect(&client,
+                         &QLocalSocket::readyRead,
+                         [&client, &answers]()
+                         {
+                             while (client.canReadLine())
+                             {
+                                 client.readLine();
+                                 ++answers;
+                             }
+                         });
+
+        iteration.start();
+        client.write(requests);
+        if (waitUntil(
+                [&answers, count]()
+                {
+                    return answers >= count;
+                }))
+        {
+            iteration.stop();
+        }
+
+        client.disconnectFromServer();
+    };
+}
+
+const BenchmarkRegistration OVERLAY_STATE_1K(QString::fromLatin1("ExtServer/overlayState/1000"),
+                                             1000,
+                                             overlayStateBenchmark(1000));
+
+const BenchmarkRegistration OVERLAY_STATE_10K(QString::fromLatin1("ExtServer/overlayState/10000"),
+                                              10000,
+                                              overlayStateBenchmark(10000));
+}
+
+#endif
@@ -0,0 +1,46 @@
+#include "BenchmarkRunner.h"
+#include "MegaApplication.h"
+#include "MegaSyncLogger.h"
+
+#include <string>
+#include <vector>
+
+namespace
+{
+// Messages are prepared beforehand, only the logger cost is measured
+BenchmarkBody logBenchmark(int count, int level)
+{
+    return [count, level](BenchmarkIteration& iteration)
+    {
+        std::vector<std::string> messages;
+        messages.reserve(static_cast<size_t>(count));
+        for (int i = 0; i < count; ++i)
+        {
+            messages.push_back("Benchmark message " + std::to_string(i) +
+                               " with a payload similar to the SDK transfer traces [" +
+                               std::string(static_cast<size_t>(32 + i % 96), 'x') + "]");
+        }
+
+        auto& logger(MegaSyncApp->getLogger());
+
+        iteration.start();
+        for (const auto& message: messages)
+        {
+#ifdef ENABLE_LOG_PERFORMANCE
+            logger.log(nullptr, level, __FILE__, message.c_str(), nullptr, nullptr, 0);
+#else
+            logger.log(nullptr, level, __FILE__, message.c_str());
+#endif
+        }
+        iteration.stop();
+    };
+}
+
+const BenchmarkRegistration LOG_INFO(QString::fromLatin1("MegaSyncLogger/log/info/100000"),
+                                     100000,
+                                     logBenchmark(100000, mega::MegaApi::LOG_LEVEL_INFO));
+
+const BenchmarkRegistration LOG_DEBUG(QString::fromLatin1("MegaSyncLogger/log/debug/100000"),
+                                      100000,
+                                      logBenchmark(100000, mega::MegaApi::LOG_LEVEL_DEBUG));
+}
@@ -0,0 +1,135 @@
+#include "BenchmarkRunner.h"
+#include "FakeSdkObjects.h"
+#include "NodeSelectorModel.h"
+#include "NodeSelectorModelItem.h"
+#include "NodeSelectorProxyModel.h"
+
+#include <QCollator>
+#include <QVariant>
+
+#include <algorithm>
+#include <vector>
+
+namespace
+{
+// High enough to never match a node of the logged in account
+constexpr mega::MegaHandle ROOT_HANDLE = 0x7F0000000000;
+
+// Expansion of a folder: the model creates one item per child once the children are fetched
+BenchmarkBody expandBenchmark(int count)
+{
+    return [count](BenchmarkIteration& iteration)
+    {
+        auto children(FakeSdkObjects::createNodeList(count, ROOT_HANDLE));
+        NodeSelectorModelItemCloudDrive root(
+            std::make_unique<FakeMegaNode>(ROOT_HANDLE,
+                                           mega::MegaNode::TYPE_FOLDER,
+                                           std::string("Cloud drive")),
+            true);
+
+        iteration.start();
+        root.createChildItems(std::move(children));
+        iteration.stop();
+    };
+}
+
+// Sorting of the children of a folder by name, as NodeSelectorProxyModel does when the folder is
+// expanded. The collation keys are created in the measured work, as they are on the first sort.
+BenchmarkBody sortByNameBenchmark(int count, bool collationKeys)
+{
+    return [count, collationKeys](BenchmarkIteration& iteration)
+    {
+        NodeSelectorModelItemCloudDrive root(
+            std::make_unique<FakeMegaNode>(ROOT_HANDLE,
+                                           mega::MegaNode::TYPE_FOLDER,
+                                           std::string("Cloud drive")),
+            true);
+        root.createChildItems(FakeSdkObjects::createNodeList(count, ROOT_HANDLE));
+
+        std::vector<NodeSelectorModelItem*> items;
+        items.reserve(static_cast<size_t>(count));
+        for (int row = 0; row < count; ++row)
+        {
+            items.push_back(root.getChild(row));
+        }
+
+        if (collationKeys)
+        {
+            iteration.start();
+            std::sort(items.begin(),
+                      items.end(),
+                      [](NodeSelectorModelItem* left, NodeSelectorModelItem* right)
+                      {
+                          return NodeSelectorProxyModel::isItemLessThan(left,
+                                                                        right,
+                                                                        NodeSelectorModel::NODE,
+                                                                        Qt::AscendingOrder);
+                      });
+            iteration.stop();
+        }
+        else
+        {
+            QCollator collator;
+            collator.setCaseSensitivity(Qt::CaseInsensitive);
+            collator.setNumericMode(true);
+            collator.setIgnorePunctuation(false);
+
+            // What lessThan did before: the file flags and the names through QVariant, and a
+            // full collation for each comparison
+            iteration.start();
+            std::sort(items.begin(),
+                      items.end(),
+                      [&collator](NodeSelectorModelItem* left, NodeSelectorModelItem* right)
+                      {
+                          const bool leftIsFile(QVariant(left->getNode()->isFile()).toBool());
+                          const bool rightIsFile(QVariant(right->getNode()->isFile()).toBool());
+                          if (leftIsFile != rightIsFile)
+                          {
+                              return rightIsFile;
+                          }
+                          return collator.compare(QVariant(left->getName()).toString(),
+                                                  QVariant(right->getName()).toString()) < 0;
+                      });
+            iteration.stop();
+        }
+    };
+}
+
+const BenchmarkRegistration EXPAND_1K(QString::fromLatin1("NodeSelectorModel/expand/1000"),
+                                      1000,
+                                      expandBenchmark(1000));
+
+const BenchmarkRegistration EXPAND_10K(QString::fromLatin1("NodeSelectorModel/expand/10000"),
+                                       10000,
+                                       expandBenchmark(10000));
+
+const BenchmarkRegistration SORT_COLLATOR_10K(
+    QString::fromLatin1("NodeSelectorModel/sortByName/collator/10000"),
+    10000,
+    sortByNameBenchmark(10000, false));
+
+const BenchmarkRegistration SORT_KEYS_10K(
+    QString::fromLatin1("NodeSelectorModel/sortByName/collationKeys/10000"),
+    10000,
+    sortByNameBenchmark(10000, true));
+
+const BenchmarkRegistration SORT_COLLATOR_100K(
+    QString::fromLatin1("NodeSelectorModel/sortByName/collator/100000"),
+    100000,
+    sortByNameBenchmark(100000, false));
+
+const BenchmarkRegistration SORT_KEYS_100K(
+    QString::fromLatin1("NodeSelectorModel/sortByName/collationKeys/100000"),
+    100000,
+    sortByNameBenchmark(100000, true));
+
+const BenchmarkRegistration SORT_COLLATOR_1M(
+    QString::fromLatin1("NodeSelectorModel/sortByName/collator/1000000"),
+    1000000,
+    sortByNameBenchmark(1000000, false));
+
+const BenchmarkRegistration SORT_KEYS_1M(
+    QString::fromLatin1("NodeSelectorModel/sortByName/collationKeys/1000000"),
+    1000000,
+    sortByNameBenchmark(1000000, true));
+}
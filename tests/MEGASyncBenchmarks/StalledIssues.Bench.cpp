@@ -0,0 +1,31 @@
+#include "BenchmarkRunner.h"
+#include "FakeSdkObjects.h"
+#include "StalledIssuesFactory.h"
+
+namespace
+{
+// Same work the StalledIssuesModel refresh does when the stall list request finishes
+BenchmarkBody createIssuesBenchmark(int count)
+{
+    return [count](BenchmarkIteration& iteration)
+    {
+        auto stalls(FakeSdkObjects::createStallList(count));
+        StalledIssuesCreator creator;
+
+        iteration.start();
+        creator.createIssues(stalls.get(), UpdateType::UI);
+        auto issues(creator.getStalledIssues());
+        iteration.stop();
+
+        Q_UNUSED(issues)
+    };
+}
+
+const BenchmarkRegistration CREATE_ISSUES_1K(QString::fromLatin1("StalledIssues/refresh/1000"),
+                                             1000,
+                                             createIssuesBenchmark(1000));
+
+const BenchmarkRegistration CREATE_ISSUES_10K(QString::fromLatin1("StalledIssues/refresh/10000"),
+                                              10000,
+                                              createIssuesBenchmark(10000));
+}
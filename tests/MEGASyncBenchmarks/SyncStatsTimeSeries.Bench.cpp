@@ -0,0 +1,124 @@
+#include "BenchmarkRunner.h"
+#include "SyncStatsTimeSeries.h"
+
+#include <vector>
+
+namespace
+{
+const qint64 START_MS = 1700000000000;
+const qint64 SAMPLE_INTERVAL_MS = 30000;
+const int STATS_UPDATES_PER_SECOND = 5;
+const int TRANSFER_UPDATES_PER_SECOND = 10;
+
+struct SyntheticEvent
+{
+    enum class Type
+    {
+        STATS,
+        UPLOAD,
+        DOWNLOAD,
+        SAMPLE
+    };
+
+    Type type;
+    qint64 timeMs;
+    mega::MegaHandle backupId;
+    SyncStatsTimeSeries::StatsUpdate update;
+    qint64 bytes;
+};
+
+// Synthetic stats of syncs that scan for a while, then transfer and go idle, each one with its
+// own phase. Updates are sent more often than the SDK does to stress the recorder.
+std::vector<SyntheticEvent> generateEvents(int syncs, int seconds)
+{
+    std::vector<SyntheticEvent> events;
+    events.reserve(static_cast<size_t>(syncs) * static_cast<size_t>(seconds) *
+                   (STATS_UPDATES_PER_SECOND + TRANSFER_UPDATES_PER_SECOND));
+
+    for (int second = 0; second < seconds; ++second)
+    {
+        for (int sync = 0; sync < syncs; ++sync)
+        {
+            const auto backupId(static_cast<mega::MegaHandle>(sync + 1));
+            const int phase((second + sync * 37) % 300);
+            const bool scanning(phase < 40);
+            const bool syncing(!scanning && phase < 200);
+
+            for (int i = 0; i < STATS_UPDATES_PER_SECOND; ++i)
+            {
+                SyntheticEvent event{};
+                event.type = SyntheticEvent::Type::STATS;
+                event.timeMs = START_MS + second * 1000 + i * (1000 / STATS_UPDATES_PER_SECOND);
+                event.backupId = backupId;
+                event.update.scanning = scanning;
+                event.update.syncing = syncing;
+                event.update.pendingUploads = syncing ? 200 - phase : 0;
+                event.update.pendingDownloads = syncing ? (200 - phase) / 4 : 0;
+                events.push_back(event);
+            }
+
+            for (int i = 0; syncing && i < TRANSFER_UPDATES_PER_SECOND; ++i)
+            {
+                SyntheticEvent event{};
+                event.type = i % 4 ? SyntheticEvent::Type::UPLOAD : SyntheticEvent::Type::DOWNLOAD;
+                event.backupId = backupId;
+                event.bytes = 256 * 1024;
+                events.push_back(event);
+            }
+        }
+
+        const qint64 nowMs(START_MS + (second + 1) * 1000);
+        if ((nowMs - START_MS) % SAMPLE_INTERVAL_MS == 0)
+        {
+            SyntheticEvent event{};
+            event.type = SyntheticEvent::Type::SAMPLE;
+            event.timeMs = nowMs;
+            events.push_back(event);
+        }
+    }
+
+    return events;
+}
+
+// Feeds one hour of synthetic activity and saves it
+BenchmarkBody recordBenchmark(int syncs)
+{
+    return [syncs](BenchmarkIteration& iteration)
+    {
+        const auto events(generateEvents(syncs, 3600));
+        SyncStatsTimeSeries timeSeries;
+
+        iteration.start();
+        for (const auto& event: events)
+        {
+            switch (event.type)
+            {
+                case SyntheticEvent::Type::STATS:
+                    timeSeries.updateStats(event.backupId, event.update, event.timeMs);
+                    break;
+                case SyntheticEvent::Type::UPLOAD:
+                    timeSeries.addUploadedBytes(event.backupId, event.bytes);
+                    break;
+                case SyntheticEvent::Type::DOWNLOAD:
+                    timeSeries.addDownloadedBytes(event.backupId, event.bytes);
+                    break;
+                case SyntheticEvent::Type::SAMPLE:
+                    timeSeries.takeSamples(event.timeMs);
+                    break;
+            }
+        }
+        const auto data(timeSeries.serialize());
+        iteration.stop();
+
+        Q_UNUSED(data)
+    };
+}
+
+const BenchmarkRegistration RECORD_10(QString::fromLatin1("SyncStatsTimeSeries/hour/10"),
+                                      10,
+                                      recordBenchmark(10));
+
+const BenchmarkRegistration RECORD_25(QString::fromLatin1("SyncStatsTimeSeries/hour/25"),
+                                      25,
+                                      recordBenchmark(25));
+}
@@ -0,0 +1,136 @@
+#include "BenchmarkRunner.h"
+#include "FakeSdkObjects.h"
+#include "MegaApplication.h"
+#include "TransfersManagerSortFilterProxyModel.h"
+#include "TransfersModel.h"
+
+using FakeTransfers = std::vector<std::unique_ptr<FakeMegaTransfer>>;
+
+class TransfersModelBenchmark
+{
+public:
+    // Processes the transfers as the SDK listener would do. Returns false if the model did not
+    // show all of them before the timeout.
+    static bool ingest(TransfersModel& model, const FakeTransfers& transfers)
+    {
+        // The processing timer is replaced by explicit calls, so the results do not depend on
+        // its interval
+        model.pauseModelProcessing(true);
+
+        auto megaApi(MegaSyncApp->getMegaApi());
+        for (const auto& transfer: transfers)
+        {
+            model.mTransferEventWorker->onTransferStart(megaApi, transfer.get());
+        }
+
+        const auto expectedRows(static_cast<int>(transfers.size()));
+        return waitUntil(
+            [&model, expectedRows]()
+            {
+                model.onProcessTransfers();
+                return model.rowCount(QModelIndex()) >= expectedRows;
+            });
+    }
+};
+
+namespace
+{
+BenchmarkBody ingestBenchmark(int count)
+{
+    return [count](BenchmarkIteration& iteration)
+    {
+        TransfersModel model;
+        auto transfers(FakeSdkObjects::createTransfers(count));
+
+        iteration.start();
+        if (TransfersModelBenchmark::ingest(model, transfers))
+        {
+            iteration.stop();
+        }
+    };
+}
+
+// Runs the proxy operation on a model with count transfers and measures it until the proxy
+// reports the new layout
+BenchmarkBody proxyBenchmark(int count,
+                             std::function<void(TransfersManagerSortFilterProxyModel&)> operation)
+{
+    return [count, operation](BenchmarkIteration& iteration)
+    {
+        TransfersModel model;
+        auto transfers(FakeSdkObjects::createTransfers(count));
+        if (!TransfersModelBenchmark::ingest(model, transfers))
+        {
+            return;
+        }
+
+        TransfersManagerSortFilterProxyModel proxy;
+        proxy.initProxyModel(SortCriterion::PRIORITY, Qt::DescendingOrder);
+        proxy.setSourceModel(&model);
+
+        bool modelChanged(false);
+        QObject::connect(&proxy,
+                         &TransfersManagerSortFilterProxyModel::modelChanged,
+                         [&modelChanged]()
+                         {
+                             modelChanged = true;
+                         });
+
+        iteration.start();
+        operation(proxy);
+        if (waitUntil(
+                [&modelChanged]()
+                {
+                    return modelChanged;
+                }))
+        {
+            iteration.stop();
+        }
+    };
+}
+
+const BenchmarkRegistration INGEST_1K(QString::fromLatin1("TransfersModel/ingest/1000"),
+                                      1000,
+                                      ingestBenchmark(1000));
+
+const BenchmarkRegistration INGEST_10K(QString::fromLatin1("TransfersModel/ingest/10000"),
+                                       10000,
+                                       ingestBenchmark(10000));
+
+const BenchmarkRegistration SORT_BY_NAME(
+    QString::fromLatin1("TransfersProxyModel/sort/name/10000"),
+    10000,
+    proxyBenchmark(10000,
+                   [](TransfersManagerSortFilterProxyModel& proxy)
+                   {
+                       proxy.sort(static_cast<int>(SortCriterion::NAME), Qt::AscendingOrder);
+                   }));
+
+const BenchmarkRegistration SORT_BY_SPEED(
+    QString::fromLatin1("TransfersProxyModel/sort/speed/10000"),
+    10000,
+    proxyBenchmark(10000,
+                   [](TransfersManagerSortFilterProxyModel& proxy)
+                   {
+                       proxy.sort(static_cast<int>(SortCriterion::SPEED), Qt::DescendingOrder);
+                   }));
+
+const BenchmarkRegistration FILTER_BY_TYPE(
+    QString::fromLatin1("TransfersProxyModel/filter/type/10000"),
+    10000,
+    proxyBenchmark(10000,
+                   [](TransfersManagerSortFilterProxyModel& proxy)
+                   {
+                       proxy.setFilters(TransferData::TRANSFER_UPLOAD, {}, {});
+                       proxy.refreshFilterFixedString();
+                   }));
+
+const BenchmarkRegistration FILTER_BY_TEXT(
+    QString::fromLatin1("TransfersProxyModel/filter/text/10000"),
+    10000,
+    proxyBenchmark(10000,
+                   [](TransfersManagerSortFilterProxyModel& proxy)
+                   {
+                       proxy.setFilterFixedString(QString::fromLatin1("file_1"));
+                   }));
+}
@@ -0,0 +1,80 @@
+#include "BenchmarkRunner.h"
+#include "MegaApplication.h"
+#include "Platform.h"
+
+#include <QCommandLineParser>
+#include <QDir>
+
+#include <cstdio>
+
+int main(int argc, char* argv[])
+{
+    // Benchmarks do not need a display
+    if (!qEnvironmentVariableIsSet("QT_QPA_PLATFORM"))
+    {
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+    }
+
+    // Keep the benchmark data (preferences, logs, sockets) away from the installed app
+    QCoreApplication::setOrganizationName(QString::fromUtf8("Mega Limited"));
+    QCoreApplication::setOrganizationDomain(QString::fromUtf8("mega.co.nz"));
+    QCoreApplication::setApplicationName(QString::fromUtf8("MEGAsyncBenchmarks"));
+
+    QStringList arguments;
+    for (int i = 0; i < argc; ++i)
+    {
+        arguments.append(QString::fromUtf8(argv[i]));
+    }
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription(QString::fromUtf8("MEGA Desktop App benchmarks"));
+    parser.addHelpOption();
+    QCommandLineOption outputOption(
+        QStringList() << QString::fromUtf8("o") << QString::fromUtf8("output"),
+        QString::fromUtf8("JSON file for the results. Use - to write them to stdout."),
+        QString::fromUtf8("file"),
+        QString::fromUtf8("MEGASyncBenchmarks.json"));
+    QCommandLineOption filterOption(
+        QStringList() << QString::fromUtf8("f") << QString::fromUtf8("filter"),
+        QString::fromUtf8("Only run the benchmarks whose name starts with this prefix."),
+        QString::fromUtf8("prefix"));
+    QCommandLineOption iterationsOption(
+        QStringList() << QString::fromUtf8("i") << QString::fromUtf8("iterations"),
+        QString::fromUtf8("Measured iterations per benchmark."),
+        QString::fromUtf8("count"),
+        QString::fromUtf8("5"));
+    parser.addOptions({outputOption, filterOption, iterationsOption});
+
+    if (!parser.parse(arguments))
+    {
+        fprintf(stderr, "%s\n", parser.errorText().toUtf8().constData());
+        return 2;
+    }
+
+    if (parser.isSet(QString::fromUtf8("help")))
+    {
+        fprintf(stdout, "%s", parser.helpText().toUtf8().constData());
+        return 0;
+    }
+
+    BenchmarkRunner::Options options;
+    options.filters = parser.values(filterOption);
+    options.iterations = parser.value(iterationsOption).toInt();
+
+    // The app changes the working directory to its data path, so relative paths are resolved now
+    auto output(parser.value(outputOption));
+    if (output != QString::fromUtf8("-"))
+    {
+        options.outputFile = QDir::current().absoluteFilePath(output);
+    }
+
+    Platform::create();
+
+    MegaApplication app(argc, argv);
+    app.initialize();
+
+    auto result(BenchmarkRunner::instance().run(options));
+
+    Platform::destroy();
+    return result;
+}
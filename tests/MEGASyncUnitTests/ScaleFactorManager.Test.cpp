@@ -31,7 +31,7 @@ SCENARIO("Scale factor calculation on linux platforms")
 
     GIVEN("A single screen with 1920x1080 resolution")
     {
-        ScaleFactorManager scaleFactorManager(OsType::LINUX, {{"screenName", 1920, 1080, 96, 1.}}, "Ubuntu20", "plasma");
+        ScaleFactorManager scaleFactorManager(OsType::LINUX, {{QString::fromUtf8("screenName"), 1920, 1080, 96, 1.}}, QString::fromUtf8("Ubuntu20"), QString::fromUtf8("plasma"));
 
         WHEN("Scale factor is set")
         {
@@ -47,22 +47,22 @@ SCENARIO("Scale factor calculation on linux platforms")
 
     GIVEN("A single screen with 1920x1080 resolution and 200% screen scaled")
     {
-        ScaleFactorManager scaleFactorManager(OsType::LINUX, {{"screenName", 1920, 1080, 192, 1.}}, "Ubuntu20", "plasma");
+        ScaleFactorManager scaleFactorManager(OsType::LINUX, {{QString::fromUtf8("screenName"), 1920, 1080, 192, 1.}}, QString::fromUtf8("Ubuntu20"), QString::fromUtf8("plasma"));
 
         WHEN("Scale factor is set")
         {
             scaleFactorManager.setScaleFactorEnvironmentVariable();
 
-            THEN("environment variable is set with the correct factor")
+            THEN("environment variable is set with the biggest factor that lets the biggest MEGASync window fit")
             {
-                CHECK(getenv(scaleEnvironmentVariableName) == std::string("1.66667"));
+                CHECK(getenv(scaleEnvironmentVariableName) == std::string("1.33333"));
             }
         }
     }
 
     GIVEN("A single screen with 640x480 resolution and 100% screen scaled")
     {
-        ScaleFactorManager scaleFactorManager(OsType::LINUX, {{"screenName", 640, 480, 96, 1.}}, "Ubuntu20", "plasma");
+        ScaleFactorManager scaleFactorManager(OsType::LINUX, {{QString::fromUtf8("screenName"), 640, 480, 96, 1.}}, QString::fromUtf8("Ubuntu20"), QString::fromUtf8("plasma"));
 
         WHEN("Scale factor is set")
         {
@@ -78,7 +78,7 @@ SCENARIO("Scale factor calculation on linux platforms")
 
     GIVEN("A single screen with 8000x6000 resolution and 100% screen scaled")
     {
-        ScaleFactorManager scaleFactorManager(OsType::LINUX, {{"screenName", 8000, 6000, 96, 1.}}, "Ubuntu20", "plasma");
+        ScaleFactorManager scaleFactorManager(OsType::LINUX, {{QString::fromUtf8("screenName"), 8000, 6000, 96, 1.}}, QString::fromUtf8("Ubuntu20"), QString::fromUtf8("plasma"));
 
         WHEN("Scale factor is set")
         {
@@ -93,7 +93,7 @@ SCENARIO("Scale factor calculation on linux platforms")
 
     GIVEN("A single screen with 3840x2160 resolution")
     {
-        ScaleFactorManager scaleFactorManager(OsType::LINUX, {{"screenName", 3840, 2160, 96, 1.}}, "Ubuntu20", "plasma");
+        ScaleFactorManager scaleFactorManager(OsType::LINUX, {{QString::fromUtf8("screenName"), 3840, 2160, 96, 1.}}, QString::fromUtf8("Ubuntu20"), QString::fromUtf8("plasma"));
 
         WHEN("Scale factor is set")
         {
@@ -108,7 +108,7 @@ SCENARIO("Scale factor calculation on linux platforms")
 
     GIVEN("A single screen with 3840x2160 resolution and 200% screen scaled")
     {
-        ScaleFactorManager scaleFactorManager(OsType::LINUX, {{"screenName", 3840, 2160, 192, 1.}}, "Ubuntu20", "plasma");
+        ScaleFactorManager scaleFactorManager(OsType::LINUX, {{QString::fromUtf8("screenName"), 3840, 2160, 192, 1.}}, QString::fromUtf8("Ubuntu20"), QString::fromUtf8("plasma"));
 
         WHEN("Scale factor is set")
         {
@@ -126,7 +126,7 @@ SCENARIO("Scale factor calculation on linux platforms")
         // When QT_AUTO_SCREEN_SCALE_FACTOR is set Qt treats the screan as 1920x1080
         // and sets the variable highDpiAutoScalingEnabled to 2.0
         // Qt return 96 dpi but xrdb return 192
-        ScaleFactorManager scaleFactorManager(OsType::LINUX, {{"screenName", 1920, 1080, 192, 2.}}, "Ubuntu20", "plasma");
+        ScaleFactorManager scaleFactorManager(OsType::LINUX, {{QString::fromUtf8("screenName"), 1920, 1080, 192, 2.}}, QString::fromUtf8("Ubuntu20"), QString::fromUtf8("plasma"));
 
         WHEN("Scale factor is set")
         {
@@ -141,7 +141,7 @@ SCENARIO("Scale factor calculation on linux platforms")
 
     GIVEN("Two screens with 3840x2160 and 1920x1080 resolutions")
     {
-        ScaleFactorManager scaleFactorManager(OsType::LINUX, {{"screenName1", 1920, 1080, 96, 1.}, {"screenName2", 3840, 2160, 96, 1.}}, "Ubuntu20", "plasma");
+        ScaleFactorManager scaleFactorManager(OsType::LINUX, {{QString::fromUtf8("screenName1"), 1920, 1080, 96, 1.}, {QString::fromUtf8("screenName2"), 3840, 2160, 96, 1.}}, QString::fromUtf8("Ubuntu20"), QString::fromUtf8("plasma"));
 
         WHEN("Scale factor is set")
         {
@@ -150,14 +150,14 @@ SCENARIO("Scale factor calculation on linux platforms")
             THEN("Environment variable is set with the correct factor")
             {
                 CHECK_FALSE(getenv(scaleEnvironmentVariableName));
-                CHECK(getenv(scaleScreensEnvironmentVariableName) == std::string("1,000000;1,500000"));
+                CHECK(getenv(scaleScreensEnvironmentVariableName) == std::string("1;1.5"));
             }
         }
     }
 
     GIVEN("Two screens with 3840x2160 and 1920x1080 resolutions scaled to 200%")
     {
-        ScaleFactorManager scaleFactorManager(OsType::LINUX, {{"screenName1", 1920, 1080, 192, 1.}, {"screenName2", 3840, 2160, 192, 1.}}, "Ubuntu20", "plasma");
+        ScaleFactorManager scaleFactorManager(OsType::LINUX, {{QString::fromUtf8("screenName1"), 1920, 1080, 192, 1.}, {QString::fromUtf8("screenName2"), 3840, 2160, 192, 1.}}, QString::fromUtf8("Ubuntu20"), QString::fromUtf8("plasma"));
 
         WHEN("Scale factor is set")
         {
@@ -166,22 +166,7 @@ SCENARIO("Scale factor calculation on linux platforms")
             THEN("Environment variable is set with the correct factor")
             {
                 CHECK_FALSE(getenv(scaleEnvironmentVariableName));
-                CHECK(getenv(scaleScreensEnvironmentVariableName) == std::string("1,666667;2,000000"));
-            }
-        }
-    }
-
-    GIVEN("Two screens with 3840x2160 and 1920x1080 resolutions scaled to 200% on Deepin 20 distro")
-    {
-        ScaleFactorManager scaleFactorManager(OsType::LINUX, {{"screenName1", 3840, 2160, 192, 1.}, {"screenName2", 1920, 1080, 192, 1.}}, "Deepin 20", "DDE");
-
-        WHEN("Scale factor is set")
-        {
-            scaleFactorManager.setScaleFactorEnvironmentVariable();
-
-            THEN("Environment variable is set for all screens with the minimum factor calculated for Deepin distro")
-            {
-                CHECK(getenv(scaleEnvironmentVariableName) == std::string("1.66667"));
+                CHECK(getenv(scaleScreensEnvironmentVariableName) == std::string("1.33333;2"));
             }
         }
     }
@@ -193,7 +178,7 @@ SCENARIO("Scale factor calculation on windows platforms")
 
     GIVEN("A single screen set with 1920x1080 resolution with 100% scale")
     {
-        ScaleFactorManager scaleFactorManager(OsType::WIN, {{"screenName", 1920, 1040, 96., 1.}}, "Windows 10", "");
+        ScaleFactorManager scaleFactorManager(OsType::WIN, {{QString::fromUtf8("screenName"), 1920, 1040, 96., 1.}}, QString::fromUtf8("Windows 10"), QString());
 
         WHEN("Scale factor is set")
         {
@@ -209,7 +194,7 @@ SCENARIO("Scale factor calculation on windows platforms")
 
     GIVEN("A single screen with 1920x1080 resolution with 150% scale")
     {
-        ScaleFactorManager scaleFactorManager(OsType::WIN, {{"screenName", 960, 510, 72., 2.0}}, "Windows 10", "");
+        ScaleFactorManager scaleFactorManager(OsType::WIN, {{QString::fromUtf8("screenName"), 960, 510, 72., 2.0}}, QString::fromUtf8("Windows 10"), QString());
 
         WHEN("Scale factor is set")
         {
@@ -217,14 +202,14 @@ SCENARIO("Scale factor calculation on windows platforms")
 
             THEN("Environment variable is set with the correct factor since the biggest MEGASync window does not fit the available screen space.")
             {
-                CHECK(getenv(scaleEnvironmentVariableName) == std::string("0.75"));
+                CHECK(getenv(scaleEnvironmentVariableName) == std::string("0.583333"));
             }
         }
     }
 
     GIVEN("A single screen with 640x480 resolution and 100% screen scaled")
     {
-        ScaleFactorManager scaleFactorManager(OsType::WIN, {{"screenName", 640, 480, 96, 1.}}, "Windows 10", "");
+        ScaleFactorManager scaleFactorManager(OsType::WIN, {{QString::fromUtf8("screenName"), 640, 480, 96, 1.}}, QString::fromUtf8("Windows 10"), QString());
 
         WHEN("Scale factor is set")
         {
@@ -240,30 +225,30 @@ SCENARIO("Scale factor calculation on windows platforms")
 
     GIVEN("A single screen with 3840x2160 resolution with 150% scale")
     {
-        ScaleFactorManager scaleFactorManager(OsType::WIN, {{"screenName", 1920, 1050, 72., 2.0}}, "Windows 10", "");
+        ScaleFactorManager scaleFactorManager(OsType::WIN, {{QString::fromUtf8("screenName"), 1920, 1050, 72., 2.0}}, QString::fromUtf8("Windows 10"), QString());
 
         WHEN("Scale factor is set")
         {
             scaleFactorManager.setScaleFactorEnvironmentVariable();
 
-            THEN("Scale factor environment variable is not set because highDpi is enabled and biggest window fits the available screen")
+            THEN("Scale factor environment variable is lowered so that the biggest window fits the available screen")
             {
-                CHECK_FALSE(getenv(scaleEnvironmentVariableName));
+                CHECK(getenv(scaleEnvironmentVariableName) == std::string("1.25"));
             }
         }
     }
 
     GIVEN("A single screen with 3840x2160 resolution with 200% scale")
     {
-        ScaleFactorManager scaleFactorManager(OsType::WIN, {{"screenName", 1920, 1050, 96., 2.0}}, "Windows 10", "");
+        ScaleFactorManager scaleFactorManager(OsType::WIN, {{QString::fromUtf8("screenName"), 1920, 1050, 96., 2.0}}, QString::fromUtf8("Windows 10"), QString());
 
         WHEN("Scale factor is set")
         {
             scaleFactorManager.setScaleFactorEnvironmentVariable();
 
-            THEN("Scale factor environment variable is not set because highDpi is enabled and bigger window fits the available screen")
+            THEN("Scale factor environment variable is lowered so that the biggest window fits the available screen")
             {
-                CHECK_FALSE(getenv(scaleEnvironmentVariableName));
+                CHECK(getenv(scaleEnvironmentVariableName) == std::string("1.25"));
             }
         }
     }
@@ -275,7 +260,7 @@ SCENARIO("Retrieve loggin after calculations")
 
     GIVEN("A two screen setup")
     {
-        ScaleFactorManager scaleFactorManager(OsType::LINUX, {{"screenName1", 1920, 1080, 96, 1.}, {"screenName2", 3840, 2160, 96, 1.}}, "Ubuntu20", "plasma");
+        ScaleFactorManager scaleFactorManager(OsType::LINUX, {{QString::fromUtf8("screenName1"), 1920, 1080, 96, 1.}, {QString::fromUtf8("screenName2"), 3840, 2160, 96, 1.}}, QString::fromUtf8("Ubuntu20"), QString::fromUtf8("plasma"));
 
         WHEN("Scale factor is set")
         {
@@ -284,10 +269,10 @@ SCENARIO("Retrieve loggin after calculations")
             THEN("Loged messages can be retrieved")
             {
                 const auto logMessages{scaleFactorManager.getLogMessages()};
-                std::vector<std::string> expectedLogMessages{"Ubuntu20 (plasma)"};
-                expectedLogMessages.emplace_back("Screen detected: screenName1, 1920, 1080, 96,000000, 1,000000");
-                expectedLogMessages.emplace_back("Screen detected: screenName2, 3840, 2160, 96,000000, 1,000000");
-                expectedLogMessages.emplace_back("QT_SCREEN_SCALE_FACTORS set to 1,000000;1,500000");
+                QVector<QString> expectedLogMessages{QString::fromUtf8("Ubuntu20 (plasma)")};
+                expectedLogMessages.append(QString::fromUtf8("Screen detected: screenName1, 1920, 1080, 96, 1"));
+                expectedLogMessages.append(QString::fromUtf8("Screen detected: screenName2, 3840, 2160, 96, 1"));
+                expectedLogMessages.append(QString::fromUtf8("QT_SCREEN_SCALE_FACTORS set to 1;1.5"));
 
                 CHECK(logMessages == expectedLogMessages);
             }
@@ -297,7 +282,7 @@ SCENARIO("Retrieve loggin after calculations")
     GIVEN("A two screen setup with QT_AUTO_SCREEN_SCALE_FACTOR environment set")
     {
         setenv("QT_AUTO_SCREEN_SCALE_FACTOR", "1", true);
-        ScaleFactorManager scaleFactorManager(OsType::LINUX, {{"screenName1", 1920, 1080, 96, 1.}, {"screenName2", 3840, 2160, 96, 1.}}, "Ubuntu20", "plasma");
+        ScaleFactorManager scaleFactorManager(OsType::LINUX, {{QString::fromUtf8("screenName1"), 1920, 1080, 96, 1.}, {QString::fromUtf8("screenName2"), 3840, 2160, 96, 1.}}, QString::fromUtf8("Ubuntu20"), QString::fromUtf8("plasma"));
 
         WHEN("Scale factor is set")
         {
@@ -306,10 +291,10 @@ SCENARIO("Retrieve loggin after calculations")
             THEN("Loged messages can be retrieved")
             {
                 const auto logMessages{scaleFactorManager.getLogMessages()};
-                std::vector<std::string> expectedLogMessages{"Ubuntu20 (plasma)"};
-                expectedLogMessages.emplace_back("Screen detected: screenName1, 1920, 1080, 96,000000, 1,000000");
-                expectedLogMessages.emplace_back("Screen detected: screenName2, 3840, 2160, 96,000000, 1,000000");
-                expectedLogMessages.emplace_back("QT_SCREEN_SCALE_FACTORS set to 1,000000;1,500000");
+                QVector<QString> expectedLogMessages{QString::fromUtf8("Ubuntu20 (plasma)")};
+                expectedLogMessages.append(QString::fromUtf8("Screen detected: screenName1, 1920, 1080, 96, 1"));
+                expectedLogMessages.append(QString::fromUtf8("Screen detected: screenName2, 3840, 2160, 96, 1"));
+                expectedLogMessages.append(QString::fromUtf8("QT_SCREEN_SCALE_FACTORS set to 1;1.5"));
 
                 CHECK(logMessages == expectedLogMessages);
             }
@@ -320,7 +305,7 @@ SCENARIO("Retrieve loggin after calculations")
 SCENARIO("Environment variables already set before execution")
 {
     unsetEnvironmentVariables();
-    ScaleFactorManager scaleFactorManager(OsType::LINUX, {{"screenName1", 1920, 1080, 192, 1.}, {"screenName2", 3840, 2160, 192, 1.}}, "Ubuntu20", "plasma");
+    ScaleFactorManager scaleFactorManager(OsType::LINUX, {{QString::fromUtf8("screenName1"), 1920, 1080, 192, 1.}, {QString::fromUtf8("screenName2"), 3840, 2160, 192, 1.}}, QString::fromUtf8("Ubuntu20"), QString::fromUtf8("plasma"));
 
     GIVEN("QT_SCALE_FACTOR Environment variable already set")
     {
@@ -336,10 +321,10 @@ SCENARIO("Environment variables already set before execution")
 
                 AND_THEN("Logs can be retrieved")
                 {
-                    std::vector<std::string> expectedLogMessages{"Ubuntu20 (plasma)"};
-                    expectedLogMessages.emplace_back("Screen detected: screenName1, 1920, 1080, 192,000000, 1,000000");
-                    expectedLogMessages.emplace_back("Screen detected: screenName2, 3840, 2160, 192,000000, 1,000000");
-                    expectedLogMessages.emplace_back("Scale factor not calculated because QT_SCALE_FACTOR is already set to: 1.27");
+                    QVector<QString> expectedLogMessages{QString::fromUtf8("Ubuntu20 (plasma)")};
+                    expectedLogMessages.append(QString::fromUtf8("Screen detected: screenName1, 1920, 1080, 192, 1"));
+                    expectedLogMessages.append(QString::fromUtf8("Screen detected: screenName2, 3840, 2160, 192, 1"));
+                    expectedLogMessages.append(QString::fromUtf8("Scale factor not calculated because QT_SCALE_FACTOR is already set to: 1.27"));
 
                     const auto logMessages{scaleFactorManager.getLogMessages()};
                     CHECK(logMessages == expectedLogMessages);
@@ -364,11 +349,11 @@ SCENARIO("Environment variables already set before execution")
 
                 AND_THEN("Logs can be retrieved")
                 {
-                    std::vector<std::string> expectedLogMessages{"Ubuntu20 (plasma)"};
-                    expectedLogMessages.emplace_back("Screen detected: screenName1, 1920, 1080, 192,000000, 1,000000");
-                    expectedLogMessages.emplace_back("Screen detected: screenName2, 3840, 2160, 192,000000, 1,000000");
-                    expectedLogMessages.emplace_back("Scale factor not calculated because QT_SCREEN_SCALE_FACTORS is already set to: "
-                                                     + std::string(variableValue));
+                    QVector<QString> expectedLogMessages{QString::fromUtf8("Ubuntu20 (plasma)")};
+                    expectedLogMessages.append(QString::fromUtf8("Screen detected: screenName1, 1920, 1080, 192, 1"));
+                    expectedLogMessages.append(QString::fromUtf8("Screen detected: screenName2, 3840, 2160, 192, 1"));
+                    expectedLogMessages.append(QString::fromUtf8("Scale factor not calculated because QT_SCREEN_SCALE_FACTORS is already set to: ")
+                                                     + QString::fromUtf8(variableValue));
 
                     const auto logMessages{scaleFactorManager.getLogMessages()};
                     CHECK(logMessages == expectedLogMessages);
@@ -390,12 +375,12 @@ SCENARIO("Environment variables already set before execution")
             {
                 AND_THEN("Logs can be retrieved")
                 {
-                    std::vector<std::string> expectedLogMessages{"Ubuntu20 (plasma)"};
-                    expectedLogMessages.emplace_back("Screen detected: screenName1, 1920, 1080, 192,000000, 1,000000");
-                    expectedLogMessages.emplace_back("Screen detected: screenName2, 3840, 2160, 192,000000, 1,000000");
-                    expectedLogMessages.emplace_back("Screen name screenName1 not found in predefined QT_SCREEN_SCALE_FACTORS: "
-                                                     + std::string(variableValue));
-                    expectedLogMessages.emplace_back("QT_SCREEN_SCALE_FACTORS set to 1,666667;2,000000");
+                    QVector<QString> expectedLogMessages{QString::fromUtf8("Ubuntu20 (plasma)")};
+                    expectedLogMessages.append(QString::fromUtf8("Screen detected: screenName1, 1920, 1080, 192, 1"));
+                    expectedLogMessages.append(QString::fromUtf8("Screen detected: screenName2, 3840, 2160, 192, 1"));
+                    expectedLogMessages.append(QString::fromUtf8("Screen name screenName1 not found in predefined QT_SCREEN_SCALE_FACTORS: ")
+                                                     + QString::fromUtf8(variableValue));
+                    expectedLogMessages.append(QString::fromUtf8("QT_SCREEN_SCALE_FACTORS set to 1.33333;2"));
 
                     const auto logMessages{scaleFactorManager.getLogMessages()};
                     CHECK(logMessages == expectedLogMessages);
@@ -0,0 +1,290 @@
+#include <catch.hpp>
+#include "FakeSdkObjects.h"
+#include "LinkInfoScheduler.h"
+
+#include <QHash>
+#include <QString>
+
+#include <deque>
+#include <memory>
+#include <vector>
+
+namespace
+{
+const qint64 TIMEOUT_MS = 30000;
+
+struct SentRequest
+{
+    quint64 requestId;
+    QString link;
+    int session;
+};
+
+// Stands for the MegaApi instances resolving the links: the requests are answered later, when
+// the test decides, and the folder sessions are created on demand up to maxFolderSessions
+class FakeLinkInfoApi
+{
+public:
+    explicit FakeLinkInfoApi(int maxFolderSessions = 3):
+        mMaxFolderSessions(maxFolderSessions)
+    {}
+
+    LinkInfoScheduler::Handlers getHandlers()
+    {
+        return {[this](quint64 requestId, const QString& link)
+                {
+                    mFileRequests.push_back({requestId, link, -1});
+                },
+                [this](quint64 requestId, const QString& link, int session)
+                {
+                    mFolderRequests.push_back({requestId, link, session});
+                },
+                [this](quint64 requestId, const QString& link)
+                {
+                    mSetRequests.push_back({requestId, link, -1});
+                },
+                [this](int session)
+                {
+                    mOpenedSessions.push_back(session);
+                    return session < mMaxFolderSessions;
+                }};
+    }
+
+    // The public node of the oldest file request
+    std::unique_ptr<FakeMegaNode> answerFileRequest(quint64* requestId)
+    {
+        const auto sentRequest(mFileRequests.front());
+        mFileRequests.pop_front();
+
+        *requestId = sentRequest.requestId;
+        return std::make_unique<FakeMegaNode>(static_cast<mega::MegaHandle>(sentRequest.requestId),
+                                              mega::MegaNode::TYPE_FILE,
+                                              sentRequest.link.toStdString());
+    }
+
+    std::deque<SentRequest> mFileRequests;
+    std::vector<SentRequest> mFolderRequests;
+    std::vector<SentRequest> mSetRequests;
+    std::vector<int> mOpenedSessions;
+
+private:
+    int mMaxFolderSessions;
+};
+
+QString fileLink(int i)
+{
+    return QString::fromUtf8("https://mega.nz/file/%1").arg(i);
+}
+
+QString folderLink(int i)
+{
+    return QString::fromUtf8("https://mega.nz/folder/%1").arg(i);
+}
+
+QString setLink(int i)
+{
+    return QString::fromUtf8("https://mega.nz/collection/%1").arg(i);
+}
+}
+
+TEST_CASE("File links are resolved in a bounded window")
+{
+    FakeLinkInfoApi api;
+    LinkInfoScheduler scheduler(8, 3, TIMEOUT_MS, api.getHandlers());
+
+    for (int i = 0; i < 20; i++)
+    {
+        scheduler.addLink(fileLink(i), LinkInfoScheduler::LinkType::FILE, i);
+    }
+    scheduler.dispatch(0);
+
+    REQUIRE(api.mFileRequests.size() == 8);
+    REQUIRE(scheduler.getFileRequestsInFlight() == 8);
+
+    QHash<int, QString> resolvedNames;
+    while (!api.mFileRequests.empty())
+    {
+        quint64 requestId(0);
+        const auto node(api.answerFileRequest(&requestId));
+        const auto linkRequest(scheduler.finish(requestId));
+        for (auto index : linkRequest.indexes)
+        {
+            resolvedNames.insert(index, QString::fromUtf8(node->getName()));
+        }
+
+        scheduler.dispatch(0);
+        REQUIRE(scheduler.getFileRequestsInFlight() <= 8);
+    }
+
+    REQUIRE(scheduler.isEmpty());
+    REQUIRE(resolvedNames.size() == 20);
+    for (int i = 0; i < 20; i++)
+    {
+        REQUIRE(resolvedNames.value(i) == fileLink(i));
+    }
+}
+
+TEST_CASE("Duplicated links share one request")
+{
+    FakeLinkInfoApi api;
+    LinkInfoScheduler scheduler(8, 3, TIMEOUT_MS, api.getHandlers());
+
+    scheduler.addLink(fileLink(1), LinkInfoScheduler::LinkType::FILE, 0);
+    scheduler.addLink(fileLink(2), LinkInfoScheduler::LinkType::FILE, 1);
+    scheduler.addLink(fileLink(1), LinkInfoScheduler::LinkType::FILE, 2);
+    scheduler.addLink(fileLink(1), LinkInfoScheduler::LinkType::FILE, 3);
+    scheduler.dispatch(0);
+
+    REQUIRE(api.mFileRequests.size() == 2);
+
+    quint64 requestId(0);
+    const auto node(api.answerFileRequest(&requestId));
+    const auto linkRequest(scheduler.finish(requestId));
+
+    REQUIRE(QString::fromUtf8(node->getName()) == fileLink(1));
+    REQUIRE(linkRequest.indexes == QList<int>({0, 2, 3}));
+    REQUIRE_FALSE(scheduler.isEmpty());
+}
+
+TEST_CASE("Folder links wait for a free folder session")
+{
+    FakeLinkInfoApi api;
+    LinkInfoScheduler scheduler(8, 3, TIMEOUT_MS, api.getHandlers());
+
+    for (int i = 0; i < 5; i++)
+    {
+        scheduler.addLink(folderLink(i), LinkInfoScheduler::LinkType::FOLDER, i);
+    }
+    scheduler.dispatch(0);
+
+    REQUIRE(api.mFolderRequests.size() == 3);
+    REQUIRE(api.mOpenedSessions == std::vector<int>({0, 1, 2}));
+    REQUIRE(scheduler.getBusyFolderSessions() == 3);
+
+    SECTION("A session takes the next link once the SDK answers it")
+    {
+        const auto sentRequest(api.mFolderRequests[1]);
+        scheduler.releaseFolderSession(sentRequest.session, sentRequest.requestId);
+        scheduler.finish(sentRequest.requestId);
+        scheduler.dispatch(0);
+
+        REQUIRE(api.mFolderRequests.size() == 4);
+        REQUIRE(api.mFolderRequests.back().link == folderLink(3));
+        REQUIRE(api.mFolderRequests.back().session == sentRequest.session);
+        REQUIRE(api.mOpenedSessions.size() == 3);
+    }
+
+    SECTION("Only the sessions that could be opened are used")
+    {
+        FakeLinkInfoApi singleSessionApi(1);
+        LinkInfoScheduler singleSessionScheduler(8, 3, TIMEOUT_MS, singleSessionApi.getHandlers());
+
+        singleSessionScheduler.addLink(folderLink(1), LinkInfoScheduler::LinkType::FOLDER, 0);
+        singleSessionScheduler.addLink(folderLink(2), LinkInfoScheduler::LinkType::FOLDER, 1);
+        singleSessionScheduler.dispatch(0);
+
+        REQUIRE(singleSessionApi.mFolderRequests.size() == 1);
+        REQUIRE(singleSessionApi.mFolderRequests.front().session == 0);
+        REQUIRE(singleSessionApi.mOpenedSessions == std::vector<int>({0, 1}));
+    }
+}
+
+TEST_CASE("A timed out folder link keeps its session until the SDK answers")
+{
+    FakeLinkInfoApi api(1);
+    LinkInfoScheduler scheduler(8, 1, TIMEOUT_MS, api.getHandlers());
+
+    scheduler.addLink(folderLink(1), LinkInfoScheduler::LinkType::FOLDER, 0);
+    scheduler.addLink(folderLink(2), LinkInfoScheduler::LinkType::FOLDER, 1);
+    scheduler.dispatch(0);
+
+    REQUIRE(api.mFolderRequests.size() == 1);
+    const auto lateRequest(api.mFolderRequests.front());
+
+    REQUIRE(scheduler.takeExpired(TIMEOUT_MS - 1).isEmpty());
+
+    const auto expiredRequests(scheduler.takeExpired(TIMEOUT_MS));
+    REQUIRE(expiredRequests.size() == 1);
+    REQUIRE(expiredRequests.front().indexes == QList<int>({0}));
+    REQUIRE_FALSE(scheduler.contains(lateRequest.requestId));
+
+    // The login is still running in the session
+    scheduler.dispatch(TIMEOUT_MS);
+    REQUIRE(api.mFolderRequests.size() == 1);
+    REQUIRE(scheduler.getBusyFolderSessions() == 1);
+
+    // Its late answer frees the session for the next link
+    scheduler.releaseFolderSession(lateRequest.session, lateRequest.requestId);
+    scheduler.dispatch(TIMEOUT_MS);
+    REQUIRE(api.mFolderRequests.size() == 2);
+    REQUIRE(api.mFolderRequests.back().link == folderLink(2));
+    REQUIRE(api.mFolderRequests.back().session == 0);
+
+    // A late answer of the given up request does not free the session of the new one
+    scheduler.releaseFolderSession(lateRequest.session, lateRequest.requestId);
+    REQUIRE(scheduler.getBusyFolderSessions() == 1);
+}
+
+TEST_CASE("Fetching the nodes of a folder link has no deadline")
+{
+    FakeLinkInfoApi api;
+    LinkInfoScheduler scheduler(8, 3, TIMEOUT_MS, api.getHandlers());
+
+    scheduler.addLink(folderLink(1), LinkInfoScheduler::LinkType::FOLDER, 0);
+    scheduler.addLink(fileLink(1), LinkInfoScheduler::LinkType::FILE, 1);
+    scheduler.dispatch(0);
+
+    const auto folderRequest(api.mFolderRequests.front());
+    scheduler.onFolderLoggedIn(folderRequest.requestId);
+
+    const auto expiredRequests(scheduler.takeExpired(10 * TIMEOUT_MS));
+    REQUIRE(expiredRequests.size() == 1);
+    REQUIRE(expiredRequests.front().link == fileLink(1));
+    REQUIRE(scheduler.contains(folderRequest.requestId));
+    REQUIRE(scheduler.getFileRequestsInFlight() == 0);
+}
+
+TEST_CASE("Set links are sent one at a time")
+{
+    FakeLinkInfoApi api;
+    LinkInfoScheduler scheduler(8, 3, TIMEOUT_MS, api.getHandlers());
+
+    scheduler.addLink(setLink(1), LinkInfoScheduler::LinkType::SET, 0);
+    scheduler.addLink(setLink(2), LinkInfoScheduler::LinkType::SET, 1);
+    scheduler.dispatch(0);
+
+    REQUIRE(api.mSetRequests.size() == 1);
+    REQUIRE(scheduler.findSentSetRequest(setLink(1)) == api.mSetRequests.front().requestId);
+    REQUIRE(scheduler.findSentSetRequest(setLink(2)) == 0);
+
+    scheduler.finish(api.mSetRequests.front().requestId);
+    scheduler.dispatch(0);
+
+    REQUIRE(api.mSetRequests.size() == 2);
+    REQUIRE(scheduler.findSentSetRequest(setLink(2)) == api.mSetRequests.back().requestId);
+}
+
+TEST_CASE("Cleared requests keep their folder sessions busy")
+{
+    FakeLinkInfoApi api(1);
+    LinkInfoScheduler scheduler(8, 1, TIMEOUT_MS, api.getHandlers());
+
+    scheduler.addLink(folderLink(1), LinkInfoScheduler::LinkType::FOLDER, 0);
+    scheduler.addLink(fileLink(1), LinkInfoScheduler::LinkType::FILE, 1);
+    scheduler.dispatch(0);
+    const auto oldRequest(api.mFolderRequests.front());
+
+    scheduler.clear();
+    REQUIRE(scheduler.isEmpty());
+    REQUIRE(scheduler.getFileRequestsInFlight() == 0);
+
+    // The same link of a new list is a new request, sent once the old login is answered
+    scheduler.addLink(folderLink(1), LinkInfoScheduler::LinkType::FOLDER, 0);
+    scheduler.dispatch(0);
+    REQUIRE(api.mFolderRequests.size() == 1);
+
+    scheduler.releaseFolderSession(oldRequest.session, oldRequest.requestId);
+    scheduler.dispatch(0);
+    REQUIRE(api.mFolderRequests.size() == 2);
+    REQUIRE(api.mFolderRequests.back().requestId != oldRequest.requestId);
+}
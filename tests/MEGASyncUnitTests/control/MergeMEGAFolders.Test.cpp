@@ -0,0 +1,254 @@
+#include <catch.hpp>
+#include "FakeSdkObjects.h"
+#include "MergeMEGAFolders.h"
+
+#include <QHash>
+#include <QString>
+#include <QStringList>
+
+#include <memory>
+
+namespace
+{
+const mega::MegaHandle ROOT_HANDLE = 1;
+
+// Stands for the cloud the plan reads: the children are returned in the order they were added,
+// and every folder read is counted
+class FakeCloud
+{
+public:
+    FakeCloud()
+    {
+        mNodes.append(std::make_shared<FakeMegaNode>(ROOT_HANDLE,
+                                                     mega::MegaNode::TYPE_ROOT,
+                                                     std::string("Cloud drive")));
+    }
+
+    std::shared_ptr<FakeMegaNode> addFolder(mega::MegaHandle parentHandle, const std::string& name)
+    {
+        return addNode(parentHandle, mega::MegaNode::TYPE_FOLDER, name, std::string());
+    }
+
+    std::shared_ptr<FakeMegaNode> addFile(mega::MegaHandle parentHandle,
+                                          const std::string& name,
+                                          const std::string& fingerprint)
+    {
+        return addNode(parentHandle, mega::MegaNode::TYPE_FILE, name, fingerprint);
+    }
+
+    MergeMEGAFolders::NodeSource getNodeSource()
+    {
+        MergeMEGAFolders::NodeSource nodeSource;
+
+        nodeSource.getChildren = [this](mega::MegaNode* folder)
+        {
+            mChildrenReads[folder->getHandle()]++;
+
+            QList<std::shared_ptr<mega::MegaNode>> children;
+            for (const auto& node : mNodes)
+            {
+                if (node->getParentHandle() == folder->getHandle())
+                {
+                    children.append(std::shared_ptr<mega::MegaNode>(node->copy()));
+                }
+            }
+            return children;
+        };
+
+        nodeSource.getNodeByHandle = [this](mega::MegaHandle handle)
+        {
+            for (const auto& node : mNodes)
+            {
+                if (node->getHandle() == handle)
+                {
+                    return std::shared_ptr<mega::MegaNode>(node->copy());
+                }
+            }
+            return std::shared_ptr<mega::MegaNode>();
+        };
+
+        nodeSource.unescapeName = [](const char* name)
+        {
+            return QString::fromUtf8(name);
+        };
+
+        return nodeSource;
+    }
+
+    QHash<mega::MegaHandle, int> mChildrenReads;
+
+private:
+    std::shared_ptr<FakeMegaNode> addNode(mega::MegaHandle parentHandle,
+                                          int type,
+                                          const std::string& name,
+                                          const std::string& fingerprint)
+    {
+        auto node(std::make_shared<FakeMegaNode>(mNextHandle++, type, name));
+        node->mParentHandle = parentHandle;
+        node->mFingerprint = fingerprint;
+        mNodes.append(node);
+        return node;
+    }
+
+    mega::MegaHandle mNextHandle = 100;
+    QList<std::shared_ptr<FakeMegaNode>> mNodes;
+};
+
+QStringList getNewNames(const MergeMEGAFolders::Plan& plan)
+{
+    QStringList newNames;
+    for (const auto& operation : plan.contentOperations + plan.finishOperations)
+    {
+        if (operation.type == MergeMEGAFolders::Operation::Type::MoveAndRename)
+        {
+            newNames.append(operation.newName);
+        }
+    }
+    return newNames;
+}
+}
+
+TEST_CASE("The content of the merged folder is moved, skipped or renamed")
+{
+    FakeCloud cloud;
+    auto target(cloud.addFolder(ROOT_HANDLE, "photos"));
+    auto toMerge(cloud.addFolder(ROOT_HANDLE, "photos"));
+
+    cloud.addFile(target->getHandle(), "same", "fp1");
+    cloud.addFile(target->getHandle(), "different", "fp2");
+    cloud.addFile(toMerge->getHandle(), "same", "fp1");
+    cloud.addFile(toMerge->getHandle(), "different", "fp3");
+    cloud.addFile(toMerge->getHandle(), "new", "fp4");
+
+    const auto plan(MergeMEGAFolders::plan(target.get(),
+                                           toMerge.get(),
+                                           MergeMEGAFolders::Rename,
+                                           cloud.getNodeSource()));
+
+    REQUIRE(plan.dryRun() == QStringList({QString::fromUtf8("remove \"same\""),
+                                          QString::fromUtf8("move \"different\" to \"photos\" as "
+                                                            "\"different(1)\""),
+                                          QString::fromUtf8("move \"new\" to \"photos\""),
+                                          QString::fromUtf8("remove \"photos\"")}));
+    REQUIRE(plan.contentOperations.size() == 3);
+    REQUIRE(plan.finishOperations.size() == 1);
+    REQUIRE(plan.finishOperations.front().node->getHandle() == toMerge->getHandle());
+}
+
+TEST_CASE("Nested folders with the same name are merged and removed with their parent")
+{
+    FakeCloud cloud;
+    auto target(cloud.addFolder(ROOT_HANDLE, "docs"));
+    auto toMerge(cloud.addFolder(ROOT_HANDLE, "docs"));
+    auto targetNested(cloud.addFolder(target->getHandle(), "2024"));
+    auto nestedToMerge(cloud.addFolder(toMerge->getHandle(), "2024"));
+    cloud.addFile(nestedToMerge->getHandle(), "invoice", "fp1");
+
+    const auto plan(MergeMEGAFolders::plan(target.get(),
+                                           toMerge.get(),
+                                           MergeMEGAFolders::Rename,
+                                           cloud.getNodeSource()));
+
+    REQUIRE(plan.dryRun() == QStringList({QString::fromUtf8("move \"invoice\" to \"2024\""),
+                                          QString::fromUtf8("remove \"docs\"")}));
+    REQUIRE(plan.finishOperations.front().node->getHandle() == toMerge->getHandle());
+}
+
+TEST_CASE("New names skip the names in the folder and the ones given by the plan")
+{
+    FakeCloud cloud;
+    auto target(cloud.addFolder(ROOT_HANDLE, "music"));
+    auto firstToMerge(cloud.addFolder(ROOT_HANDLE, "music"));
+    auto secondToMerge(cloud.addFolder(ROOT_HANDLE, "music"));
+
+    cloud.addFile(target->getHandle(), "song", "fp1");
+    cloud.addFile(target->getHandle(), "song(1)", "fp2");
+    cloud.addFile(firstToMerge->getHandle(), "song", "fp3");
+    cloud.addFile(secondToMerge->getHandle(), "song", "fp4");
+    cloud.addFile(secondToMerge->getHandle(), "song.txt", "fp5");
+    cloud.addFile(target->getHandle(), "song.txt", "fp6");
+
+    const auto plan(MergeMEGAFolders::plan(target.get(),
+                                           nullptr,
+                                           MergeMEGAFolders::Rename,
+                                           cloud.getNodeSource()));
+
+    const auto newNames(getNewNames(plan));
+    REQUIRE(newNames.size() == 3);
+    REQUIRE(newNames.at(0) == QString::fromUtf8("song(2)"));
+    REQUIRE(newNames.at(1) == QString::fromUtf8("song(3)"));
+    REQUIRE(newNames.at(2) != QString::fromUtf8("song.txt"));
+    REQUIRE(newNames.at(2).startsWith(QString::fromUtf8("song")));
+
+    // Both merged folders are empty once their content is moved
+    REQUIRE(plan.finishOperations.size() == 2);
+    for (const auto& operation : plan.finishOperations)
+    {
+        REQUIRE(operation.type == MergeMEGAFolders::Operation::Type::Remove);
+    }
+}
+
+TEST_CASE("A file with the name of the target folder follows the action for duplicates")
+{
+    FakeCloud cloud;
+    auto target(cloud.addFolder(ROOT_HANDLE, "backup"));
+    auto file(cloud.addFile(ROOT_HANDLE, "backup", "fp1"));
+
+    auto planWith = [&](MergeMEGAFolders::ActionForDuplicates action)
+    {
+        return MergeMEGAFolders::plan(target.get(), nullptr, action, cloud.getNodeSource());
+    };
+
+    SECTION("Rename")
+    {
+        const auto plan(planWith(MergeMEGAFolders::Rename));
+        REQUIRE(plan.contentOperations.isEmpty());
+        REQUIRE(plan.finishOperations.size() == 1);
+
+        const auto& operation(plan.finishOperations.front());
+        REQUIRE(operation.type == MergeMEGAFolders::Operation::Type::MoveAndRename);
+        REQUIRE(operation.node->getHandle() == file->getHandle());
+        REQUIRE(operation.targetFolder->getHandle() == ROOT_HANDLE);
+        REQUIRE(operation.newName == QString::fromUtf8("backup(1)"));
+    }
+
+    SECTION("Remove")
+    {
+        const auto plan(planWith(MergeMEGAFolders::IgnoreAndRemove));
+        REQUIRE(plan.dryRun() == QStringList({QString::fromUtf8("remove \"backup\"")}));
+    }
+
+    SECTION("Move to bin")
+    {
+        const auto plan(planWith(MergeMEGAFolders::IgnoreAndMoveToBin));
+        REQUIRE(plan.dryRun() == QStringList({QString::fromUtf8("move \"backup\" to bin")}));
+    }
+}
+
+TEST_CASE("Planning reads every folder once and changes nothing")
+{
+    FakeCloud cloud;
+    auto target(cloud.addFolder(ROOT_HANDLE, "work"));
+    auto toMerge(cloud.addFolder(ROOT_HANDLE, "work"));
+    for (int i = 0; i < 50; i++)
+    {
+        cloud.addFile(target->getHandle(), "file_" + std::to_string(i), "fp" + std::to_string(i));
+        cloud.addFile(toMerge->getHandle(), "file_" + std::to_string(i), "other");
+    }
+
+    const auto firstPlan(MergeMEGAFolders::plan(target.get(),
+                                                toMerge.get(),
+                                                MergeMEGAFolders::Rename,
+                                                cloud.getNodeSource()));
+
+    REQUIRE(firstPlan.contentOperations.size() == 50);
+    REQUIRE(cloud.mChildrenReads.value(target->getHandle()) == 1);
+    REQUIRE(cloud.mChildrenReads.value(toMerge->getHandle()) == 1);
+
+    // The names given by a plan are not taken until it is executed
+    const auto secondPlan(MergeMEGAFolders::plan(target.get(),
+                                                 toMerge.get(),
+                                                 MergeMEGAFolders::Rename,
+                                                 cloud.getNodeSource()));
+    REQUIRE(secondPlan.dryRun() == firstPlan.dryRun());
+}
@@ -0,0 +1,206 @@
+#include <catch.hpp>
+#include "SetElementPipeline.h"
+
+#include <QHash>
+#include <QVector>
+
+#include <algorithm>
+#include <deque>
+#include <functional>
+
+namespace
+{
+// Stands for the MegaApi of a public Set in preview: the Element requests are answered later,
+// in the order they were sent, as the SDK does
+class FakeSetApi
+{
+public:
+    // Synthetic Set: every tenth Element is a duplicate of the previous one
+    explicit FakeSetApi(int nrElements)
+    {
+        for (int i = 0; i < nrElements; i++)
+        {
+            mElements.push_back(static_cast<mega::MegaHandle>(1000 + i - (i % 10 == 9 ? 1 : 0)));
+        }
+    }
+
+    const QList<mega::MegaHandle>& getPublicSetElementsInPreview() const
+    {
+        return mElements;
+    }
+
+    void getPreviewElementNode(mega::MegaHandle elementHandle)
+    {
+        mPendingResponses.push_back(elementHandle);
+        mMaxPendingResponses = std::max(mMaxPendingResponses,
+                                        static_cast<int>(mPendingResponses.size()));
+    }
+
+    // Answers the oldest request. Returns false if there are no requests to answer.
+    bool answerNext(std::function<void(mega::MegaHandle)> responseFunc)
+    {
+        if (mPendingResponses.empty())
+        {
+            return false;
+        }
+
+        auto elementHandle(mPendingResponses.front());
+        mPendingResponses.pop_front();
+        responseFunc(elementHandle);
+        return true;
+    }
+
+    int getMaxPendingResponses() const
+    {
+        return mMaxPendingResponses;
+    }
+
+private:
+    QList<mega::MegaHandle> mElements;
+    std::deque<mega::MegaHandle> mPendingResponses;
+    int mMaxPendingResponses = 0;
+};
+}
+
+TEST_CASE("Set Elements are selected without duplicates")
+{
+    FakeSetApi api(50000);
+    const auto& setElements(api.getPublicSetElementsInPreview());
+
+    SECTION("All Elements when none is requested")
+    {
+        const auto selected(SetElementPipeline::selectElements(setElements, {}));
+        REQUIRE(selected.size() == 45000);
+        REQUIRE(std::is_sorted(selected.cbegin(), selected.cend()));
+        REQUIRE(std::adjacent_find(selected.cbegin(), selected.cend()) == selected.cend());
+    }
+
+    SECTION("Only the requested Elements, in the order of the Set")
+    {
+        QList<mega::MegaHandle> requested;
+        for (int i = 49999; i >= 0; i -= 2)
+        {
+            requested.push_back(static_cast<mega::MegaHandle>(1000 + i));
+        }
+        // Not in the Set
+        requested.push_back(static_cast<mega::MegaHandle>(1));
+
+        const auto selected(SetElementPipeline::selectElements(setElements, requested));
+        REQUIRE(selected.size() == 20000);
+        REQUIRE(selected.first() == 1001);
+        REQUIRE(selected.last() == 50997);
+        REQUIRE(std::is_sorted(selected.cbegin(), selected.cend()));
+    }
+}
+
+TEST_CASE("Set Element nodes are fetched through a bounded window")
+{
+    FakeSetApi api(50000);
+    const auto elements(
+        SetElementPipeline::selectElements(api.getPublicSetElementsInPreview(), {}));
+
+    const int maxPendingRequests(16);
+    SetElementPipeline pipeline(maxPendingRequests);
+
+    QHash<mega::MegaHandle, int> indexByHandle;
+    for (int i = 0; i < elements.size(); i++)
+    {
+        indexByHandle.insert(elements.at(i), i);
+    }
+
+    QVector<mega::MegaHandle> fetched(elements.size(), mega::INVALID_HANDLE);
+    int progressEvents(0);
+    bool lastRequestReported(false);
+    pipeline.start(elements.size(),
+                   [&api, &elements](int index)
+                   {
+                       api.getPreviewElementNode(elements.at(index));
+                   });
+
+    while (api.answerNext(
+        [&](mega::MegaHandle elementHandle)
+        {
+            const auto index(indexByHandle.value(elementHandle, -1));
+            REQUIRE(index >= 0);
+            fetched[index] = elementHandle;
+
+            REQUIRE_FALSE(lastRequestReported);
+            lastRequestReported = pipeline.onRequestFinished();
+            progressEvents++;
+        }))
+    {}
+
+    REQUIRE(lastRequestReported);
+    REQUIRE_FALSE(pipeline.isRunning());
+    REQUIRE(pipeline.getFinished() == elements.size());
+    REQUIRE(progressEvents == elements.size());
+    REQUIRE(fetched.toList() == elements);
+    REQUIRE(api.getMaxPendingResponses() == maxPendingRequests);
+}
+
+TEST_CASE("Set Elements finished from inside the request function")
+{
+    // E.g. Elements that already exist in the import destination
+    const int nrElements(200000);
+    SetElementPipeline pipeline(8);
+
+    int requested(0);
+    int maxPending(0);
+    pipeline.start(nrElements,
+                   [&](int index)
+                   {
+                       REQUIRE(index == requested);
+                       requested++;
+                       maxPending = std::max(maxPending, pipeline.getPending());
+                       pipeline.onRequestFinished();
+                   });
+
+    REQUIRE(requested == nrElements);
+    REQUIRE(maxPending == 1);
+    REQUIRE_FALSE(pipeline.isRunning());
+}
+
+TEST_CASE("Set Element responses after clearing the pipeline are ignored")
+{
+    FakeSetApi api(1000);
+    const auto elements(
+        SetElementPipeline::selectElements(api.getPublicSetElementsInPreview(), {}));
+
+    SetElementPipeline pipeline(4);
+    pipeline.start(elements.size(),
+                   [&api, &elements](int index)
+                   {
+                       api.getPreviewElementNode(elements.at(index));
+                   });
+
+    REQUIRE(pipeline.getPending() == 4);
+    pipeline.clear();
+
+    int answered(0);
+    while (api.answerNext(
+        [&](mega::MegaHandle)
+        {
+            REQUIRE_FALSE(pipeline.onRequestFinished());
+            answered++;
+        }))
+    {}
+
+    REQUIRE(answered == 4);
+    REQUIRE(pipeline.getFinished() == 0);
+    REQUIRE(api.getMaxPendingResponses() == 4);
+}
+
+TEST_CASE("Empty Sets do not send requests")
+{
+    SetElementPipeline pipeline;
+    bool requested(false);
+    pipeline.start(0,
+                   [&requested](int)
+                   {
+                       requested = true;
+                   });
+
+    REQUIRE_FALSE(requested);
+    REQUIRE_FALSE(pipeline.isRunning());
+    REQUIRE_FALSE(pipeline.onRequestFinished());
+}
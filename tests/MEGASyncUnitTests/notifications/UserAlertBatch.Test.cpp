@@ -0,0 +1,101 @@
+#include <catch.hpp>
+#include "FakeSdkObjects.h"
+#include "UserAlertBatch.h"
+
+#include <vector>
+
+namespace
+{
+// Backlog received after reconnecting: a contact that shared a folder and kept adding files
+// to it, and a few alerts of other users and types
+std::vector<FakeMegaUserAlert> createBacklog()
+{
+    std::vector<FakeMegaUserAlert> backlog;
+    unsigned id(0);
+    for (int i = 0; i < 50; i++)
+    {
+        backlog.emplace_back(++id, mega::MegaUserAlert::TYPE_NEWSHAREDNODES, 1, 100);
+    }
+    for (int i = 0; i < 3; i++)
+    {
+        backlog.emplace_back(++id, mega::MegaUserAlert::TYPE_NEWSHARE, 1, 200 + i);
+    }
+    backlog.emplace_back(++id, mega::MegaUserAlert::TYPE_NEWSHAREDNODES, 1, 101);
+    backlog.emplace_back(++id,
+                         mega::MegaUserAlert::TYPE_INCOMINGPENDINGCONTACT_REQUEST,
+                         2,
+                         mega::INVALID_HANDLE,
+                         "contact@mega.co.nz");
+    backlog.emplace_back(++id,
+                         mega::MegaUserAlert::TYPE_CONTACTCHANGE_CONTACTESTABLISHED,
+                         2,
+                         mega::INVALID_HANDLE,
+                         "contact@mega.co.nz");
+    backlog.emplace_back(++id, mega::MegaUserAlert::TYPE_TAKEDOWN, mega::INVALID_HANDLE, 300);
+    backlog.emplace_back(++id, mega::MegaUserAlert::TYPE_TAKEDOWN, mega::INVALID_HANDLE, 301);
+    return backlog;
+}
+}
+
+TEST_CASE("User alerts are grouped by user and type")
+{
+    const auto backlog(createBacklog());
+    UserAlertBatch batch;
+    for (const auto& alert : backlog)
+    {
+        batch.addAlert(&alert);
+    }
+
+    REQUIRE(batch.getAlertCount() == static_cast<int>(backlog.size()));
+    const auto groups(batch.takeGroups());
+    REQUIRE(batch.isEmpty());
+    REQUIRE(batch.getAlertCount() == 0);
+
+    // Items added to a folder, the new shares, items added to another folder, the contact
+    // alerts and the take downs, which are never coalesced
+    REQUIRE(groups.size() == 7);
+    REQUIRE(groups[0].type == mega::MegaUserAlert::TYPE_NEWSHAREDNODES);
+    REQUIRE(groups[0].alerts.size() == 50);
+    REQUIRE(groups[1].type == mega::MegaUserAlert::TYPE_NEWSHARE);
+    REQUIRE(groups[1].alerts.size() == 3);
+    REQUIRE(groups[2].alerts.size() == 1);
+    REQUIRE(groups[2].alerts.front()->getNodeHandle() == 101);
+
+    REQUIRE(groups[3].type == mega::MegaUserAlert::TYPE_INCOMINGPENDINGCONTACT_REQUEST);
+    REQUIRE(groups[3].email == QLatin1String("contact@mega.co.nz"));
+    REQUIRE(groups[4].type == mega::MegaUserAlert::TYPE_CONTACTCHANGE_CONTACTESTABLISHED);
+    REQUIRE(groups[5].alerts.size() == 1);
+    REQUIRE(groups[6].alerts.size() == 1);
+    REQUIRE(groups[6].userHandle == mega::INVALID_HANDLE);
+    REQUIRE(groups[6].email.isEmpty());
+}
+
+TEST_CASE("User alerts received again are batched once")
+{
+    const auto backlog(createBacklog());
+    UserAlertBatch batch;
+    for (int i = 0; i < 2; i++)
+    {
+        for (const auto& alert : backlog)
+        {
+            batch.addAlert(&alert);
+        }
+    }
+
+    REQUIRE(batch.getAlertCount() == static_cast<int>(backlog.size()));
+    const auto groups(batch.takeGroups());
+    REQUIRE(groups[0].alerts.size() == 50);
+
+    // Once sent, the next batch starts from scratch
+    batch.addAlert(&backlog.front());
+    REQUIRE(batch.getAlertCount() == 1);
+}
+
+TEST_CASE("Only some user alert types are coalesced")
+{
+    REQUIRE(UserAlertBatch::canBeCoalesced(mega::MegaUserAlert::TYPE_NEWSHARE));
+    REQUIRE(UserAlertBatch::canBeCoalesced(mega::MegaUserAlert::TYPE_NEWSHAREDNODES));
+    REQUIRE_FALSE(
+        UserAlertBatch::canBeCoalesced(mega::MegaUserAlert::TYPE_INCOMINGPENDINGCONTACT_REQUEST));
+    REQUIRE_FALSE(UserAlertBatch::canBeCoalesced(mega::MegaUserAlert::TYPE_TAKEDOWN));
+}
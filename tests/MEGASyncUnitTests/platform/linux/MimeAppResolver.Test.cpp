@@ -0,0 +1,125 @@
+#include <catch.hpp>
+#include "MimeAppResolver.h"
+
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QTemporaryDir>
+
+namespace
+{
+void writeFile(const QString& path, const char* contents)
+{
+    QDir().mkpath(QFileInfo(path).absolutePath());
+    QFile file(path);
+    REQUIRE(file.open(QFile::WriteOnly | QFile::Truncate));
+    file.write(contents);
+}
+
+void writeDesktopFile(const QString& path, const char* exec, const char* mimeTypes)
+{
+    const QByteArray contents = QByteArray("[Desktop Entry]\nType=Application\nExec=") + exec
+                                + "\nMimeType=" + mimeTypes + "\n";
+    writeFile(path, contents.constData());
+}
+
+// Fixture XDG tree: a user config dir, a system config dir, a user data dir and a system data dir
+struct XdgTree
+{
+    QTemporaryDir root;
+    MimeAppResolver::XdgDirs dirs;
+
+    XdgTree()
+    {
+        REQUIRE(root.isValid());
+        dirs.configDirs = {path("config"), path("etc/xdg")};
+        dirs.dataDirs = {path("local/share"), path("usr/share")};
+        dirs.desktops = {QString::fromUtf8("gnome")};
+
+        writeDesktopFile(path("usr/share/applications/nautilus.desktop"),
+                         "nautilus --new-window %U", "inode/directory;");
+        writeDesktopFile(path("usr/share/applications/vlc.desktop"),
+                         "/usr/bin/vlc --started-from-file %U", "video/mp4;audio/mpeg;");
+        writeDesktopFile(path("usr/share/applications/kde4/dolphin.desktop"),
+                         "dolphin %u", "inode/directory;");
+        writeDesktopFile(path("usr/share/applications/mpv.desktop"),
+                         "\"/opt/my apps/mpv\" %U", "video/mp4;");
+    }
+
+    QString path(const char* relativePath) const
+    {
+        return root.path() + QLatin1Char('/') + QString::fromUtf8(relativePath);
+    }
+};
+
+const QString DIRECTORY = QString::fromUtf8("inode/directory");
+const QString MP4 = QString::fromUtf8("video/mp4");
+}
+
+TEST_CASE("MimeAppResolver falls back to the MimeType of the desktop files")
+{
+    XdgTree tree;
+    MimeAppResolver resolver(tree.dirs);
+
+    // kde4/dolphin.desktop sorts before nautilus.desktop
+    CHECK(resolver.getDefaultDesktopId(DIRECTORY) == QString::fromUtf8("kde4-dolphin.desktop"));
+    CHECK(resolver.getDefaultCommand(DIRECTORY) == QString::fromUtf8("dolphin"));
+    CHECK(resolver.getDefaultCommand(QString::fromUtf8("audio/mpeg"))
+          == QString::fromUtf8("/usr/bin/vlc"));
+    CHECK(resolver.getDefaultCommand(QString::fromUtf8("text/plain")).isEmpty());
+}
+
+TEST_CASE("MimeAppResolver honours the mimeapps.list precedence")
+{
+    XdgTree tree;
+    writeFile(tree.path("usr/share/applications/defaults.list"),
+              "[Default Applications]\ninode/directory=nautilus.desktop\n");
+    writeFile(tree.path("etc/xdg/mimeapps.list"),
+              "[Default Applications]\nvideo/mp4=vlc.desktop\n");
+    writeFile(tree.path("config/gnome-mimeapps.list"),
+              "[Default Applications]\nvideo/mp4=missing.desktop;mpv.desktop;\n");
+
+    MimeAppResolver resolver(tree.dirs);
+
+    CHECK(resolver.getDefaultDesktopId(DIRECTORY) == QString::fromUtf8("nautilus.desktop"));
+    // Uninstalled applications are skipped, and quoted paths kept whole
+    CHECK(resolver.getDefaultDesktopId(MP4) == QString::fromUtf8("mpv.desktop"));
+    CHECK(resolver.getDefaultCommand(MP4) == QString::fromUtf8("/opt/my apps/mpv"));
+}
+
+TEST_CASE("MimeAppResolver applies added and removed associations")
+{
+    XdgTree tree;
+    writeFile(tree.path("config/mimeapps.list"),
+              "[Added Associations]\ninode/directory=nautilus.desktop;\n"
+              "[Removed Associations]\nvideo/mp4=vlc.desktop;\n");
+    writeFile(tree.path("usr/share/applications/mimeapps.list"),
+              "[Added Associations]\nvideo/mp4=vlc.desktop;\n");
+
+    MimeAppResolver resolver(tree.dirs);
+
+    CHECK(resolver.getDefaultDesktopId(DIRECTORY) == QString::fromUtf8("nautilus.desktop"));
+    CHECK(resolver.getDefaultDesktopId(MP4) == QString::fromUtf8("mpv.desktop"));
+}
+
+TEST_CASE("MimeAppResolver lets user desktop files shadow and hide the system ones")
+{
+    XdgTree tree;
+    writeFile(tree.path("local/share/applications/kde4/dolphin.desktop"),
+              "[Desktop Entry]\nHidden=true\n");
+    writeDesktopFile(tree.path("local/share/applications/vlc.desktop"),
+                     "/home/user/bin/vlc %U", "audio/mpeg;");
+
+    MimeAppResolver resolver(tree.dirs);
+
+    CHECK(resolver.getDefaultDesktopId(DIRECTORY) == QString::fromUtf8("nautilus.desktop"));
+    CHECK(resolver.getDefaultCommand(QString::fromUtf8("audio/mpeg"))
+          == QString::fromUtf8("/home/user/bin/vlc"));
+    CHECK(resolver.getDefaultDesktopId(MP4) == QString::fromUtf8("mpv.desktop"));
+
+    // Changes are picked up after invalidating the index
+    writeFile(tree.path("config/mimeapps.list"),
+              "[Default Applications]\nvideo/mp4=vlc.desktop\n");
+    resolver.invalidate();
+    CHECK(resolver.getDefaultDesktopId(MP4) == QString::fromUtf8("vlc.desktop"));
+}
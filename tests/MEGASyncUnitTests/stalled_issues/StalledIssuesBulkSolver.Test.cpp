@@ -0,0 +1,317 @@
+#include <catch.hpp>
+#include "StalledIssuesBulkSolver.h"
+
+#include <QStringList>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <iterator>
+#include <map>
+#include <mutex>
+#include <thread>
+
+namespace
+{
+using Result = StalledIssuesBulkSolver::Result;
+
+// Stall list recorded after a migration that left name conflicts in a few folders of two syncs:
+// sync id|parent folder|name|what the solver finds (solve, fail or external)
+const char* RECORDED_STALLS = R"(
+1|/Photos/2019|IMG_0001.jpg|solve
+1|/Photos/2019|IMG_0002.jpg|solve
+1|/Photos/2020|IMG_0100.jpg|solve
+1|/Photos/2019|IMG_0003.jpg|external
+1|/Photos/2021|IMG_0200.jpg|solve
+2|/Photos/2019|IMG_0001.jpg|solve
+1|/Photos/2020|IMG_0101.jpg|fail
+1|/Documents|report.pdf|solve
+2|/Photos/2019|IMG_0002.jpg|solve
+1|/Photos/2021|IMG_0201.jpg|solve
+2|/Music|song.mp3|solve
+1|/Photos/2019|IMG_0004.jpg|solve
+1|/Documents|notes.txt|external
+2|/Music|other song.mp3|solve
+1|/Photos/2020|IMG_0102.jpg|solve
+2|/Videos|clip.mp4|fail
+)";
+
+struct RecordedStall
+{
+    QString groupKey;
+    QString name;
+    Result expectedResult = Result::NOT_RUN;
+};
+
+std::vector<RecordedStall> loadRecordedStalls()
+{
+    std::vector<RecordedStall> stalls;
+    const auto lines(QString::fromUtf8(RECORDED_STALLS).split(QLatin1Char('\n')));
+    for (const auto& line : lines)
+    {
+        const auto fields(line.split(QLatin1Char('|')));
+        if (fields.size() != 4)
+        {
+            continue;
+        }
+
+        RecordedStall stall;
+        stall.groupKey = fields[0] + QLatin1Char(':') + fields[1];
+        stall.name = fields[2];
+        if (fields[3] == QLatin1String("solve"))
+        {
+            stall.expectedResult = Result::SOLVED;
+        }
+        else if (fields[3] == QLatin1String("fail"))
+        {
+            stall.expectedResult = Result::FAILED;
+        }
+        else
+        {
+            stall.expectedResult = Result::EXTERNALLY_CHANGED;
+        }
+        stalls.push_back(stall);
+    }
+    return stalls;
+}
+
+// Stands for the SDK round trips of the solvers, keeping track of what ran at the same time
+class FakeSdk
+{
+public:
+    explicit FakeSdk(std::chrono::milliseconds latency):
+        mLatency(latency)
+    {}
+
+    bool request(const QString& groupKey, bool succeeds)
+    {
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            if (++mRunningByGroup[groupKey] > 1)
+            {
+                mSameGroupOverlap = true;
+            }
+            mMaxRunning = std::max(mMaxRunning, ++mRunning);
+        }
+
+        std::this_thread::sleep_for(mLatency);
+
+        std::lock_guard<std::mutex> lock(mMutex);
+        --mRunningByGroup[groupKey];
+        --mRunning;
+        return succeeds;
+    }
+
+    int getMaxRunning() const
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        return mMaxRunning;
+    }
+
+    bool hadSameGroupOverlap() const
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        return mSameGroupOverlap;
+    }
+
+private:
+    std::chrono::milliseconds mLatency;
+    mutable std::mutex mMutex;
+    std::map<QString, int> mRunningByGroup;
+    int mRunning = 0;
+    int mMaxRunning = 0;
+    bool mSameGroupOverlap = false;
+};
+
+std::vector<StalledIssuesBulkSolver::Job> createJobs(const std::vector<RecordedStall>& stalls,
+                                                     FakeSdk& sdk)
+{
+    std::vector<StalledIssuesBulkSolver::Job> jobs;
+    for (const auto& stall : stalls)
+    {
+        StalledIssuesBulkSolver::Job job;
+        job.groupKey = stall.groupKey;
+        job.solveFunc = [&sdk, stall]()
+        {
+            if (stall.expectedResult == Result::EXTERNALLY_CHANGED)
+            {
+                return Result::EXTERNALLY_CHANGED;
+            }
+            return sdk.request(stall.groupKey, stall.expectedResult == Result::SOLVED) ?
+                       Result::SOLVED :
+                       Result::FAILED;
+        };
+        jobs.push_back(job);
+    }
+    return jobs;
+}
+
+void runInNewThread(std::function<void()> task)
+{
+    std::thread(std::move(task)).detach();
+}
+}
+
+TEST_CASE("Bulk solver replays a recorded stall list")
+{
+    const auto stalls(loadRecordedStalls());
+    REQUIRE(stalls.size() == 16);
+
+    FakeSdk sdk(std::chrono::milliseconds(20));
+    const int maxParallelGroups(3);
+    StalledIssuesBulkSolver solver(maxParallelGroups, runInNewThread);
+
+    const auto callerThread(std::this_thread::get_id());
+    std::vector<int> finishedJobs;
+    bool callbacksInCallerThread(true);
+    solver.setFinishedFunc(
+        [&](int jobIndex, Result)
+        {
+            callbacksInCallerThread &= std::this_thread::get_id() == callerThread;
+            finishedJobs.push_back(jobIndex);
+        });
+
+    StalledIssuesBulkSolver::Progress lastProgress;
+    solver.setProgressFunc(
+        [&](const StalledIssuesBulkSolver::Progress& progress)
+        {
+            callbacksInCallerThread &= std::this_thread::get_id() == callerThread;
+            REQUIRE(progress.finished >= lastProgress.finished);
+            lastProgress = progress;
+        });
+
+    const auto results(solver.solve(createJobs(stalls, sdk)));
+
+    REQUIRE(results.size() == stalls.size());
+    for (size_t index = 0; index < stalls.size(); ++index)
+    {
+        REQUIRE(results[index] == stalls[index].expectedResult);
+    }
+
+    REQUIRE(finishedJobs.size() == stalls.size());
+    REQUIRE(callbacksInCallerThread);
+    REQUIRE(lastProgress.finished == lastProgress.total);
+    REQUIRE(lastProgress.total == static_cast<int>(stalls.size()));
+    REQUIRE(lastProgress.issuesPerSecond > 0.0);
+
+    // The issues of a folder never run at the same time, the folders do
+    REQUIRE_FALSE(sdk.hadSameGroupOverlap());
+    REQUIRE(sdk.getMaxRunning() > 1);
+    REQUIRE(sdk.getMaxRunning() <= maxParallelGroups);
+}
+
+TEST_CASE("Bulk solver keeps the order of the issues of each folder")
+{
+    const auto stalls(loadRecordedStalls());
+    FakeSdk sdk(std::chrono::milliseconds(1));
+    StalledIssuesBulkSolver solver(4, runInNewThread);
+
+    std::map<QString, int> lastJobByGroup;
+    bool inOrder(true);
+    solver.setFinishedFunc(
+        [&](int jobIndex, Result)
+        {
+            const auto& groupKey(stalls[static_cast<size_t>(jobIndex)].groupKey);
+            auto lastJobIt(lastJobByGroup.find(groupKey));
+            if (lastJobIt != lastJobByGroup.end() && lastJobIt->second > jobIndex)
+            {
+                inOrder = false;
+            }
+            lastJobByGroup[groupKey] = jobIndex;
+        });
+
+    solver.solve(createJobs(stalls, sdk));
+    REQUIRE(inOrder);
+}
+
+TEST_CASE("Bulk solver solves the issues of nested folders one after the other")
+{
+    // Group key and the key of its outermost folder
+    const std::vector<std::pair<QString, QString>> keys = {
+        {QString::fromUtf8("1:/Photos/2019"), QString::fromUtf8("1:/Photos")},
+        {QString::fromUtf8("1:/Photos 2019"), QString::fromUtf8("1:/Photos 2019")},
+        {QString::fromUtf8("1:/Photos"), QString::fromUtf8("1:/Photos")},
+        {QString::fromUtf8("2:/Photos/2019"), QString::fromUtf8("2:/Photos/2019")},
+        {QString::fromUtf8("1:/Photos/2019/Trip"), QString::fromUtf8("1:/Photos")},
+        {QString::fromUtf8("1:/Photos 2019/Trip"), QString::fromUtf8("1:/Photos 2019")},
+        {QString::fromUtf8("1:/Photos/2020"), QString::fromUtf8("1:/Photos")},
+        {QString::fromUtf8("2:/Photos/2019/Trip"), QString::fromUtf8("2:/Photos/2019")}};
+
+    FakeSdk sdk(std::chrono::milliseconds(20));
+    std::vector<StalledIssuesBulkSolver::Job> jobs;
+    for (const auto& key : keys)
+    {
+        StalledIssuesBulkSolver::Job job;
+        job.groupKey = key.first;
+        job.solveFunc = [&sdk, rootKey = key.second]()
+        {
+            return sdk.request(rootKey, true) ? Result::SOLVED : Result::FAILED;
+        };
+        jobs.push_back(job);
+    }
+
+    StalledIssuesBulkSolver solver(4, runInNewThread);
+    std::vector<int> finishedJobs;
+    solver.setFinishedFunc(
+        [&finishedJobs](int jobIndex, Result)
+        {
+            finishedJobs.push_back(jobIndex);
+        });
+
+    const auto results(solver.solve(jobs));
+    REQUIRE(std::count(results.cbegin(), results.cend(), Result::SOLVED) ==
+            static_cast<std::ptrdiff_t>(keys.size()));
+    REQUIRE_FALSE(sdk.hadSameGroupOverlap());
+    REQUIRE(sdk.getMaxRunning() > 1);
+
+    // The issues of "1:/Photos" keep the order received, the subfolders included
+    std::vector<int> photosJobs;
+    std::copy_if(finishedJobs.cbegin(),
+                 finishedJobs.cend(),
+                 std::back_inserter(photosJobs),
+                 [&keys](int jobIndex)
+                 {
+                     return keys[static_cast<size_t>(jobIndex)].second ==
+                            QString::fromUtf8("1:/Photos");
+                 });
+    REQUIRE(photosJobs == std::vector<int>({0, 2, 4, 6}));
+}
+
+TEST_CASE("Bulk solver does not start more issues once stopped")
+{
+    const auto stalls(loadRecordedStalls());
+    FakeSdk sdk(std::chrono::milliseconds(100));
+    StalledIssuesBulkSolver solver(2, runInNewThread);
+
+    std::atomic<bool> stop(false);
+    solver.setProgressFunc(
+        [&stop](const StalledIssuesBulkSolver::Progress&)
+        {
+            stop = true;
+        });
+    solver.setStopFunc(
+        [&stop]()
+        {
+            return stop.load();
+        });
+
+    const auto results(solver.solve(createJobs(stalls, sdk)));
+
+    const auto notRun(std::count(results.cbegin(), results.cend(), Result::NOT_RUN));
+    REQUIRE(notRun > 0);
+}
+
+TEST_CASE("Bulk solver with no issues")
+{
+    StalledIssuesBulkSolver solver(4, runInNewThread);
+    bool progressReported(false);
+    solver.setProgressFunc(
+        [&progressReported](const StalledIssuesBulkSolver::Progress&)
+        {
+            progressReported = true;
+        });
+
+    REQUIRE(solver.solve({}).empty());
+    REQUIRE_FALSE(progressReported);
+}
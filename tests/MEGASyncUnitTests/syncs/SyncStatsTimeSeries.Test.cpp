@@ -0,0 +1,198 @@
+#include <catch.hpp>
+#include "SyncStatsTimeSeries.h"
+
+#include <algorithm>
+
+namespace
+{
+const qint64 START_MS = 1700000000000;
+const qint64 SAMPLE_INTERVAL_MS = 30000;
+
+SyncStatsTimeSeries::StatsUpdate createUpdate(bool scanning,
+                                              bool syncing,
+                                              int pendingUploads = 0,
+                                              int pendingDownloads = 0)
+{
+    SyncStatsTimeSeries::StatsUpdate update;
+    update.scanning = scanning;
+    update.syncing = syncing;
+    update.pendingUploads = pendingUploads;
+    update.pendingDownloads = pendingDownloads;
+    return update;
+}
+
+// Synthetic sync that keeps scanning for 10 s, then uploads 1 MB/s for 50 s and repeats
+void feedActiveInterval(SyncStatsTimeSeries& timeSeries,
+                        mega::MegaHandle backupId,
+                        qint64 intervalStartMs)
+{
+    for (qint64 ms = 0; ms < SAMPLE_INTERVAL_MS; ms += 1000)
+    {
+        const qint64 nowMs(intervalStartMs + ms);
+        const bool scanning((nowMs - START_MS) % 60000 < 10000);
+        timeSeries.updateStats(backupId, createUpdate(scanning, !scanning, 5), nowMs);
+        if (!scanning)
+        {
+            timeSeries.addUploadedBytes(backupId, 1000000);
+        }
+    }
+}
+}
+
+TEST_CASE("Sync stats samples account the scanning and syncing time")
+{
+    SyncStatsTimeSeries timeSeries;
+    const mega::MegaHandle backupId(1);
+
+    timeSeries.updateStats(backupId, createUpdate(true, false), START_MS);
+    timeSeries.updateStats(backupId, createUpdate(false, true, 3, 2), START_MS + 12000);
+    timeSeries.addUploadedBytes(backupId, 3000000);
+    timeSeries.addDownloadedBytes(backupId, 600000);
+    timeSeries.updateStats(backupId, createUpdate(false, false, 1, 0), START_MS + 20000);
+
+    REQUIRE(timeSeries.takeSamples(START_MS + SAMPLE_INTERVAL_MS) == 1);
+
+    const auto samples(timeSeries.getSamples(backupId));
+    REQUIRE(samples.size() == 1);
+    const auto& sample(samples.front());
+    REQUIRE(sample.timestampMs == START_MS + SAMPLE_INTERVAL_MS);
+    REQUIRE(sample.intervalMs == SAMPLE_INTERVAL_MS);
+    REQUIRE(sample.scanningMs == 12000);
+    REQUIRE(sample.syncingMs == 8000);
+    REQUIRE(sample.finishedScanMs == 12000);
+    REQUIRE(sample.pendingUploads == 1);
+    REQUIRE(sample.pendingDownloads == 0);
+    REQUIRE(sample.uploadBytesPerSecond == 100000);
+    REQUIRE(sample.downloadBytesPerSecond == 20000);
+}
+
+TEST_CASE("Sync stats scans longer than a sample are measured when they finish")
+{
+    SyncStatsTimeSeries timeSeries;
+    const mega::MegaHandle backupId(1);
+
+    timeSeries.updateStats(backupId, createUpdate(true, false), START_MS);
+    timeSeries.takeSamples(START_MS + SAMPLE_INTERVAL_MS);
+    timeSeries.takeSamples(START_MS + 2 * SAMPLE_INTERVAL_MS);
+    timeSeries.updateStats(backupId, createUpdate(false, false), START_MS + 75000);
+    timeSeries.takeSamples(START_MS + 3 * SAMPLE_INTERVAL_MS);
+
+    const auto samples(timeSeries.getSamples(backupId));
+    REQUIRE(samples.size() == 3);
+    REQUIRE(samples[0].scanningMs == SAMPLE_INTERVAL_MS);
+    REQUIRE(samples[0].finishedScanMs == 0);
+    REQUIRE(samples[1].scanningMs == SAMPLE_INTERVAL_MS);
+    REQUIRE(samples[2].scanningMs == 15000);
+    REQUIRE(samples[2].finishedScanMs == 75000);
+}
+
+TEST_CASE("Sync stats are kept in a bounded ring buffer")
+{
+    const int capacity(10);
+    SyncStatsTimeSeries timeSeries(capacity);
+    const mega::MegaHandle backupId(1);
+
+    const int intervals(25);
+    for (int i = 0; i < intervals; i++)
+    {
+        const qint64 intervalStartMs(START_MS + i * SAMPLE_INTERVAL_MS);
+        feedActiveInterval(timeSeries, backupId, intervalStartMs);
+        REQUIRE(timeSeries.takeSamples(intervalStartMs + SAMPLE_INTERVAL_MS) == 1);
+    }
+
+    const auto samples(timeSeries.getSamples(backupId));
+    REQUIRE(static_cast<int>(samples.size()) == capacity);
+    REQUIRE(samples.front().timestampMs ==
+            START_MS + (intervals - capacity + 1) * SAMPLE_INTERVAL_MS);
+    REQUIRE(samples.back().timestampMs == START_MS + intervals * SAMPLE_INTERVAL_MS);
+    REQUIRE(std::is_sorted(samples.cbegin(),
+                           samples.cend(),
+                           [](const auto& first, const auto& second)
+                           {
+                               return first.timestampMs < second.timestampMs;
+                           }));
+}
+
+TEST_CASE("Idle syncs record a single idle sample")
+{
+    SyncStatsTimeSeries timeSeries;
+    const mega::MegaHandle backupId(1);
+
+    feedActiveInterval(timeSeries, backupId, START_MS);
+    timeSeries.updateStats(backupId,
+                           createUpdate(false, false),
+                           START_MS + SAMPLE_INTERVAL_MS - 1);
+    REQUIRE(timeSeries.takeSamples(START_MS + SAMPLE_INTERVAL_MS) == 1);
+
+    for (int i = 2; i < 10; i++)
+    {
+        timeSeries.takeSamples(START_MS + i * SAMPLE_INTERVAL_MS);
+    }
+    REQUIRE(timeSeries.getSamples(backupId).size() == 2);
+    REQUIRE(timeSeries.getSamples(backupId).back().isIdle());
+
+    // The skipped idle intervals are a gap, the next sample only covers its own interval
+    timeSeries.addDownloadedBytes(backupId, 1000);
+    REQUIRE(timeSeries.takeSamples(START_MS + 10 * SAMPLE_INTERVAL_MS) == 1);
+    REQUIRE(timeSeries.getSamples(backupId).back().intervalMs == SAMPLE_INTERVAL_MS);
+}
+
+TEST_CASE("Transferred bytes of syncs without stats are ignored")
+{
+    SyncStatsTimeSeries timeSeries;
+    timeSeries.addUploadedBytes(1, 1000);
+    REQUIRE(timeSeries.getBackupIds().isEmpty());
+    REQUIRE(timeSeries.takeSamples(START_MS) == 0);
+}
+
+TEST_CASE("Sync stats are saved and loaded")
+{
+    SyncStatsTimeSeries timeSeries(20);
+    for (int i = 0; i < 30; i++)
+    {
+        const qint64 intervalStartMs(START_MS + i * SAMPLE_INTERVAL_MS);
+        feedActiveInterval(timeSeries, 1, intervalStartMs);
+        feedActiveInterval(timeSeries, 2, intervalStartMs);
+        timeSeries.takeSamples(intervalStartMs + SAMPLE_INTERVAL_MS);
+    }
+
+    const QByteArray data(timeSeries.serialize());
+
+    SECTION("With the same capacity")
+    {
+        SyncStatsTimeSeries loaded(20);
+        REQUIRE(loaded.deserialize(data));
+        REQUIRE(loaded.getBackupIds().size() == 2);
+        for (const auto& backupId : timeSeries.getBackupIds())
+        {
+            const auto samples(timeSeries.getSamples(backupId));
+            const auto loadedSamples(loaded.getSamples(backupId));
+            REQUIRE(loadedSamples.size() == samples.size());
+            for (size_t i = 0; i < samples.size(); i++)
+            {
+                REQUIRE(loadedSamples[i].timestampMs == samples[i].timestampMs);
+                REQUIRE(loadedSamples[i].scanningMs == samples[i].scanningMs);
+                REQUIRE(loadedSamples[i].uploadBytesPerSecond ==
+                        samples[i].uploadBytesPerSecond);
+            }
+        }
+        REQUIRE(loaded.getSummary(1) == timeSeries.getSummary(1));
+    }
+
+    SECTION("With a smaller capacity the latest samples are kept")
+    {
+        SyncStatsTimeSeries loaded(5);
+        REQUIRE(loaded.deserialize(data));
+        const auto loadedSamples(loaded.getSamples(1));
+        REQUIRE(loadedSamples.size() == 5);
+        REQUIRE(loadedSamples.back().timestampMs == timeSeries.getSamples(1).back().timestampMs);
+    }
+
+    SECTION("Truncated data is discarded")
+    {
+        SyncStatsTimeSeries loaded;
+        REQUIRE_FALSE(loaded.deserialize(data.left(data.size() / 2)));
+        REQUIRE(loaded.getBackupIds().isEmpty());
+        REQUIRE_FALSE(loaded.deserialize(QByteArray("not a time series")));
+    }
+}
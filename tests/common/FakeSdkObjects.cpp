@@ -0,0 +1,381 @@
+#include "FakeSdkObjects.h"
+
+#include <array>
+
+using namespace mega;
+
+namespace
+{
+const std::array<const char*, 8> EXTENSIONS{".jpg", ".mp4", ".pdf", ".txt",
+                                            ".zip", ".mp3", ".docx", ""};
+
+const char* extension(int i)
+{
+    return EXTENSIONS[static_cast<size_t>(i) % EXTENSIONS.size()];
+}
+}
+
+// FakeMegaTransfer
+FakeMegaTransfer::FakeMegaTransfer(int tag,
+                                   int type,
+                                   const std::string& fileName,
+                                   long long totalBytes):
+    mTag(tag),
+    mType(type),
+    mFileName(fileName),
+    mPath("/tmp/megasync-benchmarks/" + fileName),
+    mParentPath("/tmp/megasync-benchmarks/"),
+    mTotalBytes(totalBytes)
+{}
+
+int FakeMegaTransfer::getType() const
+{
+    return mType;
+}
+
+int FakeMegaTransfer::getTag() const
+{
+    return mTag;
+}
+
+int FakeMegaTransfer::getState() const
+{
+    return mState;
+}
+
+const char* FakeMegaTransfer::getPath() const
+{
+    return mPath.c_str();
+}
+
+const char* FakeMegaTransfer::getParentPath() const
+{
+    return mParentPath.c_str();
+}
+
+const char* FakeMegaTransfer::getFileName() const
+{
+    return mFileName.c_str();
+}
+
+long long FakeMegaTransfer::getTotalBytes() const
+{
+    return mTotalBytes;
+}
+
+long long FakeMegaTransfer::getTransferredBytes() const
+{
+    return mTransferredBytes;
+}
+
+long long FakeMegaTransfer::getSpeed() const
+{
+    return mSpeed;
+}
+
+unsigned long long FakeMegaTransfer::getPriority() const
+{
+    return static_cast<unsigned long long>(mTag);
+}
+
+long long FakeMegaTransfer::getNotificationNumber() const
+{
+    return mTag;
+}
+
+MegaHandle FakeMegaTransfer::getNodeHandle() const
+{
+    return static_cast<MegaHandle>(mTag);
+}
+
+MegaHandle FakeMegaTransfer::getParentHandle() const
+{
+    return INVALID_HANDLE;
+}
+
+bool FakeMegaTransfer::isSyncTransfer() const
+{
+    return mSyncTransfer;
+}
+
+bool FakeMegaTransfer::isBackupTransfer() const
+{
+    return false;
+}
+
+bool FakeMegaTransfer::isStreamingTransfer() const
+{
+    return false;
+}
+
+bool FakeMegaTransfer::isFolderTransfer() const
+{
+    return false;
+}
+
+int FakeMegaTransfer::getFolderTransferTag() const
+{
+    return 0;
+}
+
+const char* FakeMegaTransfer::getAppData() const
+{
+    return nullptr;
+}
+
+// FakeMegaNode
+FakeMegaNode::FakeMegaNode(MegaHandle handle, int type, const std::string& name, int64_t size):
+    mHandle(handle),
+    mType(type),
+    mName(name),
+    mSize(size)
+{}
+
+MegaNode* FakeMegaNode::copy()
+{
+    return new FakeMegaNode(*this);
+}
+
+int FakeMegaNode::getType()
+{
+    return mType;
+}
+
+const char* FakeMegaNode::getName()
+{
+    return mName.c_str();
+}
+
+const char* FakeMegaNode::getFingerprint()
+{
+    return mFingerprint.c_str();
+}
+
+MegaHandle FakeMegaNode::getHandle()
+{
+    return mHandle;
+}
+
+MegaHandle FakeMegaNode::getParentHandle()
+{
+    return mParentHandle;
+}
+
+int64_t FakeMegaNode::getSize()
+{
+    return mSize;
+}
+
+bool FakeMegaNode::isFile()
+{
+    return mType == MegaNode::TYPE_FILE;
+}
+
+bool FakeMegaNode::isFolder()
+{
+    return mType != MegaNode::TYPE_FILE && mType != MegaNode::TYPE_UNKNOWN;
+}
+
+bool FakeMegaNode::isInShare()
+{
+    return false;
+}
+
+bool FakeMegaNode::isNodeKeyDecrypted()
+{
+    return true;
+}
+
+// FakeMegaSyncStall
+FakeMegaSyncStall::FakeMegaSyncStall(SyncStallReason reason,
+                                     const std::string& localPath,
+                                     const std::string& cloudPath):
+    mReason(reason),
+    mLocalPath(localPath),
+    mCloudPath(cloudPath)
+{}
+
+MegaSyncStall* FakeMegaSyncStall::copy() const
+{
+    return new FakeMegaSyncStall(*this);
+}
+
+MegaSyncStall::SyncStallReason FakeMegaSyncStall::reason() const
+{
+    return mReason;
+}
+
+const char* FakeMegaSyncStall::reasonDebugString() const
+{
+    return MegaSyncStall::reasonDebugString(mReason);
+}
+
+const char* FakeMegaSyncStall::path(bool cloudSide, int index) const
+{
+    if (index != 0)
+    {
+        return "";
+    }
+
+    return cloudSide ? mCloudPath.c_str() : mLocalPath.c_str();
+}
+
+MegaHandle FakeMegaSyncStall::cloudNodeHandle(int) const
+{
+    return INVALID_HANDLE;
+}
+
+unsigned int FakeMegaSyncStall::pathCount(bool) const
+{
+    return 1;
+}
+
+int FakeMegaSyncStall::pathProblem(bool, int) const
+{
+    return MegaSyncStall::SyncPathProblem::NoProblem;
+}
+
+bool FakeMegaSyncStall::couldSuggestIgnoreThisPath(bool, int) const
+{
+    return false;
+}
+
+bool FakeMegaSyncStall::detectedCloudSide() const
+{
+    return false;
+}
+
+size_t FakeMegaSyncStall::getHash() const
+{
+    return std::hash<std::string>()(mLocalPath) ^ std::hash<std::string>()(mCloudPath);
+}
+
+// FakeMegaSyncStallList
+MegaSyncStallList* FakeMegaSyncStallList::copy() const
+{
+    return new FakeMegaSyncStallList(*this);
+}
+
+const MegaSyncStall* FakeMegaSyncStallList::get(size_t i) const
+{
+    return i < mStalls.size() ? mStalls[i].get() : nullptr;
+}
+
+size_t FakeMegaSyncStallList::size() const
+{
+    return mStalls.size();
+}
+
+// FakeMegaUserAlert
+FakeMegaUserAlert::FakeMegaUserAlert(unsigned id,
+                                     int type,
+                                     MegaHandle userHandle,
+                                     MegaHandle nodeHandle,
+                                     const std::string& email):
+    mId(id),
+    mType(type),
+    mUserHandle(userHandle),
+    mNodeHandle(nodeHandle),
+    mEmail(email)
+{}
+
+MegaUserAlert* FakeMegaUserAlert::copy() const
+{
+    return new FakeMegaUserAlert(*this);
+}
+
+unsigned FakeMegaUserAlert::getId() const
+{
+    return mId;
+}
+
+int FakeMegaUserAlert::getType() const
+{
+    return mType;
+}
+
+MegaHandle FakeMegaUserAlert::getUserHandle() const
+{
+    return mUserHandle;
+}
+
+MegaHandle FakeMegaUserAlert::getNodeHandle() const
+{
+    return mNodeHandle;
+}
+
+const char* FakeMegaUserAlert::getEmail() const
+{
+    return mEmail.empty() ? nullptr : mEmail.c_str();
+}
+
+// Generators
+namespace FakeSdkObjects
+{
+std::vector<std::unique_ptr<FakeMegaTransfer>> createTransfers(int count, int firstTag)
+{
+    std::vector<std::unique_ptr<FakeMegaTransfer>> transfers;
+    transfers.reserve(static_cast<size_t>(count));
+
+    for (int i = 0; i < count; ++i)
+    {
+        auto tag(firstTag + i);
+        auto type(i % 2 ? MegaTransfer::TYPE_UPLOAD : MegaTransfer::TYPE_DOWNLOAD);
+        auto fileName("file_" + std::to_string(tag) + extension(i));
+        auto totalBytes(1024LL * (1 + (tag * 7919) % 100000));
+
+        auto transfer = std::make_unique<FakeMegaTransfer>(tag, type, fileName, totalBytes);
+        transfer->mTransferredBytes = totalBytes / (1 + i % 4);
+        transfer->mSpeed = 1024LL * (1 + i % 512);
+        transfer->mSyncTransfer = (i % 5 == 0);
+        transfers.push_back(std::move(transfer));
+    }
+
+    return transfers;
+}
+
+std::unique_ptr<MegaNodeList> createNodeList(int count, MegaHandle parentHandle)
+{
+    std::unique_ptr<MegaNodeList> nodes(MegaNodeList::createInstance());
+
+    for (int i = 0; i < count; ++i)
+    {
+        // One folder every four nodes, with handles that can not collide with the session ones
+        auto type(i % 4 ? MegaNode::TYPE_FILE : MegaNode::TYPE_FOLDER);
+        auto name("node_" + std::to_string(count - i) +
+                  (type == MegaNode::TYPE_FILE ? extension(i) : ""));
+
+        FakeMegaNode node(parentHandle + 1 + static_cast<MegaHandle>(i),
+                          type,
+                          name,
+                          type == MegaNode::TYPE_FILE ? 1024 * (1 + i % 1000) : 0);
+        node.mParentHandle = parentHandle;
+        nodes->addNode(&node);
+    }
+
+    return nodes;
+}
+
+std::unique_ptr<FakeMegaSyncStallList> createStallList(int count)
+{
+    static const std::array<MegaSyncStall::SyncStallReason, 4> REASONS{
+        MegaSyncStall::SyncStallReason::FileIssue,
+        MegaSyncStall::SyncStallReason::LocalAndRemoteChangedSinceLastSyncedState_userMustChoose,
+        MegaSyncStall::SyncStallReason::CannotCreateFolder,
+        MegaSyncStall::SyncStallReason::UploadIssue};
+
+    auto stalls = std::make_unique<FakeMegaSyncStallList>();
+    stalls->mStalls.reserve(static_cast<size_t>(count));
+
+    for (int i = 0; i < count; ++i)
+    {
+        auto name("stalled_" + std::to_string(i) + extension(i));
+        stalls->mStalls.push_back(
+            std::make_shared<FakeMegaSyncStall>(REASONS[static_cast<size_t>(i) % REASONS.size()],
+                                                "/tmp/megasync-benchmarks/sync/" + name,
+                                                "/sync/" + name));
+    }
+
+    return stalls;
+}
+}
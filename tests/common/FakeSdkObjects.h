@@ -0,0 +1,141 @@
+#ifndef FAKE_SDK_OBJECTS_H
+#define FAKE_SDK_OBJECTS_H
+
+#include "megaapi.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+/*
+ * Lightweight SDK objects used to feed the desktop app data structures without a logged in
+ * session, shared by the benchmarks and the unit tests. They only implement the getters the
+ * code under test reads; the rest keep the SDK default values.
+ */
+class FakeMegaTransfer: public mega::MegaTransfer
+{
+public:
+    FakeMegaTransfer(int tag, int type, const std::string& fileName, long long totalBytes);
+
+    int getType() const override;
+    int getTag() const override;
+    int getState() const override;
+    const char* getPath() const override;
+    const char* getParentPath() const override;
+    const char* getFileName() const override;
+    long long getTotalBytes() const override;
+    long long getTransferredBytes() const override;
+    long long getSpeed() const override;
+    unsigned long long getPriority() const override;
+    long long getNotificationNumber() const override;
+    mega::MegaHandle getNodeHandle() const override;
+    mega::MegaHandle getParentHandle() const override;
+    bool isSyncTransfer() const override;
+    bool isBackupTransfer() const override;
+    bool isStreamingTransfer() const override;
+    bool isFolderTransfer() const override;
+    int getFolderTransferTag() const override;
+    const char* getAppData() const override;
+
+    int mTag;
+    int mType;
+    int mState = mega::MegaTransfer::STATE_ACTIVE;
+    std::string mFileName;
+    std::string mPath;
+    std::string mParentPath;
+    long long mTotalBytes;
+    long long mTransferredBytes = 0;
+    long long mSpeed = 0;
+    bool mSyncTransfer = false;
+};
+
+class FakeMegaNode: public mega::MegaNode
+{
+public:
+    FakeMegaNode(mega::MegaHandle handle, int type, const std::string& name, int64_t size = 0);
+
+    mega::MegaNode* copy() override;
+    int getType() override;
+    const char* getName() override;
+    const char* getFingerprint() override;
+    mega::MegaHandle getHandle() override;
+    mega::MegaHandle getParentHandle() override;
+    int64_t getSize() override;
+    bool isFile() override;
+    bool isFolder() override;
+    bool isInShare() override;
+    bool isNodeKeyDecrypted() override;
+
+    mega::MegaHandle mHandle;
+    mega::MegaHandle mParentHandle = mega::INVALID_HANDLE;
+    int mType;
+    std::string mName;
+    std::string mFingerprint;
+    int64_t mSize;
+};
+
+class FakeMegaSyncStall: public mega::MegaSyncStall
+{
+public:
+    FakeMegaSyncStall(SyncStallReason reason,
+                      const std::string& localPath,
+                      const std::string& cloudPath);
+
+    mega::MegaSyncStall* copy() const override;
+    SyncStallReason reason() const override;
+    const char* reasonDebugString() const override;
+    const char* path(bool cloudSide, int index) const override;
+    mega::MegaHandle cloudNodeHandle(int index) const override;
+    unsigned int pathCount(bool cloudSide) const override;
+    int pathProblem(bool cloudSide, int index) const override;
+    bool couldSuggestIgnoreThisPath(bool cloudSide, int index) const override;
+    bool detectedCloudSide() const override;
+    size_t getHash() const override;
+
+    SyncStallReason mReason;
+    std::string mLocalPath;
+    std::string mCloudPath;
+};
+
+class FakeMegaSyncStallList: public mega::MegaSyncStallList
+{
+public:
+    mega::MegaSyncStallList* copy() const override;
+    const mega::MegaSyncStall* get(size_t i) const override;
+    size_t size() const override;
+
+    std::vector<std::shared_ptr<FakeMegaSyncStall>> mStalls;
+};
+
+class FakeMegaUserAlert: public mega::MegaUserAlert
+{
+public:
+    FakeMegaUserAlert(unsigned id,
+                      int type,
+                      mega::MegaHandle userHandle,
+                      mega::MegaHandle nodeHandle = mega::INVALID_HANDLE,
+                      const std::string& email = std::string());
+
+    mega::MegaUserAlert* copy() const override;
+    unsigned getId() const override;
+    int getType() const override;
+    mega::MegaHandle getUserHandle() const override;
+    mega::MegaHandle getNodeHandle() const override;
+    const char* getEmail() const override;
+
+    unsigned mId;
+    int mType;
+    mega::MegaHandle mUserHandle;
+    mega::MegaHandle mNodeHandle;
+    std::string mEmail;
+};
+
+// Generators of deterministic fixtures: the same count always produces the same data
+namespace FakeSdkObjects
+{
+std::vector<std::unique_ptr<FakeMegaTransfer>> createTransfers(int count, int firstTag = 1);
+std::unique_ptr<mega::MegaNodeList> createNodeList(int count, mega::MegaHandle parentHandle);
+std::unique_ptr<FakeMegaSyncStallList> createStallList(int count);
+}
+
+#endif // FAKE_SDK_OBJECTS_H